@@ -28,4 +28,5 @@ find_package(ICONV QUIET)
 find_package(UUID QUIET)
 find_package(Libunwind)
 find_package(NUMA QUIET)
+find_package(URING QUIET)
 find_package(ML QUIET)
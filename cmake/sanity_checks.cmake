@@ -154,6 +154,10 @@ if (NUMA_FOUND)
     check_library_exists (${NUMA_LIBRARIES} numa_num_possible_cpus "" HAVE_NUMA)
 endif()
 
+if (URING_FOUND)
+    check_library_exists (${URING_LIBRARIES} io_uring_queue_init "" HAVE_LIBURING)
+endif()
+
 if (LIBUNWIND_FOUND)
     # We don't actually use backtrace from libunwind, but it's basically the
     # only symbol guaranteed to be present.
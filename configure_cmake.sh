@@ -130,6 +130,10 @@ Optional Packages:
                             libnuma include directory
     --with-libnuma-libraries=DIR
                             libnuma library directory
+    --with-liburing-includes=DIR
+                            liburing include directory
+    --with-liburing-libraries=DIR
+                            liburing library directory
 
 Some influential variable definitions:
     SIGNAL_SNORT_RELOAD=<int>
@@ -497,6 +501,12 @@ while [ $# -ne 0 ]; do
         --with-libnuma-libraries=*)
             append_cache_entry NUMA_LIBRARIES_DIR_HINT PATH $optarg
             ;;
+        --with-liburing-includes=*)
+            append_cache_entry URING_INCLUDE_DIR_HINT PATH $optarg
+            ;;
+        --with-liburing-libraries=*)
+            append_cache_entry URING_LIBRARIES_DIR_HINT PATH $optarg
+            ;;
         SIGNAL_SNORT_RELOAD=*)
             append_cache_entry SIGNAL_SNORT_RELOAD STRING $optarg
             ;;
@@ -30,9 +30,8 @@ class FileConnectorConfig : public snort::ConnectorConfig
 {
 public:
     FileConnectorConfig()
-    { direction = snort::Connector::CONN_UNDEFINED; text_format = false; }
+    { direction = snort::Connector::CONN_UNDEFINED; }
 
-    bool text_format;
     std::string name;
 };
 
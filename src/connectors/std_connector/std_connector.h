@@ -42,6 +42,9 @@ struct TextLog;
 class StdConnectorConfig : public snort::ConnectorConfig
 {
 public:
+    StdConnectorConfig()
+    { text_format = true; }
+
     uint32_t buffer_size = 0;
     StdConnectorBuffer* buffer = nullptr;
     std::string output = "stdout";
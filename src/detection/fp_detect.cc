@@ -370,6 +370,10 @@ static void detection_option_tree_evaluate(detection_option_tree_root_t* root,
     {
         detection_option_node_evaluate(root->children[i], eval_data, c);
     }
+
+    if ( eval_data.leaf_reached )
+        RuleLatency::matched();
+
     clear_trace_cursor_info();
 }
 
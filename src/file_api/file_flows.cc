@@ -34,6 +34,7 @@
 #include "main/snort_config.h"
 #include "main/thread.h"
 #include "managers/inspector_manager.h"
+#include "memory/memory_cap.h"
 #include "packet_io/packet_tracer.h"
 #include "protocols/packet.h"
 #include "trace/trace_api.h"
@@ -235,7 +236,7 @@ FileContext* FileFlows::find_main_file_context(FilePosition pos, FileDirection d
             delete context;
     }
 
-    context = new FileContext;
+    context = memory::arena_new<FileContext>(memory::ARENA_FILE);
     main_context = context;
     context->check_policy(flow, dir, file_policy);
 
@@ -294,7 +295,7 @@ FileContext* FileFlows::get_file_context(
         }
         else
         {
-            context = new FileContext;
+            context = memory::arena_new<FileContext>(memory::ARENA_FILE);
             is_new_context = true;
             partially_processed_contexts[multi_file_processing_id] = context;
             FILE_DEBUG(file_trace, DEFAULT_TRACE_OPTION_ID, TRACE_DEBUG_LEVEL, GET_CURRENT_PACKET,
@@ -37,6 +37,7 @@
 #include "main/analyzer.h"
 #endif
 #include "main/thread_config.h"
+#include "memory/memory_cap.h"
 #include "packet_io/active.h"
 #include "packet_io/packet_tracer.h"
 #include "stream/base/stream_module.h"
@@ -400,7 +401,7 @@ Flow* FlowCache::allocate(const FlowKey* key)
         }
     }
 
-    Flow* flow = new Flow;
+    Flow* flow = memory::arena_new<Flow>(memory::ARENA_FLOW);
     push(flow);
 
     flow = (Flow*)hash_table->get(key, to_utype(key->pkt_type));
@@ -35,6 +35,7 @@
 #include "main/analyzer.h"
 #include "main/thread_config.h"
 #include "managers/inspector_manager.h"
+#include "memory/memory_cap.h"
 #include "main/policy.h"
 #include "main/snort_config.h"
 #include "main/thread_config.h"
@@ -96,6 +97,9 @@ const char* SfIp::ntop(char* buf, int) const
 
 bool ControlConn::respond(const char*, ...) { return true; }
 
+void* memory::MemoryCap::allocate(memory::Arena, size_t size) { return ::operator new(size); }
+void memory::MemoryCap::deallocate(memory::Arena, void* p, size_t) { ::operator delete(p); }
+
 class TcpStreamTracker;
 const char* stream_tcp_state_to_str(const TcpStreamTracker&) { return "error"; }
 
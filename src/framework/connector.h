@@ -37,7 +37,7 @@
 namespace snort
 {
 // this is the current version of the api
-#define CONNECTOR_API_VERSION ((BASE_API_VERSION << 16) | 3)
+#define CONNECTOR_API_VERSION ((BASE_API_VERSION << 16) | 4)
 
 //-------------------------------------------------------------------------
 // api for class
@@ -136,6 +136,7 @@ public:
     typedef std::vector<std::unique_ptr<ConnectorConfig>> ConfigSet;
     Connector::Direction direction;
     std::string connector_name;
+    bool text_format = false;   // messages are written as lines of text
 
     virtual ~ConnectorConfig() = default;
 };
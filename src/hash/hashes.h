@@ -20,6 +20,8 @@
 #ifndef HASHES_H
 #define HASHES_H
 
+#include <cstdint>
+
 #include "main/snort_types.h"
 
 namespace snort
@@ -33,6 +35,18 @@ namespace snort
 SO_PUBLIC void md5(const unsigned char* data, size_t size, unsigned char* digest);
 SO_PUBLIC void sha256(const unsigned char* data, size_t size, unsigned char* digest);
 SO_PUBLIC void sha512(const unsigned char* data, size_t size, unsigned char* digest);
+
+// MurmurHash3 finalizer (fmix64); every input bit affects every output bit,
+// so it spreads integer keys and weak hashes over table indexes
+inline uint64_t mix64(uint64_t h)
+{
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
 }
 #endif
 
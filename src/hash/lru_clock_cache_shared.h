@@ -0,0 +1,688 @@
+//--------------------------------------------------------------------------
+// Copyright (C) 2026 Cisco and/or its affiliates. All rights reserved.
+//
+// This program is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License Version 2 as published
+// by the Free Software Foundation.  You may not use, modify or distribute
+// this program under any other version of the GNU General Public License.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+//--------------------------------------------------------------------------
+// lru_clock_cache_shared.h author Cisco
+
+#ifndef LRU_CLOCK_CACHE_SHARED_H
+#define LRU_CLOCK_CACHE_SHARED_H
+
+// ClockCacheShared -- Implements a thread-safe unordered map with the same
+// interface, statistics and size accounting as LruCacheShared, but which
+// approximates LRU order with the CLOCK algorithm.  A hit only sets the
+// entry's reference bit, so lookups run under a shared lock and never
+// reorder anything.  Once the cache is over its max size, the clock hand
+// sweeps the slots, clearing reference bits and evicting the first entry
+// that has not been referenced since the last sweep.  Entries are stored in
+// fixed size slabs and recycled through a free list instead of allocating a
+// list node per insert.
+//
+// ShardedClockCache spreads keys over a power of 2 number of ClockCacheShared
+// shards, sized from the number of packet threads that share the cache.
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "hash/hashes.h"
+#include "hash/lru_cache_shared.h"
+
+#define MAX_CLOCK_CACHE_SHARDS 64
+
+template<typename Key, typename Value, typename Hash = std::hash<Key>,
+    typename Eq = std::equal_to<Key>, typename Purgatory = std::vector<std::shared_ptr<Value>>>
+class ClockCacheShared
+{
+public:
+
+    //  Do not allow default constructor, copy constructor or assignment
+    //  operator.  Cannot safely copy the ClockCacheShared due to the mutex
+    //  lock.
+    ClockCacheShared() = delete;
+    ClockCacheShared(const ClockCacheShared& arg) = delete;
+    ClockCacheShared& operator=(const ClockCacheShared& arg) = delete;
+
+    ClockCacheShared(const size_t initial_size) :
+        max_size(initial_size), current_size(0) { }
+
+    virtual ~ClockCacheShared() = default;
+
+    using Data = std::shared_ptr<Value>;
+    using ValueType = Value;
+    using KeyType = Key;
+
+    // Return data entry associated with key. If doesn't exist, return nullptr.
+    Data find(const Key&);
+
+    // Return data entry associated with key. If doesn't exist, create a new entry.
+    Data operator[](const Key& key)
+    { return find_else_create(key, nullptr); }
+
+    // Same as operator[]; additionally, sets the boolean if a new entry is created.
+    Data find_else_create(const Key&, bool* new_data);
+
+    // Returns true if found or replaced, takes a ref to a user managed entry
+    bool find_else_insert(const Key&, Data&, bool replace = false);
+
+    // Returns the found or inserted data, takes a ref to user managed entry.
+    Data find_else_insert(const Key&, Data&, LcsInsertStatus*, bool replace = false);
+
+    // Return all data from the cache. There is no strict recency order; entries
+    // are returned in slot order.
+    std::vector<std::pair<Key, Data>> get_all_data();
+
+    //  Get current number of elements in the cache.
+    size_t size()
+    {
+        std::shared_lock<std::shared_mutex> cache_lock(cache_mutex);
+        return map.size();
+    }
+
+    virtual size_t mem_size()
+    {
+        std::shared_lock<std::shared_mutex> cache_lock(cache_mutex);
+        return map.size() * mem_chunk;
+    }
+
+    size_t get_max_size() const
+    { return max_size; }
+
+    //  Modify the maximum size allowed in the cache. If the size is reduced,
+    //  entries are evicted by the clock until the cache fits.
+    bool set_max_size(size_t newsize);
+
+    // If the new size causes pruning, don't modify max_size and return true
+    // signifying that a gradual pruning/resizing is needed with reload_prune().
+    // Otherwise, modify max_size and return false.
+    bool reload_resize(size_t new_size)
+    {
+        if ( current_size > new_size )
+            return true;
+
+        max_size = new_size;
+        return false;
+    }
+
+    // Evict up to max_prune entries chosen by the clock, keeping max_size at
+    // the current watermark. Return true when new_size is reached.
+    bool reload_prune(size_t new_size, unsigned max_prune);
+
+    //  Remove entry associated with Key.
+    //  Returns true if entry existed, false otherwise.
+    //  Sets new_size to the number of entries in the cache after removal.
+    virtual bool remove(const Key&, size_t* new_size = nullptr);
+
+    //  Remove entry associated with key and return removed data.
+    //  Returns true and copy of data if entry existed.  Returns false if
+    //  entry did not exist.
+    //  Sets new_size to the number of entries in the cache after removal.
+    virtual bool remove(const Key&, Data&, size_t* new_size = nullptr);
+
+    const PegInfo* get_pegs() const
+    { return lru_cache_shared_peg_names; }
+
+    // Hits and misses are counted atomically since most of them happen under
+    // the shared lock; fold them into the stats before handing them out.
+    const PegCount* get_counts()
+    {
+        stats.find_hits = find_hits.load(std::memory_order_relaxed);
+        stats.find_misses = find_misses.load(std::memory_order_relaxed);
+        return (const PegCount*)&stats;
+    }
+
+    void lock()
+    { cache_mutex.lock(); }
+
+    void unlock()
+    { cache_mutex.unlock(); }
+
+protected:
+    // Slots are default constructed in whole slabs, so Key must be default
+    // constructible and assignable.
+    struct Entry
+    {
+        Key key;
+        Data data;
+        std::atomic<bool> referenced { false };
+        bool in_use = false;
+    };
+
+    static constexpr uint32_t slab_entries = 256;
+    static constexpr size_t mem_chunk = sizeof(Data) + sizeof(Value);
+
+    std::atomic<size_t> max_size; // Once max_size is exceeded, the clock starts to evict
+                                  // entries that were not referenced since its last pass.
+
+    std::atomic<size_t> current_size; // Number of entries currently in the cache.
+
+    std::shared_mutex cache_mutex;
+    std::mutex reload_mutex;
+    std::unordered_map<Key, uint32_t, Hash, Eq> map; // Maps key to its slot.
+    std::vector<std::unique_ptr<Entry[]>> slabs;
+    std::vector<uint32_t> free_slots;
+    uint32_t slot_count = 0;
+    uint32_t hand = 0;
+
+    struct LruCacheSharedStats stats;
+    std::atomic<PegCount> find_hits { 0 };
+    std::atomic<PegCount> find_misses { 0 };
+
+    // See LruCacheShared; derived classes may account for size differently.
+    virtual void increase_size(ValueType* value_ptr=nullptr)
+    {
+        UNUSED(value_ptr);
+        current_size++;
+    }
+
+    virtual void decrease_size(ValueType* value_ptr=nullptr)
+    {
+        UNUSED(value_ptr);
+        current_size--;
+    }
+
+    Entry& get_slot(uint32_t idx)
+    { return slabs[idx / slab_entries][idx % slab_entries]; }
+
+    // Caller must hold the shared lock. Returns nullptr without counting a
+    // miss so that the caller can retry under the exclusive lock.
+    Data lookup(const Key& key)
+    {
+        auto map_iter = map.find(key);
+        if (map_iter == map.end())
+            return nullptr;
+
+        Entry& entry = get_slot(map_iter->second);
+        // avoid dirtying the line when the bit is already set
+        if ( !entry.referenced.load(std::memory_order_relaxed) )
+            entry.referenced.store(true, std::memory_order_relaxed);
+        find_hits.fetch_add(1, std::memory_order_relaxed);
+        return entry.data;
+    }
+
+    // Caller must hold the exclusive lock.
+    void add_entry(const Key& key, const Data& data)
+    {
+        uint32_t idx;
+        if (free_slots.empty())
+        {
+            if (slot_count % slab_entries == 0)
+                slabs.emplace_back(new Entry[slab_entries]);
+            idx = slot_count++;
+        }
+        else
+        {
+            idx = free_slots.back();
+            free_slots.pop_back();
+        }
+        Entry& entry = get_slot(idx);
+        entry.key = key;
+        entry.data = data;
+        entry.referenced.store(true, std::memory_order_relaxed);
+        entry.in_use = true;
+        map.emplace(key, idx);
+    }
+
+    // Caller must hold the exclusive lock and a reference to the data if its
+    // destructor may call back into the cache.
+    void free_entry(uint32_t idx)
+    {
+        Entry& entry = get_slot(idx);
+        map.erase(entry.key);
+        entry.data.reset();
+        entry.referenced.store(false, std::memory_order_relaxed);
+        entry.in_use = false;
+        free_slots.emplace_back(idx);
+    }
+
+    // Caller must hold the exclusive lock and the cache must not be empty.
+    // At most two passes of the hand are needed to find a victim since the
+    // first pass clears every reference bit. The victim's data is handed back
+    // so that it is released after the cache is unlocked.
+    void evict(Data& data)
+    {
+        while (true)
+        {
+            uint32_t idx = hand;
+            hand = (hand + 1) % slot_count;
+
+            Entry& entry = get_slot(idx);
+            if (!entry.in_use)
+                continue;
+
+            if (entry.referenced.load(std::memory_order_relaxed))
+            {
+                entry.referenced.store(false, std::memory_order_relaxed);
+                continue;
+            }
+
+            data = entry.data; // increase reference count
+            decrease_size(entry.data.get());
+            free_entry(idx);
+            return;
+        }
+    }
+
+    // Caller must hold the exclusive lock.
+    void prune(Purgatory& data)
+    {
+        assert(data.empty());
+        while (current_size > max_size && !map.empty())
+        {
+            Data victim;
+            evict(victim);
+            data.emplace_back(victim);
+            ++stats.alloc_prunes;
+        }
+    }
+
+    template<typename Remove>
+    bool remove_entry(const Key&, size_t* new_size, Remove);
+};
+
+template<typename Key, typename Value, typename Hash, typename Eq, typename Purgatory>
+bool ClockCacheShared<Key, Value, Hash, Eq, Purgatory>::set_max_size(size_t newsize)
+{
+    if (newsize == 0)
+        return false;   //  Not allowed to set size to zero.
+
+    // Evicted data must self-destruct after the cache_lock does.
+    Purgatory data;
+
+    std::lock_guard<std::shared_mutex> cache_lock(cache_mutex);
+
+    max_size = newsize;
+    prune(data);
+
+    return true;
+}
+
+template<typename Key, typename Value, typename Hash, typename Eq, typename Purgatory>
+bool ClockCacheShared<Key, Value, Hash, Eq, Purgatory>::reload_prune(size_t new_size,
+    unsigned max_prune)
+{
+    std::unique_lock<std::mutex> reload_lock(reload_mutex, std::try_to_lock);
+    if ( !reload_lock.owns_lock() )
+        return false; // some other thread wins this round
+
+    // As in LruCacheSharedMemcap, take the lock once per entry so that the
+    // evicted data is released, and its size accounted, between evictions.
+    while ( max_prune-- > 0 )
+    {
+        // Data must self-destruct after the cache_lock does.
+        Data data;
+        std::lock_guard<std::shared_mutex> cache_lock(cache_mutex);
+
+        if ( !map.empty() )
+        {
+            max_size.store(current_size);
+            if ( max_size > new_size )
+            {
+                evict(data);
+                max_size.store(current_size); // in sync with current_size
+                ++stats.reload_prunes;
+            }
+        }
+
+        if ( max_size <= new_size or map.empty() )
+        {
+            max_size = new_size;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+template<typename Key, typename Value, typename Hash, typename Eq, typename Purgatory>
+std::shared_ptr<Value> ClockCacheShared<Key, Value, Hash, Eq, Purgatory>::find(const Key& key)
+{
+    std::shared_lock<std::shared_mutex> cache_lock(cache_mutex);
+
+    Data data = lookup(key);
+    if (!data)
+        find_misses.fetch_add(1, std::memory_order_relaxed);
+    return data;
+}
+
+template<typename Key, typename Value, typename Hash, typename Eq, typename Purgatory>
+std::shared_ptr<Value> ClockCacheShared<Key, Value, Hash, Eq, Purgatory>::find_else_create(
+    const Key& key, bool* new_data)
+{
+    {
+        std::shared_lock<std::shared_mutex> cache_lock(cache_mutex);
+        if (Data data = lookup(key))
+        {
+            if (new_data)
+                *new_data = false;
+            return data;
+        }
+    }
+
+    // As in LruCacheShared, pruned entries must outlive the cache lock.
+    Purgatory tmp_data;
+
+    std::lock_guard<std::shared_mutex> cache_lock(cache_mutex);
+
+    // another thread may have added the key while the lock was released
+    if (Data data = lookup(key))
+    {
+        if (new_data)
+            *new_data = false;
+        return data;
+    }
+
+    find_misses.fetch_add(1, std::memory_order_relaxed);
+    stats.adds++;
+    if (new_data)
+        *new_data = true;
+
+    Data data = Data(new Value);
+    add_entry(key, data);
+    increase_size(data.get());
+    prune(tmp_data);
+
+    return data;
+}
+
+template<typename Key, typename Value, typename Hash, typename Eq, typename Purgatory>
+bool ClockCacheShared<Key, Value, Hash, Eq, Purgatory>::find_else_insert(const Key& key,
+    Data& data, bool replace)
+{
+    LcsInsertStatus status;
+    find_else_insert(key, data, &status, replace);
+    return status != LcsInsertStatus::LCS_ITEM_INSERTED;
+}
+
+template<typename Key, typename Value, typename Hash, typename Eq, typename Purgatory>
+std::shared_ptr<Value> ClockCacheShared<Key, Value, Hash, Eq, Purgatory>::find_else_insert(
+    const Key& key, Data& data, LcsInsertStatus* status, bool replace)
+{
+    if (!replace)
+    {
+        std::shared_lock<std::shared_mutex> cache_lock(cache_mutex);
+        if (Data found = lookup(key))
+        {
+            if (status)
+                *status = LcsInsertStatus::LCS_ITEM_PRESENT;
+            return found;
+        }
+    }
+
+    // Both the replaced and the pruned objects must outlive the cache lock.
+    Data replaced;
+    Purgatory tmp_data;
+
+    std::lock_guard<std::shared_mutex> cache_lock(cache_mutex);
+
+    auto map_iter = map.find(key);
+    if (map_iter != map.end())
+    {
+        Entry& entry = get_slot(map_iter->second);
+        entry.referenced.store(true, std::memory_order_relaxed);
+        find_hits.fetch_add(1, std::memory_order_relaxed);
+        if (status)
+            *status = LcsInsertStatus::LCS_ITEM_PRESENT;
+        if (replace)
+        {
+            replaced = entry.data;
+            decrease_size(entry.data.get());
+            entry.data = data;
+            increase_size(entry.data.get());
+            stats.replaced++;
+            if (status)
+                *status = LcsInsertStatus::LCS_ITEM_REPLACED;
+        }
+        return entry.data;
+    }
+
+    find_misses.fetch_add(1, std::memory_order_relaxed);
+    stats.adds++;
+    if (status)
+        *status = LcsInsertStatus::LCS_ITEM_INSERTED;
+
+    add_entry(key, data);
+    increase_size(data.get());
+    prune(tmp_data);
+
+    return data;
+}
+
+template<typename Key, typename Value, typename Hash, typename Eq, typename Purgatory>
+std::vector<std::pair<Key, std::shared_ptr<Value>>>
+ClockCacheShared<Key, Value, Hash, Eq, Purgatory>::get_all_data()
+{
+    std::vector<std::pair<Key, Data>> vec;
+    std::shared_lock<std::shared_mutex> cache_lock(cache_mutex);
+
+    vec.reserve(map.size());
+    for (uint32_t idx = 0; idx < slot_count; ++idx)
+    {
+        Entry& entry = get_slot(idx);
+        if (entry.in_use)
+            vec.emplace_back(entry.key, entry.data);
+    }
+    return vec;
+}
+
+template<typename Key, typename Value, typename Hash, typename Eq, typename Purgatory>
+template<typename Remove>
+bool ClockCacheShared<Key, Value, Hash, Eq, Purgatory>::remove_entry(const Key& key,
+    size_t* new_size, Remove keep)
+{
+    std::lock_guard<std::shared_mutex> cache_lock(cache_mutex);
+
+    auto map_iter = map.find(key);
+    if (map_iter == map.end())
+    {
+        if (new_size)
+            *new_size = map.size();
+
+        return false;   //  Key is not in the cache.
+    }
+
+    Entry& entry = get_slot(map_iter->second);
+    keep(entry.data);
+    decrease_size(entry.data.get());
+    free_entry(map_iter->second);
+    stats.removes++;
+
+    if (new_size)
+        *new_size = map.size();
+
+    return true;
+}
+
+template<typename Key, typename Value, typename Hash, typename Eq, typename Purgatory>
+bool ClockCacheShared<Key, Value, Hash, Eq, Purgatory>::remove(const Key& key, size_t* new_size)
+{
+    // As in LruCacheShared, data must be defined before the lock is taken so
+    // that the Value is destroyed only after the cache is unlocked.
+    Data data;
+    return remove_entry(key, new_size, [&data](const Data& d) { data = d; });
+}
+
+template<typename Key, typename Value, typename Hash, typename Eq, typename Purgatory>
+bool ClockCacheShared<Key, Value, Hash, Eq, Purgatory>::remove(const Key& key, Data& data,
+    size_t* new_size)
+{
+    return remove_entry(key, new_size, [&data](const Data& d) { data = d; });
+}
+
+template<typename Key, typename Value, typename Hash = std::hash<Key>, typename Eq = std::equal_to<Key>>
+class ShardedClockCache
+{
+public:
+
+    using ClockCacheType = ClockCacheShared<Key, Value, Hash, Eq>;
+    using Data = typename ClockCacheType::Data;
+
+    // The shard count is the smallest power of 2 that is at least twice the
+    // number of threads sharing the cache, up to MAX_CLOCK_CACHE_SHARDS.
+    ShardedClockCache(const size_t initial_size, unsigned threads) :
+        shard_count(get_shard_count(threads))
+    {
+        size_t shard_size = std::max<size_t>(initial_size / shard_count, 1);
+        shards.reserve(shard_count);
+        for (size_t i = 0; i < shard_count; ++i)
+            shards.emplace_back(std::make_unique<ClockCacheType>(shard_size));
+    }
+
+    static size_t get_shard_count(unsigned threads)
+    {
+        size_t n = 1;
+        while (n < 2 * (size_t)threads and n < MAX_CLOCK_CACHE_SHARDS)
+            n <<= 1;
+        return n;
+    }
+
+    Data find(const Key& key)
+    { return shards[get_shard_idx(key)]->find(key); }
+
+    Data operator[](const Key& key)
+    { return (*shards[get_shard_idx(key)])[key]; }
+
+    bool remove(const Key& key, size_t* new_size = nullptr)
+    { return shards[get_shard_idx(key)]->remove(key, new_size); }
+
+    bool remove(const Key& key, Data& data, size_t* new_size = nullptr)
+    { return shards[get_shard_idx(key)]->remove(key, data, new_size); }
+
+    Data find_else_create(const Key& key, bool* new_data)
+    { return shards[get_shard_idx(key)]->find_else_create(key, new_data); }
+
+    bool find_else_insert(const Key& key, Data& data, bool replace = false)
+    { return shards[get_shard_idx(key)]->find_else_insert(key, data, replace); }
+
+    Data find_else_insert(const Key& key, Data& data, LcsInsertStatus* status,
+        bool replace = false)
+    { return shards[get_shard_idx(key)]->find_else_insert(key, data, status, replace); }
+
+    bool set_max_size(size_t max_size)
+    {
+        bool success = true;
+        size_t shard_size = std::max<size_t>(max_size / shard_count, 1);
+        for (const auto& shard : shards)
+        {
+            if (!shard->set_max_size(shard_size))
+                success = false;
+        }
+        return success;
+    }
+
+    // Each shard gets an equal share of new_size and of max_prune.
+    bool reload_resize(size_t new_size)
+    {
+        bool prune = false;
+        size_t shard_size = std::max<size_t>(new_size / shard_count, 1);
+        for (const auto& shard : shards)
+        {
+            if (shard->reload_resize(shard_size))
+                prune = true;
+        }
+        return prune;
+    }
+
+    bool reload_prune(size_t new_size, unsigned max_prune)
+    {
+        bool done = true;
+        size_t shard_size = std::max<size_t>(new_size / shard_count, 1);
+        unsigned shard_prune = std::max<unsigned>(max_prune / shard_count, 1);
+        for (const auto& shard : shards)
+        {
+            if (!shard->reload_prune(shard_size, shard_prune))
+                done = false;
+        }
+        return done;
+    }
+
+    std::vector<std::pair<Key, Data>> get_all_data()
+    {
+        std::vector<std::pair<Key, Data>> all_data;
+
+        for (const auto& shard : shards)
+        {
+            auto shard_data = shard->get_all_data();
+            all_data.insert(all_data.end(), shard_data.begin(), shard_data.end());
+        }
+        return all_data;
+    }
+
+    size_t mem_size() const
+    {
+        size_t mem_size = 0;
+        for (const auto& shard : shards)
+            mem_size += shard->mem_size();
+        return mem_size;
+    }
+
+    const PegInfo* get_pegs()
+    { return lru_cache_shared_peg_names; }
+
+    const PegCount* get_counts()
+    {
+        PegCount* pcs = (PegCount*)&counts;
+        const PegInfo* pegs = get_pegs();
+
+        for (int i = 0; pegs[i].type != CountType::END; i++)
+            pcs[i] = 0;
+
+        for (const auto& shard : shards)
+        {
+            const PegCount* shard_counts = shard->get_counts();
+            for (int i = 0; pegs[i].type != CountType::END; i++)
+                pcs[i] += shard_counts[i];
+        }
+        return (const PegCount*)&counts;
+    }
+
+    size_t size() const
+    {
+        size_t total_size = 0;
+        for (const auto& shard : shards)
+            total_size += shard->size();
+        return total_size;
+    }
+
+    size_t get_max_size() const
+    {
+        size_t max_size = 0;
+        for (const auto& shard : shards)
+            max_size += shard->get_max_size();
+        return max_size;
+    }
+
+    size_t get_shard_count() const
+    { return shard_count; }
+
+private:
+    const size_t shard_count;
+    std::vector<std::unique_ptr<ClockCacheType>> shards;
+    struct LruCacheSharedStats counts;
+
+    size_t get_shard_idx(const Key& key) const
+    {
+        // mix the hash so that identity hashes of integer keys still spread
+        // across the shards
+        return snort::mix64(Hash()(key)) & (shard_count - 1);
+    }
+};
+
+#endif
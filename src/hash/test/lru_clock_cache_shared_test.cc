@@ -0,0 +1,307 @@
+//--------------------------------------------------------------------------
+// Copyright (C) 2026 Cisco and/or its affiliates. All rights reserved.
+//
+// This program is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License Version 2 as published
+// by the Free Software Foundation.  You may not use, modify or distribute
+// this program under any other version of the GNU General Public License.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+//--------------------------------------------------------------------------
+// lru_clock_cache_shared_test.cc author Cisco
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <cstring>
+#include <string>
+#include <thread>
+
+#include "hash/lru_clock_cache_shared.h"
+
+#include <CppUTest/CommandLineTestRunner.h>
+#include <CppUTest/TestHarness.h>
+
+TEST_GROUP(clock_cache_shared)
+{
+};
+
+// Test insert, find and that new entries replace the stale ones.
+TEST(clock_cache_shared, insert_test)
+{
+    ClockCacheShared<int, std::string> cache(3);
+
+    auto data = cache[0];
+    CHECK(data == cache.find(0));
+    data->assign("zero");
+
+    cache[1]->assign("one");
+    cache[2]->assign("two");
+    CHECK(3 == cache.size());
+
+    // every entry is referenced, so the clock clears all bits and evicts the
+    // first slot it comes back to
+    cache[3]->assign("three");
+    CHECK(3 == cache.size());
+    CHECK(nullptr == cache.find(0));
+
+    // 1 and 2 lost their bits in the last sweep; touching 1 protects it
+    CHECK(nullptr != cache.find(1));
+    cache[4]->assign("four");
+    CHECK(nullptr != cache.find(1));
+    CHECK(nullptr == cache.find(2));
+    CHECK("three" == *cache.find(3));
+    CHECK("four" == *cache.find(4));
+}
+
+// Freed slots are reused before the slabs grow.
+TEST(clock_cache_shared, slot_reuse_test)
+{
+    ClockCacheShared<int, int> cache(1000);
+
+    for (int i = 0; i < 300; i++)
+        *cache[i] = i;
+
+    for (int i = 0; i < 300; i += 2)
+        CHECK(cache.remove(i));
+
+    for (int i = 300; i < 450; i++)
+        *cache[i] = i;
+
+    CHECK(300 == cache.size());
+    CHECK(300 * (sizeof(std::shared_ptr<int>) + sizeof(int)) == cache.mem_size());
+
+    auto vec = cache.get_all_data();
+    CHECK(300 == vec.size());
+    for (const auto& kv : vec)
+        CHECK(kv.first == *kv.second);
+}
+
+// Test statistics counters; they match the LruCacheShared ones.
+TEST(clock_cache_shared, stats_test)
+{
+    ClockCacheShared<int, std::string> cache(5);
+
+    for (int i = 0; i < 10; i++)
+        cache[i];
+
+    cache.find(7);
+    cache.find(8);
+    cache.find(9);
+    cache.find(10);
+    cache.find(11);
+
+    CHECK(cache.set_max_size(12) == true);
+
+    size_t cache_size = 0;
+    cache.remove(7, &cache_size);
+    CHECK(4 == cache_size);
+
+    std::shared_ptr<std::string> data(new std::string("replacement"));
+    CHECK(cache.find_else_insert(8, data, true));
+    CHECK(data == cache.find(8));
+
+    const PegCount* stats = cache.get_counts();
+
+    CHECK(stats[0] == 10);  //  adds
+    CHECK(stats[1] == 5);   //  alloc_prunes
+    CHECK(stats[2] == 0);   //  bytes_in_use
+    CHECK(stats[3] == 0);   //  items_in_use
+    CHECK(stats[4] == 5);   //  find hits
+    CHECK(stats[5] == 12);  //  find misses
+    CHECK(stats[6] == 0);   //  reload prunes
+    CHECK(stats[7] == 1);   //  removes
+    CHECK(stats[8] == 1);   //  replaced
+
+    const PegInfo* pegs = cache.get_pegs();
+    CHECK(!strcmp(pegs[4].name, "find_hits"));
+}
+
+// Test the find_else_insert method for item replacement
+TEST(clock_cache_shared, find_else_insert_replace)
+{
+    ClockCacheShared<int, std::string> cache(8);
+    std::shared_ptr<std::string> data(new std::string("hello"));
+    LcsInsertStatus status;
+
+    cache.find_else_insert(1, data, &status, false);
+    CHECK(status == LcsInsertStatus::LCS_ITEM_INSERTED);
+
+    std::shared_ptr<std::string> new_data(new std::string("world"));
+    auto returned = cache.find_else_insert(1, new_data, &status, true);
+    CHECK(status == LcsInsertStatus::LCS_ITEM_REPLACED);
+    CHECK(*returned == "world");
+
+    returned = cache.find_else_insert(1, data, &status, false);
+    CHECK(status == LcsInsertStatus::LCS_ITEM_PRESENT);
+    CHECK(*returned == "world");
+}
+
+// Memcap cache in the style of LruCacheSharedMemcap (host_tracker/host_cache.h):
+// sizes are accounted in bytes and items may grow after they are cached.
+template<typename Key, typename Value>
+class ClockCacheSharedMemcap : public ClockCacheShared<Key, Value>
+{
+public:
+    using ClockBase = ClockCacheShared<Key, Value>;
+    using ClockBase::cache_mutex;
+    using ClockBase::current_size;
+    using ClockBase::max_size;
+    using ClockBase::mem_chunk;
+    using Purgatory = std::vector<std::shared_ptr<Value>>;
+    using ValueType = typename ClockBase::ValueType;
+
+    ClockCacheSharedMemcap(const size_t sz) : ClockBase(sz) { }
+
+    size_t mem_size() override
+    { return current_size; }
+
+    void update(int size)
+    {
+        if ( (current_size += size) > max_size )
+        {
+            Purgatory data;
+            std::lock_guard<std::shared_mutex> cache_lock(cache_mutex);
+            ClockBase::prune(data);
+        }
+    }
+
+    static constexpr size_t chunk = ClockBase::mem_chunk;
+
+private:
+    void increase_size(ValueType*) override
+    { current_size += mem_chunk; }
+
+    void decrease_size(ValueType*) override
+    {
+        assert( current_size >= mem_chunk );
+        current_size -= mem_chunk;
+    }
+};
+
+TEST(clock_cache_shared, memcap_reload_prune)
+{
+    using MemcapCache = ClockCacheSharedMemcap<int, int>;
+    const size_t chunk = MemcapCache::chunk;
+    MemcapCache cache(10 * chunk);
+
+    for (int i = 0; i < 10; i++)
+        cache[i];
+    CHECK(10 == cache.size());
+    CHECK(10 * chunk == cache.mem_size());
+
+    // growing a cached item over the memcap prunes by the clock
+    cache.update(chunk);
+    CHECK(9 == cache.size());
+    CHECK(10 * chunk == cache.mem_size());
+
+    // growing the memcap does not need pruning
+    CHECK(!cache.reload_resize(20 * chunk));
+    CHECK(20 * chunk == cache.get_max_size());
+
+    // shrinking it is done a few entries at a time
+    CHECK(cache.reload_resize(4 * chunk));
+    CHECK(20 * chunk == cache.get_max_size());
+
+    CHECK(!cache.reload_prune(4 * chunk, 2));
+    CHECK(7 == cache.size());
+    CHECK(8 * chunk == cache.get_max_size());
+
+    CHECK(!cache.reload_prune(4 * chunk, 2));
+    CHECK(5 == cache.size());
+    CHECK(cache.reload_prune(4 * chunk, 2));
+    CHECK(3 == cache.size());
+    CHECK(4 * chunk == cache.mem_size());
+    CHECK(4 * chunk == cache.get_max_size());
+
+    const PegCount* stats = cache.get_counts();
+    CHECK(1 == stats[1]);   // alloc_prunes
+    CHECK(6 == stats[6]);   // reload_prunes
+    CHECK(cache.reload_prune(4 * chunk, 2));
+}
+
+TEST_GROUP(sharded_clock_cache)
+{
+};
+
+TEST(sharded_clock_cache, shard_count_test)
+{
+    CHECK(1 == (ShardedClockCache<int, int>::get_shard_count(0)));
+    CHECK(2 == (ShardedClockCache<int, int>::get_shard_count(1)));
+    CHECK(8 == (ShardedClockCache<int, int>::get_shard_count(3)));
+    CHECK(MAX_CLOCK_CACHE_SHARDS == (ShardedClockCache<int, int>::get_shard_count(1000)));
+
+    ShardedClockCache<int, int> cache(64, 4);
+    CHECK(8 == cache.get_shard_count());
+    CHECK(64 == cache.get_max_size());
+}
+
+TEST(sharded_clock_cache, insert_test)
+{
+    ShardedClockCache<int, std::string> cache(64, 2);
+
+    for (int i = 0; i < 32; i++)
+        cache[i]->assign(std::to_string(i));
+
+    for (int i = 0; i < 32; i++)
+        CHECK(std::to_string(i) == *cache.find(i));
+
+    CHECK(32 == cache.size());
+    CHECK(32 == cache.get_all_data().size());
+
+    bool new_data = false;
+    cache.find_else_create(100, &new_data);
+    CHECK(new_data);
+    cache.find_else_create(100, &new_data);
+    CHECK(!new_data);
+
+    CHECK(cache.remove(100));
+    CHECK(!cache.remove(100));
+
+    const PegCount* stats = cache.get_counts();
+    CHECK(stats[0] == 33);  //  adds
+    CHECK(stats[4] == 33);  //  find hits
+    CHECK(stats[7] == 1);   //  removes
+}
+
+// Threads hitting and growing the same cache must keep it within its size.
+TEST(sharded_clock_cache, threads_test)
+{
+    ShardedClockCache<int, int> cache(256, 4);
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < 4; t++)
+    {
+        threads.emplace_back([&cache, t]()
+        {
+            for (int i = 0; i < 10000; i++)
+            {
+                int key = (i * 7 + t) % 1024;
+                bool new_data;
+                auto data = cache.find_else_create(key, &new_data);
+                if (new_data)
+                    *data = key;
+                cache.find(key);
+            }
+        });
+    }
+
+    for (auto& thread : threads)
+        thread.join();
+
+    CHECK(cache.size() <= cache.get_max_size());
+    CHECK(cache.size() > 0);
+}
+
+int main(int argc, char** argv)
+{
+    return CommandLineTestRunner::RunAllTests(argc, argv);
+}
@@ -55,15 +55,19 @@ HostTracker::HostTracker()
 
 void HostTracker::update_last_seen()
 {
-    lock_guard<mutex> lck(host_tracker_lock);
     //coverity[y2k38_safety]
-    last_seen = (uint32_t) packet_time();
+    uint32_t now = (uint32_t) packet_time();
+
+    // packet time has second granularity, so most calls have nothing new to
+    // store; skipping those keeps the line shared between packet threads
+    if ( last_seen.load(std::memory_order_relaxed) != now )
+        last_seen.store(now, std::memory_order_relaxed);
 }
 
 void HostTracker::update_last_event(uint32_t time)
 {
-    lock_guard<mutex> lck(host_tracker_lock);
-    last_event = time ? time : last_seen;
+    last_event.store(time ? time : last_seen.load(std::memory_order_relaxed),
+        std::memory_order_relaxed);
 }
 
 bool HostTracker::add_network_proto(const uint16_t type)
@@ -876,8 +880,7 @@ bool HostTracker::set_visibility(bool v)
 
 bool HostTracker::is_visible() const
 {
-    std::lock_guard<std::mutex> lck(host_tracker_lock);
-    return visibility == host_cache.get_valid_id(cache_idx);
+    return get_visibility() == host_cache.get_valid_id(get_cache_idx());
 }
 
 
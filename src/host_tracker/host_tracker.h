@@ -23,8 +23,11 @@
 
 // The HostTracker class holds information known about a host (may be from
 // configuration or dynamic discovery).  It provides a thread-safe API to
-// set/get the host data.
+// set/get the host data.  Scalar attributes that packet threads read on
+// every lookup are atomics and do not take host_tracker_lock; containers
+// are still guarded by it.
 
+#include <atomic>
 #include <cstring>
 #include <mutex>
 #include <list>
@@ -210,17 +213,11 @@ public:
 
     void update_last_seen();
     uint32_t get_last_seen() const
-    {
-        std::lock_guard<std::mutex> lck(host_tracker_lock);
-        return last_seen;
-    }
+    { return last_seen.load(std::memory_order_relaxed); }
 
     void update_last_event(uint32_t time = 0);
     uint32_t get_last_event() const
-    {
-        std::lock_guard<std::mutex> lck(host_tracker_lock);
-        return last_event;
-    }
+    { return last_event.load(std::memory_order_relaxed); }
 
     std::vector<uint16_t> get_network_protos()
     {
@@ -243,28 +240,16 @@ public:
     }
 
     void set_host_type(HostType rht)
-    {
-        std::lock_guard<std::mutex> lck(host_tracker_lock);
-        host_type = rht;
-    }
+    { host_type.store(rht, std::memory_order_relaxed); }
 
     HostType get_host_type() const
-    {
-        std::lock_guard<std::mutex> lck(host_tracker_lock);
-        return host_type;
-    }
+    { return host_type.load(std::memory_order_relaxed); }
 
-    uint8_t get_hops()
-    {
-        std::lock_guard<std::mutex> lck(host_tracker_lock);
-        return hops;
-    }
+    uint8_t get_hops() const
+    { return hops.load(std::memory_order_relaxed); }
 
     void update_hops(uint8_t h)
-    {
-        std::lock_guard<std::mutex> lck(host_tracker_lock);
-        hops = h;
-    }
+    { hops.store(h, std::memory_order_relaxed); }
 
     bool add_client_payload(HostClient&, AppId, size_t);
 
@@ -338,68 +323,40 @@ public:
     void stringify(std::string& str);
 
     uint8_t get_ip_ttl() const
-    {
-        std::lock_guard<std::mutex> lck(host_tracker_lock);
-        return ip_ttl;
-    }
+    { return ip_ttl.load(std::memory_order_relaxed); }
 
     void set_ip_ttl(uint8_t ttl)
-    {
-        std::lock_guard<std::mutex> lck(host_tracker_lock);
-        ip_ttl = ttl;
-    }
+    { ip_ttl.store(ttl, std::memory_order_relaxed); }
 
     uint32_t get_nat_count_start() const
-    {
-        std::lock_guard<std::mutex> lck(host_tracker_lock);
-        return nat_count_start;
-    }
+    { return nat_count_start.load(std::memory_order_relaxed); }
 
     void set_nat_count_start(uint32_t natCountStart)
-    {
-        std::lock_guard<std::mutex> lck(host_tracker_lock);
-        nat_count_start = natCountStart;
-    }
+    { nat_count_start.store(natCountStart, std::memory_order_relaxed); }
 
     uint32_t get_nat_count() const
-    {
-        std::lock_guard<std::mutex> lck(host_tracker_lock);
-        return nat_count;
-    }
+    { return nat_count.load(std::memory_order_relaxed); }
 
     void set_nat_count(uint32_t v = 0)
-    {
-        std::lock_guard<std::mutex> lck(host_tracker_lock);
-        nat_count = v;
-    }
+    { nat_count.store(v, std::memory_order_relaxed); }
 
     uint32_t inc_nat_count()
-    {
-        std::lock_guard<std::mutex> lck(host_tracker_lock);
-        return ++nat_count;
-    }
+    { return nat_count.fetch_add(1, std::memory_order_relaxed) + 1; }
 
     void set_cache_idx(uint8_t idx)
-    {
-        std::lock_guard<std::mutex> lck(host_tracker_lock);
-        cache_idx = idx;
-    }
+    { cache_idx.store(idx, std::memory_order_relaxed); }
 
     void init_visibility(size_t v)
-    {
-        std::lock_guard<std::mutex> lck(host_tracker_lock);
-        visibility = v;
-    }
+    { visibility.store(v, std::memory_order_relaxed); }
 
     uint8_t get_cache_idx() const
-    {
-        return cache_idx;
-    }
+    { return cache_idx.load(std::memory_order_relaxed); }
 
     bool set_netbios_name(const char*);
 
     bool set_visibility(bool v = true);
-    size_t get_visibility() const {return visibility;}
+    size_t get_visibility() const
+    { return visibility.load(std::memory_order_relaxed); }
 
 
     bool is_visible() const;
@@ -438,9 +395,9 @@ private:
 
     mutable std::mutex host_tracker_lock; // ensure that updates to a shared object are safe
     mutable std::mutex flows_lock;        // protect the flows set separately
-    uint8_t hops = ~0;                 // hops from the snort inspector, e.g., zero for ARP
-    uint32_t last_seen;           // the last time this host was seen
-    uint32_t last_event = ~0;          // the last time an event was generated
+    std::atomic<uint8_t> hops { (uint8_t)~0 };  // hops from the snort inspector, e.g., zero for ARP
+    std::atomic<uint32_t> last_seen;            // the last time this host was seen
+    std::atomic<uint32_t> last_event { (uint32_t)~0 };  // the last time an event was generated
 
     // list guarantees iterator validity on insertion
     std::list<HostMac_t, HostCacheAllocIp<HostMac_t>> macs;
@@ -460,13 +417,13 @@ private:
 
     bool vlan_tag_present = false;
     vlan::VlanTagHdr vlan_tag = {};
-    HostType host_type = HOST_TYPE_HOST;
-    uint8_t ip_ttl = 0;
-    uint32_t nat_count = 0;
-    uint32_t nat_count_start;     // the time nat counting starts for this host
+    std::atomic<HostType> host_type { HOST_TYPE_HOST };
+    std::atomic<uint8_t> ip_ttl { 0 };
+    std::atomic<uint32_t> nat_count { 0 };
+    std::atomic<uint32_t> nat_count_start;  // the time nat counting starts for this host
 
-    size_t visibility;
-    uint8_t cache_idx = 0;
+    std::atomic<size_t> visibility;
+    std::atomic<uint8_t> cache_idx { 0 };
 
     uint32_t num_visible_services = 0;
     uint32_t num_visible_clients = 0;
@@ -23,8 +23,9 @@
 
 #include "js_identifier_ctx.h"
 
+#include <algorithm>
 #include <cassert>
-#include <memory.h>
+#include <cstring>
 
 #include "js_enum.h"
 #include "js_norm_module.h"
@@ -38,6 +39,8 @@ using namespace jsn;
 #define TYPE_IGNORED_ID     2
 #define TYPE_IGNORED_PROP   4
 
+#define MIN_NAME_SLOTS 256
+
 static char norm_names[NORM_NAME_SIZE * NORM_NAME_CNT];
 
 static void init_norm_names()
@@ -63,19 +66,131 @@ static void init_norm_names()
 
 static int _init_norm_names __attribute__((unused)) = (static_cast<void>(init_norm_names()), 0);
 
+// FNV-1a, the length comes out of the same pass
+static inline uint32_t name_hash(const char* str, uint32_t& len)
+{
+    uint32_t h = 2166136261u;
+    const char* c = str;
+
+    for (; *c; ++c)
+        h = (h ^ (uint8_t)*c) * 16777619u;
+
+    len = c - str;
+    return h;
+}
+
+const char* JSIdentifierCtx::Arena::store(const char* str, size_t len)
+{
+    char* dst;
+
+    if (len >= BLOCK_SIZE / 4)
+    {
+        large.emplace_back(new char[len + 1]);
+        dst = large.back().get();
+    }
+    else
+    {
+        if (!cur || (size_t)(end - cur) < len + 1)
+        {
+            blocks.emplace_back(new char[BLOCK_SIZE]);
+            cur = blocks.back().get();
+            end = cur + BLOCK_SIZE;
+        }
+        dst = cur;
+        cur += len + 1;
+    }
+
+    memcpy(dst, str, len);
+    dst[len] = '\0';
+    return dst;
+}
+
+void JSIdentifierCtx::Arena::reset()
+{
+    // keep one block for the next transaction
+    large.clear();
+    blocks.resize(std::min(blocks.size(), (size_t)1));
+    cur = blocks.empty() ? nullptr : blocks[0].get();
+    end = cur ? cur + BLOCK_SIZE : nullptr;
+}
+
 JSIdentifierCtx::JSIdentifierCtx(int32_t depth, uint32_t max_scope_depth,
     const std::unordered_set<std::string>& ignored_ids_list,
     const std::unordered_set<std::string>& ignored_props_list)
-    : ignored_ids_list(ignored_ids_list), ignored_props_list(ignored_props_list),
-    max_scope_depth(max_scope_depth)
+    : slots(MIN_NAME_SLOTS, 0), ignored_ids_list(ignored_ids_list),
+    ignored_props_list(ignored_props_list), max_scope_depth(max_scope_depth)
 {
     norm_name = norm_names;
     norm_name_end = norm_names + NORM_NAME_SIZE * std::min(depth, NORM_NAME_CNT);
-    scopes.emplace_back(JSProgramScopeType::GLOBAL);
+    scopes.push_back({JSProgramScopeType::GLOBAL, 0});
 
     init_ignored_names();
 }
 
+uint32_t JSIdentifierCtx::intern(const char* str)
+{
+    uint32_t len;
+    uint32_t hash = name_hash(str, len);
+
+    return intern(str, len, hash, nullptr);
+}
+
+uint32_t JSIdentifierCtx::intern(const char* str, uint32_t len, uint32_t hash, const char* stored)
+{
+    const uint32_t mask = slots.size() - 1;
+
+    for (uint32_t i = hash & mask; ; i = (i + 1) & mask)
+    {
+        uint32_t slot = slots[i];
+
+        if (!slot)
+        {
+            uint32_t id = names.size();
+            names.push_back({stored ? stored : arena.store(str, len), len, hash, {}, NO_ALIAS});
+            slots[i] = id + 1;
+
+            if (names.size() * 4 > slots.size() * 3)
+                grow();
+
+            return id;
+        }
+
+        const Name& n = names[slot - 1];
+        if (n.hash == hash && n.len == len && !memcmp(n.str, str, len))
+            return slot - 1;
+    }
+}
+
+const JSIdentifierCtx::Name* JSIdentifierCtx::find(const char* str) const
+{
+    uint32_t len;
+    uint32_t hash = name_hash(str, len);
+    const uint32_t mask = slots.size() - 1;
+
+    for (uint32_t i = hash & mask; slots[i]; i = (i + 1) & mask)
+    {
+        const Name& n = names[slots[i] - 1];
+        if (n.hash == hash && n.len == len && !memcmp(n.str, str, len))
+            return &n;
+    }
+
+    return nullptr;
+}
+
+void JSIdentifierCtx::grow()
+{
+    slots.assign(slots.size() * 2, 0);
+    const uint32_t mask = slots.size() - 1;
+
+    for (uint32_t id = 0; id < names.size(); ++id)
+    {
+        uint32_t i = names[id].hash & mask;
+        while (slots[i])
+            i = (i + 1) & mask;
+        slots[i] = id + 1;
+    }
+}
+
 const char* JSIdentifierCtx::substitute(unsigned char c, bool is_property)
 {
     auto p = id_fast[c];
@@ -92,11 +207,11 @@ const char* JSIdentifierCtx::substitute(const char* id_name, bool is_property)
     if (id_name[1] == '\0')
         return substitute(*id_name, is_property);
 
-    const auto it = id_names.find(id_name);
-    if (it != id_names.end() && is_substituted(it->second, is_property))
-        return is_property ? it->second.prop_name : it->second.id_name;
+    NormId& id = names[intern(id_name)].norm;
+    if (is_substituted(id, is_property))
+        return is_property ? id.prop_name : id.id_name;
 
-    return acquire_norm_name(id_names[id_name]);
+    return acquire_norm_name(id);
 }
 
 bool JSIdentifierCtx::is_ignored(const char* id_name) const
@@ -135,11 +250,17 @@ const char* JSIdentifierCtx::acquire_norm_name(NormId& id)
 
 void JSIdentifierCtx::init_ignored_names()
 {
+    // the configured names outlive the context, no need to copy them
     for (const auto& iid : ignored_ids_list)
         if (iid.length() == 1)
             id_fast[(unsigned)iid[0]] = {iid.c_str(), nullptr, TYPE_IGNORED_ID};
         else
-            id_names[iid] = {iid.c_str(), nullptr, TYPE_IGNORED_ID};
+        {
+            uint32_t len;
+            uint32_t hash = name_hash(iid.c_str(), len);
+            names[intern(iid.c_str(), len, hash, iid.c_str())].norm =
+                {iid.c_str(), nullptr, TYPE_IGNORED_ID};
+        }
 
     for (const auto& iprop : ignored_props_list)
     {
@@ -150,8 +271,11 @@ void JSIdentifierCtx::init_ignored_names()
         }
         else
         {
-            id_names[iprop].prop_name = iprop.c_str();
-            id_names[iprop].type |= TYPE_IGNORED_PROP;
+            uint32_t len;
+            uint32_t hash = name_hash(iprop.c_str(), len);
+            NormId& id = names[intern(iprop.c_str(), len, hash, iprop.c_str())].norm;
+            id.prop_name = iprop.c_str();
+            id.type |= TYPE_IGNORED_PROP;
         }
     }
 }
@@ -163,7 +287,7 @@ bool JSIdentifierCtx::scope_push(JSProgramScopeType t)
     if (scopes.size() >= max_scope_depth)
         return false;
 
-    scopes.emplace_back(t);
+    scopes.push_back({t, (uint32_t)aliases.size()});
     return true;
 }
 
@@ -171,21 +295,35 @@ bool JSIdentifierCtx::scope_pop(JSProgramScopeType t)
 {
     assert(t != JSProgramScopeType::GLOBAL && t != JSProgramScopeType::PROG_SCOPE_TYPE_MAX);
 
-    if (scopes.back().type() != t)
+    if (scopes.back().type != t)
         return false;
 
     assert(scopes.size() != 1);
+    unwind_aliases(scopes.back().aliases);
     scopes.pop_back();
     return true;
 }
 
+void JSIdentifierCtx::unwind_aliases(uint32_t mark)
+{
+    while (aliases.size() > mark)
+    {
+        const Alias& a = aliases.back();
+        names[a.name].alias = a.prev;
+        aliases.pop_back();
+    }
+}
+
 void JSIdentifierCtx::reset()
 {
     memset(&id_fast, 0, sizeof(id_fast));
     norm_name = norm_names;
-    id_names.clear();
+    names.clear();
+    std::fill(slots.begin(), slots.end(), 0);
+    aliases.clear();
     scopes.clear();
-    scopes.emplace_back(JSProgramScopeType::GLOBAL);
+    scopes.push_back({JSProgramScopeType::GLOBAL, 0});
+    arena.reset();
     init_ignored_names();
 }
 
@@ -194,20 +332,18 @@ void JSIdentifierCtx::add_alias(const char* alias, const std::string&& value)
     assert(alias);
     assert(!scopes.empty());
 
-    auto& a = aliases[alias];
-    a.emplace_back(std::move(value));
-
-    scopes.back().reference(a);
+    uint32_t id = intern(alias);
+    aliases.push_back({arena.store(value.c_str(), value.size()), id, names[id].alias});
+    names[id].alias = aliases.size() - 1;
 }
 
 const char* JSIdentifierCtx::alias_lookup(const char* alias) const
 {
     assert(alias);
 
-    const auto& i = aliases.find(alias);
+    const Name* n = find(alias);
 
-    return i != aliases.end() && !i->second.empty()
-        ? i->second.back().c_str() : nullptr;
+    return n && n->alias != NO_ALIAS ? aliases[n->alias].value : nullptr;
 }
 
 // advanced program scope access for testing
@@ -222,7 +358,7 @@ bool JSIdentifierCtx::scope_check(const std::list<JSProgramScopeType>& compare)
     auto cmp = compare.begin();
     for (auto it = scopes.begin(); it != scopes.end(); ++it, ++cmp)
     {
-        if (it->type() != *cmp)
+        if (it->type != *cmp)
             return false;
     }
     return true;
@@ -232,7 +368,7 @@ const std::list<JSProgramScopeType> JSIdentifierCtx::get_types() const
 {
     std::list<JSProgramScopeType> return_list;
     std::transform(scopes.cbegin(), scopes.cend(), std::back_inserter(return_list),
-        [](const ProgramScope& scope){ return scope.type(); });
+        [](const ProgramScope& scope){ return scope.type; });
     return return_list;
 }
 
@@ -22,8 +22,8 @@
 
 #include <cstdint>
 #include <list>
+#include <memory>
 #include <string>
-#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
@@ -80,42 +80,65 @@ private:
         uint8_t type = 0;
     };
 
-    using Alias = std::vector<std::string>;
-    using AliasRef = std::list<Alias*>;
-    using AliasMap = std::unordered_map<std::string, Alias>;
-    using NameMap = std::unordered_map<std::string, NormId>;
-
-    class ProgramScope
+    // bump allocator for the identifier names and alias values of a transaction
+    class Arena
     {
     public:
-        ProgramScope(JSProgramScopeType t) : t(t)
-        {}
+        const char* store(const char* str, size_t len);
+        void reset();
 
-        ~ProgramScope()
-        { for (auto a : to_remove) a->pop_back(); }
+    private:
+        static constexpr size_t BLOCK_SIZE = 4096;
 
-        void reference(Alias& a)
-        { to_remove.push_back(&a); }
+        std::vector<std::unique_ptr<char[]>> blocks;
+        std::vector<std::unique_ptr<char[]>> large;
+        char* cur = nullptr;
+        char* end = nullptr;
+    };
 
-        JSProgramScopeType type() const
-        { return t; }
+    // an interned identifier, its index in the names table is the identifier id
+    struct Name
+    {
+        const char* str;
+        uint32_t len;
+        uint32_t hash;
+        NormId norm;
+        uint32_t alias;     // top of this name's alias stack
+    };
 
-    private:
-        JSProgramScopeType t;
-        AliasRef to_remove{};
+    struct Alias
+    {
+        const char* value;
+        uint32_t name;
+        uint32_t prev;      // alias shadowed by this one
+    };
+
+    struct ProgramScope
+    {
+        JSProgramScopeType type;
+        uint32_t aliases;   // alias stack size when the scope was entered
     };
 
+    static constexpr uint32_t NO_ALIAS = UINT32_MAX;
+
     inline const char* substitute(unsigned char c, bool is_property);
     inline bool is_substituted(const NormId& id, bool is_property);
     inline const char* acquire_norm_name(NormId& id);
     inline void init_ignored_names();
 
-    // do not swap next two lines, the destructor frees them in the reverse order
-    AliasMap aliases;
-    std::list<ProgramScope> scopes;
+    uint32_t intern(const char* str);
+    uint32_t intern(const char* str, uint32_t len, uint32_t hash, const char* stored);
+    const Name* find(const char* str) const;
+    void grow();
+    void unwind_aliases(uint32_t mark);
+
+    Arena arena;
+    std::vector<Name> names;
+    std::vector<uint32_t> slots;    // open addressing, name index + 1, 0 when empty
+    std::vector<Alias> aliases;     // aliases of all scopes, innermost last
+    std::vector<ProgramScope> scopes;
 
     NormId id_fast[256];
-    NameMap id_names;
     const std::unordered_set<std::string>& ignored_ids_list;
     const std::unordered_set<std::string>& ignored_props_list;
 
@@ -108,6 +108,21 @@ TEST_CASE("JSIdentifierCtx::substitute()", "[JSIdentifierCtx]")
         CHECK(!strcmp(ident_ctx.substitute("watch", false), "var_0001"));
         CHECK(!strcmp(ident_ctx.substitute("watch", true), "watch"));
     }
+    SECTION("reset")
+    {
+        JSIdentifierCtx ident_ctx(DEPTH, SCOPE_DEPTH, s_ignored_ids, s_ignored_props);
+
+        for (int it = 0; it < 1000; ++it)
+            REQUIRE(ident_ctx.substitute(("n" + std::to_string(it)).c_str(), false));
+        CHECK(!strcmp(ident_ctx.substitute("n999", false), "var_03e7"));
+
+        ident_ctx.reset();
+
+        CHECK(!strcmp(ident_ctx.substitute("n999", false), "var_0000"));
+        CHECK(!strcmp(ident_ctx.substitute("console", false), "console"));
+        CHECK(!strcmp(ident_ctx.substitute("watch", true), "watch"));
+        CHECK(!strcmp(ident_ctx.substitute("n0", false), "var_0001"));
+    }
 }
 
 TEST_CASE("JSIdentifierCtx::is_ignored()", "[JSIdentifierCtx]")
@@ -186,6 +201,27 @@ TEST_CASE("JSIdentifierCtx::scopes", "[JSIdentifierCtx]")
 
         CHECK(ident_ctx.alias_lookup("c") == nullptr);
     }
+    SECTION("aliases of normalized names")
+    {
+        CHECK(!strcmp(ident_ctx.substitute("foo", false), "var_0000"));
+        ident_ctx.add_alias("foo", "document.write");
+        CHECK(!strcmp(ident_ctx.alias_lookup("foo"), "document.write"));
+        CHECK(!strcmp(ident_ctx.substitute("foo", false), "var_0000"));
+
+        std::string long_value(5000, 'x');
+        REQUIRE(true == ident_ctx.scope_push(JSProgramScopeType::BLOCK));
+        ident_ctx.add_alias("foo", std::string(long_value));
+        ident_ctx.add_alias("bar", "eval");
+        CHECK(long_value == ident_ctx.alias_lookup("foo"));
+        CHECK(!strcmp(ident_ctx.alias_lookup("bar"), "eval"));
+
+        REQUIRE(true == ident_ctx.scope_pop(JSProgramScopeType::BLOCK));
+        CHECK(!strcmp(ident_ctx.alias_lookup("foo"), "document.write"));
+        CHECK(ident_ctx.alias_lookup("bar") == nullptr);
+
+        ident_ctx.reset();
+        CHECK(ident_ctx.alias_lookup("foo") == nullptr);
+    }
     SECTION("scope mismatch")
     {
         CHECK(false == ident_ctx.scope_pop(JSProgramScopeType::FUNCTION));
@@ -80,6 +80,21 @@ static const Parameter s_rule_params[] =
     { "max_suspend_time", Parameter::PT_INT, "0:max32", "30000",
         "set max time for suspending a rule (ms, 0 means permanently disable rule)" },
 
+    { "adaptive", Parameter::PT_BOOL, nullptr, "false",
+        "learn rule tree costs and sample expensive rule trees while overloaded" },
+
+    { "adaptive_cost", Parameter::PT_INT, "0:max32", "100",
+        "rule trees costing more than this per eval are sampled when overloaded (usec)" },
+
+    { "adaptive_load", Parameter::PT_INT, "1:100", "50",
+        "percent of time spent in rule evaluation that triggers sampling" },
+
+    { "adaptive_sample", Parameter::PT_INT, "2:max32", "8",
+        "evaluate one of this many expensive rule tree evals while overloaded" },
+
+    { "adaptive_window", Parameter::PT_INT, "1:max32", "1000",
+        "interval for measuring rule evaluation load (ms)" },
+
 #ifdef REG_TEST
     { "test_timeout", Parameter::PT_BOOL, nullptr, "false",
         "timeout on every rule evaluation" },
@@ -119,6 +134,10 @@ static const PegInfo latency_pegs[] =
     { CountType::SUM, "total_rule_evals", "total rule evals monitored" },
     { CountType::SUM, "rule_eval_timeouts", "rule evals that timed out" },
     { CountType::SUM, "rule_tree_enables", "rule tree re-enables" },
+    { CountType::SUM, "rule_evals_sampled", "rule evals skipped by adaptive sampling" },
+    { CountType::SUM, "rule_eval_savings", "projected usecs saved by adaptive sampling" },
+    { CountType::SUM, "rule_overloads", "times adaptive sampling was started due to load" },
+    { CountType::SUM, "rule_overload_restores", "times full rule evaluation was restored" },
     { CountType::END, nullptr, nullptr }
 };
 
@@ -164,6 +183,25 @@ static inline bool latency_set(const Value& v, RuleLatencyConfig& config)
         long t = clock_ticks(v.get_uint32());
         config.max_suspend_time = TO_DURATION(config.max_time, t);
     }
+    else if ( v.is("adaptive") )
+        config.adaptive = v.get_bool();
+
+    else if ( v.is("adaptive_cost") )
+    {
+        long t = clock_ticks(v.get_uint32());
+        config.adaptive_cost = TO_DURATION(config.adaptive_cost, t);
+    }
+    else if ( v.is("adaptive_load") )
+        config.adaptive_load = v.get_uint32();
+
+    else if ( v.is("adaptive_sample") )
+        config.adaptive_sample = v.get_uint32();
+
+    else if ( v.is("adaptive_window") )
+    {
+        long t = clock_ticks(v.get_uint32() * 1000L);
+        config.adaptive_window = TO_DURATION(config.adaptive_window, t);
+    }
 #ifdef REG_TEST
     else if ( v.is("test_timeout") )
         config.test_timeout = v.get_bool();
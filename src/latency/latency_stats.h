@@ -32,6 +32,10 @@ struct LatencyStats
     PegCount total_rule_evals;
     PegCount rule_eval_timeouts;
     PegCount rule_tree_enables;
+    PegCount rule_evals_sampled;
+    PegCount rule_eval_savings;
+    PegCount rule_overloads;
+    PegCount rule_overload_restores;
 };
 
 extern THREAD_LOCAL LatencyStats latency_stats;
@@ -71,7 +71,9 @@ struct Event
     {
         EVENT_ENABLED,
         EVENT_TIMED_OUT,
-        EVENT_SUSPENDED
+        EVENT_SUSPENDED,
+        EVENT_OVERLOADED,
+        EVENT_RESTORED
     };
 
     Type type;
@@ -89,6 +91,8 @@ public:
 
     const detection_option_tree_root_t& root;
     Packet* packet;
+    bool skipped = false;
+    bool matched = false;
 };
 
 using ConfigWrapper = ReferenceWrapper<RuleLatencyConfig>;
@@ -114,6 +118,14 @@ static inline std::ostream& operator<<(std::ostream& os, const Event& e)
     case Event::EVENT_SUSPENDED:
         os << "suspended: ";
         break;
+
+    case Event::EVENT_OVERLOADED:
+        os << "overload, sampling expensive rule trees: ";
+        break;
+
+    case Event::EVENT_RESTORED:
+        os << "load restored, full evaluation: ";
+        break;
     }
 
     os << clock_usecs(TO_USECS(e.elapsed)) << " usec, ";
@@ -147,6 +159,9 @@ static inline std::ostream& operator<<(std::ostream& os, const Event& e)
 // rule tree interface
 // -----------------------------------------------------------------------------
 
+// number of full evaluations before the cost model of a rule tree is trusted
+static constexpr uint64_t min_model_evals = 16;
+
 // goes in a static structure so we can templatize Impl
 struct DefaultRuleInterface
 {
@@ -203,6 +218,28 @@ struct DefaultRuleInterface
 
         return false;
     }
+
+    template<typename Duration>
+    static void update_cost(const detection_option_tree_root_t& root, Duration elapsed,
+        bool matched)
+    { root.latency_state[get_instance_id()].update(TO_TICKS(elapsed), matched); }
+
+    // return true if this evaluation should be skipped; saved is the projected cost
+    template<typename Duration>
+    static bool sample(const detection_option_tree_root_t& root, Duration max_cost,
+        unsigned rate, long& saved)
+    {
+        auto& state = root.latency_state[get_instance_id()];
+
+        if ( state.evals < min_model_evals or state.cost() <= TO_TICKS(max_cost) )
+            return false;
+
+        if ( ++state.samples % rate == 0 )
+            return false;
+
+        saved = (long)state.mean_ticks;
+        return true;
+    }
 };
 
 // -----------------------------------------------------------------------------
@@ -217,17 +254,29 @@ public:
 
     bool push(const detection_option_tree_root_t&, Packet*);
     bool pop();
-    bool suspended() const;
+    bool suspended();
+    void matched();
+
+    bool skipped(long& saved) const;
+    bool overloaded() const
+    { return overload; }
 
 private:
+    void update_load(const RuleTimer<Clock>&, typename Clock::duration);
+
     std::vector<RuleTimer<Clock>> timers;
     const ConfigWrapper& config;
     EventHandler& event_handler;
+
+    typename Clock::time_point window_start;
+    typename Clock::duration window_busy;
+    long last_saved = 0;
+    bool overload = false;
 };
 
 template<typename Clock, typename RuleTree>
 inline Impl<Clock, RuleTree>::Impl(const ConfigWrapper& cfg, EventHandler& eh) :
-    config(cfg), event_handler(eh)
+    config(cfg), event_handler(eh), window_start(Clock::now()), window_busy(DURA_ZERO)
 { }
 
 template<typename Clock, typename RuleTree>
@@ -256,12 +305,20 @@ inline bool Impl<Clock, RuleTree>::pop()
 {
     assert(!timers.empty());
     const auto& timer = timers.back();
+    auto elapsed = timer.elapsed();
+
     if ( timer.packet->flow )
-        timer.packet->flow->flowstats.total_rule_latency += clock_usecs(TO_USECS(timer.elapsed()));
+        timer.packet->flow->flowstats.total_rule_latency += clock_usecs(TO_USECS(elapsed));
 
     bool timed_out = false;
 
-    if ( !RuleTree::is_suspended(timer.root) )
+    if ( config->allow_sampling() and !timer.skipped and !RuleTree::is_suspended(timer.root) )
+    {
+        RuleTree::update_cost(timer.root, elapsed, timer.matched);
+        update_load(timer, elapsed);
+    }
+
+    if ( !timer.skipped and !RuleTree::is_suspended(timer.root) )
     {
         timed_out = timer.timed_out();
 #ifdef REG_TEST
@@ -287,13 +344,74 @@ inline bool Impl<Clock, RuleTree>::pop()
 }
 
 template<typename Clock, typename RuleTree>
-inline bool Impl<Clock, RuleTree>::suspended() const
+inline bool Impl<Clock, RuleTree>::suspended()
 {
-    if ( !config->suspend )
+    assert(!timers.empty());
+    auto& timer = timers.back();
+
+    if ( config->suspend and RuleTree::is_suspended(timer.root) )
+        return true;
+
+    if ( !overload or !config->allow_sampling() )
         return false;
 
+    timer.skipped = RuleTree::sample(timer.root, config->adaptive_cost,
+        config->adaptive_sample, last_saved);
+
+    return timer.skipped;
+}
+
+template<typename Clock, typename RuleTree>
+inline void Impl<Clock, RuleTree>::matched()
+{
     assert(!timers.empty());
-    return RuleTree::is_suspended(timers.back().root);
+    timers.back().matched = true;
+}
+
+template<typename Clock, typename RuleTree>
+inline bool Impl<Clock, RuleTree>::skipped(long& saved) const
+{
+    assert(!timers.empty());
+
+    if ( !timers.back().skipped )
+        return false;
+
+    saved = last_saved;
+    return true;
+}
+
+// the load is the share of wall time spent in rule evaluation over the last window;
+// sampling starts when it reaches adaptive_load and stops once it falls below half that,
+// rounded up so the lowest setting can still be left
+template<typename Clock, typename RuleTree>
+inline void Impl<Clock, RuleTree>::update_load(const RuleTimer<Clock>& timer,
+    typename Clock::duration elapsed)
+{
+    window_busy += elapsed;
+
+    auto now = Clock::now();
+    auto span = now - window_start;
+
+    if ( span < config->adaptive_window )
+        return;
+
+    uint64_t load = (100 * TO_TICKS(window_busy)) / TO_TICKS(span);
+
+    window_start = now;
+    window_busy = DURA_ZERO;
+
+    if ( !overload and load >= config->adaptive_load )
+    {
+        overload = true;
+        Event e { Event::EVENT_OVERLOADED, span, timer.root, timer.packet };
+        event_handler.handle(e);
+    }
+    else if ( overload and load < (config->adaptive_load + 1) / 2 )
+    {
+        overload = false;
+        Event e { Event::EVENT_RESTORED, span, timer.root, timer.packet };
+        event_handler.handle(e);
+    }
 }
 
 // -----------------------------------------------------------------------------
@@ -327,6 +445,14 @@ static struct SnortEventHandler : public EventHandler
                 DetectionEngine::queue_event(GID_LATENCY, LATENCY_EVENT_RULE_TREE_SUSPENDED);
                 break;
 
+            case Event::EVENT_OVERLOADED:
+                ++latency_stats.rule_overloads;
+                break;
+
+            case Event::EVENT_RESTORED:
+                ++latency_stats.rule_overload_restores;
+                break;
+
             default:
                 break;
         }
@@ -365,11 +491,26 @@ void RuleLatency::pop()
 {
     if ( rule_latency::force_enabled() )
     {
-        if ( rule_latency::get_impl().pop() )
+        auto& impl = rule_latency::get_impl();
+        long saved;
+
+        if ( impl.skipped(saved) )
+        {
+            ++latency_stats.rule_evals_sampled;
+            latency_stats.rule_eval_savings += clock_usecs(TO_USECS(hr_duration(saved)));
+        }
+
+        if ( impl.pop() )
             ++latency_stats.rule_eval_timeouts;
     }
 }
 
+void RuleLatency::matched()
+{
+    if ( rule_latency::force_enabled() )
+        rule_latency::get_impl().matched();
+}
+
 bool RuleLatency::suspended()
 {
     if ( rule_latency::force_enabled() )
@@ -437,6 +578,8 @@ struct RuleInterfaceSpy
     static bool reenable_called;
     static bool timeout_and_suspend_result;
     static bool timeout_and_suspend_called;
+    static bool sample_result;
+    static unsigned update_cost_called;
 
     static void reset()
     {
@@ -446,6 +589,8 @@ struct RuleInterfaceSpy
         reenable_called = false;
         timeout_and_suspend_result = false;
         timeout_and_suspend_called = false;
+        sample_result = false;
+        update_cost_called = 0;
     }
 
     static bool is_suspended(const detection_option_tree_root_t&)
@@ -458,6 +603,14 @@ struct RuleInterfaceSpy
     template<typename Time>
     static bool timeout_and_suspend(const detection_option_tree_root_t&, unsigned, Time, bool)
     { timeout_and_suspend_called = true; return timeout_and_suspend_result; }
+
+    template<typename Duration>
+    static void update_cost(const detection_option_tree_root_t&, Duration, bool)
+    { ++update_cost_called; }
+
+    template<typename Duration>
+    static bool sample(const detection_option_tree_root_t&, Duration, unsigned, long& saved)
+    { saved = 7; return sample_result; }
 };
 
 bool RuleInterfaceSpy::is_suspended_result = false;
@@ -466,6 +619,8 @@ bool RuleInterfaceSpy::reenable_result = false;
 bool RuleInterfaceSpy::reenable_called = false;
 bool RuleInterfaceSpy::timeout_and_suspend_result = false;
 bool RuleInterfaceSpy::timeout_and_suspend_called = false;
+bool RuleInterfaceSpy::sample_result = false;
+unsigned RuleInterfaceSpy::update_cost_called = 0;
 
 } // namespace t_rule_latency
 
@@ -593,6 +748,94 @@ TEST_CASE ( "rule latency impl", "[latency]" )
             CHECK_FALSE( RuleInterfaceSpy::timeout_and_suspend_called );
         }
     }
+
+    SECTION( "adaptive" )
+    {
+        config.config.adaptive = true;
+        config.config.adaptive_window = 10_ticks;
+        config.config.adaptive_load = 50;
+        config.config.adaptive_sample = 2;
+
+        SECTION( "not overloaded" )
+        {
+            MockClock::inc(10_ticks);
+            impl.push(root, &pkt);
+            CHECK( false == impl.suspended() );
+            MockClock::inc(1_ticks);
+            impl.pop();
+
+            CHECK( RuleInterfaceSpy::update_cost_called == 1 );
+            CHECK( event_handler.count == 0 );
+            CHECK_FALSE( impl.overloaded() );
+        }
+
+        SECTION( "suspended" )
+        {
+            // suspended trees don't run, so their time says nothing about cost
+            RuleInterfaceSpy::is_suspended_result = true;
+            impl.push(root, &pkt);
+            MockClock::inc(11_ticks);
+            impl.pop();
+
+            CHECK( RuleInterfaceSpy::update_cost_called == 0 );
+            CHECK_FALSE( impl.overloaded() );
+        }
+
+        SECTION( "overloaded" )
+        {
+            impl.push(root, &pkt);
+            MockClock::inc(11_ticks);
+            impl.pop();
+
+            CHECK( event_handler.count == 1 );
+            REQUIRE( impl.overloaded() );
+
+            RuleInterfaceSpy::sample_result = true;
+            impl.push(root, &pkt);
+            CHECK( true == impl.suspended() );
+
+            long saved = 0;
+            CHECK( impl.skipped(saved) );
+            CHECK( saved == 7 );
+
+            CHECK( false == impl.pop() );
+            CHECK( RuleInterfaceSpy::update_cost_called == 1 );
+
+            SECTION( "restored" )
+            {
+                RuleInterfaceSpy::sample_result = false;
+                impl.push(root, &pkt);
+                CHECK( false == impl.suspended() );
+                MockClock::inc(20_ticks);
+                impl.push(root, &pkt);
+                impl.pop();
+                impl.pop();
+
+                CHECK( event_handler.count == 2 );
+                CHECK_FALSE( impl.overloaded() );
+            }
+        }
+
+        SECTION( "lowest load" )
+        {
+            config.config.adaptive_load = 1;
+
+            impl.push(root, &pkt);
+            MockClock::inc(11_ticks);
+            impl.pop();
+
+            CHECK( event_handler.count == 1 );
+            REQUIRE( impl.overloaded() );
+
+            // an idle window ends the overload even at the lowest setting
+            MockClock::inc(20_ticks);
+            impl.push(root, &pkt);
+            impl.pop();
+
+            CHECK( event_handler.count == 2 );
+            CHECK_FALSE( impl.overloaded() );
+        }
+    }
 }
 
 TEST_CASE ( "default latency rule interface", "[latency]" )
@@ -647,6 +890,36 @@ TEST_CASE ( "default latency rule interface", "[latency]" )
         }
     }
 
+    SECTION( "sample" )
+    {
+        auto& state = root.latency_state[get_instance_id()];
+        long saved = 0;
+
+        for ( unsigned i = 0; i < rule_latency::min_model_evals; ++i )
+            state.update(10, false);
+
+        CHECK( state.mean_ticks == 10.0 );
+        CHECK( state.variance() == 0.0 );
+
+        SECTION( "cheap rule tree" )
+        {
+            CHECK( false == RuleInterface::sample(root, 20_ticks, 2, saved) );
+        }
+
+        SECTION( "expensive rule tree" )
+        {
+            CHECK( true == RuleInterface::sample(root, 5_ticks, 2, saved) );
+            CHECK( saved == 10 );
+            CHECK( false == RuleInterface::sample(root, 5_ticks, 2, saved) );
+        }
+
+        SECTION( "expensive rule tree that always matches" )
+        {
+            state.matches = state.evals;
+            CHECK( false == RuleInterface::sample(root, 5_ticks, 2, saved) );
+        }
+    }
+
     SECTION( "timeout_and_suspend" )
     {
         SECTION( "suspend enabled" )
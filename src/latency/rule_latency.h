@@ -41,6 +41,7 @@ public:
     static void push(const detection_option_tree_root_t&, snort::Packet*);
     static void pop();
     static bool suspended();
+    static void matched();
 
     static void tterm();
 
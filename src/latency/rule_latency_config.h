@@ -29,6 +29,12 @@ struct RuleLatencyConfig
     bool suspend = false;
     unsigned suspend_threshold = 0;
     hr_duration max_suspend_time = 0_ticks;
+
+    bool adaptive = false;
+    hr_duration adaptive_cost = 0_ticks;
+    hr_duration adaptive_window = 0_ticks;
+    unsigned adaptive_load = 0;
+    unsigned adaptive_sample = 1;
 #ifdef REG_TEST
     bool test_timeout = false;
 #endif
@@ -43,6 +49,9 @@ struct RuleLatencyConfig
     }
 
     bool allow_reenable() const { return max_suspend_time > 0_ticks; }
+
+    bool allow_sampling() const
+    { return adaptive and adaptive_window > 0_ticks and adaptive_sample > 1; }
 };
 
 #endif
@@ -21,6 +21,9 @@
 #ifndef RULE_LATENCY_STATE_H
 #define RULE_LATENCY_STATE_H
 
+#include <cmath>
+#include <cstdint>
+
 #include "time/clock_defs.h"
 
 struct RuleLatencyState
@@ -29,6 +32,36 @@ struct RuleLatencyState
     unsigned timeouts = 0;
     bool suspended = false;
 
+    // adaptive cost model, updated incrementally (Welford) on each full evaluation
+    uint64_t evals = 0;
+    uint64_t matches = 0;
+    uint64_t samples = 0;
+    double mean_ticks = 0.0;
+    double m2_ticks = 0.0;
+
+    void update(long ticks, bool matched)
+    {
+        ++evals;
+
+        if ( matched )
+            ++matches;
+
+        double delta = ticks - mean_ticks;
+        mean_ticks += delta / evals;
+        m2_ticks += delta * (ticks - mean_ticks);
+    }
+
+    double variance() const
+    { return evals > 1 ? m2_ticks / (evals - 1) : 0.0; }
+
+    double match_rate() const
+    { return evals ? (double)matches / evals : 0.0; }
+
+    // pessimistic cost of an evaluation discounted by how often it yields a match;
+    // rule trees that match often are worth their cost and keep full priority
+    double cost() const
+    { return (mean_ticks + std::sqrt(variance())) * (1.0 - match_rate()); }
+
     void enable()
     {
         timeouts = 0;
@@ -0,0 +1,667 @@
+//--------------------------------------------------------------------------
+// Copyright (C) 2026 Cisco and/or its affiliates. All rights reserved.
+//
+// This program is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License Version 2 as published
+// by the Free Software Foundation.  You may not use, modify or distribute
+// this program under any other version of the GNU General Public License.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+//--------------------------------------------------------------------------
+// record_writer.cc
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "record_writer.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#ifdef HAVE_LIBURING
+#include <liburing.h>
+#endif
+
+#include <atomic>
+#include <cassert>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "log/messages.h"
+#include "utils/util.h"
+
+#include "text_log_writer.h"
+
+using namespace snort;
+
+static const size_t block_size = 4096;
+static const time_t flush_secs = 1;
+static const std::chrono::microseconds reap_wait(50);
+
+enum BatchState : int { BATCH_FREE, BATCH_QUEUED, BATCH_DONE };
+
+struct RecordFile
+{
+    std::string path;
+    int fd;
+    size_t size = 0;       // logical bytes, excludes direct padding
+    size_t prealloc;
+    unsigned pending = 0;  // batches in flight
+    bool closed = false;
+    bool direct;
+};
+
+struct RecordBatch
+{
+    uint8_t* buf;
+    size_t used = 0;       // bytes filled, including carried tail
+    size_t carried = 0;    // tail of previous batch rewritten by this one
+    size_t len = 0;        // bytes to write, padded for direct
+    size_t done = 0;       // bytes written so far
+    off_t off = 0;
+
+    RecordFile* file = nullptr;
+    RecordBatch* overlap = nullptr;  // must complete before this is written
+
+    unsigned index;
+    int error = 0;
+    std::atomic<int> state { BATCH_FREE };
+};
+
+static inline size_t align_up(size_t n)
+{ return (n + block_size - 1) & ~(block_size - 1); }
+
+static inline size_t align_down(size_t n)
+{ return n & ~(block_size - 1); }
+
+//--------------------------------------------------------------------------
+// engines
+//--------------------------------------------------------------------------
+
+class RecordEngine
+{
+public:
+    virtual ~RecordEngine() = default;
+
+    virtual void submit(RecordBatch*) = 0;
+
+    // returns a completed batch if any
+    virtual RecordBatch* reap(bool wait) = 0;
+
+    virtual const char* name() const = 0;
+};
+
+// writer pool is shared by all writers when io_uring is not available
+
+static std::mutex pool_mutex;
+static std::condition_variable pool_cv;
+static std::deque<RecordBatch*> pool_jobs;
+static std::vector<std::thread*> pool_threads;
+static unsigned pool_users = 0;
+static bool pool_running = false;
+
+static void write_batch(RecordBatch* b)
+{
+    while ( b->done < b->len )
+    {
+        ssize_t n = pwrite(b->file->fd, b->buf + b->done, b->len - b->done, b->off + b->done);
+
+        if ( n < 0 )
+        {
+            if ( errno == EINTR )
+                continue;
+
+            b->error = errno;
+            break;
+        }
+        b->done += n;
+    }
+    b->state.store(BATCH_DONE, std::memory_order_release);
+}
+
+static void pool_main(unsigned id)
+{
+    char name[16];
+    snprintf(name, sizeof(name), "snort.recwr%u", id);
+    SET_THREAD_NAME(pthread_self(), name);
+
+    std::unique_lock<std::mutex> lock(pool_mutex);
+
+    while ( true )
+    {
+        pool_cv.wait(lock, []() { return !pool_running or !pool_jobs.empty(); });
+
+        // stopped only after all queued batches are written
+        if ( pool_jobs.empty() )
+            break;
+
+        RecordBatch* b = pool_jobs.front();
+        pool_jobs.pop_front();
+
+        lock.unlock();
+        write_batch(b);
+        lock.lock();
+    }
+}
+
+class PoolEngine : public RecordEngine
+{
+public:
+    PoolEngine(RecordBatch* b, unsigned n, unsigned threads) : batches(b), num(n)
+    {
+        std::lock_guard<std::mutex> lock(pool_mutex);
+
+        if ( pool_users++ )
+            return;
+
+        pool_running = true;
+
+        for ( unsigned i = 0; i < threads; ++i )
+            pool_threads.emplace_back(new std::thread(pool_main, i));
+    }
+
+    ~PoolEngine() override
+    {
+        std::vector<std::thread*> done;
+        {
+            std::lock_guard<std::mutex> lock(pool_mutex);
+
+            if ( --pool_users )
+                return;
+
+            pool_running = false;
+            done.swap(pool_threads);
+        }
+        pool_cv.notify_all();
+
+        for ( auto* t : done )
+        {
+            t->join();
+            delete t;
+        }
+    }
+
+    void submit(RecordBatch* b) override
+    {
+        {
+            std::lock_guard<std::mutex> lock(pool_mutex);
+            pool_jobs.emplace_back(b);
+        }
+        pool_cv.notify_one();
+    }
+
+    RecordBatch* reap(bool wait) override
+    {
+        while ( true )
+        {
+            for ( unsigned i = 0; i < num; ++i )
+            {
+                if ( batches[i].state.load(std::memory_order_acquire) == BATCH_DONE )
+                    return batches + i;
+            }
+            if ( !wait )
+                return nullptr;
+
+            std::this_thread::sleep_for(reap_wait);
+        }
+    }
+
+    const char* name() const override
+    { return "threads"; }
+
+private:
+    RecordBatch* batches;
+    unsigned num;
+};
+
+#ifdef HAVE_LIBURING
+class UringEngine : public RecordEngine
+{
+public:
+    ~UringEngine() override
+    {
+        if ( registered )
+            io_uring_unregister_buffers(&ring);
+
+        if ( ready )
+            io_uring_queue_exit(&ring);
+    }
+
+    bool init(RecordBatch* batches, unsigned n, size_t size)
+    {
+        if ( io_uring_queue_init(n, &ring, 0) < 0 )
+            return false;
+
+        ready = true;
+        std::vector<struct iovec> iov(n);
+
+        for ( unsigned i = 0; i < n; ++i )
+        {
+            iov[i].iov_base = batches[i].buf;
+            iov[i].iov_len = size;
+        }
+
+        // registration may fail with a low RLIMIT_MEMLOCK; plain writes still work
+        registered = !io_uring_register_buffers(&ring, iov.data(), n);
+        return true;
+    }
+
+    void submit(RecordBatch* b) override
+    {
+        // the ring has an entry per batch so this can't fail
+        struct io_uring_sqe* sqe = io_uring_get_sqe(&ring);
+        assert(sqe);
+
+        if ( registered )
+            io_uring_prep_write_fixed(sqe, b->file->fd, b->buf + b->done,
+                b->len - b->done, b->off + b->done, b->index);
+        else
+            io_uring_prep_write(sqe, b->file->fd, b->buf + b->done,
+                b->len - b->done, b->off + b->done);
+
+        io_uring_sqe_set_data(sqe, b);
+        io_uring_submit(&ring);
+    }
+
+    RecordBatch* reap(bool wait) override
+    {
+        struct io_uring_cqe* cqe;
+        int rc = wait ? io_uring_wait_cqe(&ring, &cqe) : io_uring_peek_cqe(&ring, &cqe);
+
+        if ( rc < 0 )
+            return nullptr;
+
+        RecordBatch* b = (RecordBatch*)io_uring_cqe_get_data(cqe);
+        int res = cqe->res;
+        io_uring_cqe_seen(&ring, cqe);
+
+        if ( res == -EINTR or res == -EAGAIN )
+        {
+            submit(b);
+            return nullptr;
+        }
+        if ( res < 0 )
+            b->error = -res;
+
+        else if ( res > 0 and (b->done += res) < b->len )
+        {
+            // short write, continue from where it stopped
+            submit(b);
+            return nullptr;
+        }
+        return b;
+    }
+
+    const char* name() const override
+    { return registered ? "io_uring (registered buffers)" : "io_uring"; }
+
+private:
+    struct io_uring ring;
+    bool ready = false;
+    bool registered = false;
+};
+#endif
+
+//--------------------------------------------------------------------------
+// writer
+//--------------------------------------------------------------------------
+
+RecordWriter::RecordWriter(const RecordWriterConfig& c) : config(c)
+{
+    config.batch_size = align_up(config.batch_size);
+    config.batches = std::max(config.batches, 2u);
+
+    void* p = nullptr;
+
+    if ( posix_memalign(&p, block_size, config.batches * config.batch_size) )
+        FatalError("record writer could not allocate %zu batches\n", (size_t)config.batches);
+
+    mem = (uint8_t*)p;
+    batches = new RecordBatch[config.batches];
+
+    for ( unsigned i = 0; i < config.batches; ++i )
+    {
+        batches[i].buf = mem + i * config.batch_size;
+        batches[i].index = i;
+    }
+
+#ifdef HAVE_LIBURING
+    UringEngine* uring = new UringEngine;
+
+    if ( uring->init(batches, config.batches, config.batch_size) )
+        engine = uring;
+    else
+        delete uring;
+#endif
+
+    if ( !engine )
+        engine = new PoolEngine(batches, config.batches, std::max(config.threads, 1u));
+}
+
+RecordWriter::~RecordWriter()
+{
+    close();
+
+    while ( in_flight )
+        reap(true);
+
+    delete engine;
+    delete[] batches;
+    free(mem);
+}
+
+const char* RecordWriter::engine_name() const
+{ return engine->name(); }
+
+size_t RecordWriter::size() const
+{ return file ? file->size : 0; }
+
+bool RecordWriter::open(const char* path)
+{
+    close();
+
+    // reopening a path (eg unified2 nostamp) truncates it, so writes still
+    // queued for the prior file must land and the file be released first
+    if ( last_path == path )
+    {
+        while ( in_flight )
+            reap(true);
+    }
+
+    int flags = O_WRONLY | O_CREAT | O_TRUNC;
+#ifdef __linux__
+    bool direct = config.direct;
+    int fd = ::open(path, flags | (direct ? O_DIRECT : 0), 0666);
+
+    // not all file systems support O_DIRECT
+    if ( fd < 0 and direct and errno == EINVAL )
+    {
+        direct = false;
+        fd = ::open(path, flags, 0666);
+    }
+#else
+    // block aligned direct writes are only supported on Linux
+    bool direct = false;
+    int fd = ::open(path, flags, 0666);
+#endif
+
+    if ( fd < 0 )
+        return false;
+
+    size_t prealloc = 0;
+
+#ifdef __linux__
+    // reserve space up front so extents aren't allocated one write at a time
+    if ( config.prealloc and !fallocate(fd, FALLOC_FL_KEEP_SIZE, 0, config.prealloc) )
+        prealloc = config.prealloc;
+#endif
+
+    file = new RecordFile;
+    file->path = path;
+    file->fd = fd;
+    file->prealloc = prealloc;
+    file->direct = direct;
+    last_path = path;
+
+    carry = nullptr;
+    started = 0;
+    return true;
+}
+
+void RecordWriter::close()
+{
+    if ( !file )
+        return;
+
+    flush();
+
+    RecordBatch* b = batches + cur;
+
+    // drop a carried tail that wasn't followed by new data
+    if ( b->file == file and b->state.load(std::memory_order_acquire) == BATCH_FREE )
+    {
+        b->file = nullptr;
+        b->overlap = nullptr;
+        b->used = b->carried = 0;
+    }
+
+    release(file);
+    file = nullptr;
+    carry = nullptr;
+}
+
+void RecordWriter::release(RecordFile* f)
+{
+    f->closed = true;
+
+    if ( f->pending )
+        return;
+
+    // trim direct padding and any unused preallocation
+    if ( f->direct )
+        (void)ftruncate(f->fd, f->size);
+
+#ifdef __linux__
+    if ( f->prealloc > f->size )
+        fallocate(f->fd, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, f->size,
+            f->prealloc - f->size);
+#endif
+
+    ::close(f->fd);
+    delete f;
+}
+
+// a batch is bound to the current file when it gets its first record;
+// with O_DIRECT it starts at the last block boundary and rewrites the tail
+void RecordWriter::start(RecordBatch* b)
+{
+    b->file = file;
+    b->used = 0;
+    b->overlap = nullptr;
+
+    if ( file->direct )
+    {
+        b->off = align_down(file->size);
+        size_t tail = file->size - b->off;
+
+        if ( tail )
+        {
+            assert(carry);
+            memcpy(b->buf, carry->buf + carry->used - tail, tail);
+            b->used = tail;
+            b->overlap = carry;
+        }
+    }
+    else
+        b->off = file->size;
+
+    b->carried = b->used;
+}
+
+bool RecordWriter::ready(RecordBatch* b, bool wait)
+{
+    if ( b->state.load(std::memory_order_acquire) == BATCH_FREE )
+        return true;
+
+    reap(false);
+
+    if ( b->state.load(std::memory_order_acquire) == BATCH_FREE )
+        return true;
+
+    if ( !wait )
+        return false;
+
+    ++async_log_stats.blocked;
+
+    while ( b->state.load(std::memory_order_acquire) != BATCH_FREE )
+        reap(true);
+
+    return true;
+}
+
+RecordBatch* RecordWriter::get_batch(size_t need, bool wait)
+{
+    RecordBatch* b = batches + cur;
+
+    if ( !ready(b, wait) )
+        return nullptr;
+
+    if ( b->file == file and b->used + need > config.batch_size )
+    {
+        submit(b);
+        b = batches + cur;
+
+        if ( !ready(b, wait) )
+            return nullptr;
+    }
+
+    if ( b->file != file )
+        start(b);
+
+    return b;
+}
+
+bool RecordWriter::write(const void* data, size_t len)
+{
+    struct iovec iov = { const_cast<void*>(data), len };
+    return write(&iov, 1);
+}
+
+bool RecordWriter::write(const struct iovec* iov, unsigned n)
+{ return put(iov, n, config.block); }
+
+bool RecordWriter::write_header(const void* data, size_t len)
+{
+    struct iovec iov = { const_cast<void*>(data), len };
+    return put(&iov, 1, true);
+}
+
+bool RecordWriter::put(const struct iovec* iov, unsigned n, bool wait)
+{
+    if ( !file )
+        return false;
+
+    size_t total = 0;
+
+    for ( unsigned i = 0; i < n; ++i )
+        total += iov[i].iov_len;
+
+    // leave room for a carried tail
+    RecordBatch* b = total <= config.batch_size - block_size ? get_batch(total, wait) : nullptr;
+
+    if ( !b )
+    {
+        ++async_log_stats.dropped;
+        async_log_stats.dropped_bytes += total;
+        return false;
+    }
+
+    for ( unsigned i = 0; i < n; ++i )
+    {
+        memcpy(b->buf + b->used, iov[i].iov_base, iov[i].iov_len);
+        b->used += iov[i].iov_len;
+    }
+    file->size += total;
+
+    // bound the latency of a partially filled batch
+    time_t now = time(nullptr);
+
+    if ( !started )
+        started = now;
+
+    else if ( now - started >= flush_secs )
+        flush();
+
+    return true;
+}
+
+void RecordWriter::flush()
+{
+    RecordBatch* b = batches + cur;
+
+    if ( b->state.load(std::memory_order_acquire) == BATCH_FREE and
+        b->file == file and b->used > b->carried )
+        submit(b);
+}
+
+void RecordWriter::submit(RecordBatch* b)
+{
+    // a rewritten tail must land after the write it overlaps
+    while ( b->overlap and b->overlap->state.load(std::memory_order_acquire) != BATCH_FREE )
+        reap(true);
+
+    b->overlap = nullptr;
+    b->len = b->used;
+    b->done = 0;
+    b->error = 0;
+
+    if ( b->file->direct )
+    {
+        b->len = align_up(b->used);
+        memset(b->buf + b->used, 0, b->len - b->used);
+    }
+
+    ++async_log_stats.buffers;
+    async_log_stats.bytes += b->used - b->carried;
+
+    b->file->pending++;
+    in_flight++;
+
+    b->state.store(BATCH_QUEUED, std::memory_order_release);
+    engine->submit(b);
+
+    carry = b;
+    cur = (cur + 1) % config.batches;
+    started = 0;
+}
+
+void RecordWriter::reap(bool wait)
+{
+    while ( in_flight )
+    {
+        RecordBatch* b = engine->reap(wait);
+
+        if ( b )
+        {
+            complete(b);
+
+            if ( wait )
+                return;
+        }
+        else if ( !wait )
+            return;
+    }
+}
+
+void RecordWriter::complete(RecordBatch* b)
+{
+    RecordFile* f = b->file;
+
+    if ( b->error )
+        ErrorMessage("record writer failed to write %s: %s\n",
+            f->path.c_str(), get_error(b->error));
+
+    // used is kept so a following batch can still copy the tail
+    b->file = nullptr;
+    b->state.store(BATCH_FREE, std::memory_order_release);
+    in_flight--;
+
+    if ( !--f->pending and f->closed )
+        release(f);
+}
+
@@ -0,0 +1,106 @@
+//--------------------------------------------------------------------------
+// Copyright (C) 2026 Cisco and/or its affiliates. All rights reserved.
+//
+// This program is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License Version 2 as published
+// by the Free Software Foundation.  You may not use, modify or distribute
+// this program under any other version of the GNU General Public License.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+//--------------------------------------------------------------------------
+// record_writer.h
+
+#ifndef RECORD_WRITER_H
+#define RECORD_WRITER_H
+
+// RecordWriter takes binary log output (log_pcap, unified2) off the packet
+// thread.  Records are copied into the current batch of a ring of aligned
+// buffers; full batches are written at explicit file offsets by io_uring
+// (registered buffers) when available or else by a small pool of writer
+// threads.  The packet thread only copies and submits; completions are
+// reaped on later writes.
+
+#include <sys/uio.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <string>
+
+struct RecordWriterConfig
+{
+    size_t batch_size = 256 * 1024;  // rounded up to block size
+    size_t prealloc = 0;             // reserve this much when a file is opened (Linux only)
+    unsigned batches = 16;           // ring depth
+    unsigned threads = 1;            // writer pool size if no io_uring
+    bool direct = false;             // O_DIRECT with block aligned writes (Linux only)
+    bool block = false;              // wait for a free batch instead of dropping
+};
+
+struct RecordBatch;
+struct RecordFile;
+class RecordEngine;
+
+class RecordWriter
+{
+public:
+    RecordWriter(const RecordWriterConfig&);
+    ~RecordWriter();
+
+    // start a new file; the previous one is closed when its writes complete
+    bool open(const char* path);
+    void close();
+
+    // records are never split across files or dropped partially
+    bool write(const void*, size_t);
+    bool write(const struct iovec*, unsigned n);
+
+    // like write() but waits for a free batch even if not configured to
+    // block; for file headers without which the rest of the file is unusable
+    bool write_header(const void*, size_t);
+
+    // submit the current batch even if not full
+    void flush();
+
+    // logical size of the current file
+    size_t size() const;
+
+    bool is_open() const
+    { return file != nullptr; }
+
+    const char* engine_name() const;
+
+private:
+    bool put(const struct iovec*, unsigned n, bool wait);
+    bool ready(RecordBatch*, bool wait);
+    RecordBatch* get_batch(size_t need, bool wait);
+    void start(RecordBatch*);
+    void submit(RecordBatch*);
+    void reap(bool wait);
+    void complete(RecordBatch*);
+    void release(RecordFile*);
+
+private:
+    RecordWriterConfig config;
+    RecordEngine* engine = nullptr;
+    RecordBatch* batches = nullptr;
+    uint8_t* mem = nullptr;
+    RecordFile* file = nullptr;
+    std::string last_path;  // of the most recently opened file
+
+    RecordBatch* carry = nullptr;  // last submitted batch, holds unaligned tail
+
+    unsigned cur = 0;       // batch being filled
+    unsigned in_flight = 0;
+    time_t started = 0;     // when current batch got its first record
+};
+
+#endif
+
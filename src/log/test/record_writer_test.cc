@@ -0,0 +1,227 @@
+//--------------------------------------------------------------------------
+// Copyright (C) 2026 Cisco and/or its affiliates. All rights reserved.
+//
+// This program is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License Version 2 as published
+// by the Free Software Foundation.  You may not use, modify or distribute
+// this program under any other version of the GNU General Public License.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+//--------------------------------------------------------------------------
+// record_writer_test.cc
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include "../record_writer.h"
+#include "../text_log_writer.h"
+
+#include <CppUTest/CommandLineTestRunner.h>
+#include <CppUTest/TestHarness.h>
+
+THREAD_LOCAL AsyncLogStats async_log_stats;
+
+namespace snort
+{
+[[noreturn]] void FatalError(const char*, ...) { FAIL("fatal"); throw 0; }
+void ErrorMessage(const char*, ...) { }
+const char* get_error(int) { return ""; }
+}
+
+static const unsigned num_records = 20000;
+
+static std::string read_file(const std::string& path)
+{
+    std::string s;
+    char buf[4096];
+    size_t n;
+
+    FILE* f = fopen(path.c_str(), "r");
+
+    while ( f and (n = fread(buf, 1, sizeof(buf), f)) > 0 )
+        s.append(buf, n);
+
+    if ( f )
+        fclose(f);
+
+    return s;
+}
+
+static std::string write_records(RecordWriter& rw, unsigned first, unsigned last)
+{
+    std::string s;
+
+    for ( unsigned i = first; i < last; ++i )
+    {
+        char hdr[32];
+        int n = snprintf(hdr, sizeof(hdr), "%u:", i);
+        std::string body(i % 97, 'a' + i % 26);
+        body += '\n';
+
+        struct iovec iov[2] = { { hdr, (size_t)n }, { &body[0], body.size() } };
+        CHECK(rw.write(iov, 2));
+
+        s.append(hdr, n);
+        s += body;
+    }
+    return s;
+}
+
+TEST_GROUP(record_writer)
+{
+    std::string path;
+
+    void setup() override
+    {
+        char tmp[] = "/tmp/record_writer_XXXXXX";
+        int fd = mkstemp(tmp);
+        close(fd);
+        path = tmp;
+        memset(&async_log_stats, 0, sizeof(async_log_stats));
+    }
+
+    void teardown() override
+    {
+        unlink(path.c_str());
+        unlink((path + ".1").c_str());
+    }
+};
+
+TEST(record_writer, buffered)
+{
+    RecordWriterConfig cfg;
+    cfg.batch_size = 16 * 1024;
+    cfg.batches = 4;
+    cfg.block = true;
+    cfg.prealloc = 1024 * 1024;
+
+    std::string expect;
+    {
+        RecordWriter rw(cfg);
+        CHECK(rw.open(path.c_str()));
+        expect = write_records(rw, 0, num_records);
+        UNSIGNED_LONGS_EQUAL(expect.size(), rw.size());
+    }
+    CHECK(read_file(path) == expect);
+    UNSIGNED_LONGS_EQUAL(0, async_log_stats.dropped);
+    UNSIGNED_LONGS_EQUAL(expect.size(), async_log_stats.bytes);
+}
+
+TEST(record_writer, direct)
+{
+    RecordWriterConfig cfg;
+    cfg.batch_size = 16 * 1024;
+    cfg.batches = 4;
+    cfg.block = true;
+    cfg.direct = true;
+
+    std::string expect;
+    {
+        RecordWriter rw(cfg);
+        CHECK(rw.open(path.c_str()));
+        expect = write_records(rw, 0, num_records / 2);
+
+        // partial batch then more data rewrites the unaligned tail
+        rw.flush();
+        expect += write_records(rw, num_records / 2, num_records);
+    }
+    CHECK(read_file(path) == expect);
+}
+
+TEST(record_writer, rotate)
+{
+    RecordWriterConfig cfg;
+    cfg.batch_size = 16 * 1024;
+    cfg.block = true;
+
+    std::string first, second;
+    {
+        RecordWriter rw(cfg);
+        CHECK(rw.open(path.c_str()));
+        first = write_records(rw, 0, 1000);
+
+        CHECK(rw.open((path + ".1").c_str()));
+        UNSIGNED_LONGS_EQUAL(0, rw.size());
+        second = write_records(rw, 1000, 2000);
+    }
+    CHECK(read_file(path) == first);
+    CHECK(read_file(path + ".1") == second);
+}
+
+TEST(record_writer, reopen)
+{
+    RecordWriterConfig cfg;
+    cfg.batch_size = 16 * 1024;
+    cfg.block = true;
+    cfg.direct = true;
+
+    std::string second;
+    {
+        RecordWriter rw(cfg);
+        CHECK(rw.open(path.c_str()));
+        write_records(rw, 0, 5000);
+
+        // like unified2 nostamp, rotation truncates and rewrites the same path
+        CHECK(rw.open(path.c_str()));
+        UNSIGNED_LONGS_EQUAL(0, rw.size());
+        second = write_records(rw, 5000, 6000);
+    }
+    CHECK(read_file(path) == second);
+}
+
+TEST(record_writer, header_not_dropped)
+{
+    RecordWriterConfig cfg;
+    cfg.batch_size = 8 * 1024;
+    cfg.batches = 2;
+
+    const std::string hdr = "header";
+    {
+        RecordWriter rw(cfg);
+        CHECK(rw.open(path.c_str()));
+
+        // fill the ring without blocking, then roll over
+        std::string rec(4 * 1024, 'r');
+        for ( unsigned i = 0; i < 1000; ++i )
+            rw.write(rec.data(), rec.size());
+
+        CHECK(rw.open((path + ".1").c_str()));
+        CHECK(rw.write_header(hdr.data(), hdr.size()));
+        UNSIGNED_LONGS_EQUAL(hdr.size(), rw.size());
+    }
+    CHECK(read_file(path + ".1") == hdr);
+}
+
+TEST(record_writer, too_big)
+{
+    RecordWriterConfig cfg;
+    cfg.batch_size = 8 * 1024;
+
+    RecordWriter rw(cfg);
+    CHECK(rw.open(path.c_str()));
+
+    std::string big(cfg.batch_size, 'x');
+    CHECK_FALSE(rw.write(big.data(), big.size()));
+    UNSIGNED_LONGS_EQUAL(1, async_log_stats.dropped);
+    UNSIGNED_LONGS_EQUAL(0, rw.size());
+}
+
+int main(int argc, char* argv[])
+{
+    return CommandLineTestRunner::RunAllTests(argc, argv);
+}
+
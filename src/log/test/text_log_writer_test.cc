@@ -0,0 +1,190 @@
+//--------------------------------------------------------------------------
+// Copyright (C) 2026 Cisco and/or its affiliates. All rights reserved.
+//
+// This program is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License Version 2 as published
+// by the Free Software Foundation.  You may not use, modify or distribute
+// this program under any other version of the GNU General Public License.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+//--------------------------------------------------------------------------
+// text_log_writer_test.cc
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <unistd.h>
+#include <zlib.h>
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+
+#include "../text_log_writer.h"
+
+#include <CppUTest/CommandLineTestRunner.h>
+#include <CppUTest/TestHarness.h>
+
+namespace snort
+{
+[[noreturn]] void FatalError(const char*, ...) { FAIL("fatal"); throw 0; }
+void ErrorMessage(const char*, ...) { }
+const char* get_error(int) { return ""; }
+}
+
+static const unsigned num_lines = 5000;
+
+static void write_lines(AsyncTextLog* log)
+{
+    for ( unsigned i = 0; i < num_lines; ++i )
+    {
+        char* buf = log->get_buffer();
+        int n = snprintf(buf, 64, "line %u\n", i);
+        log->publish(n);
+    }
+}
+
+static std::string read_file(const std::string& path, bool gz)
+{
+    std::string s;
+    char buf[4096];
+    int n;
+
+    if ( gz )
+    {
+        gzFile f = gzopen(path.c_str(), "rb");
+        while ( f and (n = gzread(f, buf, sizeof(buf))) > 0 )
+            s.append(buf, n);
+        if ( f )
+            gzclose(f);
+    }
+    else
+    {
+        FILE* f = fopen(path.c_str(), "r");
+        while ( f and (n = fread(buf, 1, sizeof(buf), f)) > 0 )
+            s.append(buf, n);
+        if ( f )
+            fclose(f);
+    }
+    return s;
+}
+
+static std::string expected()
+{
+    std::string s;
+    for ( unsigned i = 0; i < num_lines; ++i )
+        s += "line " + std::to_string(i) + "\n";
+    return s;
+}
+
+TEST_GROUP(text_log_writer)
+{
+    std::string path;
+
+    void setup() override
+    {
+        char tmp[] = "/tmp/text_log_writer_XXXXXX";
+        int fd = mkstemp(tmp);
+        close(fd);
+        path = tmp;
+        memset(&async_log_stats, 0, sizeof(async_log_stats));
+    }
+
+    void teardown() override
+    {
+        unlink(path.c_str());
+        unlink((path + ".gz").c_str());
+        unlink((path + ".other").c_str());
+    }
+};
+
+TEST(text_log_writer, block)
+{
+    AsyncLogConfig cfg;
+    cfg.buffers = 4;
+    cfg.block = true;
+
+    AsyncTextLog* log = AsyncTextLog::open(path.c_str(), 64, 0, cfg, true);
+    CHECK(log);
+    write_lines(log);
+    delete log;
+
+    CHECK(read_file(path, false) == expected());
+    UNSIGNED_LONGS_EQUAL(num_lines, async_log_stats.buffers);
+    UNSIGNED_LONGS_EQUAL(0, async_log_stats.dropped);
+}
+
+TEST(text_log_writer, drop)
+{
+    AsyncLogConfig cfg;
+    cfg.buffers = 2;
+
+    AsyncTextLog* log = AsyncTextLog::open(path.c_str(), 64, 0, cfg, true);
+    CHECK(log);
+    write_lines(log);
+    delete log;
+
+    std::string s = read_file(path, false);
+    UNSIGNED_LONGS_EQUAL(num_lines, async_log_stats.buffers + async_log_stats.dropped);
+    UNSIGNED_LONGS_EQUAL(async_log_stats.bytes, s.size());
+    UNSIGNED_LONGS_EQUAL(0, async_log_stats.blocked);
+}
+
+TEST(text_log_writer, gzip)
+{
+    AsyncLogConfig cfg;
+    cfg.block = true;
+    cfg.gzip = true;
+
+    AsyncTextLog* log = AsyncTextLog::open(path.c_str(), 64, 0, cfg, true);
+    CHECK(log);
+    write_lines(log);
+    delete log;
+
+    CHECK(read_file(path + ".gz", true) == expected());
+}
+
+TEST(text_log_writer, close_while_writing)
+{
+    AsyncLogConfig cfg;
+    cfg.buffers = 4;
+    cfg.block = true;
+
+    AsyncTextLog* log = AsyncTextLog::open(path.c_str(), 64, 0, cfg, true);
+    CHECK(log);
+
+    // the writer keeps draining this log while others come and go
+    std::thread producer(write_lines, log);
+    std::string other = path + ".other";
+    std::string lines;
+
+    for ( unsigned i = 0; i < 100; ++i )
+    {
+        AsyncTextLog* tmp = AsyncTextLog::open(other.c_str(), 64, 0, cfg, true);
+        CHECK(tmp);
+        char* buf = tmp->get_buffer();
+        tmp->publish(snprintf(buf, 64, "line %u\n", i));
+        lines += buf;
+        delete tmp;
+    }
+    producer.join();
+    delete log;
+
+    CHECK(read_file(path, false) == expected());
+    CHECK(read_file(other, false) == lines);
+}
+
+int main(int argc, char* argv[])
+{
+    return CommandLineTestRunner::RunAllTests(argc, argv);
+}
+
@@ -37,9 +37,12 @@
 #include <algorithm>
 #include <cstdarg>
 
+#include "main/snort_config.h"
+#include "main/thread.h"
 #include "utils/util.h"
 
 #include "log.h"
+#include "text_log_writer.h"
 
 using namespace snort;
 
@@ -60,7 +63,10 @@ struct TextLog
 /* buffer attributes: */
     unsigned int pos;
     unsigned int maxBuf;
-    char buf[1];
+    char* buf;
+
+/* set when file output is done by the writer thread */
+    AsyncTextLog* async;
 };
 
 /*-------------------------------------------------------------------
@@ -111,6 +117,41 @@ void TextLog_Reset(TextLog* const txt)
     txt->buf[txt->pos] = '\0';
 }
 
+/*-------------------------------------------------------------------
+ * TextLog_InitAsync: constructor for logs written by the writer thread
+ *-------------------------------------------------------------------
+ */
+static TextLog* TextLog_InitAsync(
+    const SnortConfig* sc, const char* name, unsigned int maxBuf, size_t maxFile,
+    bool is_critical)
+{
+    std::string path;
+    get_instance_file(path, name ? name : "alert.txt");
+
+    AsyncLogConfig cfg;
+    cfg.buffers = sc->async_log_buffers;
+    cfg.block = sc->async_log_block;
+    cfg.gzip = sc->async_log_gzip;
+
+    AsyncTextLog* async = AsyncTextLog::open(path.c_str(), maxBuf, maxFile, cfg, is_critical);
+
+    if ( !async )
+        return nullptr;
+
+    TextLog* txt = (TextLog*)snort_calloc(sizeof(TextLog));
+
+    txt->name = name ? snort_strdup(name) : nullptr;
+    txt->last = time(nullptr);
+    txt->maxFile = maxFile;
+
+    txt->maxBuf = maxBuf;
+    txt->async = async;
+    txt->buf = async->get_buffer();
+    TextLog_Reset(txt);
+
+    return txt;
+}
+
 /*-------------------------------------------------------------------
  * TextLog_Init: constructor
  *-------------------------------------------------------------------
@@ -123,7 +164,15 @@ TextLog* TextLog_Init(
     if ( maxBuf < MIN_BUF )
         maxBuf = MIN_BUF;
 
+    const SnortConfig* sc = SnortConfig::get_conf();
+
+    // stdout stays synchronous so it interleaves with other console output
+    if ( sc and sc->use_log_async() and !(name and !strcasecmp(name, "stdout")) )
+        return TextLog_InitAsync(sc, name, maxBuf, maxFile, is_critical);
+
     txt = (TextLog*)snort_alloc(sizeof(TextLog)+maxBuf);
+    txt->buf = (char*)(txt + 1);
+    txt->async = nullptr;
 
     txt->name = name ? snort_strdup(name) : nullptr;
     txt->file = TextLog_Open(txt->name, is_critical);
@@ -154,7 +203,11 @@ void TextLog_Term(TextLog* const txt)
         return;
 
     TextLog_Flush(txt);
-    TextLog_Close(txt->file);
+
+    if ( txt->async )
+        delete txt->async;
+    else
+        TextLog_Close(txt->file);
 
     if ( txt->name )
         snort_free(txt->name);
@@ -193,6 +246,15 @@ bool TextLog_Flush(TextLog* const txt)
     if ( !txt->pos )
         return false;
 
+    if ( txt->async )
+    {
+        // rollover is done by the writer thread
+        ok = txt->async->publish(txt->pos);
+        txt->buf = txt->async->get_buffer();
+        TextLog_Reset(txt);
+        return ok;
+    }
+
     if ( txt->maxFile and txt->size + txt->pos > txt->maxFile )
         TextLog_Roll(txt);
 
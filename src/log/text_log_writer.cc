@@ -0,0 +1,358 @@
+//--------------------------------------------------------------------------
+// Copyright (C) 2026 Cisco and/or its affiliates. All rights reserved.
+//
+// This program is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License Version 2 as published
+// by the Free Software Foundation.  You may not use, modify or distribute
+// this program under any other version of the GNU General Public License.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+//--------------------------------------------------------------------------
+// text_log_writer.cc
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "text_log_writer.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "log/messages.h"
+#include "utils/util.h"
+
+using namespace snort;
+
+THREAD_LOCAL AsyncLogStats async_log_stats;
+
+static const unsigned max_iov = 64;
+static const std::chrono::milliseconds writer_idle(10);
+static const std::chrono::microseconds producer_wait(50);
+
+//--------------------------------------------------------------------------
+// writer thread - one for all async logs
+//--------------------------------------------------------------------------
+
+static std::mutex writer_mutex;
+static std::condition_variable writer_cv;
+static std::condition_variable pass_cv;
+static std::vector<AsyncTextLog*> writer_logs;
+static std::thread* writer_thread = nullptr;
+static bool writer_running = false;
+static bool writer_draining = false;
+static uint64_t writer_passes = 0;
+
+// logs are drained from a snapshot without the lock so file io doesn't
+// hold up opening or closing other logs; a removed log may still be in
+// the snapshot so removal waits for the current pass to finish
+static void writer_main()
+{
+    SET_THREAD_NAME(pthread_self(), "snort.logwriter");
+    std::vector<AsyncTextLog*> logs;
+    std::unique_lock<std::mutex> lock(writer_mutex);
+
+    while ( writer_running )
+    {
+        logs = writer_logs;
+        writer_draining = true;
+        lock.unlock();
+
+        bool busy = false;
+
+        for ( auto* log : logs )
+            busy = log->drain() or busy;
+
+        lock.lock();
+        writer_draining = false;
+        ++writer_passes;
+        pass_cv.notify_all();
+
+        if ( !busy )
+            writer_cv.wait_for(lock, writer_idle);
+    }
+}
+
+static void writer_add(AsyncTextLog* log)
+{
+    std::lock_guard<std::mutex> lock(writer_mutex);
+    writer_logs.emplace_back(log);
+
+    if ( writer_thread )
+        return;
+
+    writer_running = true;
+    writer_thread = new std::thread(writer_main);
+}
+
+static void writer_remove(AsyncTextLog* log)
+{
+    std::thread* done = nullptr;
+    {
+        std::unique_lock<std::mutex> lock(writer_mutex);
+        writer_logs.erase(std::remove(writer_logs.begin(), writer_logs.end(), log),
+            writer_logs.end());
+
+        // later passes won't see the log; wait out the one in progress
+        uint64_t pass = writer_passes;
+        pass_cv.wait(lock, [pass]() { return !writer_draining or writer_passes != pass; });
+
+        if ( writer_logs.empty() )
+        {
+            std::vector<AsyncTextLog*>().swap(writer_logs);
+            writer_running = false;
+            done = writer_thread;
+            writer_thread = nullptr;
+        }
+    }
+    if ( done )
+    {
+        writer_cv.notify_one();
+        done->join();
+        delete done;
+    }
+}
+
+//--------------------------------------------------------------------------
+// async log
+//--------------------------------------------------------------------------
+
+static int open_log(const char* path, bool is_critical)
+{
+    int fd = ::open(path, O_WRONLY | O_CREAT | O_APPEND, 0666);
+
+    if ( fd < 0 )
+    {
+        if ( is_critical )
+            FatalError("AsyncTextLog => open() log file %s: %s\n", path, get_error(errno));
+        else
+            ErrorMessage("AsyncTextLog => open() log file %s: %s\n", path, get_error(errno));
+    }
+    return fd;
+}
+
+AsyncTextLog* AsyncTextLog::open(const char* path, unsigned buf_size, size_t max_file,
+    const AsyncLogConfig& cfg, bool is_critical)
+{
+    std::string name(path);
+
+    if ( cfg.gzip )
+        name += ".gz";
+
+    int fd = open_log(name.c_str(), is_critical);
+
+    if ( fd < 0 )
+        return nullptr;
+
+    AsyncTextLog* log = new AsyncTextLog(name.c_str(), fd, buf_size, max_file, cfg);
+    writer_add(log);
+    return log;
+}
+
+AsyncTextLog::AsyncTextLog(const char* p, int f, unsigned buf_size, size_t max,
+    const AsyncLogConfig& cfg) : path(p)
+{
+    size = buf_size;
+    slots = std::max(cfg.buffers, 2u);
+    block = cfg.block;
+    gzip = cfg.gzip;
+
+    mem = (char*)snort_alloc(slots * size);
+    lens = (unsigned*)snort_calloc(slots, sizeof(*lens));
+
+    max_file = max;
+    last = time(nullptr);
+    attach(f);
+}
+
+AsyncTextLog::~AsyncTextLog()
+{
+    writer_remove(this);
+    drain();
+
+    if ( gz )
+        gzclose(gz);
+    else if ( fd >= 0 )
+        close(fd);
+
+    snort_free(lens);
+    snort_free(mem);
+}
+
+bool AsyncTextLog::attach(int f)
+{
+    fd = f;
+
+    struct stat sbuf;
+    file_size = fstat(fd, &sbuf) ? 0 : sbuf.st_size;
+
+    if ( !gzip )
+        return true;
+
+    // max_file is checked against uncompressed bytes in this case
+    gz = gzdopen(fd, "ab");
+
+    if ( !gz )
+    {
+        close(fd);
+        fd = -1;
+        return false;
+    }
+    return true;
+}
+
+// owning thread
+bool AsyncTextLog::publish(unsigned len)
+{
+    if ( pending() + 1 >= slots )
+    {
+        if ( !block )
+        {
+            ++async_log_stats.dropped;
+            async_log_stats.dropped_bytes += len;
+            return false;
+        }
+        ++async_log_stats.blocked;
+
+        do
+        {
+            writer_cv.notify_one();
+            std::this_thread::sleep_for(producer_wait);
+        }
+        while ( pending() + 1 >= slots );
+    }
+
+    uint64_t t = tail.load(std::memory_order_relaxed);
+    lens[t % slots] = len;
+    tail.store(t + 1, std::memory_order_release);
+
+    ++async_log_stats.buffers;
+    async_log_stats.bytes += len;
+
+    // the writer polls; only wake it early when we are filling up
+    if ( pending() >= slots / 2 )
+        writer_cv.notify_one();
+
+    return true;
+}
+
+// writer thread
+void AsyncTextLog::roll()
+{
+    // don't roll any sooner than resolution of filename discriminator
+    time_t now = time(nullptr);
+
+    if ( last >= now )
+        return;
+
+    if ( gz )
+        gzclose(gz);
+    else if ( fd >= 0 )
+        close(fd);
+
+    gz = nullptr;
+    fd = -1;
+
+    std::string old = path + "." + std::to_string((unsigned long)now);
+
+    if ( rename(path.c_str(), old.c_str()) )
+        ErrorMessage("AsyncTextLog => rename(%s, %s) = %s\n",
+            path.c_str(), old.c_str(), get_error(errno));
+
+    int f = open_log(path.c_str(), false);
+
+    if ( f >= 0 )
+        attach(f);
+
+    last = now;
+}
+
+void AsyncTextLog::write_out(struct iovec* iov, unsigned n)
+{
+    if ( gz )
+    {
+        for ( unsigned i = 0; i < n; ++i )
+        {
+            gzwrite(gz, iov[i].iov_base, iov[i].iov_len);
+            file_size += iov[i].iov_len;
+        }
+        return;
+    }
+
+    while ( n and fd >= 0 )
+    {
+        ssize_t r = writev(fd, iov, n);
+
+        if ( r < 0 )
+        {
+            if ( errno == EINTR )
+                continue;
+            break;
+        }
+        file_size += r;
+
+        while ( n and (size_t)r >= iov->iov_len )
+        {
+            r -= iov->iov_len;
+            ++iov;
+            --n;
+        }
+        if ( n )
+        {
+            iov->iov_base = (char*)iov->iov_base + r;
+            iov->iov_len -= r;
+        }
+    }
+}
+
+bool AsyncTextLog::drain()
+{
+    uint64_t h = head.load(std::memory_order_relaxed);
+    const uint64_t t = tail.load(std::memory_order_acquire);
+
+    if ( h == t )
+        return false;
+
+    while ( h < t )
+    {
+        struct iovec iov[max_iov];
+        unsigned n = 0;
+        size_t total = 0;
+
+        while ( h + n < t and n < max_iov )
+        {
+            iov[n].iov_base = slot(h + n);
+            iov[n].iov_len = lens[(h + n) % slots];
+            total += iov[n].iov_len;
+            ++n;
+        }
+
+        if ( max_file and file_size + total > max_file )
+            roll();
+
+        write_out(iov, n);
+
+        h += n;
+        head.store(h, std::memory_order_release);
+    }
+    return true;
+}
+
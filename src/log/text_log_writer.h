@@ -0,0 +1,111 @@
+//--------------------------------------------------------------------------
+// Copyright (C) 2026 Cisco and/or its affiliates. All rights reserved.
+//
+// This program is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License Version 2 as published
+// by the Free Software Foundation.  You may not use, modify or distribute
+// this program under any other version of the GNU General Public License.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+//--------------------------------------------------------------------------
+// text_log_writer.h
+
+#ifndef TEXT_LOG_WRITER_H
+#define TEXT_LOG_WRITER_H
+
+// AsyncTextLog moves file output of a TextLog off the packet thread.  The
+// owning thread formats into the current slot of a single producer / single
+// consumer ring and publishes it on flush; a single writer thread drains all
+// rings with writev (or gzwrite) and handles rollover.
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <string>
+
+#include "framework/counts.h"
+#include "main/thread.h"
+
+typedef struct gzFile_s* gzFile;
+
+struct AsyncLogConfig
+{
+    unsigned buffers = 16;   // ring slots per log
+    bool block = false;      // wait for the writer instead of dropping
+    bool gzip = false;       // compress the output stream
+};
+
+struct AsyncLogStats
+{
+    PegCount buffers;
+    PegCount bytes;
+    PegCount dropped;
+    PegCount dropped_bytes;
+    PegCount blocked;
+};
+
+extern THREAD_LOCAL AsyncLogStats async_log_stats;
+
+class AsyncTextLog
+{
+public:
+    static AsyncTextLog* open(const char* path, unsigned buf_size, size_t max_file,
+        const AsyncLogConfig&, bool is_critical);
+
+    ~AsyncTextLog();
+
+    // producer side, owning thread only
+    char* get_buffer() const
+    { return slot(tail.load(std::memory_order_relaxed)); }
+
+    // queue len bytes of the current buffer for writing
+    // returns false if the buffer was dropped instead
+    bool publish(unsigned len);
+
+    // consumer side, writer thread only
+    bool drain();
+
+private:
+    AsyncTextLog(const char* path, int fd, unsigned buf_size, size_t max_file,
+        const AsyncLogConfig&);
+
+    char* slot(uint64_t n) const
+    { return mem + (n % slots) * size; }
+
+    uint64_t pending() const
+    { return tail.load(std::memory_order_relaxed) - head.load(std::memory_order_acquire); }
+
+    bool attach(int fd);
+    void roll();
+    void write_out(struct iovec*, unsigned n);
+
+private:
+    std::string path;
+    char* mem;
+    unsigned* lens;
+    unsigned size;
+    unsigned slots;
+    bool block;
+    bool gzip;
+
+    alignas(64) std::atomic<uint64_t> head { 0 };  // advanced by writer
+    alignas(64) std::atomic<uint64_t> tail { 0 };  // advanced by owner
+
+    // writer state
+    int fd = -1;
+    gzFile gz = nullptr;
+    size_t file_size = 0;
+    size_t max_file;
+    time_t last;
+};
+
+#endif
+
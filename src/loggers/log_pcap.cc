@@ -28,6 +28,7 @@
 #include "framework/logger.h"
 #include "framework/module.h"
 #include "log/messages.h"
+#include "log/record_writer.h"
 #include "main/snort_config.h"
 #include "main/thread.h"
 #include "packet_io/sfdaq.h"
@@ -58,6 +59,7 @@ struct LtdContext
 {
     char* file;
     pcap_dumper_t* dumpd;
+    RecordWriter* writer;
     time_t lastTime;
     size_t size;
     int log_cnt;
@@ -130,6 +132,24 @@ static void LogTcpdumpSingle(
     if ( data->limit && (context.size + dumpSize > data->limit) )
         TcpdumpRollLogFile(data);
 
+    if ( context.writer )
+    {
+        // same on disk layout as pcap_dump
+        uint32_t pkth[4] =
+        {
+            (uint32_t)p->pkth->ts.tv_sec, (uint32_t)p->pkth->ts.tv_usec,
+            p->pktlen, p->pkth->pktlen
+        };
+        struct iovec iov[2] =
+        {
+            { pkth, PCAP_PKT_HDR_SZ },
+            { const_cast<uint8_t*>(p->pkt), p->pktlen }
+        };
+        if ( context.writer->write(iov, 2) )
+            context.size += dumpSize;
+        return;
+    }
+
     struct pcap_pkthdr pcaphdr;
     pcaphdr.ts = p->pkth->ts;
     pcaphdr.caplen = p->pktlen;
@@ -174,8 +194,33 @@ static void TcpdumpInitLogFile(LtdConfig*, bool no_timestamp)
     if ( dlt == DLT_IPV4 || dlt == DLT_IPV6 )
         dlt = DLT_RAW;
 
+    const SnortConfig* sc = SnortConfig::get_conf();
+    uint32_t snaplen = sc->daq_config->get_mru_size();
+
+    if ( context.writer )
+    {
+        if ( !context.writer->open(file.c_str()) )
+            FatalError("%s: can't open %s: %s\n", S_NAME, file.c_str(), get_error(errno));
+
+        // same as pcap_dump_open, in host byte order
+        struct pcap_file_header hdr = { };
+        hdr.magic = 0xa1b2c3d4;
+        hdr.version_major = PCAP_VERSION_MAJOR;
+        hdr.version_minor = PCAP_VERSION_MINOR;
+        hdr.snaplen = snaplen;
+        hdr.linktype = dlt;
+
+        // without the file header the records can't be read
+        if ( !context.writer->write_header(&hdr, PCAP_FILE_HDR_SZ) )
+            FatalError("%s: can't write header to %s\n", S_NAME, file.c_str());
+
+        context.file = snort_strdup(file.c_str());
+        context.size = PCAP_FILE_HDR_SZ;
+        return;
+    }
+
     pcap_t* pcap;
-    pcap = pcap_open_dead(dlt, SnortConfig::get_conf()->daq_config->get_mru_size());
+    pcap = pcap_open_dead(dlt, snaplen);
 
     if ( !pcap )
         FatalError("%s: can't get pcap context\n", S_NAME);
@@ -204,7 +249,13 @@ static void TcpdumpRollLogFile(LtdConfig* data)
         return;
 
     /* close the output file */
-    if ( context.dumpd != nullptr )
+    if ( context.writer and context.file )
+    {
+        context.size = 0;
+        snort_free(context.file);
+        context.file = nullptr;
+    }
+    else if ( context.dumpd != nullptr )
     {
         pcap_dump_close(context.dumpd);
         context.dumpd = nullptr;
@@ -269,13 +320,32 @@ PcapLogger::~PcapLogger()
 
 void PcapLogger::open()
 {
-    TcpdumpInitLogFile(config, SnortConfig::get_conf()->output_no_timestamp());
+    const SnortConfig* sc = SnortConfig::get_conf();
+
+    if ( sc->use_log_async() and !context.writer )
+    {
+        RecordWriterConfig cfg;
+        cfg.batch_size = sc->async_log_batch;
+        cfg.batches = sc->async_log_buffers;
+        cfg.threads = sc->async_log_threads;
+        cfg.direct = sc->async_log_direct;
+        cfg.block = sc->async_log_block;
+        cfg.prealloc = config->limit;
+        context.writer = new RecordWriter(cfg);
+    }
+    TcpdumpInitLogFile(config, sc->output_no_timestamp());
 }
 
 void PcapLogger::close()
 {
     SpoLogTcpdumpCleanup(nullptr);
 
+    if ( context.writer )
+    {
+        // waits for queued batches
+        delete context.writer;
+        context.writer = nullptr;
+    }
     if ( context.dumpd )
     {
         pcap_dump_close(context.dumpd);
@@ -287,7 +357,7 @@ void PcapLogger::close()
 
 void PcapLogger::log(Packet* p, const char* msg, Event* event)
 {
-    if(!context.dumpd)
+    if ( !context.dumpd and !context.writer )
         open();
 
     context.log_cnt++;
@@ -299,7 +369,7 @@ void PcapLogger::log(Packet* p, const char* msg, Event* event)
 
 void PcapLogger::reset()
 {
-    if(!context.dumpd)
+    if ( !context.dumpd and !context.writer )
         open();
     else
         TcpdumpRollLogFile(config);
@@ -38,6 +38,7 @@
 #include "framework/module.h"
 #include "log/messages.h"
 #include "log/obfuscator.h"
+#include "log/record_writer.h"
 #include "log/unified2.h"
 #include "log/u2_packet.h"
 #include "main/snort_config.h"
@@ -71,6 +72,7 @@ struct Unified2Config
 struct U2
 {
     FILE* stream;
+    RecordWriter* writer;
     unsigned int current;
     int base_proto;
     time_t timestamp;
@@ -128,6 +130,13 @@ static void Unified2InitFile(Unified2Config* config)
         fname_ptr = u2.filepath;
     }
 
+    if ( u2.writer )
+    {
+        if ( !u2.writer->open(fname_ptr) )
+            FatalError("unified2 could not open %s: %s\n", fname_ptr, get_error(errno));
+        return;
+    }
+
     if ((u2.stream = fopen(fname_ptr, "wb")) == nullptr)
     {
         FatalError("unified2 could not open %s: %s\n", fname_ptr, get_error(errno));
@@ -144,7 +153,10 @@ static void Unified2InitFile(Unified2Config* config)
 
 static inline void Unified2RotateFile(Unified2Config* config)
 {
-    fclose(u2.stream);
+    // the writer closes the previous file when its batches complete
+    if ( !u2.writer )
+        fclose(u2.stream);
+
     u2.current = 0;
     Unified2InitFile(config);
 }
@@ -477,6 +489,14 @@ static void Unified2Write(uint8_t* buf, uint32_t buf_len, Unified2Config* config
 {
     size_t fwcount = 0;
 
+    if ( u2.writer and buf and config )
+    {
+        // write errors are reported when the batch completes
+        if ( u2.writer->write(buf, buf_len) )
+            u2.current += buf_len;
+        return;
+    }
+
     /* Nothing to write or nothing to write to */
     if ((buf == nullptr) || (config == nullptr) || (u2.stream == nullptr))
         return;
@@ -938,7 +958,22 @@ void U2Logger::open()
     u2.base_proto = htonl(SFDAQ::get_base_protocol());
 
     write_pkt_buffer = new uint8_t[u2_buf_sz];
-    io_buffer = new char[u2_buf_sz];
+
+    const SnortConfig* sc = SnortConfig::get_conf();
+
+    if ( sc->use_log_async() )
+    {
+        RecordWriterConfig cfg;
+        cfg.batch_size = sc->async_log_batch;
+        cfg.batches = sc->async_log_buffers;
+        cfg.threads = sc->async_log_threads;
+        cfg.direct = sc->async_log_direct;
+        cfg.block = sc->async_log_block;
+        cfg.prealloc = config.limit;
+        u2.writer = new RecordWriter(cfg);
+    }
+    else
+        io_buffer = new char[u2_buf_sz];
 
     Unified2InitFile(&config);
 
@@ -947,7 +982,13 @@ void U2Logger::open()
 
 void U2Logger::close()
 {
-    if ( u2.stream )
+    if ( u2.writer )
+    {
+        // waits for queued batches
+        delete u2.writer;
+        u2.writer = nullptr;
+    }
+    else if ( u2.stream )
         fclose(u2.stream);
 
     delete[] write_pkt_buffer;
@@ -48,6 +48,7 @@
 #include "latency/latency_module.h"
 #include "log/batched_logger.h"
 #include "log/messages.h"
+#include "log/text_log_writer.h"
 #include "lua/lua.h"
 #include "managers/module_manager.h"
 #include "managers/plugin_manager.h"
@@ -735,8 +736,40 @@ static const Parameter output_event_trace_params[] =
     { nullptr, Parameter::PT_MAX, nullptr, nullptr, nullptr }
 };
 
+static const Parameter output_async_params[] =
+{
+    { "enable", Parameter::PT_BOOL, nullptr, "false",
+      "write text log files (alert_fast, alert_full, alert_json, alert_csv, etc.) "
+      "from a dedicated writer thread and log_pcap and unified2 files with io_uring "
+      "or writer threads" },
+
+    { "buffers", Parameter::PT_INT, "2:1024", "16",
+      "number of output buffers queued per log file" },
+
+    { "batch_size", Parameter::PT_INT, "128:65536", "256",
+      "size of log_pcap and unified2 write batches in KB" },
+
+    { "direct", Parameter::PT_BOOL, nullptr, "false",
+      "bypass the page cache for log_pcap and unified2 files; the last block is "
+      "padded until the file is closed" },
+
+    { "threads", Parameter::PT_INT, "1:16", "1",
+      "number of writer threads for log_pcap and unified2 when io_uring is not available" },
+
+    { "overflow", Parameter::PT_ENUM, "drop | block", "drop",
+      "drop output or wait for the writer when all buffers are queued" },
+
+    { "compression", Parameter::PT_ENUM, "none | gzip", "none",
+      "compress log files as they are written (adds .gz to file names)" },
+
+    { nullptr, Parameter::PT_MAX, nullptr, nullptr, nullptr }
+};
+
 static const Parameter output_params[] =
 {
+    { "async", Parameter::PT_TABLE, output_async_params, nullptr,
+      "text log writer thread" },
+
     { "dump_chars_only", Parameter::PT_BOOL, nullptr, "false",
       "turns on character dumps (same as -C)" },
 
@@ -789,6 +822,16 @@ static const RuleMap output_rules[] =
     { 0, nullptr }
 };
 
+static const PegInfo output_pegs[] =
+{
+    { CountType::SUM, "async_buffers", "log buffers queued for writing" },
+    { CountType::SUM, "async_bytes", "log bytes queued for writing" },
+    { CountType::SUM, "async_dropped", "log buffers or records dropped because all buffers were queued" },
+    { CountType::SUM, "async_dropped_bytes", "log bytes dropped because all buffers were queued" },
+    { CountType::SUM, "async_blocked", "times a packet thread waited for a free buffer" },
+    { CountType::END, nullptr, nullptr }
+};
+
 class OutputModule : public Module
 {
 public:
@@ -803,6 +846,12 @@ public:
 
     const RuleMap* get_rules() const override
     { return output_rules; }
+
+    const PegInfo* get_pegs() const override
+    { return output_pegs; }
+
+    PegCount* get_counts() const override
+    { return (PegCount*)&async_log_stats; }
 };
 
 bool OutputModule::set(const char*, Value& v, SnortConfig* sc)
@@ -855,6 +904,27 @@ bool OutputModule::set(const char*, Value& v, SnortConfig* sc)
         v.update_mask(sc->output_flags, OUTPUT_FLAG__LOG_BUFFERED);
     }
 
+    else if ( v.is("enable") )
+        v.update_mask(sc->output_flags, OUTPUT_FLAG__LOG_ASYNC);
+
+    else if ( v.is("buffers") )
+        sc->async_log_buffers = v.get_uint32();
+
+    else if ( v.is("batch_size") )
+        sc->async_log_batch = v.get_size() * 1024;
+
+    else if ( v.is("direct") )
+        sc->async_log_direct = v.get_bool();
+
+    else if ( v.is("threads") )
+        sc->async_log_threads = v.get_uint32();
+
+    else if ( v.is("overflow") )
+        sc->async_log_block = v.get_uint8() == 1;
+
+    else if ( v.is("compression") )
+        sc->async_log_gzip = v.get_uint8() == 1;
+
     return true;
 }
 
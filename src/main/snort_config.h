@@ -101,6 +101,7 @@ enum OutputFlag
 
     OUTPUT_FLAG__ALERT_REFS        = 0x00001000,
     OUTPUT_FLAG__LOG_BUFFERED      = 0x00002000,
+    OUTPUT_FLAG__LOG_ASYNC         = 0x00004000,
 };
 
 enum LoggingFlag
@@ -213,6 +214,13 @@ public:
     uint32_t tagged_packet_limit = 256;
     uint16_t event_trace_max = 0;
 
+    size_t async_log_batch = 256 * 1024;
+    unsigned async_log_buffers = 16;
+    unsigned async_log_threads = 1;
+    bool async_log_block = false;
+    bool async_log_gzip = false;
+    bool async_log_direct = false;
+
     std::string log_dir;
 
     //------------------------------------------------------
@@ -579,6 +587,9 @@ public:
     bool use_log_buffered() const
     { return output_flags & OUTPUT_FLAG__LOG_BUFFERED; }
 
+    bool use_log_async() const
+    { return output_flags & OUTPUT_FLAG__LOG_ASYNC; }
+
     bool output_app_data() const
     { return output_flags & OUTPUT_FLAG__APP_DATA; }
 
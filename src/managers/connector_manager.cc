@@ -224,3 +224,16 @@ Connector::Direction ConnectorManager::is_instantiated(const std::string& name)
 
     return Connector::CONN_UNDEFINED;
 }
+
+bool ConnectorManager::is_text_format(const std::string& name)
+{
+    for ( auto& conn : s_connector_commons )
+    {
+        auto connector_ptr = conn.connectors.find(name);
+
+        if ( connector_ptr != conn.connectors.end() )
+            return connector_ptr->second.config.text_format;
+    }
+
+    return false;
+}
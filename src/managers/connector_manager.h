@@ -43,6 +43,7 @@ public:
 
     static void instantiate(const snort::ConnectorApi*, snort::Module*, snort::SnortConfig*);
     static snort::Connector::Direction is_instantiated(const std::string& name);
+    static bool is_text_format(const std::string& name);
     static void update_thread_connector(const std::string& connector_name, int instance_id, snort::Connector* connector);
 
 
@@ -25,6 +25,7 @@
 #include "heap_interface.h"
 
 #include <cassert>
+#include <cstdio>
 #include <cstring>
 
 #ifdef HAVE_JEMALLOC
@@ -56,6 +57,19 @@ class JemallocInterface : public HeapInterface
     void profile_config(bool enable, uint64_t sample_rate) override;
     void dump_profile(ControlConn*) override;
     void show_profile_config(ControlConn*) override;
+
+    bool has_arenas() override
+    { return true; }
+
+    int create_arena() override;
+    void set_thread_arena(unsigned) override;
+    uint64_t get_arena_allocated(unsigned) override;
+
+    int create_tcache() override;
+    void destroy_tcache(int) override;
+
+    void* allocate(size_t, unsigned arena, int tcache) override;
+    void deallocate(void*, size_t, int tcache) override;
 };
 
 static size_t stats_mib[2], mib_len = 2;
@@ -196,6 +210,74 @@ void JemallocInterface::show_profile_config(ControlConn* ctrlcon)
     }
 }
 
+int JemallocInterface::create_arena()
+{
+    unsigned arena;
+    size_t sz = sizeof(arena);
+
+    int ret = mallctl("arenas.create", (void*)&arena, &sz, nullptr, 0);
+
+    if ( ret )
+    {
+        snort::LogMessage("Error in creating jemalloc arena : %d", ret);
+        return -1;
+    }
+    return (int)arena;
+}
+
+// this is only called when a packet thread starts; subsystem allocations
+// name their arena with mallocx rather than rebinding the thread
+void JemallocInterface::set_thread_arena(unsigned arena)
+{
+    mallctl("thread.arena", nullptr, nullptr, (void*)&arena, sizeof(arena));
+}
+
+int JemallocInterface::create_tcache()
+{
+    unsigned tcache;
+    size_t sz = sizeof(tcache);
+
+    int ret = mallctl("tcache.create", (void*)&tcache, &sz, nullptr, 0);
+
+    if ( ret )
+    {
+        snort::LogMessage("Error in creating jemalloc tcache : %d", ret);
+        return -1;
+    }
+    return (int)tcache;
+}
+
+void JemallocInterface::destroy_tcache(int tcache)
+{
+    unsigned tc = tcache;
+    mallctl("tcache.destroy", nullptr, nullptr, (void*)&tc, sizeof(tc));
+}
+
+static inline int tcache_flags(int tcache)
+{ return tcache < 0 ? MALLOCX_TCACHE_NONE : MALLOCX_TCACHE(tcache); }
+
+void* JemallocInterface::allocate(size_t size, unsigned arena, int tcache)
+{ return mallocx(size, MALLOCX_ARENA(arena) | tcache_flags(tcache)); }
+
+void JemallocInterface::deallocate(void* p, size_t size, int tcache)
+{ sdallocx(p, size, tcache_flags(tcache)); }
+
+// stats are only as current as the last epoch
+uint64_t JemallocInterface::get_arena_allocated(unsigned arena)
+{
+    char name[64];
+    size_t small = 0, large = 0;
+    size_t sz = sizeof(small);
+
+    snprintf(name, sizeof(name), "stats.arenas.%u.small.allocated", arena);
+    mallctl(name, (void*)&small, &sz, nullptr, 0);
+
+    snprintf(name, sizeof(name), "stats.arenas.%u.large.allocated", arena);
+    mallctl(name, (void*)&large, &sz, nullptr, 0);
+
+    return small + large;
+}
+
 //--------------------------------------------------------------------------
 #else  // disabled interface
 //--------------------------------------------------------------------------
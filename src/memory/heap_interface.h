@@ -21,12 +21,24 @@
 #ifndef HEAP_INTERFACE_H
 #define HEAP_INTERFACE_H
 
+#include <cstddef>
 #include <cstdint>
 
 class ControlConn;
 namespace memory
 {
 
+// subsystems that may be given their own heap arenas
+enum Arena : uint8_t
+{
+    ARENA_FLOW,
+    ARENA_STREAM,
+    ARENA_FILE,
+    ARENA_APPID,
+    ARENA_HTTP,
+    ARENA_MAX
+};
+
 class HeapInterface
 {
 public:
@@ -46,6 +58,22 @@ public:
     virtual void dump_profile(ControlConn*) { }
     virtual void show_profile_config(ControlConn*) { }
 
+    virtual bool has_arenas() { return false; }
+
+    // return the new arena index or -1 if arenas are not supported
+    virtual int create_arena() { return -1; }
+    virtual void set_thread_arena(unsigned) { }
+    virtual uint64_t get_arena_allocated(unsigned) { return 0; }
+
+    // return the new thread cache index or -1 if not supported
+    virtual int create_tcache() { return -1; }
+    virtual void destroy_tcache(int) { }
+
+    // allocate from the given arena through the given thread cache (-1 for
+    // none); return nullptr if not supported
+    virtual void* allocate(size_t, unsigned /*arena*/, int /*tcache*/) { return nullptr; }
+    virtual void deallocate(void* p, size_t, int /*tcache*/) { ::operator delete(p); }
+
     static HeapInterface* get_instance();
 
 protected:
@@ -26,6 +26,7 @@
 
 #include <sys/resource.h>
 
+#include <array>
 #include <atomic>
 #include <cassert>
 #include <vector>
@@ -54,6 +55,10 @@ namespace memory
 
 static std::vector<MemoryCounts> pkt_mem_stats;
 
+// per packet thread arena indices, the last is the thread's default arena
+using ArenaIds = std::array<int, ARENA_MAX + 1>;
+static std::vector<ArenaIds> pkt_arenas;
+
 static MemoryConfig config;
 static size_t limit = 0;
 
@@ -65,6 +70,12 @@ static std::atomic<uint64_t> max_in_use { 0 };
 // The most recent epoch reported by jemalloc
 static std::atomic<uint64_t> latest_epoch { 0 };
 
+static std::atomic<uint64_t> arena_use[ARENA_MAX] { };
+static std::atomic<unsigned> over_arena { ARENA_MAX };
+
+static THREAD_LOCAL const ArenaIds* thread_arenas = nullptr;
+static THREAD_LOCAL int thread_tcaches[ARENA_MAX];
+
 static THREAD_LOCAL uint64_t start_dealloc = 0;
 static THREAD_LOCAL uint64_t start_alloc = 0;
 static THREAD_LOCAL uint64_t start_epoch = 0;
@@ -72,13 +83,74 @@ static THREAD_LOCAL uint64_t start_epoch = 0;
 static HeapInterface* heap = nullptr;
 static PruneHandler pruner;
 
+// arenas and budgets are ignored without heap support so say so once
+static void check_arenas()
+{
+    static bool warned = false;
+    bool budgets = false;
+
+    for ( auto b : config.budgets )
+        budgets = budgets or b;
+
+    if ( !config.arenas and !budgets )
+        return;
+
+    const char* why = nullptr;
+
+    if ( !heap->has_arenas() )
+    {
+        why = "heap arenas are not supported by this build";
+        config.arenas = false;
+    }
+    else if ( !config.arenas )
+        why = "memory.arenas is disabled";
+
+    if ( why and !warned )
+    {
+        WarningMessage("memory: arenas and budgets are ignored because %s\n", why);
+        warned = true;
+    }
+}
+
+// sum usage of each subsystem over all packet thread arenas and find
+// the subsystem exceeding its budget by the most, if any
+static void arena_check()
+{
+    unsigned worst = ARENA_MAX;
+    uint64_t excess = 0;
+
+    for ( unsigned a = 0; a < ARENA_MAX; ++a )
+    {
+        uint64_t used = 0;
+
+        for ( const auto& ids : pkt_arenas )
+        {
+            if ( ids[a] >= 0 )
+                used += heap->get_arena_allocated(ids[a]);
+        }
+        arena_use[a] = used;
+
+        size_t budget = config.budgets[a];
+
+        if ( budget and used > budget and used - budget > excess )
+        {
+            excess = used - budget;
+            worst = a;
+        }
+    }
+    over_arena = worst;
+}
+
 static void epoch_check(void*)
 {
     uint64_t epoch, total;
     heap->get_process_total(epoch, total, true);
 
+    if ( config.arenas )
+        arena_check();
+
     bool prior = over_limit;
-    over_limit = limit and total > limit;
+    over_limit = (limit and total > limit) or over_arena != ARENA_MAX;
 
     if ( prior != over_limit )
         trace_logf(memory_trace, nullptr, "Epoch=%lu, memory=%lu (%s)\n", epoch, total, over_limit?"over":"under");
@@ -142,6 +214,10 @@ void MemoryCap::init(unsigned n)
     assert(in_main_thread());
     pkt_mem_stats.resize(n);
 
+    ArenaIds none;
+    none.fill(-1);
+    pkt_arenas.assign(n, none);
+
 #ifdef UNIT_TEST
     pkt_mem_stats[0] = { };
 #endif
@@ -150,8 +226,14 @@ void MemoryCap::init(unsigned n)
 void MemoryCap::term()
 {
     pkt_mem_stats.resize(0);
+    pkt_arenas.resize(0);
     delete heap;
     heap = nullptr;
+
+    for ( auto& u : arena_use )
+        u = 0;
+
+    over_arena = ARENA_MAX;
 }
 
 void MemoryCap::set_heap_interface(HeapInterface* h)
@@ -170,6 +252,7 @@ void MemoryCap::start(const MemoryConfig& c, PruneHandler ph)
         heap = HeapInterface::get_instance();
 
     heap->main_init();
+    check_arenas();
 
     if ( !config.enabled )
         return;
@@ -199,12 +282,71 @@ void MemoryCap::thread_init()
     heap->thread_init();
     start_dealloc = 0;
     start_epoch = 0;
+    thread_arenas = nullptr;
+
+    if ( !config.arenas or get_instance_id() >= pkt_arenas.size() )
+        return;
+
+    // arenas can't be destroyed while they hold memory so they are kept
+    // for the life of the process and reused if the thread is restarted
+    ArenaIds& ids = pkt_arenas[get_instance_id()];
+
+    if ( ids[ARENA_MAX] < 0 )
+    {
+        for ( auto& id : ids )
+        {
+            if ( (id = heap->create_arena()) < 0 )
+            {
+                ids.fill(-1);
+                return;
+            }
+        }
+    }
+    // subsystems allocate from their own arena by name so the thread is
+    // bound once to its default arena; a cache per subsystem keeps freed
+    // blocks from being handed out to another subsystem
+    thread_arenas = &ids;
+    heap->set_thread_arena(ids[ARENA_MAX]);
+
+    for ( auto& tc : thread_tcaches )
+        tc = heap->create_tcache();
 }
 
 void MemoryCap::thread_term()
 {
     MemoryCounts& mc = get_mem_stats();
     heap->get_thread_allocs(mc.allocated, mc.deallocated);
+
+    if ( thread_arenas )
+    {
+        for ( auto& tc : thread_tcaches )
+        {
+            if ( tc >= 0 )
+                heap->destroy_tcache(tc);
+            tc = -1;
+        }
+    }
+    thread_arenas = nullptr;
+}
+
+void* MemoryCap::allocate(Arena a, size_t size)
+{
+    if ( thread_arenas )
+    {
+        if ( void* p = heap->allocate(size, (*thread_arenas)[a], thread_tcaches[a]) )
+            return p;
+    }
+    return ::operator new(size);
+}
+
+// arena blocks are from the same heap as everything else so they can be
+// freed without their cache, eg after the thread has stopped
+void MemoryCap::deallocate(Arena a, void* p, size_t size)
+{
+    if ( thread_arenas )
+        heap->deallocate(p, size, thread_tcaches[a]);
+    else
+        ::operator delete(p);
 }
 
 MemoryCounts& MemoryCap::get_mem_stats()
@@ -344,6 +486,9 @@ void MemoryCap::update_global_stats()
     mc.active = act;
     mc.resident = res;
     mc.retained = ret;
+
+    for ( unsigned a = 0; a < ARENA_MAX; ++a )
+        mc.arena_bytes[a] = arena_use[a];
 }
 
 // called at startup and shutdown
@@ -24,6 +24,8 @@
 #include "memory/heap_interface.h"
 
 #include <cstddef>
+#include <new>
+#include <utility>
 
 #include "framework/counts.h"
 #include "main/snort_types.h"
@@ -53,6 +55,8 @@ struct MemoryCounts
     PegCount active;
     PegCount resident;
     PegCount retained;
+    // arenas
+    PegCount arena_bytes[ARENA_MAX];
 };
 
 typedef bool (*PruneHandler)();
@@ -78,6 +82,12 @@ public:
     static void thread_term();
     static void free_space();
 
+    // allocate from the arena of the given subsystem through its thread
+    // cache or from the global heap if arenas are not in use; blocks may be
+    // released with deallocate() or a plain delete
+    static void* allocate(Arena, size_t);
+    static void deallocate(Arena, void*, size_t);
+
     // main and packet threads
     static MemoryCounts& get_mem_stats();
     static void update_global_stats();
@@ -94,6 +104,22 @@ public:
 #endif
 };
 
+// construct an object in the given subsystem's arena
+template<typename T, typename... Args>
+T* arena_new(Arena a, Args&&... args)
+{ return new (MemoryCap::allocate(a, sizeof(T))) T(std::forward<Args>(args)...); }
+
+// storage policy for pools of blocks from the given subsystem's arena
+template<Arena A>
+struct ArenaStorage
+{
+    static void* allocate(size_t size)
+    { return MemoryCap::allocate(A, size); }
+
+    static void deallocate(void* ptr, size_t size)
+    { MemoryCap::deallocate(A, ptr, size); }
+};
+
 }
 
 #endif
@@ -23,6 +23,8 @@
 
 #include <cstddef>
 
+#include "memory/heap_interface.h"
+
 struct MemoryConfig
 {
     size_t cap = 0;
@@ -30,6 +32,8 @@ struct MemoryConfig
     unsigned interval = 1000;
     unsigned prune_target = 1048576;
     bool enabled = false;
+    bool arenas = false;
+    size_t budgets[memory::ARENA_MAX] = { };
 
     constexpr MemoryConfig() = default;
 };
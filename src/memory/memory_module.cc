@@ -24,6 +24,8 @@
 
 #include "memory_module.h"
 
+#include <cstring>
+
 #include "main/snort_config.h"
 #include "trace/trace.h"
 
@@ -42,8 +44,35 @@ THREAD_LOCAL const Trace* memory_trace = nullptr;
 #define s_help \
     "memory management configuration"
 
+// must be in memory::Arena order
+static const Parameter s_budget_params[] =
+{
+    { "flow", Parameter::PT_INT, "0:maxSZ", "0",
+        "bytes allowed for flows before they are pruned (0 to disable)" },
+
+    { "stream", Parameter::PT_INT, "0:maxSZ", "0",
+        "bytes allowed for stream reassembly before it is pruned (0 to disable)" },
+
+    { "file", Parameter::PT_INT, "0:maxSZ", "0",
+        "bytes allowed for file processing before it is pruned (0 to disable)" },
+
+    { "appid", Parameter::PT_INT, "0:maxSZ", "0",
+        "bytes allowed for appid sessions before they are pruned (0 to disable)" },
+
+    { "http", Parameter::PT_INT, "0:maxSZ", "0",
+        "bytes allowed for http inspection before it is pruned (0 to disable)" },
+
+    { nullptr, Parameter::PT_MAX, nullptr, nullptr, nullptr }
+};
+
 static const Parameter s_params[] =
 {
+    { "arenas", Parameter::PT_BOOL, nullptr, "false",
+        "pin packet threads to dedicated heap arenas with separate arenas per subsystem" },
+
+    { "budgets", Parameter::PT_TABLE, s_budget_params, nullptr,
+        "per subsystem memory budgets (requires arenas)" },
+
     { "cap", Parameter::PT_INT, "0:maxSZ", "0",
         "set the process cap on memory in bytes (0 to disable)" },
 
@@ -77,6 +106,11 @@ const PegInfo mem_pegs[] =
     { CountType::NOW, "active", "total bytes allocated in active pages" },
     { CountType::NOW, "resident", "maximum bytes physically resident" },
     { CountType::NOW, "retained", "total bytes not returned to OS" },
+    { CountType::NOW, "flow_bytes", "bytes allocated from flow arenas" },
+    { CountType::NOW, "stream_bytes", "bytes allocated from stream arenas" },
+    { CountType::NOW, "file_bytes", "bytes allocated from file arenas" },
+    { CountType::NOW, "appid_bytes", "bytes allocated from appid arenas" },
+    { CountType::NOW, "http_bytes", "bytes allocated from http arenas" },
 
     { CountType::END, nullptr, nullptr }
 };
@@ -89,9 +123,20 @@ MemoryModule::MemoryModule() :
     Module(s_name, s_help, s_params)
 { }
 
-bool MemoryModule::set(const char*, Value& v, SnortConfig* sc)
+bool MemoryModule::set(const char* fqn, Value& v, SnortConfig* sc)
 {
-    if ( v.is("cap") )
+    if ( !strncmp(fqn, "memory.budgets.", 15) )
+    {
+        for ( unsigned a = 0; a < memory::ARENA_MAX; ++a )
+        {
+            if ( v.is(s_budget_params[a].name) )
+                sc->memory->budgets[a] = v.get_size();
+        }
+    }
+    else if ( v.is("arenas") )
+        sc->memory->arenas = v.get_bool();
+
+    else if ( v.is("cap") )
         sc->memory->cap = v.get_size();
 
     else if ( v.is("interval") )
@@ -61,6 +61,10 @@ void trace_vprintf(const char*, TraceLevel, const char*, const Packet*, const ch
 uint8_t snort::TraceApi::get_constraints_generation() { return 0; }
 // LCOV_EXCL_STOP
 
+static unsigned warnings = 0;
+void WarningMessage(const char*, ...)
+{ ++warnings; }
+
 unsigned get_instance_id()
 { return 0; }
 
@@ -103,11 +107,53 @@ public:
     void get_thread_allocs(uint64_t& a, uint64_t& d) override
     { a = alloc; d = dealloc; }
 
+    bool has_arenas() override
+    { return supported; }
+
+    int create_arena() override
+    { return arenas < max_arenas ? (int)arenas++ : -1; }
+
+    void set_thread_arena(unsigned a) override
+    { thread_arena = a; }
+
+    uint64_t get_arena_allocated(unsigned a) override
+    { return a < max_arenas ? arena_bytes[a] : 0; }
+
+    int create_tcache() override
+    { return (int)tcaches++; }
+
+    void destroy_tcache(int) override
+    { --tcaches; }
+
+    void* allocate(size_t size, unsigned a, int tc) override
+    {
+        alloc_arena = a;
+        alloc_tcache = tc;
+        return ::operator new(size);
+    }
+
+    void deallocate(void* p, size_t, int tc) override
+    {
+        free_tcache = tc;
+        ::operator delete(p);
+    }
+
     uint64_t alloc = 2, dealloc = 1;
     uint64_t epoch = 0, total = 0;
 
     unsigned main_init_calls = 0;
     unsigned thread_init_calls = 0;
+
+    static const unsigned max_arenas = ARENA_MAX + 1;
+    unsigned arenas = 0;
+    unsigned thread_arena = max_arenas;
+    uint64_t arena_bytes[max_arenas] = { };
+
+    bool supported = true;
+    unsigned tcaches = 0;
+    unsigned alloc_arena = max_arenas;
+    int alloc_tcache = -1;
+    int free_tcache = -1;
 };
 
 static void periodic_check()
@@ -537,6 +583,102 @@ TEST(memory, reap_freed_outside_of_pruning)
     MemoryCap::stop();
 }
 
+TEST(memory, arenas)
+{
+    MemoryConfig config { 0, 100, 0, 1, true };
+    config.arenas = true;
+    config.budgets[ARENA_HTTP] = 10;
+
+    MemoryCap::start(config, pruner);
+    MemoryCap::thread_init();
+
+    // one arena per subsystem plus the thread default and a cache per subsystem
+    UNSIGNED_LONGS_EQUAL(ARENA_MAX + 1, heap->arenas);
+    UNSIGNED_LONGS_EQUAL(ARENA_MAX, heap->thread_arena);
+    UNSIGNED_LONGS_EQUAL(ARENA_MAX, heap->tcaches);
+
+    // subsystem allocations name their arena and cache without rebinding the thread
+    void* p = MemoryCap::allocate(ARENA_HTTP, 8);
+    UNSIGNED_LONGS_EQUAL(ARENA_HTTP, heap->alloc_arena);
+    LONGS_EQUAL(ARENA_HTTP, heap->alloc_tcache);
+    UNSIGNED_LONGS_EQUAL(ARENA_MAX, heap->thread_arena);
+
+    MemoryCap::deallocate(ARENA_HTTP, p, 8);
+    LONGS_EQUAL(ARENA_HTTP, heap->free_tcache);
+
+    int* i = arena_new<int>(ARENA_FILE, 3);
+    UNSIGNED_LONGS_EQUAL(ARENA_FILE, heap->alloc_arena);
+    LONGS_EQUAL(3, *i);
+    delete i;
+
+    heap->arena_bytes[ARENA_FLOW] = 5;
+    heap->arena_bytes[ARENA_HTTP] = 11;  // over budget
+    periodic_check();
+
+    // a subsystem over budget triggers a reap cycle even under the cap
+    fd.flows = 2;
+    free_space();
+    UNSIGNED_LONGS_EQUAL(1, fd.flows);
+
+    MemoryCap::update_global_stats();
+    const MemoryCounts& mc = MemoryCap::get_mem_stats();
+    UNSIGNED_LONGS_EQUAL(1, mc.reap_cycles);
+    UNSIGNED_LONGS_EQUAL(5, mc.arena_bytes[ARENA_FLOW]);
+    UNSIGNED_LONGS_EQUAL(11, mc.arena_bytes[ARENA_HTTP]);
+
+    heap->arena_bytes[ARENA_HTTP] = 9;
+    periodic_check();
+
+    fd.flows = 2;
+    free_space();
+    UNSIGNED_LONGS_EQUAL(2, fd.flows);
+
+    MemoryCap::thread_term();
+    UNSIGNED_LONGS_EQUAL(0, heap->tcaches);
+    MemoryCap::stop();
+}
+
+TEST(memory, arenas_unsupported)
+{
+    MemoryConfig config { 0, 100, 0, 1, true };
+    config.arenas = true;
+    heap->arenas = heap->max_arenas;
+
+    MemoryCap::start(config, pruner);
+    MemoryCap::thread_init();
+
+    // no arenas so allocations come from the global heap
+    void* p = MemoryCap::allocate(ARENA_HTTP, 8);
+    UNSIGNED_LONGS_EQUAL(heap->max_arenas, heap->alloc_arena);
+    UNSIGNED_LONGS_EQUAL(heap->max_arenas, heap->thread_arena);
+    UNSIGNED_LONGS_EQUAL(0, heap->tcaches);
+    MemoryCap::deallocate(ARENA_HTTP, p, 8);
+
+    MemoryCap::thread_term();
+    MemoryCap::stop();
+}
+
+TEST(memory, budgets_without_heap_support)
+{
+    MemoryConfig config { 0, 100, 0, 1, true };
+    config.arenas = true;
+    config.budgets[ARENA_FLOW] = 10;
+    heap->supported = false;
+
+    // warn once, not on every reload
+    unsigned prior = warnings;
+    MemoryCap::start(config, pruner);
+    UNSIGNED_LONGS_EQUAL(prior + 1, warnings);
+    MemoryCap::start(config, pruner);
+    UNSIGNED_LONGS_EQUAL(prior + 1, warnings);
+
+    MemoryCap::thread_init();
+    UNSIGNED_LONGS_EQUAL(0, heap->arenas);
+
+    MemoryCap::thread_term();
+    MemoryCap::stop();
+}
+
 //-------------------------------------------------------------------------
 // main
 //-------------------------------------------------------------------------
@@ -24,8 +24,13 @@
 
 #include "decode_qp.h"
 
+#include <algorithm>
 #include <cctype>
-#include <cstdlib>
+#include <cstring>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 #include "utils/util_unfold.h"
 
@@ -99,6 +104,44 @@ QPDecode::~QPDecode()
         delete buffer;
 }
 
+// Returns the length of the leading run of bytes that are copied as is:
+// printable characters other than '=' along with tab, CR, and LF. Only full
+// 16 byte blocks are checked; the byte loop takes care of the rest.
+static inline uint32_t plain_run(const char* src, uint32_t len)
+{
+    uint32_t k = 0;
+#ifdef __SSE2__
+    const __m128i space = _mm_set1_epi8(' ' - 1);
+    const __m128i del = _mm_set1_epi8(0x7F);
+    const __m128i equal = _mm_set1_epi8('=');
+    const __m128i tab = _mm_set1_epi8('\t');
+    const __m128i cr = _mm_set1_epi8('\r');
+    const __m128i lf = _mm_set1_epi8('\n');
+
+    for (; k + 16 <= len; k += 16)
+    {
+        const __m128i c = _mm_loadu_si128((const __m128i*)(src + k));
+        const __m128i print = _mm_and_si128(_mm_cmpgt_epi8(c, space), _mm_cmplt_epi8(c, del));
+        const __m128i ctl = _mm_or_si128(_mm_cmpeq_epi8(c, tab),
+            _mm_or_si128(_mm_cmpeq_epi8(c, cr), _mm_cmpeq_epi8(c, lf)));
+        const __m128i plain = _mm_or_si128(_mm_andnot_si128(_mm_cmpeq_epi8(c, equal), print), ctl);
+        const unsigned mask = _mm_movemask_epi8(plain);
+
+        if (mask != 0xFFFF)
+            return k + __builtin_ctz(~mask);
+    }
+#else
+    UNUSED(src);
+    UNUSED(len);
+#endif
+    return k;
+}
+
+static inline char hex_value(char c)
+{
+    return (c <= '9') ? (c - '0') : ((c | 0x20) - 'a' + 10);
+}
+
 int sf_qpdecode(const char* src, uint32_t slen, char* dst, uint32_t dlen, uint32_t* bytes_read,
     uint32_t* bytes_copied)
 {
@@ -110,6 +153,17 @@ int sf_qpdecode(const char* src, uint32_t slen, char* dst, uint32_t dlen, uint32
 
     while ( (*bytes_read < slen) && (*bytes_copied < dlen))
     {
+        uint32_t run = plain_run(src + *bytes_read,
+            std::min(slen - *bytes_read, dlen - *bytes_copied));
+
+        if ( run )
+        {
+            memcpy(dst + *bytes_copied, src + *bytes_read, run);
+            *bytes_read += run;
+            *bytes_copied += run;
+            continue;
+        }
+
         char ch = src[*bytes_read];
         *bytes_read += 1;
 
@@ -133,16 +187,7 @@ int sf_qpdecode(const char* src, uint32_t slen, char* dst, uint32_t dlen, uint32
                     }
                     if (isxdigit((int)ch1) && isxdigit((int)ch2))
                     {
-                        char hexBuf[3];
-                        char* eptr;
-                        hexBuf[0] = ch1;
-                        hexBuf[1] = ch2;
-                        hexBuf[2] = '\0';
-                        dst[*bytes_copied]= (char)strtoul(hexBuf, &eptr, 16);
-                        if ((*eptr != '\0'))
-                        {
-                            return -1;
-                        }
+                        dst[*bytes_copied] = (char)((hex_value(ch1) << 4) | hex_value(ch2));
                         *bytes_read += 2;
                         *bytes_copied +=1;
                         continue;
@@ -0,0 +1,284 @@
+//--------------------------------------------------------------------------
+// Copyright (C) 2026 Cisco and/or its affiliates. All rights reserved.
+//
+// This program is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License Version 2 as published
+// by the Free Software Foundation.  You may not use, modify or distribute
+// this program under any other version of the GNU General Public License.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+//--------------------------------------------------------------------------
+// decode_reference.h author Cisco
+
+#ifndef DECODE_REFERENCE_H
+#define DECODE_REFERENCE_H
+
+// The byte-at-a-time MIME decoding loops the vectorized versions replaced.
+// The tests check that both produce the same output and the benchmark
+// compares their throughput.
+
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+
+extern uint8_t sf_decode64tab[256];
+
+namespace reference
+{
+inline int sf_base64decode(uint8_t* inbuf, uint32_t inbuf_size, uint8_t* outbuf, uint32_t outbuf_size,
+    uint32_t* bytes_written)
+{
+    uint8_t* cursor, * endofinbuf;
+    uint8_t* outbuf_ptr;
+    uint8_t base64data[4], * base64data_ptr; /* temporary holder for current base64 chunk */
+    uint8_t tableval_a, tableval_b, tableval_c, tableval_d;
+
+    uint32_t n;
+    uint32_t max_base64_chars; /* The max number of decoded base64 chars that fit into outbuf */
+
+    int error = 0;
+
+    /* This algorithm will waste up to 4 bytes but we really don't care.
+       At the end we're going to copy the exact number of bytes requested. */
+    max_base64_chars = (outbuf_size / 3) * 4 + 4; /* 4 base64 bytes gives 3 data bytes, plus
+                                                    an extra 4 to take care of any rounding */
+
+    base64data_ptr = base64data;
+    endofinbuf = inbuf + inbuf_size;
+
+    /* Strip non-base64 chars from inbuf and decode */
+    n = 0;
+    *bytes_written = 0;
+    cursor = inbuf;
+    outbuf_ptr = outbuf;
+    while ((cursor < endofinbuf) && (n < max_base64_chars))
+    {
+        if (sf_decode64tab[*cursor] != 100)
+        {
+            *base64data_ptr++ = *cursor;
+            n++; /* Number of base64 bytes we've stored */
+            if (!(n % 4))
+            {
+                /* We have four databytes upon which to operate */
+
+                if ((base64data[0] == '=') || (base64data[1] == '='))
+                {
+                    /* Error in input data */
+                    error = 1;
+                    break;
+                }
+
+                /* retrieve values from lookup table */
+                tableval_a = sf_decode64tab[base64data[0]];
+                tableval_b = sf_decode64tab[base64data[1]];
+                tableval_c = sf_decode64tab[base64data[2]];
+                tableval_d = sf_decode64tab[base64data[3]];
+
+                if (*bytes_written < outbuf_size)
+                {
+                    *outbuf_ptr++ = (tableval_a << 2) | (tableval_b >> 4);
+                    (*bytes_written)++;
+                }
+
+                if ((base64data[2] != '=') && (*bytes_written < outbuf_size))
+                {
+                    *outbuf_ptr++ = (tableval_b << 4) | (tableval_c >> 2);
+                    (*bytes_written)++;
+                }
+                else
+                {
+                    break;
+                }
+
+                if ((base64data[3] != '=') && (*bytes_written < outbuf_size))
+                {
+                    *outbuf_ptr++ = (tableval_c << 6) | tableval_d;
+                    (*bytes_written)++;
+                }
+                else
+                {
+                    break;
+                }
+
+                /* Reset our decode pointer for the next group of four */
+                base64data_ptr = base64data;
+            }
+        }
+        cursor++;
+    }
+
+    if (error)
+        return(-1);
+    else
+        return(0);
+}
+
+inline int sf_qpdecode(const char* src, uint32_t slen, char* dst, uint32_t dlen, uint32_t* bytes_read,
+    uint32_t* bytes_copied)
+{
+    if (!src || !slen || !dst || !dlen || !bytes_read || !bytes_copied )
+        return -1;
+
+    *bytes_read = 0;
+    *bytes_copied = 0;
+
+    while ( (*bytes_read < slen) && (*bytes_copied < dlen))
+    {
+        char ch = src[*bytes_read];
+        *bytes_read += 1;
+
+        if ( ch == '=' )
+        {
+            if ( (*bytes_read < slen))
+            {
+                if (src[*bytes_read] == '\n')
+                {
+                    *bytes_read += 1;
+                    continue;
+                }
+                else if ( *bytes_read < (slen - 1) )
+                {
+                    char ch1 = src[*bytes_read];
+                    char ch2 = src[*bytes_read + 1];
+                    if ( ch1 == '\r' && ch2 == '\n')
+                    {
+                        *bytes_read += 2;
+                        continue;
+                    }
+                    if (isxdigit((int)ch1) && isxdigit((int)ch2))
+                    {
+                        char hexBuf[3];
+                        char* eptr;
+                        hexBuf[0] = ch1;
+                        hexBuf[1] = ch2;
+                        hexBuf[2] = '\0';
+                        dst[*bytes_copied]= (char)strtoul(hexBuf, &eptr, 16);
+                        if ((*eptr != '\0'))
+                        {
+                            return -1;
+                        }
+                        *bytes_read += 2;
+                        *bytes_copied +=1;
+                        continue;
+                    }
+                    dst[*bytes_copied] = ch;
+                    *bytes_copied +=1;
+                    continue;
+                }
+                else
+                {
+                    *bytes_read -= 1;
+                    return 0;
+                }
+            }
+            else
+            {
+                *bytes_read -= 1;
+                return 0;
+            }
+        }
+        else if ( isprint(ch) || isblank(ch) || ch == '\r' || ch == '\n' )
+        {
+            dst[*bytes_copied] = ch;
+            *bytes_copied +=1;
+        }
+    }
+
+    return 0;
+}
+
+/* Strips the CRLF from the input buffer */
+
+inline int sf_strip_CRLF(const uint8_t* inbuf, uint32_t inbuf_size, uint8_t* outbuf,
+    uint32_t outbuf_size, uint32_t* output_bytes)
+{
+    const uint8_t* cursor, * endofinbuf;
+    uint8_t* outbuf_ptr;
+    uint32_t n = 0;
+
+    if ( !inbuf || !outbuf)
+        return -1;
+
+    cursor = inbuf;
+    endofinbuf = inbuf + inbuf_size;
+    outbuf_ptr = outbuf;
+    while ((cursor < endofinbuf) && (n < outbuf_size))
+    {
+        if ((*cursor != '\n') && (*cursor != '\r'))
+        {
+            *outbuf_ptr++ = *cursor;
+            n++;
+        }
+        cursor++;
+    }
+
+    if (output_bytes)
+        *output_bytes = outbuf_ptr - outbuf;
+
+    return(0);
+}
+
+/* Strips the LWS at the end of line.
+ * Only strips the LWS before LF or CRLF
+ */
+
+inline int sf_strip_LWS(const uint8_t* inbuf, uint32_t inbuf_size, uint8_t* outbuf,
+    uint32_t outbuf_size, uint32_t* output_bytes)
+{
+    const uint8_t* cursor, * endofinbuf;
+    uint8_t* outbuf_ptr;
+    uint32_t n = 0;
+    uint8_t lws = 0;
+
+    if ( !inbuf || !outbuf)
+        return -1;
+
+    cursor = inbuf;
+    endofinbuf = inbuf + inbuf_size;
+    outbuf_ptr = outbuf;
+    while ((cursor < endofinbuf) && (n < outbuf_size))
+    {
+        if ((*cursor != '\n') && (*cursor != '\r'))
+        {
+            if ((*cursor != ' ') && (*cursor != '\t'))
+                lws = 0;
+            else
+                lws = 1;
+            *outbuf_ptr++ = *cursor;
+            n++;
+        }
+        else
+        {
+            if (lws)
+            {
+                lws = 0;
+                while ( n > 0 )
+                {
+                    if ((*(outbuf_ptr-1) != ' ') && (*(outbuf_ptr-1) !='\t'))
+                        break;
+                    n--;
+                    outbuf_ptr--;
+                }
+            }
+
+            *outbuf_ptr++ = *cursor;
+            n++;
+        }
+        cursor++;
+    }
+
+    if (output_bytes)
+        *output_bytes = outbuf_ptr - outbuf;
+
+    return(0);
+}
+}
+
+#endif
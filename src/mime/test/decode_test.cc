@@ -0,0 +1,202 @@
+//--------------------------------------------------------------------------
+// Copyright (C) 2026 Cisco and/or its affiliates. All rights reserved.
+//
+// This program is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License Version 2 as published
+// by the Free Software Foundation.  You may not use, modify or distribute
+// this program under any other version of the GNU General Public License.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+//--------------------------------------------------------------------------
+// decode_test.cc author Cisco
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "catch/catch.hpp"
+
+#include "mime/decode_b64.h"
+#include "mime/decode_qp.h"
+#include "utils/util_unfold.h"
+
+#include "decode_reference.h"
+
+using namespace snort;
+
+static std::string b64(const std::string& in, uint32_t out_size = 1024)
+{
+    std::vector<uint8_t> out(out_size);
+    uint32_t n = 0;
+    REQUIRE(sf_base64decode((uint8_t*)in.data(), in.size(), out.data(), out_size, &n) == 0);
+    return std::string((const char*)out.data(), n);
+}
+
+static std::string qp(const std::string& in, uint32_t* read = nullptr)
+{
+    std::vector<char> out(in.size() + 1);
+    uint32_t n = 0, r = 0;
+    REQUIRE(sf_qpdecode(in.data(), in.size(), out.data(), out.size(), &r, &n) == 0);
+    if (read)
+        *read = r;
+    return std::string(out.data(), n);
+}
+
+// random text with the characters each decoder cares about over-represented
+static std::string noise(std::mt19937& rng, size_t len, const std::string& alphabet)
+{
+    std::string s;
+    for (size_t i = 0; i < len; ++i)
+    {
+        unsigned r = rng() % 100;
+        if (r < 85)
+            s += alphabet[rng() % alphabet.size()];
+        else if (r < 92)
+            s += "\r\n=\t "[rng() % 5];
+        else
+            s += (char)(rng() & 0xFF);
+    }
+    return s;
+}
+
+static const std::string b64_alphabet =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+TEST_CASE("base64 vectors", "[mime_decode]")
+{
+    CHECK(b64("") == "");
+    CHECK(b64("Zg==") == "f");
+    CHECK(b64("Zm8=") == "fo");
+    CHECK(b64("Zm9v") == "foo");
+    CHECK(b64("Zm9vYmFy") == "foobar");
+    CHECK(b64("VGhlIHF1aWNrIGJyb3duIGZveCBqdW1wcw==") == "The quick brown fox jumps");
+    CHECK(b64("VGhlIHF1aWNr\r\nIGJyb3duIGZv\r\neCBqdW1wcw==") == "The quick brown fox jumps");
+    CHECK(b64("VGhlIHF1aWNrIGJyb3duIGZveCBqdW1wcw==", 7) == "The qui");
+
+    uint8_t out[16];
+    uint32_t n;
+    CHECK(sf_base64decode((uint8_t*)"=AAA", 4, out, sizeof(out), &n) == -1);
+}
+
+TEST_CASE("base64 matches reference", "[mime_decode]")
+{
+    std::mt19937 rng(39);
+
+    for (unsigned i = 0; i < 2000; ++i)
+    {
+        std::string in = noise(rng, rng() % 300, b64_alphabet);
+        uint32_t out_size = 1 + rng() % 256;
+        std::vector<uint8_t> a(out_size + 16), b(out_size + 16);
+        uint32_t na = 0, nb = 0;
+
+        int ra = sf_base64decode((uint8_t*)in.data(), in.size(), a.data(), out_size, &na);
+        int rb = reference::sf_base64decode((uint8_t*)in.data(), in.size(), b.data(), out_size, &nb);
+
+        REQUIRE(ra == rb);
+        REQUIRE(na == nb);
+        REQUIRE(memcmp(a.data(), b.data(), na) == 0);
+    }
+}
+
+TEST_CASE("quoted printable vectors", "[mime_decode]")
+{
+    uint32_t read;
+
+    CHECK(qp("plain text") == "plain text");
+    CHECK(qp("caf=C3=A9 na=c3=afve") == "caf\xc3\xa9 na\xc3\xafve");
+    CHECK(qp("soft=\r\nbreak=\nhere") == "softbreakhere");
+    CHECK(qp("a=zz") == "a=zz");
+    CHECK(qp("split=4", &read) == "split");
+    CHECK(read == 5);
+    CHECK(qp(std::string("drop\x01\x7f\xff me")) == "drop me");
+}
+
+TEST_CASE("quoted printable matches reference", "[mime_decode]")
+{
+    std::mt19937 rng(40);
+    const std::string alphabet = "The quick brown fox=3D=0A=C3=A9 jumps over the lazy dog.";
+
+    for (unsigned i = 0; i < 2000; ++i)
+    {
+        std::string in = noise(rng, 1 + rng() % 300, alphabet);
+        uint32_t out_size = 1 + rng() % 320;
+        std::vector<char> a(out_size), b(out_size);
+        uint32_t ra = 0, rb = 0, na = 0, nb = 0;
+
+        int xa = sf_qpdecode(in.data(), in.size(), a.data(), out_size, &ra, &na);
+        int xb = reference::sf_qpdecode(in.data(), in.size(), b.data(), out_size, &rb, &nb);
+
+        REQUIRE(xa == xb);
+        REQUIRE(ra == rb);
+        REQUIRE(na == nb);
+        REQUIRE(memcmp(a.data(), b.data(), na) == 0);
+    }
+}
+
+TEST_CASE("line stripping matches reference", "[mime_decode]")
+{
+    std::mt19937 rng(41);
+    const std::string alphabet = "Subject: some text with  spaces\t\t and tabs ";
+
+    for (unsigned i = 0; i < 2000; ++i)
+    {
+        std::string in = noise(rng, rng() % 300, alphabet);
+        uint32_t out_size = 1 + rng() % 320;
+        std::vector<uint8_t> a(out_size), b(out_size);
+        uint32_t na = 0, nb = 0;
+
+        sf_strip_CRLF((const uint8_t*)in.data(), in.size(), a.data(), out_size, &na);
+        reference::sf_strip_CRLF((const uint8_t*)in.data(), in.size(), b.data(), out_size, &nb);
+        REQUIRE(na == nb);
+        REQUIRE(memcmp(a.data(), b.data(), na) == 0);
+
+        sf_strip_LWS((const uint8_t*)in.data(), in.size(), a.data(), out_size, &na);
+        reference::sf_strip_LWS((const uint8_t*)in.data(), in.size(), b.data(), out_size, &nb);
+        REQUIRE(na == nb);
+        REQUIRE(memcmp(a.data(), b.data(), na) == 0);
+    }
+}
+
+TEST_CASE("base64 attachment split across segments", "[mime_decode]")
+{
+    std::string text;
+    for (unsigned i = 0; i < 200; ++i)
+        text += (char)('a' + i % 26);
+
+    std::string body = "YWJjZGVmZ2hpamtsbW5vcHFyc3R1dnd4eXphYmNkZWZnaGlqa2xtbm9wcXJzdHV2d3h5emFi\r\n"
+        "Y2RlZmdoaWprbG1ub3BxcnN0dXZ3eHl6YWJjZGVmZ2hpamtsbW5vcHFyc3R1dnd4eXphYmNk\r\n"
+        "ZWZnaGlqa2xtbm9wcXJzdHV2d3h5emFiY2RlZmdoaWprbG1ub3BxcnN0dXZ3eHl6YWJjZGVm\r\n"
+        "Z2hpamtsbW5vcHFyc3R1dnd4eXphYmNkZWZnaGlqa2xtbm9wcXI=\r\n";
+
+    for (size_t seg : { 7, 64, 500 })
+    {
+        B64Decode decoder(0, 0);
+        std::vector<uint8_t> decode_buf(65535);
+        std::string out;
+
+        for (size_t off = 0; off < body.size(); off += seg)
+        {
+            const uint8_t* start = (const uint8_t*)body.data() + off;
+            const uint8_t* end = start + std::min(seg, body.size() - off);
+            REQUIRE(decoder.decode_data(start, end, decode_buf.data()) == DECODE_SUCCESS);
+
+            const uint8_t* buf;
+            uint32_t size;
+            if (decoder.get_decoded_data(&buf, &size))
+                out.append((const char*)buf, size);
+        }
+        CHECK(out == text);
+    }
+}
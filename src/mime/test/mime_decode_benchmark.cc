@@ -0,0 +1,125 @@
+//--------------------------------------------------------------------------
+// Copyright (C) 2026 Cisco and/or its affiliates. All rights reserved.
+//
+// This program is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License Version 2 as published
+// by the Free Software Foundation.  You may not use, modify or distribute
+// this program under any other version of the GNU General Public License.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+//--------------------------------------------------------------------------
+// mime_decode_benchmark.cc author Cisco
+
+#ifdef BENCHMARK_TEST
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "catch/catch.hpp"
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "mime/decode_b64.h"
+#include "mime/decode_qp.h"
+#include "utils/util_unfold.h"
+
+#include "decode_reference.h"
+
+using namespace snort;
+
+// Decodes a 64K attachment the way the MIME stage does: strip line breaks,
+// then decode. Base64 is wrapped at 76 characters per RFC 2045 and the
+// quoted-printable body is mostly plain text with occasional escapes.
+
+static std::string make_b64_body(size_t size)
+{
+    static const char* alphabet =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::mt19937 rng(39);
+    std::string body;
+
+    for (size_t i = 0; i < size; ++i)
+    {
+        body += alphabet[rng() % 64];
+        if (i % 76 == 75)
+            body += "\r\n";
+    }
+    return body;
+}
+
+static std::string make_qp_body(size_t size)
+{
+    static const char* text = "Lorem ipsum dolor sit amet, consectetur adipiscing elit caf=C3=A9";
+    std::string body;
+    size_t col = 0;
+
+    for (size_t i = 0; body.size() < size; ++i)
+    {
+        body += text[i % 66];
+        if (++col == 75)
+        {
+            body += "=\r\n";
+            col = 0;
+        }
+    }
+    return body;
+}
+
+TEST_CASE("mime base64 attachment", "[mime_decode]")
+{
+    std::string body = make_b64_body(65536);
+    std::vector<uint8_t> stripped(body.size()), out(body.size());
+    uint32_t n, m;
+
+    BENCHMARK("reference")
+    {
+        reference::sf_strip_CRLF((const uint8_t*)body.data(), body.size(),
+            stripped.data(), stripped.size(), &n);
+        reference::sf_base64decode(stripped.data(), n, out.data(), out.size(), &m);
+        return m;
+    };
+
+    BENCHMARK("vectorized")
+    {
+        sf_strip_CRLF((const uint8_t*)body.data(), body.size(),
+            stripped.data(), stripped.size(), &n);
+        sf_base64decode(stripped.data(), n, out.data(), out.size(), &m);
+        return m;
+    };
+}
+
+TEST_CASE("mime quoted-printable body", "[mime_decode]")
+{
+    std::string body = make_qp_body(65536);
+    std::vector<uint8_t> stripped(body.size());
+    std::vector<char> out(body.size());
+    uint32_t n, r, m;
+
+    BENCHMARK("reference")
+    {
+        reference::sf_strip_LWS((const uint8_t*)body.data(), body.size(),
+            stripped.data(), stripped.size(), &n);
+        reference::sf_qpdecode((const char*)stripped.data(), n, out.data(), out.size(), &r, &m);
+        return m;
+    };
+
+    BENCHMARK("vectorized")
+    {
+        sf_strip_LWS((const uint8_t*)body.data(), body.size(),
+            stripped.data(), stripped.size(), &n);
+        sf_qpdecode((const char*)stripped.data(), n, out.data(), out.size(), &r, &m);
+        return m;
+    };
+}
+
+#endif
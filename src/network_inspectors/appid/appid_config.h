@@ -350,6 +350,18 @@ public:
         return lua_detector_mgr->get_cb_detector(app_id);
     }
 
+    LuaObject* get_lua_object(const AppIdDetector* detector) const
+    {
+        assert(lua_detector_mgr);
+        return lua_detector_mgr->get_lua_object(detector);
+    }
+
+    void flush_lua_validate_time(AppidCPUProfilingManager& profiler_mgr)
+    {
+        assert(lua_detector_mgr);
+        lua_detector_mgr->flush_validate_time(profiler_mgr);
+    }
+
 protected:
     std::shared_ptr<LuaDetectorManager> lua_detector_mgr;
 };
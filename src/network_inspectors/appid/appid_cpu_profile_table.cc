@@ -41,6 +41,10 @@ using namespace snort;
 static const char* columns = " AppId   App Name                   Usecs       Pkts     AvgUsecs/Pkt     Sessions     AvgUsecs/Sess     MaxPkts/Sess     MaxUsecs/Sess     %%/Total\n";
 static const char* partition = "---------------------------------------------------------------------------------------------------------------------------------------------------\n";
 
+#define LUA_TABLE_HEADER(num_rows) "Lua Detector Validate Statistics (top %d detectors)\n====================================================================================\n", num_rows
+static const char* lua_columns = " Detector                                         Usecs        Calls   AvgUsecs/Call\n";
+static const char* lua_partition = "------------------------------------------------------------------------------------\n";
+
 static std::string FormatWithCommas(uint64_t value)
 {
     std::string numStr = std::to_string(value);
@@ -140,6 +144,8 @@ AppidCpuTableDisplayStatus AppidCPUProfilingManager::display_appid_cpu_profiler_
     if (ctrlcon)
         output_type = OUTPUT_CONSOLE;
 
+    uint32_t lua_display_rows_limit = std::min(display_rows_limit,
+        static_cast<uint32_t>(APPID_CPU_PROFILER_MAX_DISPLAY_ROWS));
     display_rows_limit = static_cast<uint32_t>(std::min({static_cast<size_t>(display_rows_limit), sorted_appid_cpu_profiler_table.size(), static_cast<size_t>(APPID_CPU_PROFILER_MAX_DISPLAY_ROWS)}));
     print_log(ctrlcon, output_type, TRACE_INFO_LEVEL, TABLE_HEADER(display_rows_limit));
     print_log(ctrlcon, output_type, TRACE_INFO_LEVEL, columns);
@@ -170,13 +176,59 @@ AppidCpuTableDisplayStatus AppidCPUProfilingManager::display_appid_cpu_profiler_
             FormatWithCommas(total_per_appid_sessions).c_str(), FormatWithCommas(total_processing_time/total_per_appid_sessions).c_str(),
             FormatWithCommas(max_processed_pkts_per_session).c_str(), FormatWithCommas(max_processing_time_per_session).c_str(), 100);
 
+    if (!lua_detector_cpu_profiling_table.empty())
+        display_lua_detector_cpu_profiler_table(lua_display_rows_limit, output_type, ctrlcon);
+
     return DISPLAY_SUCCESS;
 }
 
+void AppidCPUProfilingManager::display_lua_detector_cpu_profiler_table(uint32_t display_rows_limit,
+    AppidCPUProfilerOutputType output_type, ControlConn* ctrlcon)
+{
+    using Entry = std::pair<std::string, LuaDetectorCPUProfilerStats>;
+    std::vector<Entry> sorted;
+    {
+        std::lock_guard<std::mutex> lock(appid_cpu_profiler_mutex);
+        sorted.assign(lua_detector_cpu_profiling_table.cbegin(), lua_detector_cpu_profiling_table.cend());
+    }
+
+    std::sort(sorted.begin(), sorted.end(), [](const Entry& a, const Entry& b)
+        { return a.second.processing_time > b.second.processing_time; });
+
+    display_rows_limit = static_cast<uint32_t>(std::min(static_cast<size_t>(display_rows_limit), sorted.size()));
+    print_log(ctrlcon, output_type, TRACE_INFO_LEVEL, LUA_TABLE_HEADER(display_rows_limit));
+    print_log(ctrlcon, output_type, TRACE_INFO_LEVEL, lua_columns);
+    print_log(ctrlcon, output_type, TRACE_INFO_LEVEL, lua_partition);
+
+    for (uint32_t i = 0; i < display_rows_limit; i++)
+    {
+        const Entry& entry = sorted[i];
+        print_log(ctrlcon, output_type, TRACE_INFO_LEVEL, " %-40.40s   %14.14s %12.12s   %13.13s\n",
+            entry.first.c_str(), FormatWithCommas(entry.second.processing_time).c_str(),
+            FormatWithCommas(entry.second.calls).c_str(),
+            FormatWithCommas(entry.second.processing_time / entry.second.calls).c_str());
+    }
+
+    print_log(ctrlcon, output_type, TRACE_INFO_LEVEL, lua_partition);
+}
+
+void AppidCPUProfilingManager::insert_lua_detector_cpu_profiler_record(const std::string& detector_name,
+    uint64_t processing_time, uint64_t calls)
+{
+    if (!calls)
+        return;
+
+    std::lock_guard<std::mutex> lock(appid_cpu_profiler_mutex);
+    auto& stats = lua_detector_cpu_profiling_table[detector_name];
+    stats.processing_time += processing_time;
+    stats.calls += calls;
+}
+
 void AppidCPUProfilingManager::cleanup_appid_cpu_profiler_table()
 {
     std::lock_guard<std::mutex> lock(appid_cpu_profiler_mutex);
     appid_cpu_profiling_table.clear();
+    lua_detector_cpu_profiling_table.clear();
     total_processing_time = 0;
     total_processed_packets = 0;
     total_per_appid_sessions = 0;
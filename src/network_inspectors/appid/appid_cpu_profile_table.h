@@ -21,6 +21,7 @@
 #ifndef APP_CPU_PROFILE_TABLE_H
 #define APP_CPU_PROFILE_TABLE_H
 
+#include <string>
 #include <unordered_map>
 #include <vector>
 #include <mutex>
@@ -64,10 +65,18 @@ struct AppidCPUProfilerStats {
     { }
 };
 
+// time spent in the validate function of a Lua detector
+struct LuaDetectorCPUProfilerStats {
+    uint64_t processing_time = 0;
+    uint64_t calls = 0;
+};
+
 class AppidCPUProfilingManager {
 private:
     using AppidCPUProfilingTable = std::unordered_map<AppId, AppidCPUProfilerStats>;
+    using LuaDetectorCPUProfilingTable = std::unordered_map<std::string, LuaDetectorCPUProfilerStats>;
     AppidCPUProfilingTable appid_cpu_profiling_table;
+    LuaDetectorCPUProfilingTable lua_detector_cpu_profiling_table;
     std::mutex appid_cpu_profiler_mutex;
     uint64_t total_processing_time = 0;
     uint64_t total_processed_packets = 0;
@@ -83,11 +92,17 @@ public:
     void check_appid_cpu_profiler_table_entry(const AppIdSession* asd, AppId service_id, AppId client_id, AppId payload_id, AppId misc_id);
     void check_appid_cpu_profiler_table_entry(const AppIdSession* asd, AppId payload_id);
     void update_totals(const AppidCPUProfilerStats& stats);
+    void insert_lua_detector_cpu_profiler_record(const std::string& detector_name,
+        uint64_t processing_time, uint64_t calls);
 
     AppidCpuTableDisplayStatus display_appid_cpu_profiler_table(OdpContext&, uint32_t display_rows_limit = APPID_CPU_PROFILER_DEFAULT_DISPLAY_ROWS,
                                                                 bool override_running_flag = false, ControlConn* control_conn = nullptr);
     AppidCpuTableDisplayStatus display_appid_cpu_profiler_table(AppId, OdpContext&, ControlConn* control_conn = nullptr);
 
     void cleanup_appid_cpu_profiler_table();
+
+private:
+    void display_lua_detector_cpu_profiler_table(uint32_t display_rows_limit,
+        AppidCPUProfilerOutputType, ControlConn*);
 };
 #endif
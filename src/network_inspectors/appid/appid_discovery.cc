@@ -159,6 +159,7 @@ void AppIdDiscovery::do_application_discovery(Packet* p, AppIdInspector& inspect
 
     do_post_discovery(p, *asd, is_discovery_done, service_id, client_id, payload_id, misc_id,
         change_bits);
+    asd->free_finished_candidates();
 
     if (is_appid_cpu_profiling_running)
     {
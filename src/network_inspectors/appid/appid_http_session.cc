@@ -190,14 +190,7 @@ bool AppIdHttpSession::initial_chp_sweep(ChpMatchDescriptor& cmd, HttpPatternMat
 {
     CHPApp* cah = nullptr;
 
-    for (unsigned i = 0; i <= MAX_KEY_PATTERN; i++)
-    {
-        if (cmd.buffer[i] and cmd.length[i])
-        {
-            cmd.cur_ptype = (HttpFieldIds)i;
-            http_matchers.scan_key_chp(cmd);
-        }
-    }
+    http_matchers.scan_key_chp(cmd);
 
     if (cmd.match_tally.empty())
     {
@@ -221,6 +221,8 @@ void AppIdInspector::tterm()
     AppIdStatistics::cleanup();
     AppIdDiscovery::tterm();
     assert(odp_thread_local_ctxt);
+    odp_thread_local_ctxt->flush_lua_validate_time(
+        pkt_thread_odp_ctxt->get_appid_cpu_profiler_mgr());
     delete odp_thread_local_ctxt;
     odp_thread_local_ctxt = nullptr;
     if (pkt_thread_tp_appid_ctxt)
@@ -228,6 +230,7 @@ void AppIdInspector::tterm()
     if ( snort::HighAvailabilityManager::active() )
         AppIdHAManager::tterm();
     ServiceDiscovery::reset_thread_local_ftp_service();
+    AppIdCandidates::purge();
 }
 
 void AppIdInspector::tear_down(SnortConfig*)
@@ -409,6 +409,57 @@ static void clear_dynamic_host_cache_services()
     }
 }
 
+// Lua detector validate time is kept by each packet thread, so every thread adds
+// what it has to the profiler before the table is shown
+class ACShowCpuProfilerStats : public AnalyzerCommand
+{
+public:
+    bool execute(Analyzer&, void**) override;
+    ACShowCpuProfilerStats(OdpContext& odp_ctxt, AppId appid, int display_rows_limit,
+        ControlConn* conn) : AnalyzerCommand(conn), odp_ctxt(odp_ctxt), appid(appid),
+        display_rows_limit(display_rows_limit)
+    { }
+    ~ACShowCpuProfilerStats() override;
+    const char* stringify() override { return "SHOW_CPU_PROFILER_STATS"; }
+private:
+    OdpContext& odp_ctxt;
+    AppId appid;
+    int display_rows_limit;
+};
+
+bool ACShowCpuProfilerStats::execute(Analyzer&, void**)
+{
+    if (odp_thread_local_ctxt and pkt_thread_odp_ctxt == &odp_ctxt)
+        odp_thread_local_ctxt->flush_lua_validate_time(odp_ctxt.get_appid_cpu_profiler_mgr());
+    return true;
+}
+
+ACShowCpuProfilerStats::~ACShowCpuProfilerStats()
+{
+    AppidCpuTableDisplayStatus displayed = DISPLAY_SUCCESS;
+    ctrlcon->respond("== showing appid cpu profiler table\n");
+    if (!appid)
+    {
+        if (display_rows_limit > APPID_CPU_PROFILER_MAX_DISPLAY_ROWS)
+            ctrlcon->respond("given number of rows exceeds maximum limit of %d, limiting to %d\n",
+                                               APPID_CPU_PROFILER_MAX_DISPLAY_ROWS, APPID_CPU_PROFILER_MAX_DISPLAY_ROWS);
+        displayed = odp_ctxt.get_appid_cpu_profiler_mgr().display_appid_cpu_profiler_table(odp_ctxt, display_rows_limit, false, ctrlcon);
+    }
+    else
+        displayed = odp_ctxt.get_appid_cpu_profiler_mgr().display_appid_cpu_profiler_table(appid, odp_ctxt, ctrlcon);
+
+    switch (displayed){
+        case DISPLAY_ERROR_TABLE_EMPTY:
+            ctrlcon->respond("== appid cpu profiler table is empty\n");
+            break;
+        case DISPLAY_ERROR_APPID_PROFILER_RUNNING:
+            ctrlcon->respond("== appid cpu profiler is still running\n");
+            break;
+        case DISPLAY_SUCCESS:
+            break;
+    }
+}
+
 static int show_cpu_profiler_stats(lua_State* L)
 {
     int appid = luaL_optint(L, 1, 0);
@@ -425,30 +476,8 @@ static int show_cpu_profiler_stats(lua_State* L)
     OdpContext& odp_ctxt = ctxt.get_odp_ctxt(); 
 
     if (odp_ctxt.is_appid_cpu_profiler_enabled())
-    {
-        AppidCpuTableDisplayStatus displayed = DISPLAY_SUCCESS;
-        ctrlcon->respond("== showing appid cpu profiler table\n");
-        if (!appid)
-        {
-            if (display_rows_limit > APPID_CPU_PROFILER_MAX_DISPLAY_ROWS)
-                ctrlcon->respond("given number of rows exceeds maximum limit of %d, limiting to %d\n",
-                                                   APPID_CPU_PROFILER_MAX_DISPLAY_ROWS, APPID_CPU_PROFILER_MAX_DISPLAY_ROWS);
-            displayed = odp_ctxt.get_appid_cpu_profiler_mgr().display_appid_cpu_profiler_table(odp_ctxt, display_rows_limit, false, ctrlcon);
-        }
-        else
-            displayed = odp_ctxt.get_appid_cpu_profiler_mgr().display_appid_cpu_profiler_table(appid, odp_ctxt, ctrlcon);
-
-        switch (displayed){
-            case DISPLAY_ERROR_TABLE_EMPTY:
-                ctrlcon->respond("== appid cpu profiler table is empty\n");
-                break;
-            case DISPLAY_ERROR_APPID_PROFILER_RUNNING:
-                ctrlcon->respond("== appid cpu profiler is still running\n");
-                break;
-            case DISPLAY_SUCCESS:
-                break;
-        }
-    }
+        main_broadcast_command(new ACShowCpuProfilerStats(odp_ctxt, appid, display_rows_limit,
+            ctrlcon), ctrlcon);
     else
         ctrlcon->respond("appid cpu profiler is disabled\n");
         
@@ -587,6 +616,8 @@ static const PegInfo appid_pegs[] =
     { CountType::SUM, "tp_reload_ignored_pkts", "count of packets ignored after third-party module is reloaded" },
     { CountType::NOW, "bytes_in_use", "number of bytes in use in the cache" },
     { CountType::NOW, "items_in_use", "items in use in the cache" },
+    { CountType::NOW, "sessions_in_use", "number of AppId sessions currently allocated" },
+    { CountType::NOW, "session_bytes_in_use", "bytes held by AppId sessions and their detector candidate lists" },
     { CountType::END, nullptr, nullptr },
 };
 
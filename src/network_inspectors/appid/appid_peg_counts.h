@@ -52,6 +52,8 @@ struct AppIdStats
     PegCount tp_reload_ignored_pkts;
     PegCount bytes_in_use;
     PegCount items_in_use;
+    PegCount sessions_in_use;
+    PegCount session_bytes_in_use;
 };
 
 class AppIdPegCounts
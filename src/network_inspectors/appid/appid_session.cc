@@ -30,6 +30,7 @@
 #include "flow/flow_stash.h"
 #include "main/snort_config.h"
 #include "managers/inspector_manager.h"
+#include "memory/memory_cap.h"
 #include "profiler/profiler.h"
 #include "protocols/packet.h"
 #include "protocols/tcp.h"
@@ -116,7 +117,8 @@ AppIdSession* AppIdSession::allocate_session(const Packet* p, IpProtocol proto,
         (p->ptrs.sp != p->ptrs.dp))
         port = (direction == APP_ID_FROM_INITIATOR) ? p->ptrs.sp : p->ptrs.dp;
 
-    AppIdSession* asd = new AppIdSession(proto, ip, port, inspector, odp_context,
+    AppIdSession* asd = memory::arena_new<AppIdSession>(memory::ARENA_APPID,
+        proto, ip, port, inspector, odp_context,
         p->pkth->address_space_id
 #ifndef DISABLE_TENANT_ID
         ,p->pkth->tenant_id
@@ -151,6 +153,8 @@ AppIdSession::AppIdSession(IpProtocol proto, const SfIp* ip, uint16_t port,
         tp_appid_ctxt(pkt_thread_tp_appid_ctxt)
 {
     appid_stats.total_sessions++;
+    appid_stats.sessions_in_use++;
+    appid_stats.session_bytes_in_use += sizeof(AppIdSession);
 }
 
 AppIdSession::~AppIdSession()
@@ -204,8 +208,10 @@ AppIdSession::~AppIdSession()
 
     delete tsession;
     free_flow_data();
-    service_candidates.clear();
-    client_candidates.clear();
+    free_candidates();
+
+    appid_stats.sessions_in_use--;
+    appid_stats.session_bytes_in_use -= sizeof(AppIdSession);
 
     // If api was not stored in the stash, delete it. An example would be when an appid future
     // session is created, but it doesn't get attached to a snort flow (because the packets for the
@@ -475,7 +481,8 @@ void AppIdSession::check_tunnel_detection_restart()
     client_inferred_service_id = APP_ID_NONE;
     client_disco_state = APPID_DISCO_STATE_NONE;
     free_flow_data_by_mask(APPID_SESSION_DATA_CLIENT_MODSTATE_BIT);
-    client_candidates.clear();
+    if (candidates)
+        candidates->clients.clear();
 
     init_tpPackets = 0;
     resp_tpPackets = 0;
@@ -797,50 +804,46 @@ void AppIdSession::delete_session_data()
 
 int AppIdSession::add_flow_data(AppIdFlowData* data, unsigned id)
 {
-    auto it = flow_data.find(id);
-    if (it != flow_data.end())
-        return -1;
+    for (const auto& fd : flow_data)
+        if (fd.first == id)
+            return -1;
 
-    flow_data[id] = data;
+    flow_data.emplace_back(id, data);
     return 0;
 }
 
 AppIdFlowData* AppIdSession::get_flow_data(unsigned id) const
 {
-    auto it = flow_data.find(id);
-    if (it != flow_data.end())
-    {
-        assert(id == it->first);
-        return it->second;
-    }
-    else
-        return nullptr;
+    for (const auto& fd : flow_data)
+        if (fd.first == id)
+            return fd.second;
+
+    return nullptr;
 }
 
 void AppIdSession::free_flow_data()
 {
-    std::for_each(std::cbegin(flow_data), std::cend(flow_data),
-        [](const std::pair<unsigned, AppIdFlowData*>& p)
-        {
-            delete p.second;
-        });
+    for (const auto& fd : flow_data)
+        delete fd.second;
     flow_data.clear();
 }
 
 void AppIdSession::free_flow_data_by_id(unsigned id)
 {
-    auto it = flow_data.find(id);
-    if (it != flow_data.end())
+    for (auto it = flow_data.begin(); it != flow_data.end(); ++it)
     {
-        assert(id == it->first);
-        delete it->second;
-        flow_data.erase(it);
+        if (it->first == id)
+        {
+            delete it->second;
+            flow_data.erase(it);
+            return;
+        }
     }
 }
 
 void AppIdSession::free_flow_data_by_mask(unsigned mask)
 {
-    for (auto it = flow_data.cbegin(); it != flow_data.cend();)
+    for (auto it = flow_data.begin(); it != flow_data.end();)
     {
         if (!mask or (it->first & mask))
         {
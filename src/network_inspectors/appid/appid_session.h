@@ -27,10 +27,12 @@
 #include <string>
 #include <tuple>
 #include <unordered_map>
+#include <vector>
 
 #include <daq_common.h>
 #include "flow/flow_data.h"
 #include "pub_sub/appid_events.h"
+#include "utils/free_list_pool.h"
 
 #include "app_info_table.h"
 #include "appid_api.h"
@@ -246,6 +248,38 @@ private:
     MatchedTlsType matched_tls_type = MATCHED_TLS_NONE;
 };
 
+// Detector candidates are only needed while service or client discovery is in
+// progress, so they are kept out of the session and recycled per thread.
+struct AppIdCandidates
+{
+    std::vector<ServiceDetector*> services;
+    std::map<std::string, ClientDetector*> clients;
+
+    static AppIdCandidates* acquire()
+    {
+        AppIdCandidates* c = Pool::take();
+        if (!c)
+            c = new AppIdCandidates;
+        appid_stats.session_bytes_in_use += sizeof(AppIdCandidates);
+        return c;
+    }
+
+    static void release(AppIdCandidates* c)
+    {
+        appid_stats.session_bytes_in_use -= sizeof(AppIdCandidates);
+        c->services.clear();
+        c->clients.clear();
+        Pool::give(c);
+    }
+
+    static void purge()
+    { Pool::term(); }
+
+private:
+    static constexpr unsigned MAX_FREE_CANDIDATES = 64;
+    using Pool = snort::FreeListPool<AppIdCandidates, MAX_FREE_CANDIDATES>;
+};
+
 class AppIdSession : public snort::FlowData
 {
 public:
@@ -266,7 +300,8 @@ public:
 
     snort::Flow* flow = nullptr;
     AppIdConfig& config;
-    std::unordered_map<unsigned, AppIdFlowData*> flow_data;
+    // sessions rarely carry more than a couple of detector flow data entries
+    std::vector<std::pair<unsigned, AppIdFlowData*>> flow_data;
     uint64_t flags = 0;
     uint16_t initiator_port = 0;
 #ifndef DISABLE_TENANT_ID
@@ -290,7 +325,6 @@ public:
     APPID_DISCOVERY_STATE service_disco_state = APPID_DISCO_STATE_NONE;
     SESSION_SERVICE_SEARCH_STATE service_search_state = SESSION_SERVICE_SEARCH_STATE::START;
     ServiceDetector* service_detector = nullptr;
-    std::vector<ServiceDetector*> service_candidates;
 
     // Following field is used only for non-http sessions. For HTTP traffic,
     // this field is maintained inside AppIdHttpSession.
@@ -303,7 +337,7 @@ public:
     APPID_DISCOVERY_STATE client_disco_state = APPID_DISCO_STATE_NONE;
     AppId client_inferred_service_id = APP_ID_NONE;
     ClientDetector* client_detector = nullptr;
-    std::map<std::string, ClientDetector*> client_candidates;
+    AppIdCandidates* candidates = nullptr;
     bool tried_reverse_service = false;
 
     TlsSession* tsession = nullptr;
@@ -364,6 +398,43 @@ public:
     void free_flow_data_by_mask(unsigned mask);
     void free_flow_data();
 
+    std::vector<ServiceDetector*>& get_service_candidates()
+    {
+        if (!candidates)
+            candidates = AppIdCandidates::acquire();
+        return candidates->services;
+    }
+
+    std::map<std::string, ClientDetector*>& get_client_candidates()
+    {
+        if (!candidates)
+            candidates = AppIdCandidates::acquire();
+        return candidates->clients;
+    }
+
+    bool has_service_candidates() const
+    { return candidates and !candidates->services.empty(); }
+
+    bool has_client_candidates() const
+    { return candidates and !candidates->clients.empty(); }
+
+    void free_candidates()
+    {
+        if (candidates)
+        {
+            AppIdCandidates::release(candidates);
+            candidates = nullptr;
+        }
+    }
+
+    // Candidates are not consulted again once both sides finished discovery
+    void free_finished_candidates()
+    {
+        if (service_disco_state == APPID_DISCO_STATE_FINISHED and
+            client_disco_state == APPID_DISCO_STATE_FINISHED)
+            free_candidates();
+    }
+
     AppId pick_service_app_id() const;
     // pick_ss_* and set_ss_* methods below are for application protocols that support only a single
     // stream in a flow. They should not be used for HTTP2/HTTP3 sessions which can have multiple
@@ -224,18 +224,22 @@ void ClientDiscovery::create_detector_candidates_list(AppIdSession& asd, Packet*
 {
     ClientAppMatch* match_list;
 
-    if ( !p->dsize || asd.client_detector != nullptr || !asd.client_candidates.empty() )
+    if ( !p->dsize || asd.client_detector != nullptr || asd.has_client_candidates() )
         return;
 
     match_list = find_detector_candidates(p, asd);
-    while ( asd.client_candidates.size() < MAX_CANDIDATE_CLIENTS )
+    if ( !match_list )
+        return;
+
+    auto& candidates = asd.get_client_candidates();
+    while ( candidates.size() < MAX_CANDIDATE_CLIENTS )
     {
         ClientDetector* cd = const_cast<ClientDetector*>(get_next_detector(&match_list));
         if (!cd)
             break;
 
-        if ( asd.client_candidates.find(cd->get_name()) == asd.client_candidates.end() )
-            asd.client_candidates[cd->get_name()] = cd;
+        if ( candidates.find(cd->get_name()) == candidates.end() )
+            candidates[cd->get_name()] = cd;
     }
 
     free_matched_list(&match_list);
@@ -272,9 +276,10 @@ void ClientDiscovery::exec_client_detectors(AppIdSession& asd, Packet* p,
             asd.client_detector->get_log_name().c_str(),
             asd.client_detector->get_code_string((APPID_STATUS_CODE)ret), ret);
     }
-    else
+    else if (asd.has_client_candidates())
     {
-        for ( auto kv = asd.client_candidates.begin(); kv != asd.client_candidates.end(); )
+        auto& candidates = asd.get_client_candidates();
+        for ( auto kv = candidates.begin(); kv != candidates.end(); )
         {
             AppIdDiscoveryArgs disco_args(p->data, p->dsize, direction, asd, p, change_bits);
             int result = kv->second->validate(disco_args);
@@ -285,11 +290,11 @@ void ClientDiscovery::exec_client_detectors(AppIdSession& asd, Packet* p,
             if (result == APPID_SUCCESS)
             {
                 asd.client_detector = kv->second;
-                asd.client_candidates.clear();
+                candidates.clear();
                 break;
             }
             else if (result != APPID_INPROCESS)
-                kv = asd.client_candidates.erase(kv);
+                kv = candidates.erase(kv);
             else
                 ++kv;
         }
@@ -297,12 +302,17 @@ void ClientDiscovery::exec_client_detectors(AppIdSession& asd, Packet* p,
         // At this point, candidates that have survived must have returned
         // either APPID_SUCCESS or APPID_INPROCESS. The others got removed
         // from the candidates list. If the list is empty, say we're done.
-        if (asd.client_candidates.empty())
+        if (candidates.empty())
         {
             ret = APPID_SUCCESS;
             asd.set_client_detected();
         }
     }
+    else
+    {
+        ret = APPID_SUCCESS;
+        asd.set_client_detected();
+    }
 
     if (ret != APPID_INPROCESS)
         asd.client_disco_state = APPID_DISCO_STATE_FINISHED;
@@ -339,7 +349,7 @@ bool ClientDiscovery::do_client_discovery(AppIdSession& asd, Packet* p,
 
     if (asd.client_disco_state == APPID_DISCO_STATE_STATEFUL)
     {
-        if (asd.client_candidates.empty() and tp_app_id > APP_ID_NONE and
+        if (!asd.has_client_candidates() and tp_app_id > APP_ID_NONE and
             asd.is_tp_appid_available())
         {
             // Third party has positively identified appId and we don't have a candidate
@@ -357,7 +367,7 @@ bool ClientDiscovery::do_client_discovery(AppIdSession& asd, Packet* p,
                 asd.client_disco_state = APPID_DISCO_STATE_FINISHED;
             }
         }
-        else if (asd.client_candidates.empty())
+        else if (!asd.has_client_candidates())
         {
             asd.set_client_detected();
             asd.client_disco_state = APPID_DISCO_STATE_FINISHED;
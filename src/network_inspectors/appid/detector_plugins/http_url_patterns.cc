@@ -23,6 +23,7 @@
 #include "config.h"
 #endif
 
+#include <algorithm>
 #include <utility>
 
 #include "http_url_patterns.h"
@@ -586,37 +587,45 @@ static int chp_pattern_match(void* id, void*, int match_end_pos, void* data, voi
     return 0;
 }
 
-static inline void chp_add_candidate_to_tally(CHPMatchTally& match_tally, CHPApp* chpapp)
-{
-    auto it = std::find_if(match_tally.begin(), match_tally.end(),
-        [&chpapp](const CHPMatchCandidate& item){ return chpapp == item.chpapp; });
-    if (it != match_tally.end())
-    {
-        (*it).key_pattern_countdown--;
-        return;
-    }
-
-    match_tally.emplace_back( CHPMatchCandidate{ chpapp, chpapp->key_pattern_length_sum,
-        chpapp->key_pattern_count - 1 } );
-}
-
-// In addition to creating the linked list of matching actions this function will
-// create the CHPMatchTally needed to find the longest matching pattern.
+// In addition to creating the linked list of matching actions this function
+// records the key pattern matches that the tally is built from.
 static int chp_key_pattern_match(void* id, void*, int match_end_pos, void* data, void*)
 {
     ChpMatchDescriptor* cmd = (ChpMatchDescriptor*)data;
     CHPAction* target = (CHPAction*)id;
 
     if (target->key_pattern)
+        cmd->key_matches.emplace_back(target->chpapp, (unsigned)cmd->key_matches.size());
+
+    return chp_pattern_match(id, nullptr, match_end_pos, cmd, nullptr);
+}
+
+// Build the tally used to find the longest matching pattern set. Each app gets
+// one candidate whose countdown reaches zero once all of its key patterns were
+// seen. Candidates keep the order their apps were first matched in. The key
+// matches are sorted in place and consumed.
+void ChpMatchDescriptor::tally_key_matches()
+{
+    std::sort(key_matches.begin(), key_matches.end());
+    match_tally.clear();
+
+    for (auto it = key_matches.cbegin(); it != key_matches.cend(); )
     {
-        // We have a match from a key pattern. We need to have it's parent chpapp represented in
-        // the tally. If the chpapp has never been seen then add an item to the tally's array
-        // else decrement the count of expected key_patterns until zero so that we know when we
-        // have them all.
-        chp_add_candidate_to_tally(cmd->match_tally, target->chpapp);
+        CHPApp* chpapp = it->first;
+        unsigned first = it->second;
+        int count = 0;
+
+        for (; it != key_matches.cend() and it->first == chpapp; ++it)
+            count++;
+
+        match_tally.emplace_back( CHPMatchCandidate{ chpapp, chpapp->key_pattern_length_sum,
+            chpapp->key_pattern_count - count, first } );
     }
+    std::sort(match_tally.begin(), match_tally.end(),
+        [](const CHPMatchCandidate& lhs, const CHPMatchCandidate& rhs)
+        { return lhs.first_match < rhs.first_match; });
 
-    return chp_pattern_match(id, nullptr, match_end_pos, cmd, nullptr);
+    key_matches.clear();
 }
 
 static int http_pattern_match(void* id, void*, int match_end_pos, void* data, void*)
@@ -873,10 +882,20 @@ static void extract_chp(const char* buf, int bs, int start, int psize, char* ada
 
 void HttpPatternMatchers::scan_key_chp(ChpMatchDescriptor& cmd)
 {
-    unsigned i = cmd.cur_ptype;
-    chp_matchers[i].find_all(cmd.buffer[i], cmd.length[i], &chp_key_pattern_match,
-        false, (void*)&cmd);
-    cmd.sort_chp_matches();
+    // each key field has its own matcher; the tally is built once for all of them
+    cmd.key_matches.clear();
+
+    for (unsigned i = 0; i <= MAX_KEY_PATTERN; i++)
+    {
+        if (cmd.buffer[i] and cmd.length[i])
+        {
+            cmd.cur_ptype = (HttpFieldIds)i;
+            chp_matchers[i].find_all(cmd.buffer[i], cmd.length[i],
+                &chp_key_pattern_match, false, (void*)&cmd);
+            cmd.sort_chp_matches();
+        }
+    }
+    cmd.tally_key_matches();
 }
 
 AppId HttpPatternMatchers::scan_chp(ChpMatchDescriptor& cmd, char** version, char** user,
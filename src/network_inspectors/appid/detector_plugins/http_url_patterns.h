@@ -23,6 +23,7 @@
 #define HTTP_URL_PATTERNS_H
 
 #include <list>
+#include <utility>
 #include <vector>
 
 #include "flow/flow.h"
@@ -219,6 +220,7 @@ struct CHPMatchCandidate
     CHPApp* chpapp;
     int key_pattern_length_sum;
     int key_pattern_countdown;
+    unsigned first_match;
 };
 
 typedef std::vector<CHPMatchCandidate> CHPMatchTally;
@@ -231,12 +233,18 @@ public:
         chp_matches[cur_ptype].sort(ChpMatchDescriptor::comp_chp_actions);
     }
 
+    void tally_key_matches();
+
     HttpFieldIds cur_ptype;
     const char* buffer[NUM_HTTP_FIELDS] = { };
     uint16_t length[NUM_HTTP_FIELDS] = { };
     std::list<MatchedCHPAction> chp_matches[NUM_HTTP_FIELDS];
     CHPMatchTally match_tally;
 
+    // app and order of each key pattern match in all key fields, tallied
+    // and cleared after the scan
+    std::vector<std::pair<CHPApp*, unsigned>> key_matches;
+
 private:
     static bool comp_chp_actions( const MatchedCHPAction& lhs, const MatchedCHPAction& rhs)
     {
@@ -111,19 +111,60 @@ TEST(http_url_patterns_tests, match_query_elements)
     CHECK_EQUAL(sizeof(pattern2), match_query_elements(&packetData, &userPattern, appVersion, 10));
 }
 
-TEST(http_url_patterns_tests, chp_add_candidate_to_tally)
+TEST(http_url_patterns_tests, chp_key_pattern_match)
 {
-    CHPMatchTally match_tally;
-    CHPApp chpapp;
-    CHPMatchCandidate chc;
-
-    // verify pattern countdown
-    chc.chpapp = &chpapp;
-    chc.key_pattern_countdown = 1;
-    chc.key_pattern_length_sum = 0;
-    match_tally.emplace_back(chc);
-    chp_add_candidate_to_tally(match_tally, &chpapp);
-    CHECK_EQUAL(match_tally[0].key_pattern_countdown, 0);
+    ChpMatchDescriptor cmd;
+    CHPApp chpapp = { };
+    CHPAction action = { };
+
+    action.ptype = REQ_HOST_FID;
+    action.psize = 2;
+    action.key_pattern = 1;
+    action.chpapp = &chpapp;
+
+    cmd.cur_ptype = REQ_HOST_FID;
+    chp_key_pattern_match(&action, nullptr, 4, &cmd, nullptr);
+    CHECK_EQUAL(1, cmd.chp_matches[REQ_HOST_FID].size());
+    CHECK_EQUAL(2, cmd.chp_matches[REQ_HOST_FID].front().start_match_pos);
+    CHECK_EQUAL(1, cmd.key_matches.size());
+    CHECK(cmd.key_matches[0].first == &chpapp);
+
+    // non-key patterns are matched but not tallied
+    action.key_pattern = 0;
+    chp_key_pattern_match(&action, nullptr, 4, &cmd, nullptr);
+    CHECK_EQUAL(2, cmd.chp_matches[REQ_HOST_FID].size());
+    CHECK_EQUAL(1, cmd.key_matches.size());
+}
+
+TEST(http_url_patterns_tests, tally_key_matches)
+{
+    ChpMatchDescriptor cmd;
+    CHPApp app1 = { };
+    CHPApp app2 = { };
+
+    app1.key_pattern_count = 2;
+    app1.key_pattern_length_sum = 10;
+    app2.key_pattern_count = 1;
+    app2.key_pattern_length_sum = 4;
+
+    // candidates are counted down per app and keep the order of first match
+    cmd.key_matches = { { &app2, 0 }, { &app1, 1 }, { &app2, 2 }, { &app1, 3 } };
+    cmd.tally_key_matches();
+    CHECK(cmd.key_matches.empty());
+    CHECK_EQUAL(2, cmd.match_tally.size());
+    CHECK(cmd.match_tally[0].chpapp == &app2);
+    CHECK_EQUAL(-1, cmd.match_tally[0].key_pattern_countdown);
+    CHECK_EQUAL(4, cmd.match_tally[0].key_pattern_length_sum);
+    CHECK(cmd.match_tally[1].chpapp == &app1);
+    CHECK_EQUAL(0, cmd.match_tally[1].key_pattern_countdown);
+    CHECK_EQUAL(10, cmd.match_tally[1].key_pattern_length_sum);
+
+    // a new tally replaces the prior one
+    cmd.key_matches = { { &app1, 0 } };
+    cmd.tally_key_matches();
+    CHECK_EQUAL(1, cmd.match_tally.size());
+    CHECK(cmd.match_tally[0].chpapp == &app1);
+    CHECK_EQUAL(1, cmd.match_tally[0].key_pattern_countdown);
 }
 
 TEST(http_url_patterns_tests, normalize_userid)
@@ -562,7 +562,7 @@ static int service_set_validator(lua_State* L)
     }
 
     lua_pop(L, 1);
-    ud->lsd.package_info.validateFunctionName = pValidator;
+    ud->lsd.set_validate_function(L, pValidator);
     lua_pushnumber(L, 0);
     return 1;
 }
@@ -3571,6 +3571,13 @@ int register_detector(lua_State* L)
     return 1;                         /* return methods on the stack */
 }
 
+void LuaStateDescriptor::set_validate_function(lua_State* L, const char* name)
+{
+    package_info.validateFunctionName = name;
+    luaL_unref(L, LUA_REGISTRYINDEX, validate_ref);
+    validate_ref = LUA_NOREF;
+}
+
 int LuaStateDescriptor::lua_validate(AppIdDiscoveryArgs& args)
 {
     auto my_lua_state = odp_thread_local_ctxt->get_lua_state();
@@ -3581,35 +3588,63 @@ int LuaStateDescriptor::lua_validate(AppIdDiscoveryArgs& args)
         return APPID_ENULL;
     }
 
-    // get the table for this chunk (env)
-    lua_getfield(my_lua_state, LUA_REGISTRYINDEX, package_info.name.c_str());
+    if (package_info.validateFunctionName.empty())
+        return APPID_NOMATCH;
+
+    OdpContext& odp_ctxt = args.asd.get_odp_ctxt();
+    if (!odp_ctxt.is_appid_cpu_profiler_running())
+        return call_validate(my_lua_state, args);
+
+    Stopwatch<SnortClock> validate_timer;
+    validate_timer.start();
+    int rc = call_validate(my_lua_state, args);
+    validate_timer.stop();
+
+    validate_usecs += TO_USECS(validate_timer.get());
+    ++validate_calls;
+
+    return rc;
+}
+
+void LuaStateDescriptor::flush_validate_time(AppidCPUProfilingManager& profiler_mgr)
+{
+    profiler_mgr.insert_lua_detector_cpu_profiler_record(package_info.name,
+        validate_usecs, validate_calls);
+    validate_usecs = 0;
+    validate_calls = 0;
+}
+
+int LuaStateDescriptor::call_validate(lua_State* L, AppIdDiscoveryArgs& args)
+{
+    if (validate_ref == LUA_NOREF)
+    {
+        // look the function up in the detector's environment once, later calls go
+        // straight to the registry
+        lua_getfield(L, LUA_REGISTRYINDEX, package_info.name.c_str());
+        lua_getfield(L, -1, package_info.validateFunctionName.c_str());
+        validate_ref = luaL_ref(L, LUA_REGISTRYINDEX);
+        lua_settop(L, 0);
+    }
+
     ldp.data = args.data;
     ldp.size = args.size;
     ldp.dir = args.dir;
     ldp.asd = &args.asd;
     ldp.change_bits = &args.change_bits;
     ldp.pkt = args.pkt;
-    const char* validateFn = package_info.validateFunctionName.c_str();
-
-    if ((!validateFn) or (validateFn[0] == '\0'))
-    {
-        ldp.pkt = nullptr;
-        lua_settop(my_lua_state, 0);
-        return APPID_NOMATCH;
-    }
 
-    lua_getfield(my_lua_state, -1, validateFn); // get the function we want to call
+    lua_rawgeti(L, LUA_REGISTRYINDEX, validate_ref);
 
-    if (lua_pcall(my_lua_state, 0, 1, 0))
+    if (lua_pcall(L, 0, 1, 0))
     {
         // Runtime Lua errors are suppressed in production code since detectors are written for
         // efficiency and with defensive minimum checks. Errors are dealt as exceptions
         // that don't impact processing by other detectors or future packets by the same detector.
         APPID_LOG(args.pkt, TRACE_ERROR_LEVEL, "lua detector %s: error validating %s\n",
-            package_info.name.c_str(), lua_tostring(my_lua_state, -1));
+            package_info.name.c_str(), lua_tostring(L, -1));
         ldp.pkt = nullptr;
         odp_thread_local_ctxt->free_detector_flow();
-        lua_settop(my_lua_state, 0);
+        lua_settop(L, 0);
         return APPID_ENULL;
     }
 
@@ -3617,19 +3652,18 @@ int LuaStateDescriptor::lua_validate(AppIdDiscoveryArgs& args)
     odp_thread_local_ctxt->free_detector_flow();
 
     /* retrieve result */
-    if (!lua_isnumber(my_lua_state, -1))
+    if (!lua_isnumber(L, -1))
     {
         APPID_LOG(args.pkt, TRACE_ERROR_LEVEL, "lua detector %s: returned non-numeric value\n",
             package_info.name.c_str());
         ldp.pkt = nullptr;
-        lua_settop(my_lua_state, 0);
+        lua_settop(L, 0);
         return APPID_ENULL;
     }
 
-    int rc = lua_tonumber(my_lua_state, -1);
-    lua_pop(my_lua_state, 1);
+    int rc = lua_tonumber(L, -1);
     ldp.pkt = nullptr;
-    lua_settop(my_lua_state, 0);
+    lua_settop(L, 0);
 
     return rc;
 }
@@ -3716,9 +3750,11 @@ int LuaServiceDetector::validate(AppIdDiscoveryArgs& args)
     	APPID_LOG(args.pkt, TRACE_WARNING_LEVEL, "appid: leak of %d lua stack elements before service validate\n",
         lua_gettop(my_lua_state));
 
-    std::string name = this->name + "_";
-    lua_getglobal(my_lua_state, name.c_str());
-    auto& ud = *UserData<LuaServiceObject>::check(my_lua_state, DETECTOR, 1);
+    // detectors without a validate function are not loaded in packet threads
+    LuaObject* ud = odp_thread_local_ctxt->get_lua_object(this);
+    if (!ud)
+        return APPID_NOMATCH;
+
     return ud->lsd.lua_validate(args);
 }
 
@@ -3792,8 +3828,10 @@ int LuaClientDetector::validate(AppIdDiscoveryArgs& args)
         APPID_LOG(args.pkt, TRACE_WARNING_LEVEL, "appid: leak of %d lua stack elements before client validate\n",
             lua_gettop(my_lua_state));
 
-    std::string name = this->name + "_";
-    lua_getglobal(my_lua_state, name.c_str());
-    auto& ud = *UserData<LuaClientObject>::check(my_lua_state, DETECTOR, 1);
+    // detectors without a validate function are not loaded in packet threads
+    LuaObject* ud = odp_thread_local_ctxt->get_lua_object(this);
+    if (!ud)
+        return APPID_NOMATCH;
+
     return ud->lsd.lua_validate(args);
 }
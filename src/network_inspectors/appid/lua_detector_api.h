@@ -27,6 +27,8 @@
 #include <cstdint>
 #include <string>
 
+#include <lua.hpp>
+
 #include "appid_types.h"
 #include "client_plugins/client_detector.h"
 #include "service_plugins/service_detector.h"
@@ -38,6 +40,7 @@ struct Packet;
 struct lua_State;
 class AppIdSession;
 class AppInfoTableEntry;
+class AppidCPUProfilingManager;
 
 #define DETECTOR "Detector"
 #define DETECTORFLOW "DetectorFlow"
@@ -81,6 +84,18 @@ public:
     DetectorPackageInfo package_info;
     AppId service_id = APP_ID_UNKNOWN;
     int lua_validate(AppIdDiscoveryArgs&);
+    void set_validate_function(lua_State*, const char* name);
+    void flush_validate_time(AppidCPUProfilingManager&);
+
+private:
+    int call_validate(lua_State*, AppIdDiscoveryArgs&);
+
+    // the validate function in the registry of this thread's Lua state, resolved on first use
+    int validate_ref = LUA_NOREF;
+
+    // validate time of this thread not yet added to the cpu profiler
+    uint64_t validate_usecs = 0;
+    uint64_t validate_calls = 0;
 };
 
 class LuaServiceDetector : public ServiceDetector
@@ -258,6 +258,34 @@ LuaObject* LuaDetectorManager::get_cb_detector(AppId app_id)
     return nullptr;
 }
 
+LuaObject* LuaDetectorManager::get_lua_object(const AppIdDetector* detector) const
+{
+    auto it = lua_objects.find(detector);
+    return it != lua_objects.end() ? it->second : nullptr;
+}
+
+void LuaDetectorManager::flush_validate_time(AppidCPUProfilingManager& profiler_mgr)
+{
+    for ( auto& lua_object : allocated_objects )
+        lua_object->lsd.flush_validate_time(profiler_mgr);
+}
+
+void LuaDetectorManager::add_lua_object(LuaObject* lua_object)
+{
+    allocated_objects.push_front(lua_object);
+
+    // a later detector with the same name replaces the earlier one, as its global does
+    if (const AppIdDetector* detector = lua_object->get_detector())
+        lua_objects[detector] = lua_object;
+}
+
+void LuaDetectorManager::remove_lua_object(LuaObject* lua_object)
+{
+    auto it = lua_objects.find(lua_object->get_detector());
+    if (it != lua_objects.end() and it->second == lua_object)
+        lua_objects.erase(it);
+}
+
 /**calculates Number of flow and host tracker entries for Lua detectors, given amount
  * of memory allocated to RNA (fraction of total system memory) and number of detectors
  * loaded in database. Calculations are based on CAICCI detector and observing memory
@@ -458,7 +486,7 @@ bool LuaDetectorManager::load_detector(char* detector_filename, bool is_custom,
     bool has_validate;
     LuaObject* lua_object = create_lua_detector(detectorName, is_custom, detector_filename, has_validate);
     if (lua_object)
-        allocated_objects.push_front(lua_object);
+        add_lua_object(lua_object);
 
     return has_validate;
 }
@@ -484,6 +512,7 @@ void LuaDetectorManager::activate_lua_detectors(const SnortConfig* sc)
             if (!(*lo)->get_detector()->is_custom_detector())
                 num_odp_detectors--;
             lua_settop(L, 0);
+            remove_lua_object(*lo);
             delete *lo;
             lo = allocated_objects.erase(lo);
             continue;
@@ -505,6 +534,7 @@ void LuaDetectorManager::activate_lua_detectors(const SnortConfig* sc)
             if (!(*lo)->get_detector()->is_custom_detector())
                 num_odp_detectors--;
             lua_settop(L, 0);
+            remove_lua_object(*lo);
             delete *lo;
             lo = allocated_objects.erase(lo);
             continue;
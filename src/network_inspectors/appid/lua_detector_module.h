@@ -27,6 +27,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <lua.hpp>
@@ -44,6 +45,7 @@ namespace snort
 
 class AppIdContext;
 class AppIdDetector;
+class AppidCPUProfilingManager;
 struct DetectorFlow;
 class LuaObject;
 
@@ -63,6 +65,8 @@ public:
     { num_odp_detectors = allocated_objects.size(); }
     bool insert_cb_detector(AppId app_id, LuaObject* ud);
     LuaObject* get_cb_detector(AppId app_id);
+    LuaObject* get_lua_object(const AppIdDetector* detector) const;
+    void flush_validate_time(AppidCPUProfilingManager&);
 
     lua_State* L;
 
@@ -76,6 +80,12 @@ protected:
     std::list<LuaObject*> allocated_objects;
     size_t num_odp_detectors = 0;
     std::map<AppId, LuaObject*> cb_detectors;
+
+    // this thread's Lua object of each detector, the detectors are shared by all threads
+    std::unordered_map<const AppIdDetector*, LuaObject*> lua_objects;
+
+    void add_lua_object(LuaObject*);
+    void remove_lua_object(LuaObject*);
 };
 
 class PacketLuaDetectorManager : public LuaDetectorManager
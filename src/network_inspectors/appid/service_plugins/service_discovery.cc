@@ -270,12 +270,13 @@ void ServiceDiscovery::match_by_pattern(AppIdSession& asd, const Packet* pkt, Ip
         if (!smOrderedList.empty() )
         {
             std::sort(smOrderedList.begin(), smOrderedList.end(), AppIdPatternPrecedence);
+            auto& candidates = asd.get_service_candidates();
             for ( auto& sm : smOrderedList )
             {
-                if ( std::find(asd.service_candidates.begin(), asd.service_candidates.end(),
-                    sm->service) == asd.service_candidates.end() )
+                if ( std::find(candidates.begin(), candidates.end(), sm->service) ==
+                    candidates.end() )
                 {
-                    asd.service_candidates.emplace_back(sm->service);
+                    candidates.emplace_back(sm->service);
                 }
                 snort_free(sm);
             }
@@ -317,19 +318,22 @@ void ServiceDiscovery::get_port_based_services(IpProtocol protocol, uint16_t por
         unsigned mapped_port = sslPortRemap(port);
         if (mapped_port)
         {
-            if ( sd.tcp_services.find(mapped_port) != sd.tcp_services.end() )
-                asd.service_candidates = sd.tcp_services[mapped_port];
+            auto it = sd.tcp_services.find(mapped_port);
+            if ( it != sd.tcp_services.end() )
+                asd.get_service_candidates() = it->second;
         }
     }
     else if ( protocol == IpProtocol::TCP )
     {
-        if ( sd.tcp_services.find(port) != sd.tcp_services.end() )
-            asd.service_candidates = sd.tcp_services[port];
+        auto it = sd.tcp_services.find(port);
+        if ( it != sd.tcp_services.end() )
+            asd.get_service_candidates() = it->second;
     }
     else
     {
-        if ( sd.udp_services.find(port) != sd.udp_services.end() )
-            asd.service_candidates = sd.udp_services[port];
+        auto it = sd.udp_services.find(port);
+        if ( it != sd.udp_services.end() )
+            asd.get_service_candidates() = it->second;
     }
 }
 
@@ -373,12 +377,12 @@ void ServiceDiscovery::get_next_service(const Packet* p, const AppidSessionDirec
                     asd.is_decrypted());
                 std::unordered_map<uint16_t, std::vector<ServiceDetector*>>::iterator urs_iterator;
                 if ( rsds && rsds->get_service() )
-                    asd.service_candidates.emplace_back(rsds->get_service());
+                    asd.get_service_candidates().emplace_back(rsds->get_service());
                 else if ( ( urs_iterator = udp_reversed_services.find(p->ptrs.sp) )
                           != udp_reversed_services.end() and !urs_iterator->second.empty() )
                 {
-                    asd.service_candidates.insert(asd.service_candidates.end(),
-                        urs_iterator->second.begin(),
+                    auto& candidates = asd.get_service_candidates();
+                    candidates.insert(candidates.end(), urs_iterator->second.begin(),
                         urs_iterator->second.end());
                 }
                 else if ( p->dsize )
@@ -462,7 +466,7 @@ int ServiceDiscovery::identify_service(AppIdSession& asd, Packet* p,
                 asd.service_detector = sds->get_service();
             /* If we've gotten to brute force, give next detector a try. */
             else if ( sds_state == ServiceState::SEARCHING_BRUTE_FORCE and
-                asd.service_candidates.empty() )
+                !asd.has_service_candidates() )
             {
                 asd.service_detector = sds->select_detector_by_brute_force(proto,
                     asd.get_odp_ctxt().get_service_disco_mgr());
@@ -501,36 +505,41 @@ int ServiceDiscovery::identify_service(AppIdSession& asd, Packet* p,
 
         /* Run all of the detectors that we currently have. */
         ret = APPID_INPROCESS;
-        auto it = asd.service_candidates.begin();
-        while ( it != asd.service_candidates.end() )
+        if ( asd.has_service_candidates() )
         {
-            ServiceDetector* service = (ServiceDetector*)*it;
-            int result;
+            auto& candidates = asd.get_service_candidates();
+            auto it = candidates.begin();
+            while ( it != candidates.end() )
+            {
+                ServiceDetector* service = (ServiceDetector*)*it;
+                int result;
 
-            result = service->validate(args);
-            APPID_LOG(p, TRACE_DEBUG_LEVEL, "%s service candidate returned %s (%d)\n",
-                service->get_log_name().c_str(), service->get_code_string((APPID_STATUS_CODE)result), result);
+                result = service->validate(args);
+                APPID_LOG(p, TRACE_DEBUG_LEVEL, "%s service candidate returned %s (%d)\n",
+                    service->get_log_name().c_str(),
+                    service->get_code_string((APPID_STATUS_CODE)result), result);
 
-            if ( result == APPID_SUCCESS )
-            {
-                ret = APPID_SUCCESS;
-                asd.service_detector = service;
-                asd.service_candidates.clear();
-                break;    /* done */
-            }
-            else
-            {
-                if ( result == APPID_NOT_COMPATIBLE )
-                    got_incompatible_service = true;
-                if (result != APPID_INPROCESS)    /* fail */
-                    it = asd.service_candidates.erase(it);
+                if ( result == APPID_SUCCESS )
+                {
+                    ret = APPID_SUCCESS;
+                    asd.service_detector = service;
+                    candidates.clear();
+                    break;    /* done */
+                }
                 else
-                    ++it;
+                {
+                    if ( result == APPID_NOT_COMPATIBLE )
+                        got_incompatible_service = true;
+                    if (result != APPID_INPROCESS)    /* fail */
+                        it = candidates.erase(it);
+                    else
+                        ++it;
+                }
             }
         }
 
         /* If we tried everything and found nothing, then fail. */
-        if ( asd.service_candidates.empty() and ret != APPID_SUCCESS and
+        if ( !asd.has_service_candidates() and ret != APPID_SUCCESS and
              ( asd.service_search_state == SESSION_SERVICE_SEARCH_STATE::PENDING ) )
         {
             // FIXIT-E: For now, wait for snort service inspection only for TCP. In the future,
@@ -720,7 +729,7 @@ bool ServiceDiscovery::do_service_discovery(AppIdSession& asd, Packet* p,
                 asd.get_session_flags(APPID_SESSION_INITIATOR_MONITORED |
                 APPID_SESSION_RESPONDER_MONITORED) ) ) )
             {
-                if (asd.service_candidates.empty() and !asd.service_detector)
+                if (!asd.has_service_candidates() and !asd.service_detector)
                     asd.free_flow_data_by_mask(APPID_SESSION_DATA_SERVICE_MODSTATE_BIT);
                 asd.service_detector = entry->service_detector;
             }
@@ -787,7 +796,7 @@ int ServiceDiscovery::incompatible_data(AppIdSession& asd, const Packet* pkt, Ap
         asd.free_flow_data_by_id(service->get_flow_data_index());
 
     // ignore fails while searching with port/pattern selected detectors
-    if ( !asd.service_detector && !asd.service_candidates.empty() )
+    if ( !asd.service_detector && asd.has_service_candidates() )
         return APPID_SUCCESS;
 
     asd.set_service_detected();
@@ -827,7 +836,7 @@ int ServiceDiscovery::fail_service(AppIdSession& asd, const Packet* pkt, AppidSe
 
     /* If we're still working on a port/pattern list of detectors, then ignore
      * individual fails until we're done looking at everything. */
-    if ((asd.first_pkt_service_id > APP_ID_NONE) or (!asd.service_detector && !asd.service_candidates.empty()))
+    if ((asd.first_pkt_service_id > APP_ID_NONE) or (!asd.service_detector && asd.has_service_candidates()))
         return APPID_SUCCESS;
 
     asd.set_service_id(APP_ID_NONE, asd.get_odp_ctxt());
@@ -190,7 +190,7 @@ void ServiceDiscoveryState::set_service_id_failed(AppIdSession& asd, const SfIp*
     }
     else if ( ( state == ServiceState::SEARCHING_PORT_PATTERN ) and
         ( asd.service_search_state == SESSION_SERVICE_SEARCH_STATE::PENDING ) and
-        asd.service_candidates.empty() and
+        !asd.has_service_candidates() and
         !asd.get_session_flags(APPID_SESSION_MID | APPID_SESSION_OOO) )
     {
         if ( ( asd.protocol == IpProtocol::TCP ) or ( asd.protocol == IpProtocol::UDP ) )
@@ -67,7 +67,7 @@ static const Parameter extractor_proto_params[] =
 
 static const Parameter s_params[] =
 {
-    { "formatting", Parameter::PT_ENUM, "csv | tsv | json", "csv",
+    { "formatting", Parameter::PT_ENUM, "csv | tsv | json | columnar", "csv",
       "output format for extractor" },
 
     { "connector", Parameter::PT_STRING, nullptr, nullptr,
@@ -79,6 +79,12 @@ static const Parameter s_params[] =
     { "default_filter", Parameter::PT_ENUM, "pick | skip", "pick",
       "default action for protocol with no filter provided" },
 
+    { "row_group_rows", Parameter::PT_INT, "1:max32", "8192",
+      "columnar formatting: send a row group after this many records" },
+
+    { "row_group_time", Parameter::PT_INT, "0:max32", "10",
+      "columnar formatting: send a row group after this many seconds (0 is unlimited)" },
+
     { "protocols", Parameter::PT_LIST, extractor_proto_params, nullptr,
       "protocols to extract data" },
 
@@ -147,6 +153,12 @@ bool ExtractorModule::set(const char*, Value& v, SnortConfig*)
     else if (v.is("time"))
         extractor_config.time_formatting = (TimeType)(v.get_uint8());
 
+    else if (v.is("row_group_rows"))
+        extractor_config.row_group_rows = v.get_uint32();
+
+    else if (v.is("row_group_time"))
+        extractor_config.row_group_time = v.get_uint32();
+
     if (v.is("default_filter"))
         extractor_config.pick_by_default = v.get_uint8() == 0;
 
@@ -197,7 +209,8 @@ public:
 
         delete inspector.logger;
         inspector.logger = ExtractorLogger::make_logger(
-            inspector.cfg.formatting, inspector.cfg.output_conn, inspector.cfg.time_formatting);
+            inspector.cfg.formatting, inspector.cfg.output_conn, inspector.cfg.time_formatting,
+            inspector.cfg.row_group_rows, inspector.cfg.row_group_time);
 
         for (auto& s : inspector.services)
             s->tinit(inspector.logger);
@@ -242,6 +255,14 @@ bool Extractor::configure(SnortConfig* sc)
         return false;
     }
 
+    // row groups are binary messages that a text connector would split into lines
+    if (cfg.formatting == FormatType::COLUMNAR and ConnectorManager::is_text_format(cfg.output_conn))
+    {
+        ParseError("can't initialize extractor, columnar formatting needs a binary connector "
+            "but \"%s\" writes text.\n", cfg.output_conn.c_str());
+        return false;
+    }
+
     return true;
 }
 
@@ -250,6 +271,12 @@ void Extractor::show(const SnortConfig*) const
     ConfigLogger::log_value("formatting", cfg.formatting.c_str());
     ConfigLogger::log_value("connector", cfg.output_conn.c_str());
     ConfigLogger::log_value("time", cfg.time_formatting.c_str());
+
+    if (cfg.formatting == FormatType::COLUMNAR)
+    {
+        ConfigLogger::log_value("row_group_rows", cfg.row_group_rows);
+        ConfigLogger::log_value("row_group_time", cfg.row_group_time);
+    }
     ConfigLogger::log_value("pick_by_default", cfg.pick_by_default ? "pick" : "skip");
 
     bool log_header = true;
@@ -269,7 +296,8 @@ void Extractor::show(const SnortConfig*) const
 
 void Extractor::tinit()
 {
-    logger = ExtractorLogger::make_logger(cfg.formatting, cfg.output_conn, cfg.time_formatting);
+    logger = ExtractorLogger::make_logger(cfg.formatting, cfg.output_conn, cfg.time_formatting,
+        cfg.row_group_rows, cfg.row_group_time);
 
     for (auto& s : services)
         s->tinit(logger);
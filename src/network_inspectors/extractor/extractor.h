@@ -52,6 +52,8 @@ struct ExtractorConfig
     FormatType formatting = FormatType::CSV;
     std::string output_conn;
     TimeType time_formatting = TimeType::UNIX;
+    uint32_t row_group_rows = 8192;
+    uint32_t row_group_time = 10;
     bool pick_by_default = true;
     std::vector<ServiceConfig> protocols;
 };
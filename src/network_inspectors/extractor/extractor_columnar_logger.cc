@@ -0,0 +1,728 @@
+//--------------------------------------------------------------------------
+// Copyright (C) 2026 Cisco and/or its affiliates. All rights reserved.
+//
+// This program is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License Version 2 as published
+// by the Free Software Foundation.  You may not use, modify or distribute
+// this program under any other version of the GNU General Public License.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+//--------------------------------------------------------------------------
+// extractor_columnar_logger.cc author Cisco
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "extractor_columnar_logger.h"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <string>
+
+#include "time/packet_time.h"
+
+using namespace snort;
+using namespace ColumnarFormat;
+
+static constexpr uint64_t shape_prime = 0x100000001b3;
+static constexpr time_t sweep_secs = 1;
+static constexpr size_t min_slots = 64;
+
+template<typename T>
+static inline void put(std::string& out, T v)
+{ out.append((const char*)&v, sizeof(v)); }
+
+static inline void pad(std::string& out, size_t align)
+{ out.append((align - out.size() % align) % align, '\0'); }
+
+//--------------------------------------------------------------------------
+// column
+//--------------------------------------------------------------------------
+
+void ColumnarExtractorLogger::Column::add_str(const char* s, size_t len)
+{
+    if ( ends.size() * 2 >= slots.size() )
+        grow();
+
+    std::string_view key(s ? s : "", len);
+    size_t mask = slots.size() - 1;
+    size_t i = std::hash<std::string_view>()(key) & mask;
+
+    while ( slots[i] and value(slots[i] - 1) != key )
+        i = (i + 1) & mask;
+
+    if ( !slots[i] )
+    {
+        bytes.append(key);
+        ends.push_back(bytes.size());
+        slots[i] = ends.size();
+    }
+    idx.push_back(slots[i] - 1);
+}
+
+// keep the table at most half full
+void ColumnarExtractorLogger::Column::grow()
+{
+    slots.assign(std::max(slots.size() * 2, min_slots), 0);
+    size_t mask = slots.size() - 1;
+
+    for ( uint32_t v = 0; v < ends.size(); ++v )
+    {
+        size_t i = std::hash<std::string_view>()(value(v)) & mask;
+
+        while ( slots[i] )
+            i = (i + 1) & mask;
+
+        slots[i] = v + 1;
+    }
+}
+
+void ColumnarExtractorLogger::Column::clear()
+{
+    nums.clear();
+    ips.clear();
+    idx.clear();
+    items.clear();
+    bytes.clear();
+    ends.clear();
+    std::fill(slots.begin(), slots.end(), 0);
+}
+
+//--------------------------------------------------------------------------
+// logger
+//--------------------------------------------------------------------------
+
+ColumnarExtractorLogger::ColumnarExtractorLogger(Connector* conn, uint32_t rows, uint32_t secs)
+    : ExtractorLogger(conn), max_rows(rows ? rows : 1), max_secs(secs)
+{ }
+
+ColumnarExtractorLogger::~ColumnarExtractorLogger()
+{
+    // pending rows were sent by flush() or add_footer() while the connector was alive
+    for ( auto t : tables )
+        delete t;
+}
+
+void ColumnarExtractorLogger::open_record()
+{
+    cells.clear();
+    stage.clear();
+    shape = 0;
+}
+
+void ColumnarExtractorLogger::add_cell(const char* name, ColumnType type, uint64_t value,
+    const void* data, size_t len)
+{
+    cells.push_back({ name, type, value, (uint32_t)stage.size(), (uint32_t)len });
+
+    if ( len )
+        stage.append((const char*)data, len);
+
+    // the type byte also separates the names
+    for ( const char* p = name ? name : ""; *p; ++p )
+        shape = (shape ^ (uint8_t)*p) * shape_prime;
+
+    shape = (shape ^ type) * shape_prime;
+}
+
+void ColumnarExtractorLogger::add_field(const char* f, const char* v)
+{ add_cell(f, COL_STR, 0, v, v ? strlen(v) : 0); }
+
+void ColumnarExtractorLogger::add_field(const char* f, const char* v, size_t len)
+{ add_cell(f, COL_STR, 0, v, v ? len : 0); }
+
+void ColumnarExtractorLogger::add_field(const char* f, uint64_t v)
+{ add_cell(f, COL_U64, v); }
+
+void ColumnarExtractorLogger::add_field(const char* f, struct timeval v)
+{ add_cell(f, COL_TIME, (uint64_t)v.tv_sec * 1000000 + v.tv_usec); }
+
+void ColumnarExtractorLogger::add_field(const char* f, const SfIp& v)
+{ add_cell(f, COL_IP, 0, v.get_ip6_ptr(), 16); }
+
+void ColumnarExtractorLogger::add_field(const char* f, bool v)
+{ add_cell(f, COL_BOOL, v); }
+
+void ColumnarExtractorLogger::add_field(const char* f, const std::vector<const char*>& v)
+{
+    add_cell(f, COL_STR_LIST, v.size());
+    Cell& c = cells.back();
+
+    // staged as u32 length + bytes per item
+    for ( auto s : v )
+    {
+        uint32_t len = s ? strlen(s) : 0;
+        put(stage, len);
+        stage.append(s ? s : "", len);
+    }
+    c.len = stage.size() - c.off;
+}
+
+void ColumnarExtractorLogger::add_field(const char* f, const std::vector<uint64_t>& v)
+{ add_cell(f, COL_U64_LIST, v.size(), v.data(), v.size() * sizeof(uint64_t)); }
+
+void ColumnarExtractorLogger::add_field(const char* f, const std::vector<bool>& v)
+{
+    add_cell(f, COL_BOOL_LIST, v.size());
+    Cell& c = cells.back();
+
+    for ( bool b : v )
+        stage.push_back(b ? 1 : 0);
+
+    c.len = stage.size() - c.off;
+}
+
+// a shape collision must not mix value types in a column
+bool ColumnarExtractorLogger::same_types(const Table& t) const
+{
+    if ( t.columns.size() != cells.size() )
+        return false;
+
+    for ( unsigned i = 0; i < cells.size(); ++i )
+    {
+        if ( t.columns[i].type != cells[i].type )
+            return false;
+    }
+    return true;
+}
+
+ColumnarExtractorLogger::Table* ColumnarExtractorLogger::get_table(const Connector::ID& service_id)
+{
+    for ( auto t : tables )
+    {
+        if ( t->shape == shape and t->service_id == service_id and same_types(*t) )
+            return t;
+    }
+
+    Table* t = new Table;
+    t->service_id = service_id;
+    t->shape = shape;
+    t->id = tables.size();
+    t->columns.resize(cells.size());
+
+    for ( unsigned i = 0; i < cells.size(); ++i )
+    {
+        t->columns[i].name = cells[i].name ? cells[i].name : "";
+        t->columns[i].type = cells[i].type;
+    }
+
+    tables.push_back(t);
+    send_schema(*t);
+
+    return t;
+}
+
+void ColumnarExtractorLogger::close_record(const Connector::ID& service_id)
+{
+    if ( cells.empty() )
+        return;
+
+    Table* t = get_table(service_id);
+    const char* base = stage.data();
+
+    for ( unsigned i = 0; i < cells.size(); ++i )
+    {
+        const Cell& cell = cells[i];
+        Column& col = t->columns[i];
+
+        switch ( cell.type )
+        {
+        case COL_STR:
+            col.add_str(base + cell.off, cell.len);
+            break;
+
+        case COL_U64:
+        case COL_TIME:
+        case COL_BOOL:
+            col.nums.push_back(cell.value);
+            break;
+
+        case COL_IP:
+            col.ips.insert(col.ips.end(), base + cell.off, base + cell.off + cell.len);
+            break;
+
+        case COL_STR_LIST:
+        {
+            const char* p = base + cell.off;
+
+            for ( uint64_t n = 0; n < cell.value; ++n )
+            {
+                uint32_t len;
+                memcpy(&len, p, sizeof(len));
+                col.add_str(p + sizeof(len), len);
+                p += sizeof(len) + len;
+            }
+            col.items.push_back(col.idx.size());
+            break;
+        }
+        case COL_U64_LIST:
+        {
+            const uint64_t* p = (const uint64_t*)(base + cell.off);
+            col.nums.insert(col.nums.end(), p, p + cell.value);
+            col.items.push_back(col.nums.size());
+            break;
+        }
+        case COL_BOOL_LIST:
+            col.nums.insert(col.nums.end(), base + cell.off, base + cell.off + cell.len);
+            col.items.push_back(col.nums.size());
+            break;
+        }
+    }
+
+    time_t now = packet_time();
+
+    if ( !t->rows++ )
+        t->started = now;
+
+    if ( t->rows >= max_rows or (max_secs and now - t->started >= max_secs) )
+        flush(*t);
+
+    // idle tables are checked at most once a second
+    if ( max_secs and now - last_sweep >= sweep_secs )
+    {
+        last_sweep = now;
+
+        for ( auto other : tables )
+        {
+            if ( other->rows and now - other->started >= max_secs )
+                flush(*other);
+        }
+    }
+}
+
+void ColumnarExtractorLogger::add_footer(const Connector::ID& service_id)
+{
+    for ( auto t : tables )
+    {
+        if ( t->service_id == service_id )
+            flush(*t);
+    }
+}
+
+void ColumnarExtractorLogger::flush()
+{
+    for ( auto t : tables )
+        flush(*t);
+
+    ExtractorLogger::flush();
+}
+
+//--------------------------------------------------------------------------
+// encoding
+//--------------------------------------------------------------------------
+
+void ColumnarExtractorLogger::send_schema(const Table& t)
+{
+    std::string tag = std::holds_alternative<int>(t.service_id) ?
+        std::to_string(std::get<int>(t.service_id)) :
+        std::string(std::get<const char*>(t.service_id) ? std::get<const char*>(t.service_id) : "");
+
+    out.clear();
+    out.append(schema_magic, sizeof(schema_magic));
+    put(out, version);
+    put(out, t.id);
+    put(out, (uint32_t)t.columns.size());
+    put(out, (uint16_t)tag.size());
+    out.append(tag);
+
+    for ( const auto& c : t.columns )
+    {
+        put(out, (uint8_t)c.type);
+        put(out, (uint8_t)0);
+        put(out, (uint16_t)c.name.size());
+        out.append(c.name);
+    }
+
+    ConnectorMsg cmsg((const uint8_t*)out.data(), out.size(), false);
+    output_conn->transmit_message(cmsg, t.service_id);
+}
+
+// dictionary unless most values are distinct
+Encoding ColumnarExtractorLogger::encode_strings(const Column& c)
+{
+    bool use_dict = c.ends.size() * 2 <= c.idx.size();
+
+    if ( use_dict )
+    {
+        put(out, (uint32_t)c.ends.size());
+        out.append((const char*)c.ends.data(), c.ends.size() * sizeof(uint32_t));
+        out.append(c.bytes);
+
+        pad(out, sizeof(uint32_t));
+        out.append((const char*)c.idx.data(), c.idx.size() * sizeof(uint32_t));
+        return ENC_DICT;
+    }
+
+    uint32_t end = 0;
+
+    for ( auto i : c.idx )
+        put(out, end += c.value(i).size());
+
+    for ( auto i : c.idx )
+        out.append(c.value(i));
+
+    return ENC_PLAIN;
+}
+
+Encoding ColumnarExtractorLogger::encode_nums(const Column& c)
+{
+    out.append((const char*)c.nums.data(), c.nums.size() * sizeof(uint64_t));
+    return ENC_PLAIN;
+}
+
+Encoding ColumnarExtractorLogger::encode_bits(const Column& c)
+{
+    size_t start = out.size();
+    out.append((c.nums.size() + 7) / 8, '\0');
+
+    for ( size_t i = 0; i < c.nums.size(); ++i )
+    {
+        if ( c.nums[i] )
+            out[start + i / 8] |= (char)(1 << (i % 8));
+    }
+    return ENC_BITMAP;
+}
+
+void ColumnarExtractorLogger::encode_items(const Column& c)
+{ out.append((const char*)c.items.data(), c.items.size() * sizeof(uint32_t)); }
+
+void ColumnarExtractorLogger::flush(Table& t)
+{
+    if ( !t.rows )
+        return;
+
+    out.clear();
+    out.append(row_group_magic, sizeof(row_group_magic));
+    put(out, version);
+    put(out, t.id);
+    put(out, t.rows);
+    put(out, (uint32_t)t.columns.size());
+
+    for ( auto& c : t.columns )
+    {
+        size_t hdr = out.size();
+        put(out, (uint8_t)c.type);
+        put(out, (uint8_t)ENC_PLAIN);
+        put(out, (uint16_t)0);
+        put(out, (uint32_t)0);
+
+        size_t start = out.size();
+        Encoding enc = ENC_PLAIN;
+
+        switch ( c.type )
+        {
+        case COL_STR:
+            enc = encode_strings(c);
+            break;
+
+        case COL_U64:
+        case COL_TIME:
+            enc = encode_nums(c);
+            break;
+
+        case COL_BOOL:
+            enc = encode_bits(c);
+            break;
+
+        case COL_IP:
+            out.append((const char*)c.ips.data(), c.ips.size());
+            break;
+
+        // list item ends per row followed by the encoded items
+        case COL_STR_LIST:
+            encode_items(c);
+            enc = encode_strings(c);
+            break;
+
+        case COL_U64_LIST:
+            encode_items(c);
+            pad(out, sizeof(uint64_t));
+            enc = encode_nums(c);
+            break;
+
+        case COL_BOOL_LIST:
+            encode_items(c);
+            enc = encode_bits(c);
+            break;
+        }
+
+        uint32_t len = out.size() - start;
+        out[hdr + 1] = (char)enc;
+        memcpy(&out[hdr + 4], &len, sizeof(len));
+
+        // keep the next column header and fixed width values aligned
+        pad(out, sizeof(uint64_t));
+        c.clear();
+    }
+
+    ConnectorMsg cmsg((const uint8_t*)out.data(), out.size(), false);
+    output_conn->transmit_message(cmsg, t.service_id);
+
+    t.rows = 0;
+    t.started = 0;
+}
+
+#ifdef UNIT_TEST
+
+#include "catch/snort_catch.h"
+
+class ColumnarTestConnector : public Connector
+{
+public:
+    ColumnarTestConnector() : Connector(conf)
+    {
+        conf.connector_name = "test";
+        conf.direction = Connector::CONN_DUPLEX;
+    }
+
+    bool transmit_message(const ConnectorMsg& m, const ID& = null) override
+    {
+        msgs.emplace_back((const char*)m.get_data(), m.get_length());
+        return true;
+    }
+
+    bool transmit_message(const ConnectorMsg&& m, const ID& id = null) override
+    { return transmit_message(m, id); }
+
+    ConnectorMsg receive_message(bool) override
+    { return ConnectorMsg(); }
+
+    std::vector<std::string> msgs;
+
+private:
+    ConnectorConfig conf;
+};
+
+template<typename T>
+static T get(const std::string& s, size_t off)
+{
+    T v;
+    memcpy(&v, s.data() + off, sizeof(v));
+    return v;
+}
+
+// returns offset of column payload, sets type, encoding and length
+static size_t find_column(const std::string& rg, unsigned col, uint8_t& type, uint8_t& enc, uint32_t& len)
+{
+    size_t off = 16;
+
+    for ( unsigned i = 0; ; ++i )
+    {
+        type = rg[off];
+        enc = rg[off + 1];
+        len = get<uint32_t>(rg, off + 4);
+
+        if ( i == col )
+            return off + 8;
+
+        off += 8 + len;
+        off += (8 - off % 8) % 8;
+    }
+}
+
+TEST_CASE("columnar: row group by count", "[extractor]")
+{
+    ColumnarTestConnector conn;
+    ColumnarExtractorLogger logger(&conn, 4, 0);
+    const char* names[] = { "a", "b", "c", "d" };
+    const char* strs[] = { "GET", "GET", "GET", "POST" };
+
+    for ( unsigned i = 0; i < 4; ++i )
+    {
+        logger.open_record();
+        logger.add_field(names[0], strs[i]);
+        logger.add_field(names[1], (uint64_t)i);
+        logger.add_field(names[2], i % 2 == 0);
+        logger.add_field(names[3], timeval{ 1, (suseconds_t)i });
+        logger.close_record(Connector::ID(1));
+    }
+
+    REQUIRE(conn.msgs.size() == 2);
+
+    const std::string& schema = conn.msgs[0];
+    CHECK(!memcmp(schema.data(), ColumnarFormat::schema_magic, 4));
+    CHECK(get<uint32_t>(schema, 8) == 4);
+
+    const std::string& rg = conn.msgs[1];
+    CHECK(!memcmp(rg.data(), ColumnarFormat::row_group_magic, 4));
+    CHECK(get<uint32_t>(rg, 8) == 4);
+    CHECK(get<uint32_t>(rg, 12) == 4);
+
+    uint8_t type, enc;
+    uint32_t len;
+
+    size_t off = find_column(rg, 0, type, enc, len);
+    CHECK(type == ColumnarFormat::COL_STR);
+    CHECK(enc == ColumnarFormat::ENC_DICT);
+    CHECK(get<uint32_t>(rg, off) == 2);
+    CHECK(rg.substr(off + 12, 7) == "GETPOST");
+    CHECK(get<uint32_t>(rg, off + 20 + 12) == 1);
+
+    off = find_column(rg, 1, type, enc, len);
+    CHECK(type == ColumnarFormat::COL_U64);
+    CHECK(len == 32);
+    CHECK(get<uint64_t>(rg, off + 24) == 3);
+
+    off = find_column(rg, 2, type, enc, len);
+    CHECK(type == ColumnarFormat::COL_BOOL);
+    CHECK(enc == ColumnarFormat::ENC_BITMAP);
+    CHECK((uint8_t)rg[off] == 0x5);
+
+    off = find_column(rg, 3, type, enc, len);
+    CHECK(type == ColumnarFormat::COL_TIME);
+    CHECK(get<uint64_t>(rg, off + 8) == 1000001);
+
+    logger.flush();
+    CHECK(conn.msgs.size() == 2);
+}
+
+TEST_CASE("columnar: tables by shape", "[extractor]")
+{
+    ColumnarTestConnector conn;
+    ColumnarExtractorLogger logger(&conn, 100, 0);
+    const char* a = "a";
+    const char* b = "b";
+
+    logger.open_record();
+    logger.add_field(a, (uint64_t)1);
+    logger.close_record(Connector::ID(1));
+
+    logger.open_record();
+    logger.add_field(b, "x");
+    logger.close_record(Connector::ID(1));
+
+    logger.open_record();
+    logger.add_field(a, (uint64_t)2);
+    logger.close_record(Connector::ID(2));
+
+    // schema per table, nothing sent yet
+    CHECK(conn.msgs.size() == 3);
+
+    logger.add_footer(Connector::ID(1));
+    REQUIRE(conn.msgs.size() == 5);
+    CHECK(get<uint16_t>(conn.msgs[3], 6) == 0);
+    CHECK(get<uint16_t>(conn.msgs[4], 6) == 1);
+
+    logger.flush();
+    REQUIRE(conn.msgs.size() == 6);
+    CHECK(get<uint16_t>(conn.msgs[5], 6) == 2);
+}
+
+TEST_CASE("columnar: shape by field name contents", "[extractor]")
+{
+    ColumnarTestConnector conn;
+    ColumnarExtractorLogger logger(&conn, 100, 0);
+    std::string a1 = "field";
+    std::string a2 = "field";
+
+    logger.open_record();
+    logger.add_field(a1.c_str(), (uint64_t)1);
+    logger.close_record(Connector::ID(1));
+
+    // same name at another address, same table
+    logger.open_record();
+    logger.add_field(a2.c_str(), (uint64_t)2);
+    logger.close_record(Connector::ID(1));
+    CHECK(conn.msgs.size() == 1);
+
+    // same name with another type, new table
+    logger.open_record();
+    logger.add_field(a2.c_str(), "x");
+    logger.close_record(Connector::ID(1));
+    CHECK(conn.msgs.size() == 2);
+
+    logger.flush();
+    REQUIRE(conn.msgs.size() == 4);
+    CHECK(get<uint32_t>(conn.msgs[2], 8) == 2);
+    CHECK(get<uint32_t>(conn.msgs[3], 8) == 1);
+}
+
+TEST_CASE("columnar: dictionary per row group", "[extractor]")
+{
+    ColumnarTestConnector conn;
+    ColumnarExtractorLogger logger(&conn, 200, 0);
+    const char* f = "f";
+
+    // enough distinct values to grow the table, each seen twice
+    for ( unsigned g = 0; g < 2; ++g )
+    {
+        for ( unsigned i = 0; i < 200; ++i )
+        {
+            std::string s = std::to_string(g * 1000 + i % 100);
+            logger.open_record();
+            logger.add_field(f, s.c_str());
+            logger.close_record(Connector::ID(1));
+        }
+    }
+
+    REQUIRE(conn.msgs.size() == 3);
+
+    for ( unsigned g = 0; g < 2; ++g )
+    {
+        const std::string& rg = conn.msgs[g + 1];
+        uint8_t type, enc;
+        uint32_t len;
+
+        size_t off = find_column(rg, 0, type, enc, len);
+        CHECK(enc == ColumnarFormat::ENC_DICT);
+        REQUIRE(get<uint32_t>(rg, off) == 100);
+
+        // values of the prior row group are gone
+        std::string first = std::to_string(g * 1000);
+        CHECK(rg.substr(off + 4 + 400, first.size()) == first);
+
+        // the 101st row repeats the first value
+        uint32_t end = get<uint32_t>(rg, off + 4 + 99 * 4);
+        size_t idx = off + 4 + 400 + end;
+        idx += (4 - idx % 4) % 4;
+        CHECK(get<uint32_t>(rg, idx + 100 * 4) == 0);
+    }
+}
+
+TEST_CASE("columnar: lists", "[extractor]")
+{
+    ColumnarTestConnector conn;
+    ColumnarExtractorLogger logger(&conn, 2, 0);
+    const char* f = "f";
+    std::vector<uint64_t> nums[] = { { 1, 2, 3 }, { } };
+    std::vector<const char*> strs[] = { { "x", "yy" }, { "zzz" } };
+
+    for ( unsigned i = 0; i < 2; ++i )
+    {
+        logger.open_record();
+        logger.add_field(f, nums[i]);
+        logger.add_field(f, strs[i]);
+        logger.close_record(Connector::ID(1));
+    }
+
+    REQUIRE(conn.msgs.size() == 2);
+    const std::string& rg = conn.msgs[1];
+
+    uint8_t type, enc;
+    uint32_t len;
+
+    size_t off = find_column(rg, 0, type, enc, len);
+    CHECK(type == ColumnarFormat::COL_U64_LIST);
+    CHECK(get<uint32_t>(rg, off) == 3);
+    CHECK(get<uint32_t>(rg, off + 4) == 3);
+    CHECK(get<uint64_t>(rg, off + 8 + 16) == 3);
+
+    off = find_column(rg, 1, type, enc, len);
+    CHECK(type == ColumnarFormat::COL_STR_LIST);
+    CHECK(enc == ColumnarFormat::ENC_PLAIN);
+    CHECK(get<uint32_t>(rg, off) == 2);
+    CHECK(get<uint32_t>(rg, off + 4) == 3);
+    CHECK(get<uint32_t>(rg, off + 8 + 8) == 6);
+    CHECK(rg.substr(off + 20, 6) == "xyyzzz");
+}
+
+#endif
@@ -0,0 +1,154 @@
+//--------------------------------------------------------------------------
+// Copyright (C) 2026 Cisco and/or its affiliates. All rights reserved.
+//
+// This program is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License Version 2 as published
+// by the Free Software Foundation.  You may not use, modify or distribute
+// this program under any other version of the GNU General Public License.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+//--------------------------------------------------------------------------
+// extractor_columnar_logger.h author Cisco
+
+#ifndef EXTRACTOR_COLUMNAR_LOGGER_H
+#define EXTRACTOR_COLUMNAR_LOGGER_H
+
+// Binary columnar output.  Records of the same shape (service and field
+// list) are accumulated column by column into a row group which is sent as
+// a single connector message when it reaches a row count or age limit.
+// Strings are dictionary encoded per row group unless mostly unique.
+
+#include <ctime>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "extractor_logger.h"
+
+namespace ColumnarFormat
+{
+// all integers are in host byte order
+constexpr char schema_magic[4] = { 'S', 'X', 'S', 'C' };
+constexpr char row_group_magic[4] = { 'S', 'X', 'R', 'G' };
+constexpr uint16_t version = 1;
+
+enum ColumnType : uint8_t
+{
+    COL_STR = 1, COL_U64, COL_TIME, COL_IP, COL_BOOL,
+    COL_STR_LIST, COL_U64_LIST, COL_BOOL_LIST
+};
+
+enum Encoding : uint8_t
+{
+    ENC_PLAIN = 0,   // fixed width values or string ends + bytes
+    ENC_BITMAP,      // one bit per value
+    ENC_DICT,        // dictionary ends + bytes, then u32 index per value
+};
+}
+
+class ColumnarExtractorLogger : public ExtractorLogger
+{
+public:
+    ColumnarExtractorLogger(snort::Connector*, uint32_t max_rows, uint32_t max_secs);
+    ~ColumnarExtractorLogger() override;
+
+    bool is_strict() const override
+    { return true; }
+
+    void add_footer(const snort::Connector::ID&) override;
+
+    void add_field(const char*, const char*) override;
+    void add_field(const char*, const char*, size_t) override;
+    void add_field(const char*, uint64_t) override;
+    void add_field(const char*, struct timeval) override;
+    void add_field(const char*, const snort::SfIp&) override;
+    void add_field(const char*, bool) override;
+
+    void add_field(const char*, const std::vector<const char*>&) override;
+    void add_field(const char*, const std::vector<uint64_t>&) override;
+    void add_field(const char*, const std::vector<bool>&) override;
+
+    void open_record() override;
+    void close_record(const snort::Connector::ID&) override;
+
+    void flush() override;
+
+protected:
+    struct Cell
+    {
+        const char* name;
+        ColumnarFormat::ColumnType type;
+        uint64_t value;   // number, usec, flag or list size
+        uint32_t off;     // staged bytes
+        uint32_t len;
+    };
+
+    struct Column
+    {
+        std::string name;
+        ColumnarFormat::ColumnType type;
+
+        std::vector<uint64_t> nums;     // numbers, times, flags
+        std::vector<uint8_t> ips;       // 16 bytes per value
+        std::vector<uint32_t> idx;      // dictionary index per string
+        std::vector<uint32_t> items;    // list end per row
+
+        // dictionary of the row group: distinct values end to end and an
+        // open addressed table of value index + 1; the storage is kept
+        // across row groups so steady state adds no allocations
+        std::string bytes;
+        std::vector<uint32_t> ends;
+        std::vector<uint32_t> slots;
+
+        std::string_view value(uint32_t i) const
+        {
+            uint32_t start = i ? ends[i - 1] : 0;
+            return { bytes.data() + start, ends[i] - start };
+        }
+
+        void add_str(const char*, size_t);
+        void grow();
+        void clear();
+    };
+
+    struct Table
+    {
+        snort::Connector::ID service_id;
+        uint64_t shape;
+        uint16_t id;
+        uint32_t rows = 0;
+        time_t started = 0;
+        std::vector<Column> columns;
+    };
+
+    void add_cell(const char*, ColumnarFormat::ColumnType, uint64_t, const void* = nullptr, size_t = 0);
+    bool same_types(const Table&) const;
+    Table* get_table(const snort::Connector::ID&);
+    void send_schema(const Table&);
+    void flush(Table&);
+
+    ColumnarFormat::Encoding encode_strings(const Column&);
+    ColumnarFormat::Encoding encode_nums(const Column&);
+    ColumnarFormat::Encoding encode_bits(const Column&);
+    void encode_items(const Column&);
+
+    std::vector<Cell> cells;
+    std::string stage;      // record bytes (strings, IPs, list items)
+    uint64_t shape = 0;     // running hash of field names and types
+
+    std::vector<Table*> tables;
+    std::string out;        // message being built
+    uint32_t max_rows;
+    time_t max_secs;
+    time_t last_sweep = 0;
+};
+
+#endif
+
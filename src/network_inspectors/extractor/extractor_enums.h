@@ -79,6 +79,7 @@ public:
         CSV,
         TSV,
         JSON,
+        COLUMNAR,
         MAX
     };
 
@@ -99,6 +100,8 @@ public:
             return "tsv";
         case JSON:
             return "json";
+        case COLUMNAR:
+            return "columnar";
         case MAX: // fallthrough
         default:
             return "(not set)";
@@ -29,6 +29,7 @@
 #include "main/thread.h"
 #include "managers/connector_manager.h"
 
+#include "extractor_columnar_logger.h"
 #include "extractor_csv_logger.h"
 #include "extractor_json_logger.h"
 
@@ -63,7 +64,8 @@ Connector* ExtractorLogger::get_connector(const std::string& conn_name)
     return nullptr;
 }
 
-ExtractorLogger* ExtractorLogger::make_logger(FormatType f_type, const std::string& conn_name, TimeType ts_type)
+ExtractorLogger* ExtractorLogger::make_logger(FormatType f_type, const std::string& conn_name, TimeType ts_type,
+    uint32_t row_group_rows, uint32_t row_group_time)
 {
     ExtractorLogger* logger = nullptr;
 
@@ -82,6 +84,9 @@ ExtractorLogger* ExtractorLogger::make_logger(FormatType f_type, const std::stri
     case FormatType::JSON:
         logger = new JsonExtractorLogger(output_conn, ts_type);
         break;
+    case FormatType::COLUMNAR:
+        logger = new ColumnarExtractorLogger(output_conn, row_group_rows, row_group_time);
+        break;
     case FormatType::MAX: // fallthrough
     default:
         break;
@@ -105,11 +110,13 @@ TEST_CASE("Format Type", "[extractor]")
         FormatType csv = FormatType::CSV;
         FormatType tsv = FormatType::TSV;
         FormatType json = FormatType::JSON;
+        FormatType columnar = FormatType::COLUMNAR;
         FormatType max = FormatType::MAX;
 
         CHECK_FALSE(strcmp("csv", csv.c_str()));
         CHECK_FALSE(strcmp("tsv", tsv.c_str()));
         CHECK_FALSE(strcmp("json", json.c_str()));
+        CHECK_FALSE(strcmp("columnar", columnar.c_str()));
         CHECK_FALSE(strcmp("(not set)", max.c_str()));
     }
 }
@@ -32,7 +32,8 @@
 class ExtractorLogger
 {
 public:
-    static ExtractorLogger* make_logger(FormatType, const std::string&, TimeType);
+    static ExtractorLogger* make_logger(FormatType, const std::string&, TimeType,
+        uint32_t row_group_rows = 0, uint32_t row_group_time = 0);
 
     ExtractorLogger(snort::Connector* conn) : output_conn(conn)
     { }
@@ -64,7 +65,7 @@ public:
 
     virtual void open_record() {}
     virtual void close_record(const snort::Connector::ID&) {}
-    void flush() { output_conn->flush(); }
+    virtual void flush() { output_conn->flush(); }
 
 protected:
     static snort::Connector* get_connector(const std::string& conn_name);
@@ -27,6 +27,7 @@
 
 #include <vector>
 
+#include "network_inspectors/extractor/extractor_columnar_logger.h"
 #include "network_inspectors/extractor/extractor_csv_logger.h"
 #include "network_inspectors/extractor/extractor_json_logger.h"
 #include "network_inspectors/extractor/extractor_null_conn.h"
@@ -225,4 +226,14 @@ TEST_CASE("JSON", "[Extractor]")
     SEQUENCE;
 }
 
+TEST_CASE("Columnar", "[Extractor]")
+{
+    ExtractorNullConnector nil;
+    ColumnarExtractorLogger logger(&nil, 8192, 0);
+    const Connector::ID& id = logger.get_id("");
+    const char* field = "test";
+
+    SEQUENCE;
+}
+
 #endif
@@ -0,0 +1,340 @@
+//--------------------------------------------------------------------------
+// Copyright (C) 2026 Cisco and/or its affiliates. All rights reserved.
+//
+// This program is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License Version 2 as published
+// by the Free Software Foundation.  You may not use, modify or distribute
+// this program under any other version of the GNU General Public License.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+//--------------------------------------------------------------------------
+
+// flow_ip_topk.cc author Cisco
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "flow_ip_topk.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+#include "hash/hashes.h"
+
+#ifdef UNIT_TEST
+#include <map>
+
+#include "catch/snort_catch.h"
+#endif
+
+static constexpr unsigned EMPTY_SLOT = ~0u;
+
+static inline uint64_t hash_key(const FlowStateKey& key)
+{
+    static_assert(sizeof(FlowStateKey) >= 4 * sizeof(uint64_t) + sizeof(uint32_t),
+        "unexpected FlowStateKey size");
+
+    uint64_t w[4];
+    uint32_t t;
+    memcpy(w, &key, sizeof(w));
+    memcpy(&t, (const uint8_t*)&key + sizeof(w), sizeof(t));
+
+    uint64_t h = snort::mix64(w[0] ^ t);
+    h = snort::mix64(h ^ w[1]);
+    h = snort::mix64(h ^ w[2]);
+    return snort::mix64(h ^ w[3]);
+}
+
+static inline bool same_key(const FlowStateKey& a, const FlowStateKey& b)
+{ return !memcmp(&a, &b, sizeof(FlowStateKey)); }
+
+size_t FlowIPTopK::entry_size()
+{
+    // one entry, one heap index and up to four open addressing slots
+    return sizeof(Entry) + 5 * sizeof(unsigned);
+}
+
+FlowIPTopK::FlowIPTopK(unsigned k) : max_entries(k ? k : 1)
+{
+    unsigned nslots = 2;
+
+    while ( nslots < 2 * max_entries )
+        nslots <<= 1;
+
+    mask = nslots - 1;
+    entries.resize(max_entries);
+    heap.resize(max_entries);
+    slots.assign(nslots, EMPTY_SLOT);
+}
+
+unsigned FlowIPTopK::find_slot(const FlowStateKey& key) const
+{
+    unsigned s = hash_key(key) & mask;
+
+    // the table is at most half full so an empty slot is always reached
+    while ( slots[s] != EMPTY_SLOT && !same_key(entries[slots[s]].key, key) )
+        s = (s + 1) & mask;
+
+    return s;
+}
+
+void FlowIPTopK::erase_slot(unsigned hole)
+{
+    // backward shift deletion keeps probe sequences intact without tombstones
+    unsigned s = hole;
+
+    while ( true )
+    {
+        s = (s + 1) & mask;
+
+        if ( slots[s] == EMPTY_SLOT )
+            break;
+
+        unsigned home = hash_key(entries[slots[s]].key) & mask;
+
+        if ( ((s - home) & mask) >= ((s - hole) & mask) )
+        {
+            slots[hole] = slots[s];
+            hole = s;
+        }
+    }
+    slots[hole] = EMPTY_SLOT;
+}
+
+void FlowIPTopK::swap_heap(unsigned a, unsigned b)
+{
+    std::swap(heap[a], heap[b]);
+    entries[heap[a]].heap_pos = a;
+    entries[heap[b]].heap_pos = b;
+}
+
+void FlowIPTopK::sift_up(unsigned pos)
+{
+    while ( pos )
+    {
+        unsigned parent = (pos - 1) / 2;
+
+        if ( entries[heap[parent]].count <= entries[heap[pos]].count )
+            break;
+
+        swap_heap(pos, parent);
+        pos = parent;
+    }
+}
+
+void FlowIPTopK::sift_down(unsigned pos)
+{
+    while ( true )
+    {
+        unsigned least = pos;
+        unsigned left = 2 * pos + 1;
+        unsigned right = left + 1;
+
+        if ( left < used && entries[heap[left]].count < entries[heap[least]].count )
+            least = left;
+
+        if ( right < used && entries[heap[right]].count < entries[heap[least]].count )
+            least = right;
+
+        if ( least == pos )
+            break;
+
+        swap_heap(pos, least);
+        pos = least;
+    }
+}
+
+FlowStateValue* FlowIPTopK::find(const FlowStateKey& key)
+{
+    unsigned s = find_slot(key);
+    return slots[s] == EMPTY_SLOT ? nullptr : &entries[slots[s]].value;
+}
+
+FlowStateValue* FlowIPTopK::update(const FlowStateKey& key, uint32_t len, bool& is_new)
+{
+    unsigned s = find_slot(key);
+
+    if ( slots[s] != EMPTY_SLOT )
+    {
+        Entry& e = entries[slots[s]];
+        e.count += len;
+        sift_down(e.heap_pos);
+        is_new = false;
+        return &e.value;
+    }
+
+    static constexpr FlowStateValue fsv_empty_value;
+    unsigned idx;
+    PegCount floor = 0;
+
+    if ( used < max_entries )
+    {
+        idx = used;
+        heap[used] = idx;
+        entries[idx].heap_pos = used++;
+    }
+    else
+    {
+        // the newcomer replaces the lightest pair and inherits its count
+        idx = heap[0];
+        floor = entries[idx].count;
+        erase_slot(find_slot(entries[idx].key));
+        s = find_slot(key);
+        evictions++;
+    }
+
+    Entry& e = entries[idx];
+    slots[s] = idx;
+    e.key = key;
+    e.value = fsv_empty_value;
+    e.count = floor + len;
+    e.error = floor;
+    admits++;
+
+    // appended entries are leaves and replaced entries are the root
+    if ( e.heap_pos )
+        sift_up(e.heap_pos);
+    else
+        sift_down(0);
+
+    is_new = true;
+    return &e.value;
+}
+
+void FlowIPTopK::get_sorted(std::vector<const Entry*>& out) const
+{
+    out.clear();
+    out.reserve(used);
+
+    for ( unsigned i = 0; i < used; ++i )
+        out.emplace_back(&entries[i]);
+
+    std::sort(out.begin(), out.end(),
+        [](const Entry* a, const Entry* b) { return a->count > b->count; });
+}
+
+void FlowIPTopK::reset()
+{
+    std::fill(slots.begin(), slots.end(), EMPTY_SLOT);
+    used = 0;
+}
+
+#ifdef UNIT_TEST
+
+static FlowStateKey make_key(uint32_t a, uint32_t b)
+{
+    FlowStateKey key;
+    key.ipA.set(&a, AF_INET);
+    key.ipB.set(&b, AF_INET);
+    return key;
+}
+
+TEST_CASE("exact below capacity", "[flow_ip_topk]")
+{
+    FlowIPTopK top(4);
+    bool is_new;
+
+    for ( uint32_t i = 1; i <= 4; ++i )
+        for ( uint32_t j = 0; j < i; ++j )
+            top.update(make_key(i, 100), 10, is_new);
+
+    CHECK(top.size() == 4);
+    CHECK(top.get_evictions() == 0);
+
+    std::vector<const FlowIPTopK::Entry*> out;
+    top.get_sorted(out);
+
+    REQUIRE(out.size() == 4);
+    for ( unsigned i = 0; i < 4; ++i )
+    {
+        CHECK(out[i]->count == 10 * (4 - i));
+        CHECK(out[i]->error == 0);
+    }
+}
+
+TEST_CASE("heavy hitter survives unique pair flood", "[flow_ip_topk]")
+{
+    FlowIPTopK top(8);
+    const FlowStateKey heavy = make_key(1, 2);
+    bool is_new;
+
+    for ( uint32_t i = 0; i < 10000; ++i )
+    {
+        FlowStateValue* v = top.update(heavy, 100, is_new);
+        REQUIRE(v);
+        v->total_bytes += 100;
+        top.update(make_key(1000 + i, 2), 60, is_new);
+        top.update(make_key(2, 50000 + i), 40, is_new);
+    }
+
+    CHECK(top.size() == 8);
+    CHECK(top.get_evictions() > 0);
+
+    FlowStateValue* v = top.find(heavy);
+    REQUIRE(v);
+    CHECK(v->total_bytes == 1000000);
+
+    std::vector<const FlowIPTopK::Entry*> out;
+    top.get_sorted(out);
+    CHECK(same_key(out[0]->key, heavy));
+}
+
+TEST_CASE("estimates bound true counts", "[flow_ip_topk]")
+{
+    FlowIPTopK top(16);
+    std::map<uint32_t, PegCount> truth;
+    uint32_t seed = 12345;
+    bool is_new;
+
+    for ( unsigned i = 0; i < 20000; ++i )
+    {
+        seed = seed * 1103515245 + 12345;
+        uint32_t a = (seed >> 16) % 64;
+        uint32_t len = 1 + (seed % 1500);
+        truth[a] += len;
+        top.update(make_key(a, 0xffffffff), len, is_new);
+    }
+
+    std::vector<const FlowIPTopK::Entry*> out;
+    top.get_sorted(out);
+    CHECK(out.size() == 16);
+
+    for ( auto e : out )
+    {
+        uint32_t a;
+        memcpy(&a, e->key.ipA.get_ip4_ptr(), sizeof(a));
+        CHECK(top.find(e->key) == &e->value);
+        CHECK(e->count >= truth[a]);
+        CHECK(e->count - e->error <= truth[a]);
+    }
+}
+
+TEST_CASE("find does not admit and reset empties", "[flow_ip_topk]")
+{
+    FlowIPTopK top(2);
+    bool is_new;
+
+    CHECK(top.find(make_key(1, 2)) == nullptr);
+    CHECK(top.size() == 0);
+
+    top.update(make_key(1, 2), 1, is_new);
+    CHECK(is_new);
+    top.update(make_key(1, 2), 1, is_new);
+    CHECK(!is_new);
+
+    top.reset();
+    CHECK(top.size() == 0);
+    CHECK(top.find(make_key(1, 2)) == nullptr);
+}
+
+#endif
+
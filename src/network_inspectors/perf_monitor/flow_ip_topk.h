@@ -0,0 +1,91 @@
+//--------------------------------------------------------------------------
+// Copyright (C) 2026 Cisco and/or its affiliates. All rights reserved.
+//
+// This program is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License Version 2 as published
+// by the Free Software Foundation.  You may not use, modify or distribute
+// this program under any other version of the GNU General Public License.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+//--------------------------------------------------------------------------
+
+// flow_ip_topk.h author Cisco
+
+#ifndef FLOW_IP_TOPK_H
+#define FLOW_IP_TOPK_H
+
+// FlowIPTopK keeps the k heaviest host pairs by bytes with the Space-Saving
+// algorithm.  Memory is fixed at construction and each packet costs one
+// open addressing probe plus an O(log k) heap adjustment, regardless of how
+// many distinct pairs are seen.
+
+#include <vector>
+
+#include "flow_ip_tracker.h"
+
+class FlowIPTopK
+{
+public:
+    struct Entry
+    {
+        FlowStateKey key;
+        FlowStateValue value;
+        PegCount count;     // estimated bytes, never less than the true count
+        PegCount error;     // maximum over-estimation inherited at admission
+        unsigned heap_pos;
+    };
+
+    explicit FlowIPTopK(unsigned k);
+
+    // returns the stats for a tracked pair or nullptr
+    FlowStateValue* find(const FlowStateKey&);
+
+    // adds len bytes to the pair, evicting the lightest pair if needed;
+    // is_new is set when the returned stats were (re)initialized
+    FlowStateValue* update(const FlowStateKey&, uint32_t len, bool& is_new);
+
+    // entries ordered by estimated bytes, heaviest first
+    void get_sorted(std::vector<const Entry*>&) const;
+
+    void reset();
+
+    unsigned size() const
+        { return used; }
+
+    unsigned capacity() const
+        { return max_entries; }
+
+    PegCount get_admits() const
+        { return admits; }
+
+    PegCount get_evictions() const
+        { return evictions; }
+
+    static size_t entry_size();
+
+private:
+    unsigned find_slot(const FlowStateKey&) const;
+    void erase_slot(unsigned);
+    void sift_up(unsigned);
+    void sift_down(unsigned);
+    void swap_heap(unsigned, unsigned);
+
+    std::vector<Entry> entries;
+    std::vector<unsigned> heap;
+    std::vector<unsigned> slots;
+    unsigned max_entries;
+    unsigned used = 0;
+    unsigned mask;
+    PegCount admits = 0;
+    PegCount evictions = 0;
+};
+
+#endif
+
@@ -24,6 +24,9 @@
 
 #include "flow_ip_tracker.h"
 
+#include <algorithm>
+#include <vector>
+
 #include <appid/appid_api.h>
 #include "flow/stream_flow.h"
 #include "framework/pig_pen.h"
@@ -31,6 +34,7 @@
 #include "log/messages.h"
 #include "protocols/packet.h"
 
+#include "flow_ip_topk.h"
 #include "perf_monitor.h"
 #include "perf_pegs.h"
 
@@ -40,18 +44,13 @@ using namespace snort;
 #define DEFAULT_XHASH_NROWS 1021
 #define TRACKER_NAME PERF_NAME "_flow_ip"
 
-struct FlowStateKey
-{
-    SfIp ipA;
-    SfIp ipB;
-};
-
 FlowStateValue* FlowIPTracker::find_stats(const SfIp* src_addr, const SfIp* dst_addr,
     int* swapped, const char* appid_name, uint16_t src_port, uint16_t dst_port,
-    uint8_t ip_protocol, uint64_t flow_latency, uint64_t rule_latency)
+    uint8_t ip_protocol, uint64_t flow_latency, uint64_t rule_latency, uint32_t len)
 {
     FlowStateKey key;
     FlowStateValue* value = nullptr;
+    bool is_new = false;
 
     if ( src_addr->less_than(*dst_addr) )
     {
@@ -66,8 +65,28 @@ FlowStateValue* FlowIPTracker::find_stats(const SfIp* src_addr, const SfIp* dst_
         *swapped = 1;
     }
 
-    value = (FlowStateValue*)ip_map->get_user_data(&key);
-    if ( value )
+    if ( top_k )
+    {
+        // state changes only annotate pairs already counted as heavy hitters
+        value = len ? top_k->update(key, len, is_new) : top_k->find(key);
+        if ( !value )
+            return nullptr;
+    }
+    else
+    {
+        value = (FlowStateValue*)ip_map->get_user_data(&key);
+        if ( !value )
+        {
+            if ( ip_map->insert(&key, nullptr) != HASH_OK )
+                return nullptr;
+            value = (FlowStateValue*)ip_map->get_user_data();
+            static constexpr FlowStateValue fsv_empty_value;
+            *value = fsv_empty_value;
+            is_new = true;
+        }
+    }
+
+    if ( !is_new )
     {
         strncpy(value->appid_name, appid_name, sizeof(value->appid_name) - 1);
         value->appid_name[sizeof(value->appid_name) - 1] = '\0';
@@ -85,14 +104,6 @@ FlowStateValue* FlowIPTracker::find_stats(const SfIp* src_addr, const SfIp* dst_
         value->total_flow_latency = flow_latency;
         value->total_rule_latency = rule_latency;
     }
-    else
-    {
-        if ( ip_map->insert(&key, nullptr) != HASH_OK )
-            return nullptr;
-        value = (FlowStateValue*)ip_map->get_user_data();
-        static constexpr FlowStateValue fsv_empty_value;
-        *value = fsv_empty_value;
-    }
 
     return value;
 }
@@ -101,6 +112,10 @@ bool FlowIPTracker::initialize(size_t new_memcap)
 {
     bool need_pruning = false;
 
+    // the heavy hitter table has a fixed size so there is nothing to prune
+    if ( top_k )
+        return false;
+
     if ( !ip_map )
     {
         ip_map = new XHash(DEFAULT_XHASH_NROWS, sizeof(FlowStateKey),
@@ -158,15 +173,33 @@ FlowIPTracker::FlowIPTracker(PerfConfig* perf) : PerfTracker(perf, TRACKER_NAME)
     formatter->register_field("protocol", protocol);
     formatter->register_field("flow_latency", flow_latency);
     formatter->register_field("rule_latency", rule_latency);
+    if ( perf->flow_ip_top_k )
+        formatter->register_field("bytes_error", &bytes_error);
     formatter->finalize_fields();
     stats.total_packets = stats.total_bytes = 0;
 
     memcap = perf->flowip_memcap;
-    ip_map = new XHash(DEFAULT_XHASH_NROWS, sizeof(FlowStateKey), sizeof(FlowStateValue), memcap);
+
+    if ( perf->flow_ip_top_k )
+    {
+        // the memcap still bounds the table when it is smaller than k entries
+        size_t k = std::min((size_t)perf->flow_ip_top_k, memcap / FlowIPTopK::entry_size());
+        top_k = new FlowIPTopK((unsigned)k);
+    }
+    else
+        ip_map = new XHash(DEFAULT_XHASH_NROWS, sizeof(FlowStateKey), sizeof(FlowStateValue), memcap);
 }
 
 FlowIPTracker::~FlowIPTracker()
 {
+    if ( top_k )
+    {
+        pmstats.flow_tracker_creates = top_k->get_admits();
+        pmstats.flow_tracker_total_deletes = top_k->get_evictions();
+        delete top_k;
+        return;
+    }
+
     const XHashStats& tmp_stats = ip_map->get_stats();
     pmstats.flow_tracker_creates = tmp_stats.nodes_created;
     pmstats.flow_tracker_total_deletes = tmp_stats.memcap_deletes;
@@ -176,7 +209,12 @@ FlowIPTracker::~FlowIPTracker()
 }
 
 void FlowIPTracker::reset()
-{ ip_map->clear_hash(); }
+{
+    if ( top_k )
+        top_k->reset();
+    else
+        ip_map->clear_hash();
+}
 
 void FlowIPTracker::update(Packet* p)
 {
@@ -226,7 +264,7 @@ void FlowIPTracker::update(Packet* p)
             type = SFS_TYPE_UDP;
 
         FlowStateValue* value = find_stats(src_addr, dst_addr, &swapped, curr_appid_name,
-            src_port, dst_port, ip_protocol, curr_flow_latency, curr_rule_latency);
+            src_port, dst_port, ip_protocol, curr_flow_latency, curr_rule_latency, len);
         if ( !value )
             return;
 
@@ -247,31 +285,45 @@ void FlowIPTracker::update(Packet* p)
     }
 }
 
-void FlowIPTracker::process(bool)
+void FlowIPTracker::write_entry(const FlowStateKey& key, const FlowStateValue& cur_stats)
 {
-    for (auto node = ip_map->find_first_node(); node; node = ip_map->find_next_node())
-    {
-        FlowStateKey* key = (FlowStateKey*)node->key;
-        FlowStateValue* cur_stats = (FlowStateValue*)node->data;
+    key.ipA.ntop(ip_a, sizeof(ip_a));
+    key.ipB.ntop(ip_b, sizeof(ip_b));
+
+    if (cur_stats.appid_name[0] != '\0')
+        strncpy(appid_name, cur_stats.appid_name, sizeof(appid_name) - 1);
+    else
+        strncpy(appid_name, "APPID_NONE", sizeof(appid_name) - 1);
+    appid_name[sizeof(appid_name) - 1] = '\0';
 
-        key->ipA.ntop(ip_a, sizeof(ip_a));
-        key->ipB.ntop(ip_b, sizeof(ip_b));
+    std::snprintf(port_a, sizeof(port_a), "%d", cur_stats.port_a);
+    std::snprintf(port_b, sizeof(port_b), "%d", cur_stats.port_b);
+    std::snprintf(protocol, sizeof(protocol), "%d", cur_stats.protocol);
+    std::snprintf(flow_latency, sizeof(flow_latency), "%lu", cur_stats.total_flow_latency);
+    std::snprintf(rule_latency, sizeof(rule_latency), "%lu", cur_stats.total_rule_latency);
 
-        if (cur_stats->appid_name[0] != '\0')
-            strncpy(appid_name, cur_stats->appid_name, sizeof(appid_name) - 1);
-        else
-            strncpy(appid_name, "APPID_NONE", sizeof(appid_name) - 1);
-        appid_name[sizeof(appid_name) - 1] = '\0';
+    memcpy(&stats, &cur_stats, sizeof(stats));
 
-        std::snprintf(port_a, sizeof(port_a), "%d", cur_stats->port_a);
-        std::snprintf(port_b, sizeof(port_b), "%d", cur_stats->port_b);
-        std::snprintf(protocol, sizeof(protocol), "%d", cur_stats->protocol);
-        std::snprintf(flow_latency, sizeof(flow_latency), "%lu", cur_stats->total_flow_latency);
-        std::snprintf(rule_latency, sizeof(rule_latency), "%lu", cur_stats->total_rule_latency);
+    write();
+}
 
-        memcpy(&stats, cur_stats, sizeof(stats));
+void FlowIPTracker::process(bool)
+{
+    if ( top_k )
+    {
+        std::vector<const FlowIPTopK::Entry*> top;
+        top_k->get_sorted(top);
 
-        write();
+        for ( auto e : top )
+        {
+            bytes_error = e->error;
+            write_entry(e->key, e->value);
+        }
+    }
+    else
+    {
+        for (auto node = ip_map->find_first_node(); node; node = ip_map->find_next_node())
+            write_entry(*(FlowStateKey*)node->key, *(FlowStateValue*)node->data);
     }
 
     if ( !(perf_flags & PERF_SUMMARY) )
@@ -285,7 +337,7 @@ int FlowIPTracker::update_state(const SfIp* src_addr, const SfIp* dst_addr,
     int swapped;
 
     FlowStateValue* value = find_stats(src_addr, dst_addr, &swapped, appid_name, src_port, dst_port,
-        ip_protocol, flow_latency, rule_latency);
+        ip_protocol, flow_latency, rule_latency, 0);
     if ( !value )
         return 1;
 
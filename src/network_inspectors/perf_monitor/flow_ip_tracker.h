@@ -22,6 +22,7 @@
 #define FLOW_IP_TRACKER_H
 
 #include "hash/xhash.h"
+#include "sfip/sf_ip.h"
 
 #include "network_inspectors/appid/application_ids.h"
 #include "perf_tracker.h"
@@ -50,6 +51,12 @@ struct TrafficStats
     PegCount  bytes_b_to_a;
 };
 
+struct FlowStateKey
+{
+    snort::SfIp ipA;
+    snort::SfIp ipB;
+};
+
 struct FlowStateValue
 {
     char appid_name[40] = "APPID_NONE";
@@ -64,6 +71,8 @@ struct FlowStateValue
     PegCount state_changes[SFS_STATE_MAX] = {};
 };
 
+class FlowIPTopK;
+
 class FlowIPTracker : public PerfTracker
 {
 public:
@@ -82,7 +91,9 @@ public:
 
 private:
     FlowStateValue stats;
-    snort::XHash* ip_map;
+    PegCount bytes_error = 0;
+    snort::XHash* ip_map = nullptr;
+    FlowIPTopK* top_k = nullptr;
     char ip_a[41], ip_b[41], port_a[8], port_b[8], protocol[8];
     char appid_name[40] = "APPID_NONE", flow_latency[20] = {}, rule_latency[20] = {};
     int perf_flags;
@@ -90,7 +101,8 @@ private:
     size_t memcap;
     FlowStateValue* find_stats(const snort::SfIp* src_addr, const snort::SfIp* dst_addr,
         int* swapped, const char* appid_name, uint16_t src_port, uint16_t dst_port,
-        uint8_t ip_protocol, uint64_t flow_latency, uint64_t rule_latency);
+        uint8_t ip_protocol, uint64_t flow_latency, uint64_t rule_latency, uint32_t len);
+    void write_entry(const FlowStateKey&, const FlowStateValue&);
     void write_stats();
     void display_stats();
 
@@ -82,6 +82,9 @@ static const Parameter s_params[] =
     { "flow_ip_memcap", Parameter::PT_INT, "236:maxSZ", "52428800",
       "maximum memory in bytes for flow tracking" },
 
+    { "flow_ip_top_k", Parameter::PT_INT, "0:max32", "0",
+      "track only the k host pairs with the most bytes; 0 tracks every pair up to flow_ip_memcap" },
+
     { "max_file_size", Parameter::PT_INT, "4096:max53", "1073741824",
       "files will be rolled over if they exceed this size" },
 
@@ -307,6 +310,10 @@ bool PerfMonModule::set(const char*, Value& v, SnortConfig*)
     {
         config->flowip_memcap = v.get_size();
     }
+    else if ( v.is("flow_ip_top_k") )
+    {
+        config->flow_ip_top_k = v.get_uint32();
+    }
     else if ( v.is("max_file_size") )
         config->max_file_size = v.get_uint64() - ROLLOVER_THRESH;
 
@@ -197,6 +197,7 @@ void PerfMonitor::show(const SnortConfig*) const
     if ( ConfigLogger::log_flag("flow_ip", config->perf_flags & PERF_FLOWIP) )
     {
         ConfigLogger::log_value("flow_ip_memcap", config->flowip_memcap);
+        ConfigLogger::log_value("flow_ip_top_k", config->flow_ip_top_k);
         ConfigLogger::log_value("flow_ip_all", config->flow_ip_all);
     }
 
@@ -281,7 +282,8 @@ bool PerfMonReloadTuner::tinit()
 
 bool PerfMonReloadTuner::tune_resources(unsigned work_limit)
 {
-    if (t_constraints->flow_ip_enabled)
+    // the top k table never grows so only the ip map needs tuning
+    if (t_constraints->flow_ip_enabled && flow_ip_tracker->get_ip_map())
     {
         unsigned num_freed = 0;
         int result = flow_ip_tracker->get_ip_map()->tune_memory_resources(work_limit, num_freed);
@@ -32,6 +32,7 @@
 
 #include "ps_inspect.h"
 #include "ps_module.h"
+#include "ps_sketch.h"
 
 using namespace snort;
 
@@ -397,6 +398,7 @@ static void portscan_config_show(const PortscanConfig* config)
         ConfigLogger::log_list("ignore_scanned", to_string(config->ignore_scanned).c_str());
 
     ConfigLogger::log_flag("alert_all", config->alert_all);
+    ConfigLogger::log_flag("shared", config->shared);
     ConfigLogger::log_flag("include_midstream", config->include_midstream);
 
     ConfigLogger::log_value("tcp_window", config->tcp_window);
@@ -410,16 +412,26 @@ static void portscan_config_show(const PortscanConfig* config)
 //-------------------------------------------------------------------------
 
 PortScan::PortScan(PortScanModule* mod)
-{ config = mod->get_data(); }
+{
+    config = mod->get_data();
+
+    if ( config->shared )
+        sketch = new PsSketch(config->memcap);
+}
 
 PortScan::~PortScan()
 {
+    delete sketch;
+
     if ( config )
         delete config;
 }
 
 void PortScan::tinit()
-{ ps_init_hash(config->memcap); }
+{
+    if ( !sketch )
+        ps_init_hash(config->memcap);
+}
 
 void PortScan::tterm()
 { ps_cleanup(); }
@@ -465,7 +477,10 @@ static void port_scan_tinit()
 { }
 
 static void port_scan_tterm()
-{ ps_cleanup(); }
+{
+    ps_cleanup();
+    ps_term_shared();
+}
 
 static Module* mod_ctor()
 { return new PortScanModule; }
@@ -45,6 +45,7 @@
 
 #include "ps_inspect.h"
 #include "ps_pegs.h"
+#include "ps_sketch.h"
 
 using namespace snort;
 
@@ -86,6 +87,17 @@ public:
 };
 
 static THREAD_LOCAL PortScanCache* portscan_hash = nullptr;
+
+// with shared tracking, updates for the current packet are applied to the
+// sketch and the trackers are filled from it once, just before the alert
+// checks read them
+struct PS_SHARED_TRACKER
+{
+    PS_TRACKER tracker;
+    PsSketch::Key key;
+};
+
+static THREAD_LOCAL PS_SHARED_TRACKER* shared_trackers = nullptr;
 extern THREAD_LOCAL PsPegStats spstats;
 
 PS_PKT::PS_PKT(Packet* p)
@@ -121,6 +133,12 @@ void ps_cleanup()
     }
 }
 
+void ps_term_shared()
+{
+    delete[] shared_trackers;
+    shared_trackers = nullptr;
+}
+
 unsigned ps_node_size()
 { return sizeof(PS_HASH_KEY) + sizeof(PS_TRACKER); }
 
@@ -325,6 +343,22 @@ static PS_TRACKER* ps_tracker_get(PS_HASH_KEY* key)
     return ht;
 }
 
+static PS_TRACKER* ps_shared_tracker_get(PsSketch* sketch, PS_HASH_KEY* key, unsigned idx)
+{
+    if ( !shared_trackers )
+        shared_trackers = new PS_SHARED_TRACKER[2];
+
+    PS_SHARED_TRACKER& st = shared_trackers[idx];
+
+    memset(&st.tracker, 0, sizeof(st.tracker));
+    st.key = sketch->get_key(key, sizeof(*key));
+
+    if ( sketch->is_alerted(st.key) )
+        st.tracker.proto.alerts = PS_ALERT_GENERATED;
+
+    return &st.tracker;
+}
+
 bool PortScan::ps_tracker_lookup(
     PS_PKT* ps_pkt, PS_TRACKER** scanner, PS_TRACKER** scanned)
 {
@@ -358,7 +392,7 @@ bool PortScan::ps_tracker_lookup(
             key.group = p->get_egress_group();
         }
 
-        *scanned = ps_tracker_get(&key);
+        *scanned = sketch ? ps_shared_tracker_get(sketch, &key, 0) : ps_tracker_get(&key);
     }
 
     //  Let's lookup the host that is scanning.
@@ -378,7 +412,7 @@ bool PortScan::ps_tracker_lookup(
             key.group = p->get_ingress_group();
         }
 
-        *scanner = ps_tracker_get(&key);
+        *scanner = sketch ? ps_shared_tracker_get(sketch, &key, 1) : ps_tracker_get(&key);
     }
 
     return *scanner or *scanned;
@@ -462,18 +496,32 @@ void PortScan::ps_proto_update_window(unsigned interval, PS_PROTO* proto, time_t
 /*
 **  This function updates the PS_PROTO structure.
 **
-**  @param PS_PROTO pointer to structure to update
+**  @param PS_TRACKER pointer to tracker to update
 **  @param int      number to increment portscan counter
 **  @param u_long   IP address of other host
 **  @param unsigned short  port/ip_proto to track
 **  @param time_t   time the packet was received. update windows.
 */
-int PortScan::ps_proto_update(PS_PROTO* proto, int ps_cnt, int pri_cnt,
+int PortScan::ps_proto_update(PS_TRACKER* tracker, int ps_cnt, int pri_cnt,
     unsigned window, const SfIp* ip, unsigned short port, time_t pkt_time)
 {
-    if (!proto)
+    if (!tracker)
         return 0;
 
+    PS_PROTO* proto = &tracker->proto;
+
+    if ( sketch )
+    {
+        const PsSketch::Key& key = ((PS_SHARED_TRACKER*)tracker)->key;
+        sketch->update(key, ps_cnt, pri_cnt, window, ip, port, pkt_time);
+
+        // the address range is only known for the current packet
+        if ( ps_cnt >= 0 and !pri_cnt )
+            proto->low_ip = proto->high_ip = *ip;
+
+        return 0;
+    }
+
     /*
     **  If the ps_cnt is negative, that means we are just taking off
     **  for valid connection, and we don't want to do anything else,
@@ -638,13 +686,13 @@ void PortScan::ps_tracker_update_tcp(PS_PKT* ps_pkt, PS_TRACKER* scanner,
         {
             if (scanned)
             {
-                ps_proto_update(&scanned->proto, 1, 0, win,
+                ps_proto_update(scanned, 1, 0, win,
                     p->ptrs.ip_api.get_src(), p->ptrs.dp, packet_time());
             }
 
             if (scanner)
             {
-                ps_proto_update(&scanner->proto, 1, 0, win,
+                ps_proto_update(scanner, 1, 0, win,
                     p->ptrs.ip_api.get_dst(), p->ptrs.dp, packet_time());
             }
         }
@@ -653,12 +701,12 @@ void PortScan::ps_tracker_update_tcp(PS_PKT* ps_pkt, PS_TRACKER* scanner,
         {
             if (scanned)
             {
-                ps_proto_update(&scanned->proto, -1, 0, win, &cleared, 0, 0);
+                ps_proto_update(scanned, -1, 0, win, &cleared, 0, 0);
             }
 
             if (scanner)
             {
-                ps_proto_update(&scanner->proto, -1, 0, win, &cleared, 0, 0);
+                ps_proto_update(scanner, -1, 0, win, &cleared, 0, 0);
             }
         }
         //  RST packet on unestablished streams
@@ -669,13 +717,13 @@ void PortScan::ps_tracker_update_tcp(PS_PKT* ps_pkt, PS_TRACKER* scanner,
         {
             if (scanned)
             {
-                ps_proto_update(&scanned->proto, 0, 1, win, &cleared, 0, 0);
+                ps_proto_update(scanned, 0, 1, win, &cleared, 0, 0);
                 scanned->priority_node = 1;
             }
 
             if (scanner)
             {
-                ps_proto_update(&scanner->proto, 0, 1, win, &cleared, 0, 0);
+                ps_proto_update(scanner, 0, 1, win, &cleared, 0, 0);
                 scanner->priority_node = 1;
             }
         }
@@ -704,13 +752,13 @@ void PortScan::ps_tracker_update_tcp(PS_PKT* ps_pkt, PS_TRACKER* scanner,
         */
         if (scanned)
         {
-            ps_proto_update(&scanned->proto, 1, 0, win,
+            ps_proto_update(scanned, 1, 0, win,
                 p->ptrs.ip_api.get_src(), p->ptrs.dp, packet_time());
         }
 
         if (scanner)
         {
-            ps_proto_update(&scanner->proto, 1, 0, win,
+            ps_proto_update(scanner, 1, 0, win,
                 p->ptrs.ip_api.get_dst(), p->ptrs.dp, packet_time());
         }
     }
@@ -723,12 +771,12 @@ void PortScan::ps_tracker_update_tcp(PS_PKT* ps_pkt, PS_TRACKER* scanner,
     {
         if (scanned)
         {
-            ps_proto_update(&scanned->proto, -1, 0, win, &cleared, 0, 0);
+            ps_proto_update(scanned, -1, 0, win, &cleared, 0, 0);
         }
 
         if (scanner)
         {
-            ps_proto_update(&scanner->proto, -1, 0, win, &cleared, 0, 0);
+            ps_proto_update(scanner, -1, 0, win, &cleared, 0, 0);
         }
     }
     /*
@@ -739,13 +787,13 @@ void PortScan::ps_tracker_update_tcp(PS_PKT* ps_pkt, PS_TRACKER* scanner,
     {
         if (scanned)
         {
-            ps_proto_update(&scanned->proto, 0, 1, win, &cleared, 0, 0);
+            ps_proto_update(scanned, 0, 1, win, &cleared, 0, 0);
             scanned->priority_node = 1;
         }
 
         if (scanner)
         {
-            ps_proto_update(&scanner->proto, 0, 1, win, &cleared, 0, 0);
+            ps_proto_update(scanner, 0, 1, win, &cleared, 0, 0);
             scanner->priority_node = 1;
         }
     }
@@ -754,13 +802,13 @@ void PortScan::ps_tracker_update_tcp(PS_PKT* ps_pkt, PS_TRACKER* scanner,
     {
         if (scanned)
         {
-            ps_proto_update(&scanned->proto, 0, 1, win, &cleared, 0, 0);
+            ps_proto_update(scanned, 0, 1, win, &cleared, 0, 0);
             scanned->priority_node = 1;
         }
 
         if (scanner)
         {
-            ps_proto_update(&scanner->proto, 0, 1, win, &cleared, 0, 0);
+            ps_proto_update(scanner, 0, 1, win, &cleared, 0, 0);
             scanner->priority_node = 1;
         }
     }
@@ -784,12 +832,12 @@ void PortScan::ps_tracker_update_ip(PS_PKT* ps_pkt, PS_TRACKER* scanner,
         {
             if (scanned)
             {
-                ps_proto_update(&scanned->proto, 0, 1, win, &cleared, 0, 0);
+                ps_proto_update(scanned, 0, 1, win, &cleared, 0, 0);
                 scanned->priority_node = 1;
             }
             if(scanner)
             {
-                ps_proto_update(&scanner->proto, 0, 1, win, &cleared, 0, 0);
+                ps_proto_update(scanner, 0, 1, win, &cleared, 0, 0);
                 scanner->priority_node = 1;
             }
         }
@@ -800,12 +848,12 @@ void PortScan::ps_tracker_update_ip(PS_PKT* ps_pkt, PS_TRACKER* scanner,
     {
         if (scanned)
         {
-            ps_proto_update(&scanned->proto, 1, 0, win, p->ptrs.ip_api.get_src(),
+            ps_proto_update(scanned, 1, 0, win, p->ptrs.ip_api.get_src(),
                 (unsigned short)p->get_ip_proto_next(), packet_time());
         }
         if (scanner)
         {
-            ps_proto_update(&scanner->proto, 1, 0, win, p->ptrs.ip_api.get_dst(),
+            ps_proto_update(scanner, 1, 0, win, p->ptrs.ip_api.get_dst(),
                 (unsigned short)p->get_ip_proto_next(), packet_time());
         }
     }
@@ -824,13 +872,13 @@ void PortScan::ps_tracker_update_udp(
     {
         if (scanned)
         {
-            ps_proto_update(&scanned->proto, 0, 1, win, &cleared, 0, 0);
+            ps_proto_update(scanned, 0, 1, win, &cleared, 0, 0);
             scanned->priority_node = 1;
         }
 
         if (scanner)
         {
-            ps_proto_update(&scanner->proto, 0, 1, win, &cleared, 0, 0);
+            ps_proto_update(scanner, 0, 1, win, &cleared, 0, 0);
             scanner->priority_node = 1;
         }
     }
@@ -844,23 +892,23 @@ void PortScan::ps_tracker_update_udp(
             {
                 if (scanned)
                 {
-                    ps_proto_update(&scanned->proto, 1, 0, win,
+                    ps_proto_update(scanned, 1, 0, win,
                         p->ptrs.ip_api.get_src(), p->ptrs.dp, packet_time());
                 }
 
                 if (scanner)
                 {
-                    ps_proto_update(&scanner->proto, 1, 0, win,
+                    ps_proto_update(scanner, 1, 0, win,
                         p->ptrs.ip_api.get_dst(), p->ptrs.dp, packet_time());
                 }
             }
             else if (direction == PKT_FROM_SERVER)
             {
                 if (scanned)
-                    ps_proto_update(&scanned->proto, -1, 0, win, &cleared, 0, 0);
+                    ps_proto_update(scanned, -1, 0, win, &cleared, 0, 0);
 
                 if (scanner)
-                    ps_proto_update(&scanner->proto, -1, 0, win, &cleared, 0, 0);
+                    ps_proto_update(scanner, -1, 0, win, &cleared, 0, 0);
             }
         }
     }
@@ -882,7 +930,7 @@ void PortScan::ps_tracker_update_icmp(
         case ICMP_INFO_REQUEST:
             if (scanner)
             {
-                ps_proto_update(&scanner->proto, 1, 0, win,
+                ps_proto_update(scanner, 1, 0, win,
                     p->ptrs.ip_api.get_dst(), 0, packet_time());
             }
             break;
@@ -893,7 +941,7 @@ void PortScan::ps_tracker_update_icmp(
                 SfIp cleared;
                 cleared.clear();
 
-                ps_proto_update(&scanner->proto, 0, 1, win, &cleared, 0, 0);
+                ps_proto_update(scanner, 0, 1, win, &cleared, 0, 0);
                 scanner->priority_node = 1;
             }
             break;
@@ -1185,6 +1233,16 @@ void PortScan::ps_alert_icmp(PS_PROTO* scanner, PS_PROTO* scanned)
     }
 }
 
+// another thread may have raised the same alert first
+static void ps_shared_alert(PsSketch* sketch, PS_TRACKER* tracker)
+{
+    if ( !tracker or !tracker->proto.alerts or tracker->proto.alerts == PS_ALERT_GENERATED )
+        return;
+
+    if ( !sketch->set_alert(((PS_SHARED_TRACKER*)tracker)->key, tracker->proto.alerts) )
+        tracker->proto.alerts = PS_ALERT_GENERATED;
+}
+
 /*
 **  This function evaluates the scanner and scanned trackers and if
 **  applicable, generate an alert or alerts for either of the trackers.
@@ -1202,6 +1260,15 @@ bool PortScan::ps_tracker_alert(
     PS_PROTO* scanner_proto = nullptr;
     PS_PROTO* scanned_proto = nullptr;
 
+    if ( sketch )
+    {
+        if ( scanner )
+            sketch->get(((PS_SHARED_TRACKER*)scanner)->key, scanner->proto);
+
+        if ( scanned )
+            sketch->get(((PS_SHARED_TRACKER*)scanned)->key, scanned->proto);
+    }
+
     if ( scanner )
     {
         if ( config->alert_all )
@@ -1238,6 +1305,12 @@ bool PortScan::ps_tracker_alert(
         return false;
     }
 
+    if ( sketch and !config->alert_all )
+    {
+        ps_shared_alert(sketch, scanner);
+        ps_shared_alert(sketch, scanned);
+    }
+
     return true;
 }
 
@@ -86,6 +86,7 @@ struct PortscanConfig
 
     bool alert_all;
     bool logfile;
+    bool shared;
 
     unsigned tcp_window;
     unsigned udp_window;
@@ -161,6 +162,7 @@ struct PS_PKT
 };
 
 void ps_cleanup();
+void ps_term_shared();
 void ps_reset();
 void ps_update_memusage_peg();
 
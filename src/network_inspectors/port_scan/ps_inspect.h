@@ -35,6 +35,7 @@ struct SfIp;
 struct PS_PROTO;
 struct PS_TRACKER;
 struct PS_PKT;
+class PsSketch;
 
 class PortScan : public snort::Inspector
 {
@@ -64,7 +65,7 @@ private:
 
     void ps_proto_update_window(unsigned window, PS_PROTO*, time_t pkt_time);
 
-    int ps_proto_update( PS_PROTO*, int ps_cnt, int pri_cnt, unsigned window, const snort::SfIp* ip,
+    int ps_proto_update( PS_TRACKER*, int ps_cnt, int pri_cnt, unsigned window, const snort::SfIp* ip,
         unsigned short port, time_t pkt_time);
 
     void ps_tracker_update_ip(PS_PKT*, PS_TRACKER* scanner, PS_TRACKER* scanned);
@@ -79,6 +80,7 @@ private:
 
 private:
     PortscanConfig* config;
+    PsSketch* sketch = nullptr;     // shared by all packet threads if configured
 };
 
 #endif
@@ -86,6 +86,10 @@ static const Parameter ps_params[] =
     { "include_midstream", Parameter::PT_BOOL, nullptr, "false",
       "list of CIDRs with optional ports" },
 
+    { "shared", Parameter::PT_BOOL, nullptr, "false",
+      "track scans across all packet threads in fixed size sketches limited by memcap "
+      "instead of exact trackers per thread" },
+
     { "tcp_ports", Parameter::PT_TABLE, scan_params, nullptr,
       "TCP port scan configuration (one-to-one)" },
 
@@ -261,6 +265,9 @@ bool PortScanModule::set(const char* fqn, Value& v, SnortConfig*)
     else if ( v.is("alert_all") )
         config->alert_all = v.get_bool();
 
+    else if ( v.is("shared") )
+        config->shared = v.get_bool();
+
     else if ( v.is("include_midstream") )
         config->include_midstream = v.get_bool();
 
@@ -331,7 +338,7 @@ bool PortScanModule::set(const char* fqn, Value& v, SnortConfig*)
 bool PortScanModule::end(const char* fqn, int, SnortConfig* sc)
 {
     if ( PigPen::snort_is_reloading() && strcmp(fqn, "port_scan") == 0 )
-        sc->register_reload_handler(new PortScanReloadTuner(config->memcap));
+        sc->register_reload_handler(new PortScanReloadTuner(config->memcap, config->shared));
     return true;
 }
 
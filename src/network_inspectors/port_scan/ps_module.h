@@ -142,14 +142,22 @@ struct SnortConfig;
 class PortScanReloadTuner : public snort::ReloadResourceTuner
 {
 public:
-    explicit PortScanReloadTuner(size_t memcap) : memcap(memcap) { }
+    PortScanReloadTuner(size_t memcap, bool shared) : memcap(memcap), shared(shared) { }
     ~PortScanReloadTuner() override = default;
 
     const char* name() const override
     { return "PortScanReloadTuner"; }
 
     bool tinit() override
-    { return ps_init_hash(memcap); }
+    {
+        // the shared sketch is built with the new inspector
+        if ( shared )
+        {
+            ps_cleanup();
+            return false;
+        }
+        return ps_init_hash(memcap);
+    }
 
     bool tune_idle_context() override
     { return ps_prune_hash(max_work_idle); }
@@ -159,6 +167,7 @@ public:
 
 private:
     size_t memcap;
+    bool shared;
 };
 
 //-------------------------------------------------------------------------
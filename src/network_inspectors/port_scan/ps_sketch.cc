@@ -0,0 +1,254 @@
+//--------------------------------------------------------------------------
+// Copyright (C) 2026 Cisco and/or its affiliates. All rights reserved.
+//
+// This program is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License Version 2 as published
+// by the Free Software Foundation.  You may not use, modify or distribute
+// this program under any other version of the GNU General Public License.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+//--------------------------------------------------------------------------
+// ps_sketch.cc author Cisco
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "ps_sketch.h"
+
+#include <cmath>
+#include <cstring>
+
+#include "hash/hashes.h"
+#include "sfip/sf_ip.h"
+
+#include "ps_detect.h"
+
+using namespace snort;
+
+static inline uint64_t hash_ip(const SfIp* ip)
+{
+    const uint32_t* a = ip->get_ip6_ptr();
+    uint64_t hi = ((uint64_t)a[0] << 32) | a[1];
+    uint64_t lo = ((uint64_t)a[2] << 32) | a[3];
+    return mix64(hi ^ mix64(lo));
+}
+
+namespace
+{
+// 2^-r for each register value and the linear counting estimate for each
+// number of zero registers so that estimates need no ldexp or log
+template<unsigned regs, unsigned max_rank>
+struct HllTables
+{
+    HllTables()
+    {
+        for ( unsigned r = 0; r <= max_rank; ++r )
+            pow[r] = std::ldexp(1.0, -(int)r);
+
+        for ( unsigned z = 1; z <= regs; ++z )
+            linear[z] = regs * std::log((double)regs / z);
+    }
+
+    double pow[max_rank + 1];
+    double linear[regs + 1] = { };
+};
+}
+
+// lower the counter by at most n without going below zero
+static inline void sub_floor(std::atomic<int32_t>& c, int32_t n)
+{
+    int32_t v = c.load(std::memory_order_relaxed);
+
+    while ( v > 0 and !c.compare_exchange_weak(v, v > n ? v - n : 0,
+        std::memory_order_relaxed) );
+}
+
+PsSketch::PsSketch(size_t memcap)
+{
+    cols = memcap / (rows * sizeof(Cell));
+
+    if ( !cols )
+        cols = 1;
+
+    // value initialization zeroes the cells
+    cells.reset(new Cell[rows * cols]());
+}
+
+size_t PsSketch::get_mem_used() const
+{ return sizeof(*this) + rows * cols * sizeof(Cell); }
+
+PsSketch::Key PsSketch::get_key(const void* key, unsigned len) const
+{
+    const uint8_t* data = (const uint8_t*)key;
+    uint64_t h = len;
+
+    while ( len )
+    {
+        uint64_t w = 0;
+        unsigned n = len < sizeof(w) ? len : sizeof(w);
+        memcpy(&w, data, n);
+        h = mix64(h ^ w);
+        data += n;
+        len -= n;
+    }
+    Key k;
+
+    for ( unsigned r = 0; r < rows; ++r )
+        k.cell[r] = mix64(h + (r + 1) * 0x9e3779b97f4a7c15ULL) % cols;
+
+    return k;
+}
+
+void PsSketch::reset(Cell& c)
+{
+    c.connection_count.store(0, std::memory_order_relaxed);
+    c.priority_count.store(0, std::memory_order_relaxed);
+    c.low_p.store(0, std::memory_order_relaxed);
+    c.high_p.store(0, std::memory_order_relaxed);
+    c.alerts.store(0, std::memory_order_relaxed);
+
+    for ( unsigned i = 0; i < hll_regs; ++i )
+    {
+        c.ips[i].store(0, std::memory_order_relaxed);
+        c.ports[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+void PsSketch::add_hll(std::atomic<uint8_t>* regs, uint64_t hash)
+{
+    static_assert(hll_regs == 64, "register index uses 6 bits");
+    static_assert(hll_max_rank == 64 - 6 + 1, "rank of the remaining 58 bits");
+
+    std::atomic<uint8_t>& reg = regs[hash & (hll_regs - 1)];
+    uint64_t w = hash >> 6;
+    uint8_t rank = w ? __builtin_ctzll(w) + 1 : hll_max_rank;
+    uint8_t cur = reg.load(std::memory_order_relaxed);
+
+    // repeated items leave the register unchanged so there is no write
+    while ( rank > cur and !reg.compare_exchange_weak(cur, rank, std::memory_order_relaxed) );
+}
+
+unsigned PsSketch::estimate_hll(const std::atomic<uint8_t>* regs)
+{
+    static const HllTables<hll_regs, hll_max_rank> tables;
+
+    double sum = 0;
+    unsigned zeros = 0;
+
+    for ( unsigned i = 0; i < hll_regs; ++i )
+    {
+        uint8_t r = regs[i].load(std::memory_order_relaxed);
+        sum += tables.pow[r];
+
+        if ( !r )
+            ++zeros;
+    }
+    const double m = hll_regs;
+    double est = 0.709 * m * m / sum;
+
+    // linear counting is much more accurate for the small counts that
+    // the default thresholds use
+    if ( est <= 2.5 * m and zeros )
+        est = tables.linear[zeros];
+
+    return (unsigned)std::lround(est);
+}
+
+void PsSketch::update(const Key& k, int ps_cnt, int pri_cnt, unsigned window,
+    const SfIp* ip, uint16_t port, time_t now)
+{
+    for ( unsigned r = 0; r < rows; ++r )
+    {
+        Cell& c = get_cell(k, r);
+
+        if ( ps_cnt < 0 )
+        {
+            sub_floor(c.connection_count, -ps_cnt);
+            continue;
+        }
+        if ( pri_cnt )
+        {
+            c.priority_count.fetch_add(pri_cnt, std::memory_order_relaxed);
+            continue;
+        }
+        time_t end = c.window.load(std::memory_order_relaxed);
+
+        if ( now > end and c.window.compare_exchange_strong(end, now + window,
+            std::memory_order_relaxed) )
+            reset(c);
+
+        c.connection_count.fetch_add(ps_cnt, std::memory_order_relaxed);
+
+        add_hll(c.ips, hash_ip(ip));
+        add_hll(c.ports, mix64(port));
+
+        uint16_t p = c.low_p.load(std::memory_order_relaxed);
+        while ( (!p or p > port) and !c.low_p.compare_exchange_weak(p, port,
+            std::memory_order_relaxed) );
+
+        p = c.high_p.load(std::memory_order_relaxed);
+        while ( p < port and !c.high_p.compare_exchange_weak(p, port,
+            std::memory_order_relaxed) );
+    }
+}
+
+void PsSketch::get(const Key& k, PS_PROTO& proto) const
+{
+    for ( unsigned r = 0; r < rows; ++r )
+    {
+        const Cell& c = get_cell(k, r);
+        int conn = c.connection_count.load(std::memory_order_relaxed);
+        int pri = c.priority_count.load(std::memory_order_relaxed);
+        int u_ip = estimate_hll(c.ips);
+        int u_port = estimate_hll(c.ports);
+
+        if ( !r or conn < proto.connection_count )
+            proto.connection_count = conn;
+
+        if ( !r or pri < proto.priority_count )
+            proto.priority_count = pri;
+
+        if ( !r or u_ip < proto.u_ip_count )
+            proto.u_ip_count = u_ip;
+
+        if ( !r or u_port < proto.u_port_count )
+        {
+            proto.u_port_count = u_port;
+            proto.low_p = c.low_p.load(std::memory_order_relaxed);
+            proto.high_p = c.high_p.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool PsSketch::set_alert(const Key& k, unsigned char alert)
+{
+    bool raised = false;
+
+    for ( unsigned r = 0; r < rows; ++r )
+    {
+        uint8_t none = 0;
+
+        if ( get_cell(k, r).alerts.compare_exchange_strong(none, alert,
+            std::memory_order_relaxed) )
+            raised = true;
+    }
+    return raised;
+}
+
+bool PsSketch::is_alerted(const Key& k) const
+{
+    for ( unsigned r = 0; r < rows; ++r )
+    {
+        if ( !get_cell(k, r).alerts.load(std::memory_order_relaxed) )
+            return false;
+    }
+    return true;
+}
@@ -0,0 +1,104 @@
+//--------------------------------------------------------------------------
+// Copyright (C) 2026 Cisco and/or its affiliates. All rights reserved.
+//
+// This program is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License Version 2 as published
+// by the Free Software Foundation.  You may not use, modify or distribute
+// this program under any other version of the GNU General Public License.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+//--------------------------------------------------------------------------
+// ps_sketch.h author Cisco
+
+#ifndef PS_SKETCH_H
+#define PS_SKETCH_H
+
+// PsSketch holds port scan state shared by all packet threads in a fixed
+// amount of memory.  It is a count-min sketch whose cells hold a complete
+// set of tracker counters: connection and priority counts plus HyperLogLog
+// registers for the distinct addresses and ports seen.  Each tracker key
+// maps to one cell per row and estimates take the minimum over the rows, so
+// collisions can only inflate the counts.  All updates are lock-free relaxed
+// atomics; a racing update or window reset may be lost, which only adds to
+// the approximation.
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <memory>
+
+namespace snort
+{
+struct SfIp;
+}
+struct PS_PROTO;
+
+class PsSketch
+{
+public:
+    static constexpr unsigned rows = 2;
+
+    struct Key
+    {
+        uint32_t cell[rows];
+    };
+
+    // memcap is the total for all threads
+    explicit PsSketch(size_t memcap);
+
+    Key get_key(const void* key, unsigned len) const;
+
+    // same semantics as the per thread tracker update: a negative ps_cnt
+    // only removes connections, a pri_cnt only adds priority points, and
+    // otherwise the window is checked before counting the address and port
+    void update(const Key&, int ps_cnt, int pri_cnt, unsigned window,
+        const snort::SfIp* ip, uint16_t port, time_t now);
+
+    // fill the counters and port range of the given proto with estimates
+    void get(const Key&, PS_PROTO&) const;
+
+    // returns true if this call raised the alert for the current window
+    bool set_alert(const Key&, unsigned char alert);
+    bool is_alerted(const Key&) const;
+
+    size_t get_cell_count() const
+    { return cols * rows; }
+
+    size_t get_mem_used() const;
+
+private:
+    static constexpr unsigned hll_regs = 64;
+    static constexpr unsigned hll_max_rank = 59;
+
+    struct Cell
+    {
+        std::atomic<time_t> window;
+        std::atomic<int32_t> connection_count;
+        std::atomic<int32_t> priority_count;
+        std::atomic<uint16_t> low_p;
+        std::atomic<uint16_t> high_p;
+        std::atomic<uint8_t> alerts;
+        std::atomic<uint8_t> ips[hll_regs];
+        std::atomic<uint8_t> ports[hll_regs];
+    };
+
+    Cell& get_cell(const Key& k, unsigned row) const
+    { return cells[row * cols + k.cell[row]]; }
+
+    static void reset(Cell&);
+    static void add_hll(std::atomic<uint8_t>* regs, uint64_t hash);
+    static unsigned estimate_hll(const std::atomic<uint8_t>* regs);
+
+    size_t cols;
+    std::unique_ptr<Cell[]> cells;
+};
+
+#endif
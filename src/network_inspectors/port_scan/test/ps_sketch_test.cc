@@ -0,0 +1,169 @@
+//--------------------------------------------------------------------------
+// Copyright (C) 2026 Cisco and/or its affiliates. All rights reserved.
+//
+// This program is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License Version 2 as published
+// by the Free Software Foundation.  You may not use, modify or distribute
+// this program under any other version of the GNU General Public License.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+//--------------------------------------------------------------------------
+// ps_sketch_test.cc author Cisco
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "network_inspectors/port_scan/ps_detect.h"
+#include "network_inspectors/port_scan/ps_sketch.h"
+
+#include <CppUTest/CommandLineTestRunner.h>
+#include <CppUTest/TestHarness.h>
+
+using namespace snort;
+
+namespace snort
+{
+char* snort_strdup(const char* str)
+{
+    size_t n = strlen(str) + 1;
+    char* p = new char[n];
+    memcpy(p, str, n);
+    return p;
+}
+}
+
+static SfIp make_ip(uint32_t n)
+{
+    SfIp ip;
+    ip.set(&n, AF_INET);
+    return ip;
+}
+
+TEST_GROUP(ps_sketch)
+{
+};
+
+// distinct counts follow the actual number of addresses and ports, not
+// the number of attempts
+TEST(ps_sketch, distinct_counts)
+{
+    PsSketch sketch(1 << 20);
+    const char* id = "scanner";
+    PsSketch::Key key = sketch.get_key(id, strlen(id));
+
+    for ( unsigned i = 0; i < 200; ++i )
+    {
+        SfIp ip = make_ip(i % 20);
+        sketch.update(key, 1, 0, 60, &ip, 1000 + (i % 40), 1);
+    }
+    PS_PROTO proto;
+    memset(&proto, 0, sizeof(proto));
+    sketch.get(key, proto);
+
+    CHECK(200 == proto.connection_count);
+    CHECK(proto.u_ip_count >= 18 and proto.u_ip_count <= 22);
+    CHECK(proto.u_port_count >= 36 and proto.u_port_count <= 44);
+    CHECK(1000 == proto.low_p);
+    CHECK(1039 == proto.high_p);
+
+    // other keys are not affected
+    const char* other = "other";
+    memset(&proto, 0, sizeof(proto));
+    sketch.get(sketch.get_key(other, strlen(other)), proto);
+    CHECK(0 == proto.connection_count);
+    CHECK(0 == proto.u_port_count);
+}
+
+TEST(ps_sketch, window)
+{
+    PsSketch sketch(1 << 20);
+    uint32_t id = 1;
+    PsSketch::Key key = sketch.get_key(&id, sizeof(id));
+    SfIp ip = make_ip(1);
+
+    sketch.update(key, 1, 0, 10, &ip, 80, 100);
+    sketch.update(key, 0, 1, 10, &ip, 0, 100);
+    sketch.update(key, 1, 0, 10, &ip, 81, 105);
+    sketch.update(key, -1, 0, 10, &ip, 0, 105);
+
+    PS_PROTO proto;
+    memset(&proto, 0, sizeof(proto));
+    sketch.get(key, proto);
+    CHECK(1 == proto.connection_count);
+    CHECK(1 == proto.priority_count);
+    CHECK(2 == proto.u_port_count);
+
+    // removals never go below zero
+    sketch.update(key, -1, 0, 10, &ip, 0, 105);
+    sketch.update(key, -1, 0, 10, &ip, 0, 105);
+    sketch.get(key, proto);
+    CHECK(0 == proto.connection_count);
+
+    CHECK(sketch.set_alert(key, PS_ALERT_ONE_TO_ONE));
+    CHECK(!sketch.set_alert(key, PS_ALERT_ONE_TO_ONE));
+    CHECK(sketch.is_alerted(key));
+
+    // the next attempt after the window starts over
+    sketch.update(key, 1, 0, 10, &ip, 82, 111);
+    sketch.get(key, proto);
+    CHECK(1 == proto.connection_count);
+    CHECK(0 == proto.priority_count);
+    CHECK(1 == proto.u_port_count);
+    CHECK(!sketch.is_alerted(key));
+}
+
+// a scan spread over several threads is counted as one
+TEST(ps_sketch, threads)
+{
+    PsSketch sketch(1 << 20);
+    const char* id = "target";
+    PsSketch::Key key = sketch.get_key(id, strlen(id));
+    const unsigned num_threads = 4;
+    std::vector<std::thread> threads;
+
+    for ( unsigned t = 0; t < num_threads; ++t )
+    {
+        threads.emplace_back([&sketch, &key, t]()
+        {
+            for ( unsigned i = 0; i < 1000; ++i )
+            {
+                SfIp ip = make_ip(t);
+                sketch.update(key, 1, 0, 60, &ip, t * 1000 + i, 1);
+            }
+        });
+    }
+    for ( auto& t : threads )
+        t.join();
+
+    PS_PROTO proto;
+    memset(&proto, 0, sizeof(proto));
+    sketch.get(key, proto);
+
+    CHECK(4000 == proto.connection_count);
+    CHECK(4 == proto.u_ip_count);
+    CHECK(proto.u_port_count > 3000 and proto.u_port_count < 5000);
+}
+
+TEST(ps_sketch, memcap)
+{
+    PsSketch sketch(1 << 20);
+    CHECK(sketch.get_mem_used() <= (1 << 20) + sizeof(sketch));
+    CHECK(sketch.get_cell_count() > 1000);
+}
+
+int main(int argc, char** argv)
+{
+    return CommandLineTestRunner::RunAllTests(argc, argv);
+}
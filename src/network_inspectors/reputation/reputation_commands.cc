@@ -23,6 +23,9 @@
 
 #include "reputation_commands.h"
 
+#include <atomic>
+#include <thread>
+
 #include "control/control.h"
 #include "framework/pig_pen.h"
 #include "log/messages.h"
@@ -34,6 +37,10 @@
 
 using namespace snort;
 
+// Large lists take seconds to parse, so the new tables are built by a loader
+// thread. Until they are ready, execute() leaves the command on each packet
+// thread's uncompleted queue and that thread keeps using the current tables.
+// The old tables are freed only after every packet thread has switched.
 class ReputationReload : public AnalyzerCommand
 {
 public:
@@ -47,28 +54,48 @@ public:
     const char* stringify() override
     { return "REPUTATION_RELOAD"; }
 
+    static bool in_progress()
+    { return reloading; }
+
 protected:
     Reputation& ins;
-    ReputationData* data;
+    ReputationData* data = nullptr;
+    std::thread* loader;
+    std::atomic<bool> loaded { false };
+
+    static std::atomic<bool> reloading;
 };
 
+std::atomic<bool> ReputationReload::reloading { false };
+
 ReputationReload::ReputationReload(ControlConn* conn, Reputation& ins)
     : AnalyzerCommand(conn), ins(ins)
 {
+    reloading = true;
     ins.add_global_ref();
     log_message(".. reputation reloading\n");
-    data = ins.load_data();
+    loader = new std::thread([this]()
+    {
+        data = this->ins.load_data();
+        loaded.store(true, std::memory_order_release);
+    });
 }
 
 ReputationReload::~ReputationReload()
 {
+    loader->join();
+    delete loader;
     ins.swap_data(data);
     log_message("== Reputation reload complete\n");
     ins.rem_global_ref();
+    reloading = false;
 }
 
 bool ReputationReload::execute(Analyzer&, void**)
 {
+    if (!loaded.load(std::memory_order_acquire))
+        return false;
+
     ins.swap_thread_data(data);
     return true;
 }
@@ -78,7 +105,9 @@ static int reload(lua_State* L)
     ControlConn* ctrlcon = ControlConn::query_from_lua(L);
     Reputation* ins = static_cast<Reputation*>(PigPen::get_inspector(REPUTATION_NAME));
 
-    if (ins)
+    if (ReputationReload::in_progress())
+        AnalyzerCommand::log_message(ctrlcon, "Reputation reload already in progress\n");
+    else if (ins)
         main_broadcast_command(new ReputationReload(ctrlcon, *ins), ctrlcon);
     else
         AnalyzerCommand::log_message(ctrlcon, "No reputation instance configured to reload\n");
@@ -35,6 +35,7 @@
 #include "protocols/packet.h"
 #include "pub_sub/auxiliary_ip_event.h"
 #include "pub_sub/reputation_events.h"
+#include "sfrt/sfrt_poptrie.h"
 #include "utils/util.h"
 
 #include "reputation_parse.h"
@@ -70,9 +71,34 @@ static inline IPrepInfo* reputation_lookup(const ReputationConfig& config,
             return nullptr;
     }
 
+    if ( data.ip_trie )
+        return (IPrepInfo*)data.ip_trie->lookup(ip);
+
     return (IPrepInfo*)sfrt_flat_dir8x_lookup(ip, data.ip_list);
 }
 
+// look up both ends of a packet at once so their cache misses overlap
+static inline void reputation_lookup(const ReputationConfig& config,
+    ReputationData& data, const SfIp* const* ips, IPrepInfo** results)
+{
+    if ( data.ip_trie )
+        data.ip_trie->lookup(ips, (GENERIC*)results, 2);
+    else
+    {
+        results[0] = (IPrepInfo*)sfrt_flat_dir8x_lookup(ips[0], data.ip_list);
+        results[1] = (IPrepInfo*)sfrt_flat_dir8x_lookup(ips[1], data.ip_list);
+    }
+
+    if (!config.scanlocal)
+    {
+        for ( unsigned i = 0; i < 2; ++i )
+        {
+            if ( ips[i]->is_private() )
+                results[i] = nullptr;
+        }
+    }
+}
+
 static inline IPdecision get_reputation(const ReputationConfig& config, ReputationData& data,
     IPrepInfo* rep_info, uint32_t& listid, uint32_t ingress_intf, uint32_t egress_intf)
 {
@@ -122,8 +148,11 @@ static bool decision_per_layer(const ReputationConfig& config, ReputationData& d
     uint32_t& iplist_id, uint32_t ingress_intf, uint32_t egress_intf, const ip::IpApi& ip_api,
     IPdecision* decision_final)
 {
-    const SfIp* ip = ip_api.get_src();
-    IPrepInfo* result = reputation_lookup(config, data, ip);
+    const SfIp* ips[2] = { ip_api.get_src(), ip_api.get_dst() };
+    IPrepInfo* results[2];
+    reputation_lookup(config, data, ips, results);
+
+    IPrepInfo* result = results[0];
     if (result)
     {
         IPdecision decision = get_reputation(config, data, result, iplist_id, ingress_intf,
@@ -142,8 +171,7 @@ static bool decision_per_layer(const ReputationConfig& config, ReputationData& d
             return true;
     }
 
-    ip = ip_api.get_dst();
-    result = reputation_lookup(config, data, ip);
+    result = results[1];
     if (result)
     {
         IPdecision decision = get_reputation(config, data, result, iplist_id, ingress_intf,
@@ -516,6 +544,8 @@ void AuxiliaryIpRepHandler::handle(DataEvent& event, Flow*)
 
 ReputationData::~ReputationData()
 {
+    delete ip_trie;
+
     if (reputation_segment)
         snort_free(reputation_segment);
 
@@ -524,7 +554,10 @@ ReputationData::~ReputationData()
 }
 
 Reputation::Reputation(ReputationConfig* pc) : config(*pc)
-{ rep_data = load_data(); }
+{
+    rep_data = load_data();
+    reputationstats.memory_allocated = rep_data->memory_allocated;
+}
 
 Reputation::~Reputation()
 { delete rep_data; }
@@ -546,7 +579,20 @@ ReputationData* Reputation::load_data()
     {
         ReputationParser parser;
         parser.ip_list_init(data->num_entries + 1, config, *data);
-        reputationstats.memory_allocated = parser.get_usage();
+        data->memory_allocated = parser.get_usage();
+
+        if ( data->ip_list )
+        {
+            data->ip_trie = new RtPoptrie;
+
+            if ( data->ip_trie->compile(data->ip_list) )
+                data->memory_allocated += data->ip_trie->usage();
+            else
+            {
+                delete data->ip_trie;
+                data->ip_trie = nullptr;
+            }
+        }
     }
 
     return data;
@@ -559,6 +605,7 @@ void Reputation::swap_data(ReputationData* data)
 {
     delete rep_data;
     rep_data = data;
+    reputationstats.memory_allocated = rep_data->memory_allocated;
 }
 
 void Reputation::tinit()
@@ -24,6 +24,8 @@
 #include "reputation_module.h"
 
 struct table_flat_t;
+class RtPoptrie;
+
 class ReputationData
 {
 public:
@@ -33,7 +35,9 @@ public:
     ListFiles list_files;
     uint8_t* reputation_segment = nullptr;
     table_flat_t* ip_list = nullptr;
+    RtPoptrie* ip_trie = nullptr;   // compressed copy of ip_list used for lookups
     int num_entries = 0;
+    size_t memory_allocated = 0;
     bool memcap_reached = false;
 };
 
@@ -56,6 +60,7 @@ public:
     { return *rep_data; }
     const ReputationConfig& get_config()
     { return config; }
+    // Builds new tables from the configured lists; safe to call off the main thread
     ReputationData* load_data();
 
     void swap_thread_data(ReputationData*);
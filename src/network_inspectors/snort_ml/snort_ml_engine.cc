@@ -25,7 +25,10 @@
 #include "snort_ml_engine.h"
 
 #include <cassert>
+#include <cstring>
 #include <fstream>
+#include <functional>
+#include <string_view>
 
 #ifdef HAVE_LIBML
 #include <libml.h>
@@ -40,10 +43,79 @@
 #include "parser/parse_conf.h"
 #include "utils/util.h"
 
+#include "snort_ml_module.h"
+
 using namespace snort;
 using namespace std;
 
+// only short inputs such as static asset queries and health checks tend to
+// repeat, so longer ones are not cached and every entry has a fixed size
+static constexpr size_t max_cached_input = 256;
+
+struct SnortMLResult
+{
+    float output;
+    uint16_t len;
+    char input[max_cached_input];
+};
+
+struct SnortMLResultHash
+{
+    size_t operator()(size_t key) const
+    { return key; }
+};
+
+class SnortMLResultCache : public LruCacheLocal<size_t, SnortMLResult, SnortMLResultHash>
+{
+public:
+    SnortMLResultCache(size_t sz, LruCacheLocalStats& st) : LruCacheLocal(sz, st) { }
+
+    // the input is kept with the output so a hash collision is a miss, not a hit
+    const SnortMLResult* find(size_t key, const char* input, size_t len)
+    {
+        auto it = map.find(key);
+
+        if (it == map.end() || it->second->second.len != len ||
+            memcmp(it->second->second.input, input, len))
+        {
+            stats.cache_misses++;
+            return nullptr;
+        }
+
+        stats.cache_hits++;
+        list.splice(list.begin(), list, it->second);
+        return &list.begin()->second;
+    }
+
+    // find() already counted the miss that led to this store
+    void store(size_t key, const SnortMLResult& res)
+    {
+        auto it = map.find(key);
+
+        if (it == map.end())
+        {
+            add_entry(key, res);
+            return;
+        }
+
+        stats.cache_replaces++;
+        list.splice(list.begin(), list, it->second);
+        it->second->second = res;
+    }
+};
+
 static THREAD_LOCAL libml::BinaryClassifierSet* classifiers = nullptr;
+static THREAD_LOCAL SnortMLResultCache* result_cache = nullptr;
+
+static void build_result_cache(size_t memcap)
+{
+    // cached outputs are only valid for the classifiers that produced them
+    delete result_cache;
+    result_cache = memcap ? new SnortMLResultCache(memcap, snort_ml_stats) : nullptr;
+}
+
+static inline size_t result_key(const char* input, size_t len)
+{ return std::hash<std::string_view>()(std::string_view(input, len)); }
 
 static bool build_classifiers(const vector<string>& models,
     libml::BinaryClassifierSet*& set)
@@ -60,6 +132,10 @@ static bool build_classifiers(const vector<string>& models,
 static const Parameter snort_ml_engine_params[] =
 {
     { "http_param_model", Parameter::PT_STRING, nullptr, nullptr, "path to model file(s)" },
+
+    { "cache_memcap", Parameter::PT_INT, "0:maxSZ", "1048576",
+      "maximum memory in bytes per packet thread for cached classifier results (0 disables)" },
+
     { nullptr, Parameter::PT_MAX, nullptr, nullptr, nullptr }
 };
 
@@ -69,6 +145,8 @@ bool SnortMLEngineModule::set(const char*, Value& v, SnortConfig*)
 {
     if (v.is("http_param_model"))
         conf.http_param_model_path = v.get_string();
+    else if (v.is("cache_memcap"))
+        conf.cache_memcap = v.get_size();
 
     return true;
 }
@@ -80,8 +158,8 @@ bool SnortMLEngineModule::set(const char*, Value& v, SnortConfig*)
 class SnortMLReloadTuner : public snort::ReloadResourceTuner
 {
 public:
-    explicit SnortMLReloadTuner(const vector<string>& models)
-        : http_param_models(models) {}
+    explicit SnortMLReloadTuner(const vector<string>& models, size_t memcap)
+        : http_param_models(models), cache_memcap(memcap) {}
 
     ~SnortMLReloadTuner() override = default;
 
@@ -95,6 +173,8 @@ public:
         if (!build_classifiers(http_param_models, classifiers))
             ErrorMessage("Could not build classifiers.\n");
 
+        build_result_cache(cache_memcap);
+
         return false;
     }
 
@@ -106,6 +186,7 @@ public:
 
 private:
     const vector<string>& http_param_models;
+    size_t cache_memcap;
 };
 
 //--------------------------------------------------------------------------
@@ -119,7 +200,10 @@ SnortMLEngine::SnortMLEngine(const SnortMLEngineConfig& c) : config(c)
 }
 
 void SnortMLEngine::show(const SnortConfig*) const
-{ ConfigLogger::log_value("http_param_model", config.http_param_model_path.c_str()); }
+{
+    ConfigLogger::log_value("http_param_model", config.http_param_model_path.c_str());
+    ConfigLogger::log_value("cache_memcap", config.cache_memcap);
+}
 
 bool SnortMLEngine::read_models()
 {
@@ -192,20 +276,53 @@ bool SnortMLEngine::validate_models()
 }
 
 void SnortMLEngine::tinit()
-{ build_classifiers(http_param_models, classifiers); }
+{
+    build_classifiers(http_param_models, classifiers);
+    build_result_cache(config.cache_memcap);
+}
 
 void SnortMLEngine::tterm()
 {
     delete classifiers;
     classifiers = nullptr;
+
+    delete result_cache;
+    result_cache = nullptr;
 }
 
 void SnortMLEngine::install_reload_handler(SnortConfig* sc)
-{ sc->register_reload_handler(new SnortMLReloadTuner(http_param_models)); }
+{ sc->register_reload_handler(new SnortMLReloadTuner(http_param_models, config.cache_memcap)); }
 
 libml::BinaryClassifierSet* SnortMLEngine::get_classifiers()
 { return classifiers; }
 
+bool SnortMLEngine::get_cached_result(const char* input, size_t len, float& output)
+{
+    if (!result_cache || len > max_cached_input)
+        return false;
+
+    const SnortMLResult* res = result_cache->find(result_key(input, len), input, len);
+
+    if (!res)
+        return false;
+
+    output = res->output;
+    return true;
+}
+
+void SnortMLEngine::cache_result(const char* input, size_t len, float output)
+{
+    if (!result_cache || len > max_cached_input)
+        return;
+
+    SnortMLResult res;
+    res.output = output;
+    res.len = (uint16_t)len;
+    memcpy(res.input, input, len);
+
+    result_cache->store(result_key(input, len), res);
+}
+
 //--------------------------------------------------------------------------
 // api stuff
 //--------------------------------------------------------------------------
@@ -275,9 +392,47 @@ const BaseApi* nin_snort_ml_engine[] =
 TEST_CASE("SnortML tuner name", "[snort_ml_module]")
 {
     const vector<string> models = { "model" };
-    SnortMLReloadTuner tuner(models);
+    SnortMLReloadTuner tuner(models, 0);
 
     REQUIRE(strcmp(tuner.name(), "SnortMLReloadTuner") == 0);
 }
 
+TEST_CASE("SnortML result cache", "[snort_ml_module]")
+{
+    memset(&snort_ml_stats, 0, sizeof(snort_ml_stats));
+    build_result_cache(16384);
+
+    const char* query = "id=1&page=home";
+    const size_t len = strlen(query);
+    float output = 0.0f;
+
+    CHECK(!SnortMLEngine::get_cached_result(query, len, output));
+    CHECK(snort_ml_stats.cache_misses == 1);
+
+    SnortMLEngine::cache_result(query, len, 0.25f);
+    CHECK(SnortMLEngine::get_cached_result(query, len, output));
+    CHECK(output == 0.25f);
+    CHECK(snort_ml_stats.cache_hits == 1);
+    CHECK(snort_ml_stats.cache_misses == 1);
+
+    // a prefix of a cached input is a different input
+    CHECK(!SnortMLEngine::get_cached_result(query, len - 1, output));
+    CHECK(snort_ml_stats.cache_misses == 2);
+
+    // same key with a different input, as with a hash collision
+    const char* other = "id=2&page=home";
+    CHECK(!result_cache->find(result_key(query, len), other, len));
+    CHECK(snort_ml_stats.cache_misses == 3);
+    CHECK(snort_ml_stats.cache_hits == 1);
+
+    // long inputs are never cached
+    const string big(max_cached_input + 1, 'a');
+    SnortMLEngine::cache_result(big.c_str(), big.size(), 1.0f);
+    CHECK(!SnortMLEngine::get_cached_result(big.c_str(), big.size(), output));
+    CHECK(snort_ml_stats.cache_adds == 1);
+
+    build_result_cache(0);
+    CHECK(!SnortMLEngine::get_cached_result(query, len, output));
+}
+
 #endif
@@ -35,6 +35,7 @@ namespace libml
 struct SnortMLEngineConfig
 {
     std::string http_param_model_path;
+    size_t cache_memcap = 0;
 };
 
 class SnortMLEngineModule : public snort::Module
@@ -69,6 +70,10 @@ public:
 
     static libml::BinaryClassifierSet* get_classifiers();
 
+    // classifier outputs for recently seen inputs on this packet thread
+    static bool get_cached_result(const char*, size_t, float&);
+    static void cache_result(const char*, size_t, float);
+
 private:
     bool read_models();
     bool read_model(const std::string&);
@@ -84,10 +84,15 @@ void HttpBodyHandler::handle(DataEvent& de, Flow*)
 
     float output = 0.0;
 
-    snort_ml_stats.libml_calls++;
+    if (!SnortMLEngine::get_cached_result(body, len, output))
+    {
+        snort_ml_stats.libml_calls++;
 
-    if (!classifiers->run(body, len, output))
-        return;
+        if (!classifiers->run(body, len, output))
+            return;
+
+        SnortMLEngine::cache_result(body, len, output);
+    }
 
     snort_ml_stats.client_body_bytes += len;
 
@@ -139,10 +144,15 @@ void HttpUriHandler::handle(DataEvent& de, Flow*)
 
     float output = 0.0;
 
-    snort_ml_stats.libml_calls++;
+    if (!SnortMLEngine::get_cached_result(query, len, output))
+    {
+        snort_ml_stats.libml_calls++;
 
-    if (!classifiers->run(query, len, output))
-        return;
+        if (!classifiers->run(query, len, output))
+            return;
+
+        SnortMLEngine::cache_result(query, len, output);
+    }
 
     snort_ml_stats.uri_bytes += len;
 
@@ -52,6 +52,7 @@ static const RuleMap snort_ml_rules[] =
 
 static const PegInfo peg_names[] =
 {
+    LRU_CACHE_LOCAL_PEGS("snort_ml result"),
     { CountType::SUM, "uri_alerts", "total number of alerts triggered on HTTP URI" },
     { CountType::SUM, "client_body_alerts", "total number of alerts triggered on HTTP client body" },
     { CountType::SUM, "uri_bytes", "total number of HTTP URI bytes processed" },
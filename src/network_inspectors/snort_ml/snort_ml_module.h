@@ -21,6 +21,7 @@
 #define SNORT_ML_MODULE_H
 
 #include "framework/module.h"
+#include "hash/lru_cache_local.h"
 #include "main/thread.h"
 #include "profiler/profiler.h"
 #include "trace/trace_api.h"
@@ -33,7 +34,7 @@
 
 enum { TRACE_CLASSIFIER };
 
-struct SnortMLStats
+struct SnortMLStats : public LruCacheLocalStats
 {
     PegCount uri_alerts;
     PegCount client_body_alerts;
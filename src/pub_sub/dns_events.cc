@@ -107,39 +107,9 @@ void IPFqdnCacheItem::add_fqdn(const FqdnTtl& fqdn_ttl)
     fqdns.emplace_back(fqdn_ttl);
 }
 
-void DnsResponseDataEvents::add_ip(const DnsResponseIp& ip)
-{
-    dns_ips.emplace_back(ip);
-}
-
-void DnsResponseDataEvents::add_fqdn(DnsResponseFqdn& fqdn, uint32_t ttl)
-{
-    fqdn.update_ttl(ttl);
-    dns_fqdns.emplace_back(fqdn);
-}
-
 void DnsResponseDataEvents::get_dns_data(IPFqdnCacheItem& ip_fqdn_cache_item)
 {
-    for (auto& it: dns_ips)
-        ip_fqdn_cache_item.add_ip(it.get_ip());
-
-    // don't add fqdns without ips
-    if (ip_fqdn_cache_item.ips.empty())
-        return;
-
-    for (auto& it: dns_fqdns)
-        ip_fqdn_cache_item.add_fqdn(it.get_fqdn());
-}
-
-bool DnsResponseDataEvents::empty() const
-{
-    return (dns_ips.empty() or dns_fqdns.empty());
-}
-
-void DnsResponseDataEvents::clear_data()
-{
-    dns_ips.clear();
-    dns_fqdns.clear();
+    session.get_fqdn_ips(packet, ip_fqdn_cache_item);
 }
 
 uint16_t DnsResponseEvent::get_trans_id() const
@@ -149,7 +119,12 @@ uint16_t DnsResponseEvent::get_trans_id() const
 
 const std::string& DnsResponseEvent::get_query() const
 {
-    return session.resp_query;
+    if (!query_set)
+    {
+        session.get_query(packet, query);
+        query_set = true;
+    }
+    return query;
 }
 
 uint16_t DnsResponseEvent::get_query_class() const
@@ -57,8 +57,6 @@ struct DnsEventIds
 
 const snort::PubKey dns_pub_key { "dns", DnsEventIds::num_ids };
 
-class DnsResponseIp;
-class DnsResponseFqdn;
 struct DNSData;
 
 namespace snort
@@ -66,22 +64,16 @@ namespace snort
 class SO_PUBLIC DnsResponseDataEvents : public snort::DataEvent
 {
 public:
-    void add_ip(const DnsResponseIp& event);
-    void add_fqdn(DnsResponseFqdn& event, uint32_t ttl);
+    DnsResponseDataEvents(const DNSData& ssn, Packet* p) : session(ssn), packet(p) { }
+
     void get_dns_data(IPFqdnCacheItem& ip_fqdn_cache_item);
-    bool empty() const;
-    void clear_data();
 
     const Packet* get_packet() const override
     { return packet; }
 
-    void set_packet(Packet* p)
-    { packet = p; }
-
 private:
-    std::vector<DnsResponseIp> dns_ips;
-    std::vector<DnsResponseFqdn> dns_fqdns;
-    Packet* packet = nullptr;
+    const DNSData& session;
+    const Packet* packet = nullptr;
 };
 
 class SO_PUBLIC DnsResponseEvent : public snort::DataEvent
@@ -111,10 +103,12 @@ public:
 private:
     const DNSData& session;
     const Packet* packet = nullptr;
+    mutable std::string query;
     mutable std::string answers;
     mutable std::string ttls;
     mutable std::string auth;
     mutable std::string addl;
+    mutable bool query_set = false;
     mutable bool answers_set = false;
     mutable bool auth_set = false;
     mutable bool addl_set = false;
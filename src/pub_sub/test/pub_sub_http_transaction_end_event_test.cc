@@ -69,6 +69,9 @@ const StreamBuffer StreamSplitter::reassemble(snort::Flow*, unsigned int, unsign
 unsigned StreamSplitter::max(snort::Flow*) { return 0; }
 }
 
+void* memory::MemoryCap::allocate(memory::Arena, size_t size) { return ::operator new(size); }
+void memory::MemoryCap::deallocate(memory::Arena, void* p, size_t) { ::operator delete(p); }
+
 HttpParaList::UriParam::UriParam() { }
 HttpParaList::JsNormParam::~JsNormParam() { }
 HttpParaList::~HttpParaList() { }
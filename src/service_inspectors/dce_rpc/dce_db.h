@@ -25,7 +25,9 @@
 #ifndef DCE_DB_H
 #define DCE_DB_H
 
-#include <unordered_map>
+#include <cassert>
+#include <cstdint>
+#include <type_traits>
 #include <vector>
 #include "dce_utils.h"
 
@@ -43,22 +45,28 @@ public:
     virtual std::vector< std::pair<Key, Value> > get_all_entry() = 0;
 };
 
+// Open addressing map of ids to tracker pointers. The slots live in a single
+// array probed linearly from a Fibonacci hash of the key, so a lookup usually
+// touches one cache line. A null value marks a free slot and Remove() shifts
+// the rest of the probe run back rather than leaving tombstones.
 template<typename Key, typename Value, typename Hash>
 class DCE2_DbMap : public DCE2_Db<Key, Value, Hash>
 {
 public:
+    static_assert(std::is_pointer<Value>::value, "values must be pointers");
 
     DCE2_DbMap(bool gc = true) :   garbage_collection(gc) { }
+    DCE2_DbMap(const DCE2_DbMap&) = delete;
+    DCE2_DbMap& operator=(const DCE2_DbMap&) = delete;
 
     ~DCE2_DbMap()
     {
-        auto it = Map.cbegin();
-        while (it != Map.cend())
+        if (garbage_collection)
         {
-            if (garbage_collection)
-                delete it->second;
-            it = Map.erase(it);
+            for (uint32_t i = 0; i < capacity; ++i)
+                delete slots[i].value;
         }
+        delete[] slots;
     }
 
     bool Insert(const Key& key, Value data) override;
@@ -66,51 +74,161 @@ public:
     void Remove(const Key& key) override;
     int GetSize() override
     {
-        return Map.size();
+        return count;
     }
 
     std::vector< std::pair<Key, Value> > get_all_entry() override;
 
+    // visit every entry without copying; f must not modify this map
+    template<typename Func>
+    void for_each(Func f) const
+    {
+        for (uint32_t i = 0; i < capacity; ++i)
+        {
+            if (slots[i].value)
+                f(slots[i].key, slots[i].value);
+        }
+    }
+
 private:
-    std::unordered_map<Key, Value, Hash> Map;
+    struct Slot
+    {
+        Key key;
+        Value value;
+    };
+
+    static constexpr uint32_t MIN_SLOTS = 8;
+
+    uint32_t home(const Key& key) const
+    {
+        return (uint64_t(Hash()(key)) * 0x9E3779B97F4A7C15ull) >> shift;
+    }
+
+    uint32_t locate(const Key& key) const;
+    void grow();
+
+    Slot* slots = nullptr;
+    uint32_t capacity = 0;
+    uint32_t count = 0;
+    uint8_t shift = 64;
     bool garbage_collection = true;
 };
 
+// returns the slot holding key or capacity if not found
+template<typename Key, typename Value, typename Hash>
+uint32_t DCE2_DbMap<Key, Value, Hash>::locate(const Key& key) const
+{
+    if (!count)
+        return capacity;
+
+    const uint32_t mask = capacity - 1;
+    uint32_t i = home(key);
+
+    while (slots[i].value)
+    {
+        if (slots[i].key == key)
+            return i;
+        i = (i + 1) & mask;
+    }
+    return capacity;
+}
+
+template<typename Key, typename Value, typename Hash>
+void DCE2_DbMap<Key, Value, Hash>::grow()
+{
+    Slot* old = slots;
+    uint32_t old_capacity = capacity;
+
+    capacity = capacity ? capacity * 2 : MIN_SLOTS;
+    shift = 64;
+    for (uint32_t n = capacity; n > 1; n >>= 1)
+        --shift;
+
+    slots = new Slot[capacity]();
+    const uint32_t mask = capacity - 1;
+
+    for (uint32_t j = 0; j < old_capacity; ++j)
+    {
+        if (!old[j].value)
+            continue;
+
+        uint32_t i = home(old[j].key);
+        while (slots[i].value)
+            i = (i + 1) & mask;
+        slots[i] = old[j];
+    }
+    delete[] old;
+}
+
 template<typename Key, typename Value, typename Hash>
 bool DCE2_DbMap<Key, Value, Hash>::Insert(const Key& key, Value data)
 {
-    return Map.insert(std::make_pair(key,data)).second;
+    assert(data);
+
+    if (!data or locate(key) != capacity)
+        return false;
+
+    // keep the load factor at or below 3/4
+    if ((count + 1) * 4 > capacity * 3)
+        grow();
+
+    const uint32_t mask = capacity - 1;
+    uint32_t i = home(key);
+
+    while (slots[i].value)
+        i = (i + 1) & mask;
+
+    slots[i].key = key;
+    slots[i].value = data;
+    count++;
+    return true;
 }
 
 template<typename Key, typename Value, typename Hash>
 Value DCE2_DbMap<Key, Value, Hash>::Find(const Key& key)
 {
-    auto elem = Map.find(key);
-    if (elem != Map.end())
-        return elem->second;
-    return nullptr;
+    uint32_t i = locate(key);
+    return (i != capacity) ? slots[i].value : nullptr;
 }
 
 template<typename Key, typename Value, typename Hash>
 void DCE2_DbMap<Key, Value, Hash>::Remove(const Key& key)
 {
-    auto elem = Map.find(key);
-    if (elem != Map.end())
+    uint32_t hole = locate(key);
+    if (hole == capacity)
+        return;
+
+    Value data = slots[hole].value;
+    const uint32_t mask = capacity - 1;
+
+    // move back any entry in the run whose home is not between the hole and
+    // its current slot, so every entry stays reachable from its home
+    for (uint32_t j = (hole + 1) & mask; slots[j].value; j = (j + 1) & mask)
     {
-        if (garbage_collection)
-            delete elem->second;
+        uint32_t h = home(slots[j].key);
 
-        Map.erase(elem->first);
+        if (((j - h) & mask) >= ((j - hole) & mask))
+        {
+            slots[hole] = slots[j];
+            hole = j;
+        }
     }
+    slots[hole].value = nullptr;
+    count--;
+
+    // the tracker is deleted after the map is consistent again since its
+    // destructor may look at other trackers
+    if (garbage_collection)
+        delete data;
 }
 
 template<typename Key, typename Value, typename Hash>
 std::vector< std::pair<Key, Value> >DCE2_DbMap<Key, Value, Hash>::get_all_entry()
 {
     std::vector<std::pair<Key, Value> > vec;
-    std::copy(Map.begin(), Map.end(), std::back_inserter(vec));
+    vec.reserve(count);
+    for_each([&vec](const Key& key, Value value) { vec.emplace_back(key, value); });
     return vec;
 }
 
 #endif
-
@@ -467,6 +467,11 @@ static void dce2_smb_tterm()
 {
     delete smb2_session_cache;
     smb2_session_cache = nullptr;
+
+    DCE2_Smb2RequestTracker::term();
+    DCE2_Smb2FileTracker::term();
+    DCE2_Smb2LocalFileTracker::term();
+    DCE2_Smb2TreeTracker::term();
 }
 
 static Inspector* dce2_smb_ctor(Module* m)
@@ -91,18 +91,14 @@ DCE2_Smb2FileTracker::~DCE2_Smb2FileTracker(void)
 {
     SMB_DEBUG(dce_smb_trace, DEFAULT_TRACE_OPTION_ID, TRACE_DEBUG_LEVEL,
         nullptr, "File tracker with file id: 0x%" PRIx64 " tracker terminating\n", file_id);
-    auto all_conn_trackers = str->conn_trackers.get_all_entry();
-    for ( const auto& h : all_conn_trackers )
+    str->conn_trackers.for_each([this](uint32_t, DCE2_Smb2SsnData* ssd)
     {
-        if (h.second->ftracker_tcp)
+        if (ssd->ftracker_tcp == this)
         {
-            if (h.second->ftracker_tcp == this)
-            {
-                h.second->ftracker_tcp = nullptr;
-                h.second->ftracker_local = nullptr;
-            }
+            ssd->ftracker_tcp = nullptr;
+            ssd->ftracker_local = nullptr;
         }
-    }
+    });
     if (multi_channel_file)
         dce2_smb_stats.v2_mc_file_transfers++;
     if (co_tracker != nullptr)
@@ -151,26 +147,23 @@ DCE2_Smb2SessionTracker::~DCE2_Smb2SessionTracker(void)
 
 void DCE2_Smb2SessionTracker::removeSessionFromAllConnection()
 {
-    auto all_conn_trackers = conn_trackers.get_all_entry();
-    auto all_tree_trackers = tree_trackers.get_all_entry();
-    for ( auto& h : all_conn_trackers )
+    conn_trackers.for_each([this](uint32_t, DCE2_Smb2SsnData* ssd)
     {
-        if (h.second->ftracker_tcp)
+        if (ssd->ftracker_tcp)
         {
-            for (auto& t : all_tree_trackers)
+            const uint64_t file_id = ssd->ftracker_tcp->file_id;
+
+            tree_trackers.for_each([ssd, file_id](uint32_t, DCE2_Smb2TreeTracker* ttr)
             {
-                DCE2_Smb2FileTracker* ftr = t.second->findFtracker(
-                    h.second->ftracker_tcp->file_id);
-                if (ftr and ftr == h.second->ftracker_tcp)
+                if (ssd->ftracker_tcp and ttr->findFtracker(file_id) == ssd->ftracker_tcp)
                 {
-                    h.second->ftracker_tcp = nullptr;
-                    h.second->ftracker_local = nullptr;
-                    break;
+                    ssd->ftracker_tcp = nullptr;
+                    ssd->ftracker_local = nullptr;
                 }
-            }
+            });
         }
-        DCE2_Smb2RemoveSidInSsd(h.second, session_id);
-    }
+        DCE2_Smb2RemoveSidInSsd(ssd, session_id);
+    });
 }
 
 void DCE2_Smb2SessionTracker::update_cache_size(int size)
@@ -205,18 +198,14 @@ DCE2_Smb2SsnData::~DCE2_Smb2SsnData()
             if (flow_key)
                 sptr->removeConnectionTracker(flow_key); // remove tcp connection from session
                                                          // tracker
-            auto ttrs = sptr->tree_trackers.get_all_entry();
-            for (const auto& titer: ttrs)
+            sptr->tree_trackers.for_each([this](uint32_t, DCE2_Smb2TreeTracker* ttr)
             {
-                DCE2_Smb2TreeTracker* ttr = titer.second;
-                auto ftrs = ttr->file_trackers.get_all_entry();
-                for (const auto& fiter: ftrs)
+                ttr->file_trackers.for_each([this](uint64_t, DCE2_Smb2FileTracker* ftr)
                 {
-                    DCE2_Smb2FileTracker* ftr = fiter.second;
                     if (flow == ftr->parent_flow)
                         ftr->parent_flow = nullptr;
-                }
-            }
+                });
+            });
         }
     }
 }
@@ -31,10 +31,14 @@
 #include "hash/lru_cache_shared.h"
 #include "flow/flow_key.h"
 #include "main/thread_config.h"
+#include "utils/free_list_pool.h"
 #include "utils/util.h"
 
 #define GET_CURRENT_PACKET snort::DetectionEngine::get_current_packet()
 
+// idle tracker blocks kept per packet thread for each tracker type
+#define DCE2_SMB2_POOL_MAX_IDLE 1024
+
 struct Smb2Hdr
 {
     uint8_t smb_idf[4];       /* contains 0xFE,’SMB’ */
@@ -95,7 +99,7 @@ struct Smb2ErrorResponseHdr
 
 class DCE2_Smb2TreeTracker;
 
-class DCE2_Smb2RequestTracker
+class DCE2_Smb2RequestTracker : public snort::StoragePool<DCE2_Smb2RequestTracker, DCE2_SMB2_POOL_MAX_IDLE>
 {
 public:
 
@@ -153,7 +157,7 @@ public:
 struct DCE2_Smb2SsnData;
 class DCE2_Smb2SessionTracker;
 
-class DCE2_Smb2FileTracker
+class DCE2_Smb2FileTracker : public snort::StoragePool<DCE2_Smb2FileTracker, DCE2_SMB2_POOL_MAX_IDLE>
 {
 public:
 
@@ -177,7 +181,7 @@ public:
     bool multi_channel_file : 1;
 };
 
-class DCE2_Smb2LocalFileTracker
+class DCE2_Smb2LocalFileTracker : public snort::StoragePool<DCE2_Smb2LocalFileTracker, DCE2_SMB2_POOL_MAX_IDLE>
 {
 public:
     uint64_t file_offset = 0;
@@ -185,7 +189,7 @@ public:
 };
 typedef DCE2_DbMap<uint64_t, DCE2_Smb2FileTracker*, std::hash<uint64_t> > DCE2_DbMapFtracker;
 typedef DCE2_DbMap<uint64_t, DCE2_Smb2RequestTracker*, std::hash<uint64_t> > DCE2_DbMapRtracker;
-class DCE2_Smb2TreeTracker
+class DCE2_Smb2TreeTracker : public snort::StoragePool<DCE2_Smb2TreeTracker, DCE2_SMB2_POOL_MAX_IDLE>
 {
 public:
 
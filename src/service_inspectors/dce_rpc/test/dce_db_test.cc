@@ -0,0 +1,160 @@
+//--------------------------------------------------------------------------
+// Copyright (C) 2026 Cisco and/or its affiliates. All rights reserved.
+//
+// This program is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License Version 2 as published
+// by the Free Software Foundation.  You may not use, modify or distribute
+// this program under any other version of the GNU General Public License.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+//--------------------------------------------------------------------------
+// dce_db_test.cc author Cisco
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <cstdint>
+#include <random>
+#include <unordered_map>
+
+#include "catch/catch.hpp"
+
+#include "service_inspectors/dce_rpc/dce_db.h"
+#include "utils/free_list_pool.h"
+
+namespace
+{
+unsigned live = 0;
+
+struct Tracker : public snort::StoragePool<Tracker, 4>
+{
+    explicit Tracker(uint64_t id) : id(id) { live++; }
+    ~Tracker() { live--; }
+
+    uint64_t id;
+};
+
+typedef DCE2_DbMap<uint64_t, Tracker*, std::hash<uint64_t> > TrackerMap;
+
+struct Request : public snort::StoragePool<Request, 4>
+{
+    uint64_t message_id = 0;
+    uint64_t offset = 0;
+};
+}
+
+TEST_CASE("insert find remove", "[dce_db]")
+{
+    TrackerMap map;
+    CHECK(map.Find(1) == nullptr);
+
+    Tracker* t = new Tracker(1);
+    CHECK(map.Insert(1, t));
+    CHECK_FALSE(map.Insert(1, t));
+    CHECK(map.Find(1) == t);
+    CHECK(map.GetSize() == 1);
+
+    map.Remove(2);
+    CHECK(map.GetSize() == 1);
+
+    map.Remove(1);
+    CHECK(map.Find(1) == nullptr);
+    CHECK(map.GetSize() == 0);
+    CHECK(live == 0);
+}
+
+TEST_CASE("matches unordered_map", "[dce_db]")
+{
+    std::mt19937_64 rng(7);
+    std::unordered_map<uint64_t, Tracker*> ref;
+
+    {
+        TrackerMap map;
+
+        for (unsigned n = 0; n < 20000; ++n)
+        {
+            // small key space so inserts and removes collide often
+            uint64_t key = rng() % 512;
+
+            if (rng() & 1)
+            {
+                if (ref.count(key))
+                    continue;
+
+                Tracker* t = new Tracker(key);
+                REQUIRE(map.Insert(key, t));
+                ref[key] = t;
+            }
+            else
+            {
+                map.Remove(key);
+                ref.erase(key);
+            }
+
+            if ((n % 97) == 0)
+            {
+                REQUIRE(map.GetSize() == (int)ref.size());
+
+                for (const auto& r : ref)
+                    REQUIRE(map.Find(r.first) == r.second);
+            }
+        }
+
+        unsigned seen = 0;
+        map.for_each([&seen, &ref](uint64_t key, Tracker* t)
+        {
+            CHECK(ref[key] == t);
+            CHECK(t->id == key);
+            seen++;
+        });
+        CHECK(seen == ref.size());
+        CHECK(map.get_all_entry().size() == ref.size());
+        CHECK(live == ref.size());
+    }
+    CHECK(live == 0);
+}
+
+TEST_CASE("no garbage collection", "[dce_db]")
+{
+    Tracker t(5);
+    {
+        TrackerMap map(false);
+        CHECK(map.Insert(5, &t));
+        map.Remove(5);
+        CHECK(map.Insert(5, &t));
+    }
+    CHECK(live == 1);
+}
+
+TEST_CASE("pooled storage is reused", "[dce_db]")
+{
+    Request* a = new Request;
+    void* storage = a;
+    delete a;
+    CHECK(Request::get_idle() == 1);
+
+    Request* b = new Request;
+    CHECK((void*)b == storage);
+    CHECK(Request::get_idle() == 0);
+
+    Request* more[6];
+    for (auto& r : more)
+        r = new Request;
+    for (auto& r : more)
+        delete r;
+    CHECK(Request::get_idle() == 4);
+
+    Request::term();
+    CHECK(Request::get_idle() == 0);
+
+    delete b;
+    CHECK(Request::get_idle() == 0);
+}
@@ -0,0 +1,193 @@
+//--------------------------------------------------------------------------
+// Copyright (C) 2026 Cisco and/or its affiliates. All rights reserved.
+//
+// This program is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License Version 2 as published
+// by the Free Software Foundation.  You may not use, modify or distribute
+// this program under any other version of the GNU General Public License.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+//--------------------------------------------------------------------------
+// dce_smb2_benchmark.cc author Cisco
+
+#ifdef BENCHMARK_TEST
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "catch/catch.hpp"
+
+#include <cstdint>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "service_inspectors/dce_rpc/dce_db.h"
+#include "utils/free_list_pool.h"
+
+// Replays the tracker traffic of a read/write heavy SMB2 file server session:
+// a tree with a working set of open files and a window of outstanding
+// requests. Each operation creates a request tracker keyed by message id,
+// finds the file tracker on the response, and retires the request; every
+// few hundred operations a file is closed and another one opened. The
+// unordered_map with heap trackers is the layout the inspector used before.
+
+namespace
+{
+template<typename Key, typename Value>
+class HeapMap
+{
+public:
+    ~HeapMap()
+    {
+        for (auto& e : map)
+            delete e.second;
+    }
+
+    bool Insert(const Key& key, Value data)
+    { return map.insert(std::make_pair(key, data)).second; }
+
+    Value Find(const Key& key)
+    {
+        auto it = map.find(key);
+        return it != map.end() ? it->second : nullptr;
+    }
+
+    void Remove(const Key& key)
+    {
+        auto it = map.find(key);
+        if (it != map.end())
+        {
+            delete it->second;
+            map.erase(it);
+        }
+    }
+
+private:
+    std::unordered_map<Key, Value, std::hash<Key> > map;
+};
+
+struct HeapRequest
+{
+    HeapRequest(uint64_t file_id, uint64_t offset) : file_id(file_id), offset(offset) { }
+    char* fname = nullptr;
+    uint16_t fname_len = 0;
+    uint64_t file_id;
+    uint64_t offset;
+    uint32_t tree_id = 0;
+    uint64_t session_id = 0;
+};
+
+struct HeapFile
+{
+    explicit HeapFile(uint64_t file_id) : file_id(file_id) { }
+    uint64_t max_offset = 0;
+    uint64_t file_id;
+    uint64_t file_size = 0;
+    uint64_t file_name_hash = 0;
+    void* ptrs[4] = { };
+};
+
+struct PooledRequest : public HeapRequest, public snort::StoragePool<PooledRequest, 1024>
+{
+    using HeapRequest::HeapRequest;
+};
+
+struct PooledFile : public HeapFile, public snort::StoragePool<PooledFile, 1024>
+{
+    using HeapFile::HeapFile;
+};
+
+static const unsigned OPEN_FILES = 256;
+static const unsigned OUTSTANDING = 32;
+static const unsigned OPS = 100000;
+static const unsigned REOPEN_INTERVAL = 300;
+
+struct Trace
+{
+    Trace()
+    {
+        std::mt19937_64 rng(1234);
+
+        for (unsigned i = 0; i < OPS; ++i)
+            file_ix.emplace_back(rng() % OPEN_FILES);
+
+        // persistent file ids are sparse 64-bit values
+        for (unsigned i = 0; i < OPEN_FILES + OPS / REOPEN_INTERVAL + 1; ++i)
+            file_ids.emplace_back(rng());
+    }
+
+    std::vector<unsigned> file_ix;
+    std::vector<uint64_t> file_ids;
+};
+
+template<typename FileMap, typename RequestMap, typename File, typename Request>
+static uint64_t replay(const Trace& trace)
+{
+    FileMap files;
+    RequestMap requests;
+    std::vector<uint64_t> open(trace.file_ids.begin(), trace.file_ids.begin() + OPEN_FILES);
+    unsigned next_id = OPEN_FILES;
+    uint64_t bytes = 0;
+
+    for (auto id : open)
+        files.Insert(id, new File(id));
+
+    for (uint64_t mid = 0; mid < OPS; ++mid)
+    {
+        uint64_t file_id = open[trace.file_ix[mid]];
+        requests.Insert(mid, new Request(file_id, mid * 65536));
+
+        // responses trail the requests by the outstanding window
+        if (mid >= OUTSTANDING)
+        {
+            Request* req = requests.Find(mid - OUTSTANDING);
+
+            // the file may have been closed with the request in flight
+            if (File* file = files.Find(req->file_id))
+            {
+                file->max_offset = req->offset + 65536;
+                bytes += file->max_offset;
+            }
+            requests.Remove(mid - OUTSTANDING);
+        }
+
+        if (mid % REOPEN_INTERVAL == 0)
+        {
+            unsigned ix = trace.file_ix[mid];
+            files.Remove(open[ix]);
+            open[ix] = trace.file_ids[next_id++];
+            files.Insert(open[ix], new File(open[ix]));
+        }
+    }
+    return bytes;
+}
+}
+
+TEST_CASE("smb2 read write trackers", "[dce_smb2]")
+{
+    static const Trace trace;
+
+    auto heap = replay<HeapMap<uint64_t, HeapFile*>, HeapMap<uint64_t, HeapRequest*>,
+        HeapFile, HeapRequest>;
+    auto flat = replay<DCE2_DbMap<uint64_t, PooledFile*, std::hash<uint64_t> >,
+        DCE2_DbMap<uint64_t, PooledRequest*, std::hash<uint64_t> >, PooledFile, PooledRequest>;
+
+    REQUIRE(heap(trace) == flat(trace));
+
+    BENCHMARK("unordered_map, heap trackers")
+    { return heap(trace); };
+
+    BENCHMARK("flat map, pooled trackers")
+    { return flat(trace); };
+}
+
+#endif
@@ -52,6 +52,7 @@ const PegInfo dns_peg_names[] =
     { CountType::NOW, "concurrent_sessions", "total concurrent dns sessions" },
     { CountType::MAX, "max_concurrent_sessions", "maximum concurrent dns sessions" },
     { CountType::SUM, "aborted_sessions", "total dns sessions aborted" },
+    { CountType::SUM, "unindexed_rrs", "resource records left out of a full per packet index" },
 
     { CountType::END, nullptr, nullptr }
 };
@@ -80,14 +81,40 @@ unsigned DnsUdpFlowData::inspector_id = 0;
 
 DnsUdpFlowData::DnsUdpFlowData() : FlowData(inspector_id) {}
 
-bool DNSData::publish_response() const
+bool DnsRrIndex::add(DnsSection section, const DNSRR& rr, uint16_t rdata)
 {
-    return (dns_config->publish_response and state == DNS_RESP_STATE_ANS_RR);
+    if ( count == DNS_MAX_INDEXED_RRS )
+    {
+        dnsstats.unindexed_rrs++;
+        return false;
+    }
+
+    DnsRr& e = rrs[count++];
+    e.msg = msg;
+    e.name = name;
+    e.rdata = rdata;
+    e.rdlength = rr.length;
+    e.type = rr.type;
+    e.section = section;
+    e.ttl = rr.ttl;
+    return true;
 }
 
+// the data event only carries name to address mappings
 bool DNSData::has_events() const
 {
-    return !dns_events.empty();
+    if ( !dns_config->publish_response )
+        return false;
+
+    for ( unsigned i = 0; i < rrs.count; ++i )
+    {
+        const DnsRr& rr = rrs.rrs[i];
+
+        if ( rr.section == DNS_SECTION_ANSWER and rr.name != DNS_RR_NO_OFFSET and
+            (rr.type == DNS_RR_TYPE_A or rr.type == DNS_RR_TYPE_AAAA) )
+            return true;
+    }
+    return false;
 }
 
 static DNSData* SetNewDNSData(Packet* p)
@@ -98,7 +125,6 @@ static DNSData* SetNewDNSData(Packet* p)
         return nullptr;
 
     fd = new DnsFlowData;
-    fd->session.dns_events.set_packet(p);
     p->flow->set_flow_data(fd);
 
     return &fd->session;
@@ -144,16 +170,13 @@ DNSData* get_dns_session_data(Packet* p, bool from_server, DNSData& udpSessionDa
             if (p->dsize < (sizeof(DNSHdr)))
                 return nullptr;
         }
-        udpSessionData.dns_events.set_packet(p);
         return &udpSessionData;
     }
 
     fd = (DnsFlowData*)((p->flow)->get_flow_data(DnsFlowData::inspector_id));
     if (fd)
-    {
-        fd->session.dns_events.set_packet(p);
         return &fd->session;
-    }
+
     return nullptr;
 }
 
@@ -320,7 +343,7 @@ static uint16_t ParseDNSHeader(
 }
 
 static uint16_t ParseDNSName(
-    const unsigned char* data, uint16_t bytes_unused, DNSData* dnsSessionData, bool parse_dns_name = false)
+    const unsigned char* data, uint16_t bytes_unused, DNSData* dnsSessionData)
 {
     uint16_t bytes_required = dnsSessionData->curr_txt.txt_len -
         dnsSessionData->curr_txt.txt_bytes_seen;
@@ -378,25 +401,6 @@ static uint16_t ParseDNSName(
                 {
                     /* If this one is a relative offset, read that extra byte */
                     dnsSessionData->curr_txt.offset |= *data;
-                    if (dnsSessionData->length > 0)
-                        dnsSessionData->curr_txt.offset += 2; // first two bytes are length in TCP
-
-                    if (parse_dns_name && dnsSessionData->data.size() > dnsSessionData->curr_txt.offset)
-                    {
-                        // If the name field is a pointer, then parse the name field at that offset only if
-                        // the offset is within the bounds of the data buffer.
-                        dnsSessionData->curr_txt.name_state = DNS_RESP_STATE_NAME_SIZE;
-                        return ParseDNSName(&dnsSessionData->data[0] + dnsSessionData->curr_txt.offset,
-                            dnsSessionData->bytes_unused, dnsSessionData, parse_dns_name);
-                    }
-                }
-
-                if (parse_dns_name)
-                {
-                    if (!dnsSessionData->curr_txt.dns_name.empty())
-                        dnsSessionData->curr_txt.dns_name += ".";
-
-                    dnsSessionData->curr_txt.dns_name.append((const char*)data, bytes_required);
                 }
 
                 data += bytes_required;
@@ -431,19 +435,25 @@ static uint16_t ParseDNSName(
 }
 
 static uint16_t ParseDNSQuestion(
-    const unsigned char* data, uint16_t bytes_unused, DNSData* dnsSessionData)
+    const unsigned char* data, uint16_t bytes_unused, DNSData* dnsSessionData, const Packet* p)
 {
     if ( !bytes_unused )
         return 0;
 
     if (dnsSessionData->curr_rec_state < DNS_RESP_STATE_Q_NAME_COMPLETE)
     {
-        uint16_t new_bytes_unused = ParseDNSName(data, bytes_unused, dnsSessionData, true);
+        if (!dnsSessionData->curr_txt.name_state)
+        {
+            // the name starts in this packet and is decoded on demand
+            dnsSessionData->rrs.query = data - p->data;
+            dnsSessionData->rrs.query_msg = dnsSessionData->rrs.msg;
+        }
+
+        uint16_t new_bytes_unused = ParseDNSName(data, bytes_unused, dnsSessionData);
         uint16_t bytes_used = bytes_unused - new_bytes_unused;
 
         if (dnsSessionData->curr_txt.name_state == DNS_RESP_STATE_NAME_COMPLETE)
         {
-            dnsSessionData->resp_query = dnsSessionData->curr_txt.dns_name;
             dnsSessionData->curr_rec_state = DNS_RESP_STATE_Q_TYPE;
             dnsSessionData->curr_txt = DNSNameState();
             data = data + bytes_used;
@@ -506,15 +516,15 @@ static uint16_t ParseDNSQuestion(
 
 static uint16_t ParseDNSAnswer(
     const unsigned char* data, uint16_t bytes_unused, DNSData* dnsSessionData,
-    const Packet* p, std::vector<uint16_t>& tabs)
+    const Packet* p, DnsSection section)
 {
     if ( !bytes_unused )
         return 0;
 
     if (dnsSessionData->curr_rec_state < DNS_RESP_STATE_RR_NAME_COMPLETE)
     {
-        if (dnsSessionData->publish_response())
-            dnsSessionData->cur_fqdn_event = DnsResponseFqdn(data, bytes_unused, dnsSessionData);
+        if (!dnsSessionData->curr_txt.name_state)
+            dnsSessionData->rrs.name = data - p->data;
 
         uint16_t new_bytes_unused = ParseDNSName(data, bytes_unused, dnsSessionData);
         uint16_t bytes_used = bytes_unused - new_bytes_unused;
@@ -534,7 +544,6 @@ static uint16_t ParseDNSAnswer(
     switch (dnsSessionData->curr_rec_state)
     {
     case DNS_RESP_STATE_RR_TYPE:
-        tabs.emplace_back(data - p->data);
         dnsSessionData->curr_rr.type = (uint8_t)*data << 8;
         data++;
 
@@ -615,6 +624,8 @@ static uint16_t ParseDNSAnswer(
     case DNS_RESP_STATE_RR_RDLENGTH_PART:
         dnsSessionData->curr_rr.length |= (uint8_t)*data;
         dnsSessionData->curr_rec_state = DNS_RESP_STATE_RR_RDATA_START;
+        dnsSessionData->rrs.add(section, dnsSessionData->curr_rr, data + 1 - p->data);
+        dnsSessionData->rrs.name = DNS_RR_NO_OFFSET;
         bytes_unused--;
         break;
     }
@@ -781,22 +792,6 @@ static uint16_t ParseDNSRData(
         DetectionEngine::queue_event(GID_DNS, DNS_EVENT_EXPERIMENTAL_TYPES);
         bytes_unused = SkipDNSRData(data, bytes_unused, dnsSessionData);
         break;
-    case DNS_RR_TYPE_A:
-    case DNS_RR_TYPE_AAAA:
-        if (dnsSessionData->publish_response())
-        {
-            dnsSessionData->dns_events.add_fqdn(dnsSessionData->cur_fqdn_event, dnsSessionData->curr_rr.ttl);
-            dnsSessionData->dns_events.add_ip(DnsResponseIp(data, dnsSessionData->curr_rr.type));
-        }
-
-        bytes_unused = SkipDNSRData(data, bytes_unused, dnsSessionData);
-        break;
-    case DNS_RR_TYPE_CNAME:
-        if (dnsSessionData->publish_response())
-            dnsSessionData->dns_events.add_fqdn(dnsSessionData->cur_fqdn_event, dnsSessionData->curr_rr.ttl);
-
-        bytes_unused = SkipDNSRData(data, bytes_unused, dnsSessionData);
-        break;
     default:
         /* An unknown RR type or one w/o special handling, skip */
         bytes_unused = SkipDNSRData(data, bytes_unused, dnsSessionData);
@@ -812,23 +807,8 @@ static void ParseDNSResponseMessage(Packet* p, DNSData* dnsSessionData, bool& ne
     int i;
     const unsigned char* data = p->data;
 
-    // For DNS over TCP, it's possible that multiple DNS transactions may be processed in a single TCP connection.
-    // When a new transaction's DNS response message arrives, the reused DNS session's data field may not be empty,
-    // so we must use the field "state" to determine if we are processing a new DNS response message.
-    // For DNS over UDP, a new session data object is created for each DNS response message, so the following condition
-    // is always met as the data field is always empty.
-    if (dnsSessionData->dns_config->publish_response and (dnsSessionData->data.empty() or
-        dnsSessionData->state == DNS_RESP_STATE_LENGTH))
-    {
-        // We are at the beginning of a new DNS response message, so we need to clear the data field
-        // and the event object, which are reused by multiple DNS transactions in a single TCP connection.
-        dnsSessionData->data.resize(bytes_unused);
-        memcpy((void*)&dnsSessionData->data[0], data, bytes_unused);
-        dnsSessionData->bytes_unused = bytes_unused;
-        // For DNS over TCP, the reused event object may hold domain names and IP addresses extracted
-        // from previous DNS response message which must be cleared before processing a new DNS message.
-        dnsSessionData->dns_events.clear_data();
-    }
+    // The index only refers to this packet; a TCP session reuses it for each PDU.
+    dnsSessionData->rrs.reset();
 
     while (bytes_unused)
     {
@@ -844,6 +824,12 @@ static void ParseDNSResponseMessage(Packet* p, DNSData* dnsSessionData, bool& ne
                 dnsSessionData->state = DNS_RESP_STATE_HDR_ID;
             }
 
+            // compression pointers are relative to the header, after any TCP length
+            if (dnsSessionData->state == DNS_RESP_STATE_LENGTH)
+                dnsSessionData->rrs.msg = data - p->data + 2;
+            else if (dnsSessionData->state == DNS_RESP_STATE_HDR_ID)
+                dnsSessionData->rrs.msg = data - p->data;
+
             bytes_unused = ParseDNSHeader(data, bytes_unused, dnsSessionData);
 
             if (dnsSessionData->hdr.flags & DNS_HDR_FLAG_RESPONSE)
@@ -875,7 +861,7 @@ static void ParseDNSResponseMessage(Packet* p, DNSData* dnsSessionData, bool& ne
             /* Skip over the 4 byte question records... */
             for (i=dnsSessionData->curr_rec; i< dnsSessionData->hdr.questions; i++)
             {
-                bytes_unused = ParseDNSQuestion(data, bytes_unused, dnsSessionData);
+                bytes_unused = ParseDNSQuestion(data, bytes_unused, dnsSessionData, p);
 
                 if (dnsSessionData->curr_rec_state == DNS_RESP_STATE_Q_COMPLETE)
                 {
@@ -901,10 +887,9 @@ static void ParseDNSResponseMessage(Packet* p, DNSData* dnsSessionData, bool& ne
         switch (dnsSessionData->state)
         {
         case DNS_RESP_STATE_ANS_RR: /* ANSWERS section */
-            dnsSessionData->answer_tabs.emplace_back(data - p->data);
             for (i=dnsSessionData->curr_rec; i<dnsSessionData->hdr.answers; i++)
             {
-                bytes_unused = ParseDNSAnswer(data, bytes_unused, dnsSessionData, p, dnsSessionData->answer_tabs);
+                bytes_unused = ParseDNSAnswer(data, bytes_unused, dnsSessionData, p, DNS_SECTION_ANSWER);
 
                 if (bytes_unused == 0)
                 {
@@ -947,10 +932,9 @@ static void ParseDNSResponseMessage(Packet* p, DNSData* dnsSessionData, bool& ne
             dnsSessionData->curr_rec = 0;
         /* Fall through */
         case DNS_RESP_STATE_AUTH_RR: /* AUTHORITIES section */
-            dnsSessionData->auth_tabs.emplace_back(data - p->data);
             for (i=dnsSessionData->curr_rec; i<dnsSessionData->hdr.authorities; i++)
             {
-                bytes_unused = ParseDNSAnswer(data, bytes_unused, dnsSessionData, p, dnsSessionData->auth_tabs);
+                bytes_unused = ParseDNSAnswer(data, bytes_unused, dnsSessionData, p, DNS_SECTION_AUTH);
 
                 if (bytes_unused == 0)
                 {
@@ -993,10 +977,9 @@ static void ParseDNSResponseMessage(Packet* p, DNSData* dnsSessionData, bool& ne
             dnsSessionData->curr_rec = 0;
         /* Fall through */
         case DNS_RESP_STATE_ADD_RR: /* ADDITIONALS section */
-            dnsSessionData->addl_tabs.emplace_back(data - p->data);
             for (i=dnsSessionData->curr_rec; i<dnsSessionData->hdr.additionals; i++)
             {
-                bytes_unused = ParseDNSAnswer(data, bytes_unused, dnsSessionData, p, dnsSessionData->addl_tabs);
+                bytes_unused = ParseDNSAnswer(data, bytes_unused, dnsSessionData, p, DNS_SECTION_ADDL);
 
                 if (bytes_unused == 0)
                 {
@@ -1042,42 +1025,6 @@ static void ParseDNSResponseMessage(Packet* p, DNSData* dnsSessionData, bool& ne
     }
 }
 
-SfIp DnsResponseIp::get_ip()
-{
-    SfIp ip = {};
-    int family = 0;
-    switch (type)
-    {
-        case DNS_RR_TYPE_A:
-            family = AF_INET;
-            break;
-        case DNS_RR_TYPE_AAAA:
-            family = AF_INET6;
-            break;
-    }
-
-    if (family and strlen((const char*)data))
-        ip.set(data, family);
-
-    return ip;
-}
-
-FqdnTtl DnsResponseFqdn::get_fqdn()
-{
-    std::string dns_name;
-    ParseDNSName(data, bytes_unused, dnsSessionData.get(), true);
-
-    if (dnsSessionData->curr_txt.name_state == DNS_RESP_STATE_NAME_COMPLETE)
-        dnsSessionData->curr_txt.get_dns_name(dns_name);
-
-    return FqdnTtl(dns_name, dnsSessionData->curr_rr.ttl);
-}
-
-void DnsResponseFqdn::update_ttl(uint32_t ttl)
-{
-    dnsSessionData->curr_rr.ttl = ttl;
-}
-
 //-------------------------------------------------------------------------
 // class stuff
 //-------------------------------------------------------------------------
@@ -1256,7 +1203,10 @@ static void snort_dns(Packet* p, const DnsConfig* dns_config)
             }
 
             if (!needNextPacket and dnsSessionData->has_events())
-                DataBus::publish(Dns::get_pub_id(), DnsEventIds::DNS_RESPONSE_DATA, dnsSessionData->dns_events);
+            {
+                DnsResponseDataEvents dns_data_event(*dnsSessionData, p);
+                DataBus::publish(Dns::get_pub_id(), DnsEventIds::DNS_RESPONSE_DATA, dns_data_event);
+            }
 
             DnsResponseEvent dns_response_event(*dnsSessionData, p);
             DataBus::publish(Dns::get_pub_id(), DnsEventIds::DNS_RESPONSE, dns_response_event, p->flow);
@@ -23,6 +23,7 @@
 #define DNS_H
 
 #include <set>
+#include <string>
 
 #include "flow/flow.h"
 
@@ -85,13 +86,6 @@ struct DNSNameState
     uint8_t alerted = 0;
     uint16_t offset = 0;
     uint8_t relative = 0;
-    std::string dns_name;
-
-    void get_dns_name(std::string& name) const
-    {
-        if (dns_name.size())
-            name = dns_name;
-    }
 };
 
 #define DNS_RR_TYPE_A                       0x0001
@@ -183,28 +177,52 @@ struct DNSNameState
 #define DNS_RESP_STATE_AUTH_RR          0x50
 #define DNS_RESP_STATE_ADD_RR           0x60
 
-class DnsConfig;
-struct DNSData;
+#define DNS_RR_NO_OFFSET 0xffff
+#define DNS_MAX_INDEXED_RRS 64
 
-class DnsResponseFqdn
+enum DnsSection : uint8_t
 {
-public:
-    DnsResponseFqdn()
-    {}
+    DNS_SECTION_ANSWER,
+    DNS_SECTION_AUTH,
+    DNS_SECTION_ADDL
+};
 
-    DnsResponseFqdn(const unsigned char* data, uint16_t bytes_unused, DNSData* dnsSessionData) :
-        data(data), bytes_unused(bytes_unused), dnsSessionData(std::make_shared<DNSData>(*dnsSessionData))
-    {}
+// A resource record of the current response packet.  Positions are packet
+// offsets so nothing is copied while parsing; names and rdata are decoded
+// only when a subscriber asks for them.
+struct DnsRr
+{
+    uint16_t msg;       // start of the enclosing message, for name compression
+    uint16_t name;      // owner name, DNS_RR_NO_OFFSET if it began in a prior packet
+    uint16_t rdata;
+    uint16_t rdlength;
+    uint16_t type;
+    DnsSection section;
+    uint32_t ttl;
+};
 
-    FqdnTtl get_fqdn();
-    void update_ttl(uint32_t ttl);
+// Fixed size index of the records parsed from one packet.  Records that
+// don't fit are counted and left out of the published data.
+struct DnsRrIndex
+{
+    DnsRr rrs[DNS_MAX_INDEXED_RRS];
+    uint16_t count = 0;
+    uint16_t msg = DNS_RR_NO_OFFSET;        // message being parsed
+    uint16_t name = DNS_RR_NO_OFFSET;       // owner name of the record being parsed
+    uint16_t query = DNS_RR_NO_OFFSET;      // question name
+    uint16_t query_msg = DNS_RR_NO_OFFSET;  // message holding the question
+
+    void reset()
+    {
+        count = 0;
+        msg = name = query = query_msg = DNS_RR_NO_OFFSET;
+    }
 
-private:
-    const unsigned char* data = nullptr;
-    uint16_t bytes_unused = 0;
-    std::shared_ptr<DNSData> dnsSessionData;
+    bool add(DnsSection, const DNSRR&, uint16_t rdata);
 };
 
+class DnsConfig;
+
 // Per-session data block containing current state
 // of the DNS inspector for the session.
 struct DNSData
@@ -214,57 +232,37 @@ struct DNSData
     uint16_t curr_rec_length = 0;
     uint16_t bytes_seen_curr_rec = 0;
     uint16_t length = 0;
-    uint16_t bytes_unused = 0;
     uint8_t curr_rec_state = 0;
     DNSHdr hdr;                   // Copy of the data from the DNS Header
     DNSQuestion curr_q;
     DNSRR curr_rr;
     DNSNameState curr_txt;
     uint8_t flags = 0;
-    std::vector<unsigned char> data;
     const DnsConfig* dns_config = nullptr;
-    snort::DnsResponseDataEvents dns_events;
-    DnsResponseFqdn cur_fqdn_event;
-    std::string resp_query;
-    std::vector<uint16_t> answer_tabs;
-    std::vector<uint16_t> auth_tabs;
-    std::vector<uint16_t> addl_tabs;
-
-    bool publish_response() const;
+    DnsRrIndex rrs;
+
     bool has_events() const;
     bool valid_dns(const DNSHdr&) const;
 
-    void decode_rdata(const snort::Packet* p, const uint8_t* rr, const uint8_t* rdata, uint16_t rdlength,
-        uint16_t type, std::string& rdata_str) const;
-    void get_rr_data(const snort::Packet *p, const std::vector<uint16_t>& tabs,
-        std::string& rrs, std::string* ttls = nullptr) const;
+    void get_fqdn_ips(const snort::Packet*, IPFqdnCacheItem&) const;
+    void get_query(const snort::Packet*, std::string& query) const;
+
+    void get_rr_data(const snort::Packet *p, DnsSection, std::string& rr_list,
+        std::string* ttls = nullptr) const;
     void get_answers(const snort::Packet *p, std::string& answers, std::string& ttls) const
-    { get_rr_data(p, answer_tabs, answers, &ttls); }
-    void get_auth(const snort::Packet *p, std::string& auth) const { get_rr_data(p, auth_tabs, auth); }
-    void get_addl(const snort::Packet *p, std::string& addl) const { get_rr_data(p, addl_tabs, addl); }
+    { get_rr_data(p, DNS_SECTION_ANSWER, answers, &ttls); }
+    void get_auth(const snort::Packet *p, std::string& auth) const { get_rr_data(p, DNS_SECTION_AUTH, auth); }
+    void get_addl(const snort::Packet *p, std::string& addl) const { get_rr_data(p, DNS_SECTION_ADDL, addl); }
 
     static const std::string& qtype_name(uint16_t query_type, bool* is_unknown = nullptr);
-};
-
-DNSData* get_dns_session_data(snort::Packet* p, bool from_server, DNSData& udpSessionData);
-
-class DnsResponseIp
-{
-public:
-    DnsResponseIp()
-    {}
-
-    DnsResponseIp(const unsigned char* data, uint16_t type) :
-        data(data), type(type)
-    {}
-
-    snort::SfIp get_ip();
 
 private:
-    const unsigned char* data = nullptr;
-    uint16_t type = 0;
+    void get_name(const snort::Packet*, uint16_t msg, uint16_t name, std::string&) const;
+    void decode_rdata(const snort::Packet*, const DnsRr&, std::string& rdata_str) const;
 };
 
+DNSData* get_dns_session_data(snort::Packet* p, bool from_server, DNSData& udpSessionData);
+
 // Flow data class for DNS over TCP
 class DnsFlowData : public snort::FlowData
 {
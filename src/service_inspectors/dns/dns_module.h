@@ -49,6 +49,7 @@ struct DnsStats
     PegCount concurrent_sessions;
     PegCount max_concurrent_sessions;
     PegCount aborted_sessions;
+    PegCount unindexed_rrs;
 };
 
 extern const PegInfo dns_peg_names[];
@@ -160,6 +160,22 @@ static void decode_ip(const uint8_t* rdata, uint16_t rdlength, std::string& rdat
 }
 
 static const std::string part_sep = " ";    // separates between parts of an item in a list
+static const unsigned RDATA_OFFSET = 10;     // type, class, ttl, and rdlength precede rdata
+
+// compression pointers are offsets from the start of the message
+struct DnsMessage
+{
+    const uint8_t* data;
+    uint16_t size;
+};
+
+static DnsMessage get_message(const Packet* p, uint16_t msg)
+{
+    if (msg >= p->dsize)
+        return { nullptr, 0 };
+
+    return { p->data + msg, (uint16_t)(p->dsize - msg) };
+}
 
 static void decode_txt(const uint8_t* rdata, uint16_t rdlength, std::string& rdata_str)
 {
@@ -185,7 +201,7 @@ static void decode_txt(const uint8_t* rdata, uint16_t rdlength, std::string& rda
 }
 
 static void decode_domain_name(const uint8_t* rdata, uint16_t rdlength,
-    std::string& rdata_str, const Packet* p = nullptr)
+    std::string& rdata_str, const DnsMessage* msg = nullptr)
 {
     static const int MAX_LINKS = 10;
     int link_count = 0;
@@ -202,20 +218,20 @@ static void decode_domain_name(const uint8_t* rdata, uint16_t rdlength,
 
         if ((label_len & DNS_RR_PTR) == DNS_RR_PTR)
         {
-            if (p == nullptr)
+            if (msg == nullptr or msg->data == nullptr)
                 break;  // compression not supported
 
             if (rdlength < 1)
                 break;  // incomplete offset
 
             uint16_t offset = ((label_len & ~DNS_RR_PTR) << 8) | *rdata;
-            if (offset >= p->dsize)
+            if (offset >= msg->size)
                 break;  // invalid offset
             if (link_count++ > MAX_LINKS)
                 break;  // too many links
 
-            rdata = p->data + offset;
-            rdlength = p->dsize - offset;
+            rdata = msg->data + offset;
+            rdlength = msg->size - offset;
             continue;
         }
 
@@ -286,7 +302,8 @@ static void decode_loc(const uint8_t* rdata, uint16_t rdlength, std::string& rda
     rdata_str.append(std::to_string(rdata[VERT_PRE_OFFSET]));
 }
 
-static void decode_mx(const uint8_t* rdata, uint16_t rdlength, std::string& rdata_str, const Packet* p)
+static void decode_mx(const uint8_t* rdata, uint16_t rdlength, std::string& rdata_str,
+    const DnsMessage* msg)
 {
     static const unsigned EXCHANGE_OFFSET = 2;
     if (rdlength <= EXCHANGE_OFFSET)
@@ -294,19 +311,16 @@ static void decode_mx(const uint8_t* rdata, uint16_t rdlength, std::string& rdat
 
     rdata += EXCHANGE_OFFSET;
     rdlength -= EXCHANGE_OFFSET;
-    decode_domain_name(rdata, rdlength, rdata_str, p);
+    decode_domain_name(rdata, rdlength, rdata_str, msg);
 }
 
 static void decode_nsec(const uint8_t* rdata, uint16_t rdlength, std::string& rdata_str,
-    const Packet* p, const uint8_t* rr_domain_name)
+    const DnsMessage* msg, const uint8_t* rr_domain_name, uint16_t rr_domain_name_len)
 {
     static const std::string nsec_prefix = "NSEC" + part_sep;
-    static const unsigned RDATA_OFFSET = 10;
-    const uint8_t* rr_domain_name_end = rdata - RDATA_OFFSET;
-    uint16_t rr_domain_name_len = rr_domain_name_end - rr_domain_name;
 
     rdata_str.append(nsec_prefix);
-    decode_domain_name(rr_domain_name, rr_domain_name_len, rdata_str, p);
+    decode_domain_name(rr_domain_name, rr_domain_name_len, rdata_str, msg);
     rdata_str.append(part_sep);
     decode_domain_name(rdata, rdlength, rdata_str);
 }
@@ -365,7 +379,8 @@ static void decode_spf(const uint8_t* rdata, uint16_t rdlength, std::string& rda
     rdata_str.append((const char*)rdata, actual_len);
 }
 
-static void decode_srv(const uint8_t* rdata, uint16_t rdlength, std::string& rdata_str, const Packet* p)
+static void decode_srv(const uint8_t* rdata, uint16_t rdlength, std::string& rdata_str,
+    const DnsMessage* msg)
 {
     static const unsigned TARGET_OFFSET = 6;
 
@@ -374,7 +389,7 @@ static void decode_srv(const uint8_t* rdata, uint16_t rdlength, std::string& rda
 
     rdata += TARGET_OFFSET;
     rdlength -= TARGET_OFFSET;
-    decode_domain_name(rdata, rdlength, rdata_str, p);
+    decode_domain_name(rdata, rdlength, rdata_str, msg);
 }
 
 static void decode_sshfp(const uint8_t* rdata, uint16_t rdlength, std::string& rdata_str)
@@ -409,13 +424,18 @@ static void decode_default_rr(std::string& rdata_str, uint16_t type)
     }
 }
 
-void DNSData::decode_rdata(const Packet* p, const uint8_t* rr_domain_name, const uint8_t* rdata,
-    uint16_t rdlength, uint16_t type, std::string& rdata_str) const
+void DNSData::decode_rdata(const Packet* p, const DnsRr& rr, std::string& rdata_str) const
 {
-    assert(rdata <= p->data + p->dsize);
+    assert(rr.rdata <= p->dsize);
 
-    if (rdata + rdlength > p->data + p->dsize)
-        rdlength = p->dsize - (rdata - p->data);
+    const uint8_t* rdata = p->data + rr.rdata;
+    uint16_t rdlength = rr.rdlength;
+    uint16_t type = rr.type;
+
+    if (rr.rdata + rdlength > p->dsize)
+        rdlength = p->dsize - rr.rdata;
+
+    const DnsMessage msg = get_message(p, rr.msg);
 
     switch (type)
     {
@@ -437,7 +457,7 @@ void DNSData::decode_rdata(const Packet* p, const uint8_t* rr_domain_name, const
     case DNS_RR_TYPE_NS:
     case DNS_RR_TYPE_PTR:
     case DNS_RR_TYPE_SOA:
-        decode_domain_name(rdata, rdlength, rdata_str, p);
+        decode_domain_name(rdata, rdlength, rdata_str, &msg);
         break;
 
     case DNS_RR_TYPE_DNSKEY:
@@ -453,12 +473,23 @@ void DNSData::decode_rdata(const Packet* p, const uint8_t* rr_domain_name, const
         break;
 
     case DNS_RR_TYPE_MX:
-        decode_mx(rdata, rdlength, rdata_str, p);
+        decode_mx(rdata, rdlength, rdata_str, &msg);
         break;
 
     case DNS_RR_TYPE_NSEC:
-        decode_nsec(rdata, rdlength, rdata_str, p, rr_domain_name);
+    {
+        // the owner name runs up to the fixed fields when it's in this packet
+        const uint8_t* name = rdata;
+        uint16_t name_len = 0;
+
+        if (rr.name != DNS_RR_NO_OFFSET and rr.rdata >= rr.name + RDATA_OFFSET)
+        {
+            name = p->data + rr.name;
+            name_len = rr.rdata - RDATA_OFFSET - rr.name;
+        }
+        decode_nsec(rdata, rdlength, rdata_str, &msg, name, name_len);
         break;
+    }
 
     case DNS_RR_TYPE_OPT:
         decode_opt(rdata, rdata_str);
@@ -473,7 +504,7 @@ void DNSData::decode_rdata(const Packet* p, const uint8_t* rr_domain_name, const
         break;
 
     case DNS_RR_TYPE_SRV:
-        decode_srv(rdata, rdlength, rdata_str, p);
+        decode_srv(rdata, rdlength, rdata_str, &msg);
         break;
 
     case DNS_RR_TYPE_SSHFP:
@@ -498,48 +529,102 @@ void DNSData::decode_rdata(const Packet* p, const uint8_t* rr_domain_name, const
     }
 }
 
-void DNSData::get_rr_data(const Packet *p, const std::vector<uint16_t>& tabs,
-    std::string& rrs, std::string* ttls) const
+void DNSData::get_rr_data(const Packet *p, DnsSection section,
+    std::string& rr_list, std::string* ttls) const
 {
     assert(p != nullptr);
     assert(p->data != nullptr);
 
     static const std::string item_sep = " ";    // list item separator
-    static const unsigned RDATA_OFFSET = 10;
-    const uint8_t* rr_domain_name = nullptr;
 
-    for (auto tab : tabs)
+    for (unsigned i = 0; i < rrs.count; i++)
     {
-        if (tab + RDATA_OFFSET > p->dsize)
-            continue;
+        const DnsRr& rr = rrs.rrs[i];
 
-        auto rr_type = p->data + tab;
-        if (rr_domain_name == nullptr)
-        {
-            rr_domain_name = rr_type;
+        if (rr.section != section)
             continue;
-        }
 
-        uint16_t type = (rr_type[0] << 8) | rr_type[1];
-        uint32_t ttl = (rr_type[4] << 24) | (rr_type[5] << 16) | (rr_type[6] << 8) | rr_type[7];
-        uint16_t rdlength = (rr_type[8] << 8) | rr_type[9];
-
-        auto rdata = rr_type + RDATA_OFFSET;
         std::string rdata_str;
-        decode_rdata(p, rr_domain_name, rdata, rdlength, type, rdata_str);
-        rr_domain_name = rdata + rdlength;
+        decode_rdata(p, rr, rdata_str);
 
         if (rdata_str.empty())
             continue;
 
-        if (!rrs.empty())
+        if (!rr_list.empty())
         {
-            rrs.append(item_sep);
+            rr_list.append(item_sep);
             if (ttls)
                 ttls->append(item_sep);
         }
-        rrs.append(rdata_str);
+        rr_list.append(rdata_str);
         if (ttls)
-            ttls->append(std::to_string(ttl));
+            ttls->append(std::to_string(rr.ttl));
+    }
+}
+
+void DNSData::get_name(const Packet* p, uint16_t msg, uint16_t name, std::string& name_str) const
+{
+    if (name >= p->dsize)
+        return;
+
+    const DnsMessage m = get_message(p, msg);
+    decode_domain_name(p->data + name, p->dsize - name, name_str, &m);
+}
+
+void DNSData::get_query(const Packet* p, std::string& query) const
+{
+    get_name(p, rrs.query_msg, rrs.query, query);
+}
+
+void DNSData::get_fqdn_ips(const Packet* p, IPFqdnCacheItem& ip_fqdn_cache_item) const
+{
+    for (unsigned i = 0; i < rrs.count; i++)
+    {
+        const DnsRr& rr = rrs.rrs[i];
+
+        if (rr.section != DNS_SECTION_ANSWER)
+            continue;
+
+        int family;
+        uint16_t len;
+
+        if (rr.type == DNS_RR_TYPE_A)
+        {
+            family = AF_INET;
+            len = 4;
+        }
+        else if (rr.type == DNS_RR_TYPE_AAAA)
+        {
+            family = AF_INET6;
+            len = 16;
+        }
+        else
+            continue;
+
+        if (rr.rdlength != len or rr.rdata + len > p->dsize or !p->data[rr.rdata])
+            continue;
+
+        SfIp ip = {};
+        ip.set(p->data + rr.rdata, family);
+        ip_fqdn_cache_item.add_ip(ip);
+    }
+
+    // don't add fqdns without ips
+    if (ip_fqdn_cache_item.ips.empty())
+        return;
+
+    for (unsigned i = 0; i < rrs.count; i++)
+    {
+        const DnsRr& rr = rrs.rrs[i];
+
+        if (rr.section != DNS_SECTION_ANSWER or rr.name == DNS_RR_NO_OFFSET)
+            continue;
+
+        if (rr.type != DNS_RR_TYPE_A and rr.type != DNS_RR_TYPE_AAAA and rr.type != DNS_RR_TYPE_CNAME)
+            continue;
+
+        std::string fqdn;
+        get_name(p, rr.msg, rr.name, fqdn);
+        ip_fqdn_cache_item.add_fqdn(FqdnTtl(fqdn, rr.ttl));
     }
 }
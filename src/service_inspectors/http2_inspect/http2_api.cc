@@ -69,7 +69,7 @@ const InspectApi Http2Api::http2_api =
     Http2Api::http2_init,
     Http2Api::http2_term,
     nullptr,
-    nullptr,
+    Http2Api::http2_tterm,
     Http2Api::http2_ctor,
     Http2Api::http2_dtor,
     nullptr,
@@ -25,6 +25,7 @@
 
 #include "http2_flow_data.h"
 #include "http2_module.h"
+#include "http2_stream.h"
 
 class Http2Api
 {
@@ -40,6 +41,7 @@ private:
     static const char* http2_help;
     static void http2_init() { Http2FlowData::init(); }
     static void http2_term() { }
+    static void http2_tterm() { Http2StreamPool::term(); }
     static snort::Inspector* http2_ctor(snort::Module* mod);
     static void http2_dtor(snort::Inspector* p) { delete p; }
 };
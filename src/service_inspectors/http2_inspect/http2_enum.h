@@ -55,7 +55,7 @@ enum HTTP2_BUFFER { HTTP2_BUFFER_FRAME_HEADER = 1, HTTP2_BUFFER_FRAME_DATA,
 // This enum must remain synchronized with Http2Module::peg_names[] in http2_tables.cc
 enum PEG_COUNT { PEG_FLOW = 0, PEG_CONCURRENT_SESSIONS, PEG_MAX_CONCURRENT_SESSIONS,
     PEG_MAX_TABLE_ENTRIES, PEG_MAX_CONCURRENT_FILES, PEG_TOTAL_BYTES, PEG_MAX_CONCURRENT_STREAMS,
-    PEG_FLOWS_OVER_STREAM_LIMIT, PEG_COUNT__MAX };
+    PEG_FLOWS_OVER_STREAM_LIMIT, PEG_EVICTED_STREAMS, PEG_COUNT__MAX };
 
 enum EventSid
 {
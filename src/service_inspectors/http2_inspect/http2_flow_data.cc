@@ -101,6 +101,9 @@ Http2FlowData::~Http2FlowData()
     }
 
     flow->stream_intf = nullptr;
+
+    for (Http2Stream* stream : streams)
+        delete stream;
 }
 
 HttpFlowData* Http2FlowData::get_hi_flow_data()
@@ -119,9 +122,13 @@ void Http2FlowData::set_hi_flow_data(HttpFlowData* flow)
 
 Http2Stream* Http2FlowData::find_stream(const uint32_t key)
 {
-    auto it = std::find_if(streams.begin(), streams.end(),
-        [key](const Http2Stream &stream){ return stream.get_stream_id() == key; });
-    return (it != streams.end()) ? &(*it) : nullptr;
+    // Newest streams are the most likely to be active
+    for (auto it = streams.rbegin(); it != streams.rend(); ++it)
+    {
+        if ((*it)->get_stream_id() == key)
+            return *it;
+    }
+    return nullptr;
 }
 
 Http2Stream* Http2FlowData::get_processing_stream(const SourceId source_id, uint32_t concurrent_streams_limit)
@@ -175,8 +182,8 @@ Http2Stream* Http2FlowData::get_processing_stream(const SourceId source_id, uint
         }
 
         // Allocate new stream
-        streams.emplace_front(key, this);
-        stream = &streams.front();
+        stream = new Http2Stream(key, this);
+        streams.push_back(stream);
 
         // stream 0 does not count against stream limit
         if (key > 0)
@@ -186,17 +193,41 @@ Http2Stream* Http2FlowData::get_processing_stream(const SourceId source_id, uint
                 Http2Module::increment_peg_counts(PEG_MAX_CONCURRENT_STREAMS);
         }
     }
+    stream->set_last_active(++frames_processed);
     return stream;
 }
 
-void Http2FlowData::delete_processing_stream()
+// Evict the HTTP/1 inspection state of the least recently active streams until no more than
+// max_resident_streams hold any. Streams with a frame in progress in either direction are never
+// chosen. A limit of zero means no limit.
+void Http2FlowData::limit_resident_streams(uint32_t max_resident_streams)
 {
-    std::list<Http2Stream>::iterator it;
+    while ((max_resident_streams > 0) && (resident_streams > max_resident_streams))
+    {
+        Http2Stream* idlest = nullptr;
+        for (Http2Stream* stream : streams)
+        {
+            const uint32_t id = stream->get_stream_id();
+            if ((stream->get_hi_flow_data() == nullptr) || (id == processing_stream_id) ||
+                (id == stream_in_hi) || (id == current_stream[SRC_CLIENT]) ||
+                (id == current_stream[SRC_SERVER]))
+                continue;
+            if ((idlest == nullptr) || (stream->get_last_active() < idlest->get_last_active()))
+                idlest = stream;
+        }
+        if (idlest == nullptr)
+            return;
+        idlest->evict();
+    }
+}
 
-    for (it = streams.begin(); it != streams.end(); ++it)
+void Http2FlowData::delete_processing_stream()
+{
+    for (auto it = streams.begin(); it != streams.end(); ++it)
     {
-        if (it->get_stream_id() == processing_stream_id)
+        if ((*it)->get_stream_id() == processing_stream_id)
         {
+            delete *it;
             streams.erase(it);
             delete_stream = false;
             assert(concurrent_streams > 0);
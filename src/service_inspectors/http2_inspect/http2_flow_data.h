@@ -90,6 +90,7 @@ public:
     Http2Stream* find_current_stream(const HttpCommon::SourceId source_id);
     uint32_t get_current_stream_id(const HttpCommon::SourceId source_id) const;
     Http2Stream* get_processing_stream(const HttpCommon::SourceId source_id, uint32_t concurrent_streams_limit);
+    void limit_resident_streams(uint32_t max_resident_streams);
     Http2Stream* find_processing_stream();
     uint32_t get_processing_stream_id() const;
     void set_processing_stream_id(const HttpCommon::SourceId source_id);
@@ -152,9 +153,13 @@ protected:
     Http2ConnectionSettings connection_settings[2];
     Http2ConnectionSettingsQueue settings_queue[2];
     Http2HpackDecoder hpack_decoder[2];
-    std::list<Http2Stream> streams;
+    // Oldest stream first
+    std::vector<Http2Stream*> streams;
     uint32_t concurrent_files = 0;
     uint32_t concurrent_streams = 0;
+    // Streams currently holding HTTP/1 inspection state
+    uint32_t resident_streams = 0;
+    uint64_t frames_processed = 0;
     uint32_t stream_memory_allocations_tracked = Http2Enums::STREAM_MEMORY_TRACKING_INCREMENT;
     uint32_t max_stream_id[2] = {0, 0};
     bool frame_in_detection = false;
@@ -120,14 +120,11 @@ bool Http2HpackDecoder::decode_indexed_name(const uint8_t* encoded_header_buffer
         return false;
     }
 
-    // If this header will be added to the dynamic table and was from the dynamic table, we need to
-    // make a copy because the original table entry may be pruned and freed
+    // If this header will be added to the dynamic table and was from the dynamic table, the
+    // original table entry may be pruned and its bytes reused. Refer to the copy just written to
+    // the decoded header buffer instead.
     if (with_indexing and index > HpackIndexTable::STATIC_MAX_INDEX)
-    {
-        uint8_t* name_copy = new uint8_t[entry->name.length()];
-        memcpy(name_copy, entry->name.start(), entry->name.length());
-        name.set(entry->name.length(), name_copy, true);
-    }
+        name.set(bytes_written, decoded_header_buffer);
     else
         name.set(entry->name);
     return true;
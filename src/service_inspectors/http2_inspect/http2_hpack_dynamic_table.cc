@@ -25,6 +25,7 @@
 #include "http2_module.h"
 
 #include <cstring>
+#include <vector>
 
 #include "http2_hpack_table.h"
 
@@ -32,11 +33,8 @@ using namespace Http2Enums;
 
 HpackDynamicTable::~HpackDynamicTable()
 {
-    for (std::vector<HpackTableEntry*>::iterator it = circular_buf.begin();
-        it != circular_buf.end(); ++it)
-    {
-        delete *it;
-    }
+    delete[] circular_buf;
+    delete[] ring;
 }
 
 bool HpackDynamicTable::add_entry(const Field& name, const Field& value)
@@ -45,7 +43,9 @@ bool HpackDynamicTable::add_entry(const Field& name, const Field& value)
     if (num_entries >= ARRAY_CAPACITY)
         return false;
 
-    const uint32_t new_entry_size = name.length() + value.length() + RFC_ENTRY_OVERHEAD;
+    const uint32_t name_len = name.length();
+    const uint32_t value_len = value.length();
+    const uint32_t new_entry_size = name_len + value_len + RFC_ENTRY_OVERHEAD;
 
     // As per the RFC, attempting to add an entry that is larger than the max size of the table is
     // not an error, it causes the table to be cleared
@@ -55,16 +55,39 @@ bool HpackDynamicTable::add_entry(const Field& name, const Field& value)
         return true;
     }
 
-    // Create new entry. This is done before pruning because the entry referenced by the new name
-    // may be pruned.
-    HpackTableEntry* new_entry = new HpackTableEntry(name, value);
+    // The new name may reference an entry that is about to be pruned and whose ring space may be
+    // reused for the new entry. Stage anything that points into the ring before pruning.
+    const uint8_t* name_src = name.start();
+    const uint8_t* value_src = value.start();
+    std::vector<uint8_t> staged;
+    if (in_ring(name) or in_ring(value))
+    {
+        staged.resize(name_len + value_len);
+        if (name_len > 0)
+            memcpy(staged.data(), name_src, name_len);
+        if (value_len > 0)
+            memcpy(staged.data() + name_len, value_src, value_len);
+        name_src = staged.data();
+        value_src = staged.data() + name_len;
+    }
 
     // If add entry would exceed max table size, evict old entries
     prune_to_size(max_size - new_entry_size);
 
+    if (num_entries == array_capacity)
+        grow_array();
+
+    uint8_t* const dest = ring_alloc(name_len + value_len);
+    if (name_len > 0)
+        memcpy(dest, name_src, name_len);
+    if (value_len > 0)
+        memcpy(dest + name_len, value_src, value_len);
+
     // Add new entry to the front of the table (newest entry = lowest index)
-    start = (start + ARRAY_CAPACITY - 1) % ARRAY_CAPACITY;
-    circular_buf[start] = new_entry;
+    start = (start + array_capacity - 1) % array_capacity;
+    HpackTableEntry& new_entry = circular_buf[start];
+    new_entry.name.set(name_len, dest);
+    new_entry.value.set(value_len, dest + name_len);
 
     num_entries++;
     if (num_entries > Http2Module::get_peg_counts(PEG_MAX_TABLE_ENTRIES))
@@ -81,8 +104,8 @@ const HpackTableEntry* HpackDynamicTable::get_entry(uint32_t virtual_index) cons
     if (dyn_index + 1 > num_entries)
         return nullptr;
 
-    const uint32_t arr_index = (start + dyn_index) % ARRAY_CAPACITY;
-    return circular_buf[arr_index];
+    const uint32_t arr_index = (start + dyn_index) % array_capacity;
+    return &circular_buf[arr_index];
 }
 
 /* This is called when adding a new entry and when receiving a dynamic table size update.
@@ -95,12 +118,31 @@ void HpackDynamicTable::prune_to_size(uint32_t new_max_size)
 {
     while (rfc_table_size > new_max_size)
     {
-        const uint32_t last_index = (start + num_entries - 1 + ARRAY_CAPACITY) % ARRAY_CAPACITY;
+        const uint32_t last_index = (start + num_entries - 1) % array_capacity;
+        HpackTableEntry& entry = circular_buf[last_index];
+        const uint32_t length = entry.name.length() + entry.value.length();
         num_entries--;
-        rfc_table_size -= circular_buf[last_index]->name.length() +
-            circular_buf[last_index]->value.length() + RFC_ENTRY_OVERHEAD;
-        delete circular_buf[last_index];
-        circular_buf[last_index] = nullptr;
+        rfc_table_size -= length + RFC_ENTRY_OVERHEAD;
+
+        // The oldest entry always sits at the ring tail, so releasing it just advances the tail
+        if (length > 0)
+        {
+            ring_bytes -= length;
+            ring_tail = (entry.name.start() - ring) + length;
+            if (ring_wrapped and ring_tail == ring_wrap_end)
+            {
+                ring_tail = 0;
+                ring_wrapped = false;
+            }
+        }
+        entry.name.reset();
+        entry.value.reset();
+    }
+
+    if (ring_bytes == 0)
+    {
+        ring_head = ring_tail = 0;
+        ring_wrapped = false;
     }
 }
 
@@ -112,3 +154,96 @@ void HpackDynamicTable::update_size(uint32_t new_size)
     }
     max_size = new_size;
 }
+
+// Descriptor array grows by doubling up to ARRAY_CAPACITY. Entries are relinearized so that the
+// newest entry is at index 0.
+void HpackDynamicTable::grow_array()
+{
+    uint32_t new_capacity = array_capacity ? array_capacity * 2 : MIN_ARRAY_CAPACITY;
+    if (new_capacity > ARRAY_CAPACITY)
+        new_capacity = ARRAY_CAPACITY;
+    HpackTableEntry* const new_buf = new HpackTableEntry[new_capacity];
+
+    for (uint32_t k = 0; k < num_entries; k++)
+    {
+        const HpackTableEntry& entry = circular_buf[(start + k) % array_capacity];
+        new_buf[k].name.set(entry.name);
+        new_buf[k].value.set(entry.value);
+    }
+
+    delete[] circular_buf;
+    circular_buf = new_buf;
+    array_capacity = new_capacity;
+    start = 0;
+}
+
+// Reserve length contiguous bytes at the ring head
+uint8_t* HpackDynamicTable::ring_alloc(uint32_t length)
+{
+    if (ring == nullptr)
+        compact_ring(length);
+    else if (!ring_wrapped)
+    {
+        if (ring_size - ring_head < length)
+        {
+            if (ring_tail >= length)
+            {
+                // Leave a gap at the end of the ring and continue at the beginning
+                ring_wrap_end = ring_head;
+                ring_head = 0;
+                ring_wrapped = true;
+            }
+            else
+                compact_ring(length);
+        }
+    }
+    else if (ring_tail - ring_head < length)
+        compact_ring(length);
+
+    uint8_t* const dest = ring + ring_head;
+    ring_head += length;
+    ring_bytes += length;
+    return dest;
+}
+
+// Copy the live entries, oldest first, to the beginning of a new ring with at least min_free
+// contiguous bytes after them. The ring is sized at twice the space needed so that compaction
+// cost is amortized over many additions.
+void HpackDynamicTable::compact_ring(uint32_t min_free)
+{
+    const uint64_t needed = (uint64_t)ring_bytes + min_free;
+    uint64_t new_size = ring_size;
+    if (new_size < 2 * needed)
+        new_size = 2 * needed > MIN_RING_SIZE ? 2 * needed : MIN_RING_SIZE;
+    if (new_size > UINT32_MAX)
+        new_size = needed;
+
+    uint8_t* const new_ring = new uint8_t[new_size];
+    uint32_t pos = 0;
+    for (uint32_t k = num_entries; k > 0; k--)
+    {
+        HpackTableEntry& entry = circular_buf[(start + k - 1) % array_capacity];
+        const uint32_t name_len = entry.name.length();
+        const uint32_t value_len = entry.value.length();
+        if (name_len + value_len > 0)
+            memcpy(new_ring + pos, entry.name.start(), name_len + value_len);
+        entry.name.reset();
+        entry.name.set(name_len, new_ring + pos);
+        entry.value.reset();
+        entry.value.set(value_len, new_ring + pos + name_len);
+        pos += name_len + value_len;
+    }
+
+    delete[] ring;
+    ring = new_ring;
+    ring_size = new_size;
+    ring_head = pos;
+    ring_tail = 0;
+    ring_wrapped = false;
+}
+
+bool HpackDynamicTable::in_ring(const Field& field) const
+{
+    return field.length() > 0 and ring != nullptr and field.start() >= ring and
+        field.start() < ring + ring_size;
+}
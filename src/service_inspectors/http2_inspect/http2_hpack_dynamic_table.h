@@ -25,16 +25,18 @@
 
 #include "http2_enum.h"
 
-#include <vector>
-
 struct HpackTableEntry;
 class Http2FlowData;
 
+// Entry names and values are stored back to back in a single byte ring. Eviction is strictly
+// oldest first so the live bytes always form one contiguous, possibly wrapped, region of the
+// ring and adding or evicting an entry never allocates. The entry descriptors are non-owning
+// Fields that point into the ring. Both the ring and the descriptor array start small and grow
+// on demand; the ring is compacted into a larger buffer when the free space is fragmented.
 class HpackDynamicTable
 {
 public:
-    // FIXIT-P This array can be optimized to start smaller and grow on demand
-    HpackDynamicTable() : circular_buf(ARRAY_CAPACITY, nullptr) {}
+    HpackDynamicTable() = default;
     ~HpackDynamicTable();
     const HpackTableEntry* get_entry(uint32_t index) const;
     bool add_entry(const Field& name, const Field& value);
@@ -46,13 +48,30 @@ private:
 
     const static uint32_t DEFAULT_MAX_SIZE = 4096;
     const static uint32_t ARRAY_CAPACITY = 512;
+    const static uint32_t MIN_ARRAY_CAPACITY = 16;
+    const static uint32_t MIN_RING_SIZE = 1024;
     uint32_t max_size = DEFAULT_MAX_SIZE;
 
     uint32_t start = 0;
     uint32_t num_entries = 0;
     uint32_t rfc_table_size = 0;
-    std::vector<HpackTableEntry*> circular_buf;
+    uint32_t array_capacity = 0;
+    HpackTableEntry* circular_buf = nullptr;
+
+    // Byte ring holding entry names and values. Used bytes are [ring_tail, ring_head) or, once
+    // the ring has wrapped, [ring_tail, ring_wrap_end) + [0, ring_head).
+    uint8_t* ring = nullptr;
+    uint32_t ring_size = 0;
+    uint32_t ring_head = 0;
+    uint32_t ring_tail = 0;
+    uint32_t ring_wrap_end = 0;
+    uint32_t ring_bytes = 0;
+    bool ring_wrapped = false;
 
     void prune_to_size(uint32_t new_max_size);
+    void grow_array();
+    uint8_t* ring_alloc(uint32_t length);
+    void compact_ring(uint32_t min_free);
+    bool in_ring(const Field& field) const;
 };
 #endif
@@ -1853,3 +1853,39 @@ const HuffmanEntry huffman_decode[HUFFMAN_LOOKUP_MAX+1] [UINT8_MAX+1] =
         {6, (char)0, HUFFMAN_FAILURE}, {6, (char)0, HUFFMAN_FAILURE},
     },
 };
+
+HuffmanMultiEntry huffman_multi_decode[1 << HUFFMAN_MULTI_BITS];
+
+// Built from huffman_decode so the two tables cannot disagree. Input bits beyond the index are
+// taken as zero, which is safe because a code is only accepted when it ends within the index.
+static bool build_huffman_multi_decode()
+{
+    for (uint32_t index = 0; index < (1 << HUFFMAN_MULTI_BITS); index++)
+    {
+        HuffmanMultiEntry& multi = huffman_multi_decode[index];
+        const uint32_t bits = index << (32 - HUFFMAN_MULTI_BITS);
+        uint8_t used = 0;
+
+        while (multi.count < 2)
+        {
+            const uint32_t window = bits << used;
+            HuffmanEntry entry = huffman_decode[HUFFMAN_LOOKUP_1][window >> 24];
+            uint8_t len = entry.len;
+            if (entry.state != HUFFMAN_MATCH and entry.state != HUFFMAN_FAILURE)
+            {
+                entry = huffman_decode[entry.state][(uint8_t)(window >> 16)];
+                len = 8 + entry.len;
+            }
+            if (entry.state != HUFFMAN_MATCH or used + len > HUFFMAN_MULTI_BITS)
+                break;
+
+            multi.symbol[multi.count++] = entry.symbol;
+            multi.last_len = entry.len;
+            used += len;
+        }
+        multi.bits = used;
+    }
+    return true;
+}
+
+static const bool huffman_multi_decode_built = build_huffman_multi_decode();
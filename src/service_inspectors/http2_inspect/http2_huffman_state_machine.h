@@ -53,5 +53,22 @@ struct HuffmanEntry
 
 SO_PUBLIC extern const HuffmanEntry huffman_decode[][UINT8_MAX+1];
 
+// Multi-symbol decode table indexed by the next HUFFMAN_MULTI_BITS bits of input. Each entry
+// holds every complete code that fits in those bits (at most two since the shortest code is
+// 5 bits). count is 0 when the first code is longer than HUFFMAN_MULTI_BITS or is EOS, in which
+// case the decoder falls back to huffman_decode. last_len is the length of the final
+// huffman_decode lookup for the last symbol so the byte-wise decoder can resume after it.
+const uint8_t HUFFMAN_MULTI_BITS = 12;
+
+struct HuffmanMultiEntry
+{
+    uint8_t symbol[2];
+    uint8_t count;
+    uint8_t bits;
+    uint8_t last_len;
+};
+
+SO_PUBLIC extern HuffmanMultiEntry huffman_multi_decode[1 << HUFFMAN_MULTI_BITS];
+
 #endif
 
@@ -30,6 +30,9 @@ const Parameter Http2Module::http2_params[] =
 {
     { "concurrent_streams_limit", Parameter::PT_INT, "100:1000", "100",
       "Maximum number of concurrent streams allowed in a single HTTP/2 flow" },
+    { "resident_streams_limit", Parameter::PT_INT, "0:1000", "0",
+      "Maximum number of streams in a single HTTP/2 flow holding HTTP/1 inspection state. "
+      "The least recently active streams beyond this are no longer inspected. 0 is no limit" },
     { "settings_max_frame_size", Parameter::PT_INT, "16384:16777215", "16777215",
       "Maximum allowed value for settings frame SETTINGS_MAX_FRAME_SIZE" },
 #ifdef REG_TEST
@@ -63,6 +66,10 @@ bool Http2Module::set(const char*, Value& val, SnortConfig*)
     {
         params->concurrent_streams_limit = val.get_uint32();
     }
+    else if (val.is("resident_streams_limit"))
+    {
+        params->resident_streams_limit = val.get_uint32();
+    }
     else if (val.is("settings_max_frame_size"))
     {
         params->settings_max_frame_size = val.get_uint32();
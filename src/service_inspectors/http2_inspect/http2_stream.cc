@@ -29,6 +29,7 @@
 
 #include "http2_data_cutter.h"
 #include "http2_flow_data.h"
+#include "http2_module.h"
 
 using namespace snort;
 using namespace HttpCommon;
@@ -43,7 +44,21 @@ Http2Stream::Http2Stream(uint32_t stream_id_, Http2FlowData* session_data_) :
 Http2Stream::~Http2Stream()
 {
     delete current_frame;
-    delete hi_flow_data;
+    if (hi_flow_data != nullptr)
+    {
+        delete hi_flow_data;
+        session_data->resident_streams--;
+    }
+}
+
+void* Http2Stream::operator new(std::size_t size)
+{
+    return Http2StreamPool::acquire(size);
+}
+
+void Http2Stream::operator delete(void* ptr, std::size_t size)
+{
+    Http2StreamPool::release(ptr, size);
 }
 
 void Http2Stream::eval_frame(const uint8_t* header_buffer, uint32_t header_len,
@@ -76,11 +91,31 @@ void Http2Stream::check_and_cleanup_completed()
         {
             delete hi_flow_data;
             hi_flow_data = nullptr;
+            session_data->resident_streams--;
         }
         session_data->delete_stream = true;
     }
 }
 
+// Release the HTTP/1 inspection state of an idle stream. The stream itself is kept so that later
+// frames on it are recognized, but it is moved to the error state in both directions and is not
+// inspected any further.
+void Http2Stream::evict()
+{
+    assert(current_frame == nullptr);
+    assert(hi_flow_data != nullptr);
+    delete hi_flow_data;
+    hi_flow_data = nullptr;
+    session_data->resident_streams--;
+
+    for (SourceId source_id : { SRC_CLIENT, SRC_SERVER })
+    {
+        if (state[source_id] != STREAM_ERROR)
+            set_state(source_id, STREAM_ERROR);
+    }
+    Http2Module::increment_peg_counts(PEG_EVICTED_STREAMS);
+}
+
 void Http2Stream::clear_frame(Packet* p)
 {
     assert(current_frame != nullptr);
@@ -104,6 +139,8 @@ void Http2Stream::set_hi_flow_data(HttpFlowData* flow_data)
 {
     assert(hi_flow_data == nullptr);
     hi_flow_data = flow_data;
+    if (hi_flow_data != nullptr)
+        session_data->resident_streams++;
 }
 
 const Field& Http2Stream::get_buf(unsigned id)
@@ -22,6 +22,7 @@
 
 #include "service_inspectors/http_inspect/http_common.h"
 #include "service_inspectors/http_inspect/http_field.h"
+#include "utils/free_list_pool.h"
 
 #include "http2_enum.h"
 #include "http2_frame.h"
@@ -37,6 +38,11 @@ class Http2Stream
 public:
     Http2Stream(uint32_t stream_id, Http2FlowData* session_data_);
     ~Http2Stream();
+
+    // Storage is recycled through Http2StreamPool
+    static void* operator new(std::size_t size);
+    static void operator delete(void* ptr, std::size_t size);
+
     uint32_t get_stream_id() const { return stream_id; }
     void eval_frame(const uint8_t* header_buffer, uint32_t header_len, const uint8_t* data_buffer,
         uint32_t data_len, HttpCommon::SourceId source_id, snort::Packet* p, const Http2ParaList* params);
@@ -47,6 +53,12 @@ public:
     void set_hi_flow_data(HttpFlowData* flow_data);
     Http2Frame *get_current_frame() { return current_frame; }
 
+    // Resident stream limit support. The least recently active stream with HTTP/1 inspection
+    // state may give it up, after which the stream is no longer inspected.
+    void set_last_active(uint64_t frame_num) { last_active = frame_num; }
+    uint64_t get_last_active() const { return last_active; }
+    void evict();
+
     void set_state(HttpCommon::SourceId source_id, Http2Enums::StreamState new_state);
     Http2Enums::StreamState get_state(HttpCommon::SourceId source_id) const
         { return state[source_id]; }
@@ -71,10 +83,14 @@ private:
     Http2FlowData* const session_data;
     Http2Frame* current_frame = nullptr;
     HttpFlowData* hi_flow_data = nullptr;
+    uint64_t last_active = 0;
     bool end_stream_on_data_flush[2] = { false, false };
     Http2Enums::StreamState state[2] =
         { Http2Enums::STREAM_EXPECT_HEADERS, Http2Enums::STREAM_EXPECT_HEADERS };
     bool discard[2] = { false, false };
 };
 
+// Connections multiplexing many short streams create and delete them at a high rate
+using Http2StreamPool = snort::StoragePool<Http2Stream, 256>;
+
 #endif
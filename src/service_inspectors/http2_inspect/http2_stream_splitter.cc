@@ -263,9 +263,11 @@ bool Http2StreamSplitter::finish(Flow* flow)
 #endif
     }
 
-    // Loop through all nonzero streams with open message bodies and call NHI finish()
-    for (const Http2Stream& stream : session_data->streams)
+    // Loop through all nonzero streams with open message bodies and call NHI finish(), newest
+    // stream first
+    for (auto it = session_data->streams.rbegin(); it != session_data->streams.rend(); ++it)
     {
+        const Http2Stream& stream = **it;
         if ((stream.get_stream_id() == 0)                            ||
             (stream.get_state(source_id) >= STREAM_COMPLETE)         ||
             (stream.get_hi_flow_data() == nullptr)                   ||
@@ -91,6 +91,7 @@ const PegInfo Http2Module::peg_names[PEG_COUNT__MAX+1] =
     { CountType::SUM, "total_bytes", "total HTTP/2 data bytes inspected" },
     { CountType::MAX, "max_concurrent_streams", "maximum concurrent streams per HTTP/2 connection" },
     { CountType::SUM, "flows_over_stream_limit", "HTTP/2 flows exceeding 100 concurrent streams" },
+    { CountType::SUM, "evicted_streams", "idle HTTP/2 streams no longer inspected due to resident_streams_limit" },
     { CountType::END, nullptr, nullptr }
 };
 
@@ -24,11 +24,43 @@
 #include "http2_varlen_string_decode.h"
 
 #include <cmath>
+#include <cstring>
+
+#include "utils/endian.h"
 
 // Minimum bit length for each lookup table
 static const uint8_t min_decode_len[HUFFMAN_LOOKUP_MAX + 1] =
     {5, 2, 2, 3, 5, 1, 1, 2, 2, 2, 2, 3, 3, 3, 4};
 
+// Decode a single symbol whose code is too long for huffman_multi_decode using the byte-wise
+// tables. At least 40 bits of input must be available at pos. Returns false on EOS and leaves
+// pos unchanged so the byte-wise decoder can report it.
+static inline bool huffman_decode_long(const uint8_t* encoded, uint32_t& pos, uint8_t*& out,
+    uint8_t& last_len)
+{
+    uint32_t code_pos = pos;
+    HuffmanState lookup = HUFFMAN_LOOKUP_1;
+    HuffmanEntry entry;
+    while (true)
+    {
+        const uint8_t* const b = encoded + (code_pos >> 3);
+        entry = huffman_decode[lookup][(uint8_t)((((uint16_t)b[0] << 8) | b[1]) >>
+            (8 - (code_pos & 7)))];
+        if (entry.state == HUFFMAN_MATCH or entry.state == HUFFMAN_FAILURE)
+            break;
+        lookup = entry.state;
+        code_pos += 8;
+    }
+
+    if (entry.state != HUFFMAN_MATCH)
+        return false;
+
+    *out++ = entry.symbol;
+    pos = code_pos + entry.len;
+    last_len = entry.len;
+    return true;
+}
+
 template <typename IntDec, typename EGen, typename Inf>
 bool VarLengthStringDecode<IntDec, EGen, Inf>::translate(const uint8_t* in_buff, const uint32_t in_len,
     IntDec& decode_int, uint32_t& bytes_consumed, uint8_t* out_buff,
@@ -161,6 +193,74 @@ bool VarLengthStringDecode<IntDec, EGen, Inf>::get_huffman_string(const uint8_t*
         return false;
     }
 
+    // Fast path: decode whole symbols with the multi-symbol table while there is enough input
+    // left that no read can run past the string. The tail and all padding checks are left to the
+    // byte-wise state machine below, which resumes at the next symbol boundary exactly as if it
+    // had decoded everything up to that point itself. Every symbol takes at least 5 bits so the
+    // max_length check above leaves room for the unconditional second symbol store.
+    const uint8_t* const encoded = in_buff + bytes_consumed;
+    const uint32_t encoded_bits = encoded_len * 8;
+    uint8_t* out = out_buff + bytes_written;
+    uint32_t pos = 0;
+    uint8_t last_len = 0;
+    bool eos = false;
+
+    // A 64-bit load leaves at least 57 valid bits, enough for four table lookups
+    while (pos + 64 <= encoded_bits and !eos)
+    {
+        uint64_t window;
+        memcpy(&window, encoded + (pos >> 3), sizeof(window));
+        window = ntohll(window) << (pos & 7);
+
+        uint32_t used = 0;
+        unsigned lookups = 0;
+        for (; lookups < 4; lookups++)
+        {
+            const HuffmanMultiEntry multi =
+                huffman_multi_decode[(window << used) >> (64 - HUFFMAN_MULTI_BITS)];
+            if (multi.count == 0)
+                break;
+            out[0] = multi.symbol[0];
+            out[1] = multi.symbol[1];
+            out += multi.count;
+            used += multi.bits;
+            last_len = multi.last_len;
+        }
+        pos += used;
+
+        if (lookups < 4 and pos + 40 <= encoded_bits)
+            eos = !huffman_decode_long(encoded, pos, out, last_len);
+    }
+
+    while (pos + 40 <= encoded_bits and !eos)
+    {
+        const uint8_t* const p = encoded + (pos >> 3);
+        const uint32_t window = (((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) |
+            ((uint32_t)p[2] << 8) | p[3]) << (pos & 7);
+        const HuffmanMultiEntry multi = huffman_multi_decode[window >> (32 - HUFFMAN_MULTI_BITS)];
+
+        if (multi.count == 0)
+        {
+            eos = !huffman_decode_long(encoded, pos, out, last_len);
+            continue;
+        }
+        out[0] = multi.symbol[0];
+        out[1] = multi.symbol[1];
+        out += multi.count;
+        pos += multi.bits;
+        last_len = multi.last_len;
+    }
+
+    if (pos > 0)
+    {
+        // Position the byte-wise decoder on the last lookup of the last decoded symbol
+        const uint32_t resume = pos - last_len;
+        bytes_written = out - out_buff;
+        bytes_consumed += resume >> 3;
+        cur_bit = resume & 7;
+        result = { last_len, 0, HUFFMAN_MATCH };
+    }
+
     while (!get_next_byte(in_buff, last_encoded_byte, bytes_consumed, cur_bit, result.len, byte,
         another_search))
     {
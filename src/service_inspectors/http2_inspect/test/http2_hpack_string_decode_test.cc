@@ -34,6 +34,8 @@ using namespace Http2Enums;
 #include "../../http_inspect/http_enum.h"
 #include "packet_io/sfdaq_instance.h"
 
+#include <vector>
+
 #include <CppUTest/CommandLineTestRunner.h>
 #include <CppUTest/TestHarness.h>
 #include <CppUTestExt/MockSupport.h>
@@ -47,6 +49,67 @@ int SFDAQInstance::inject(_daq_msg const*, int, unsigned char const*, unsigned i
 
 using namespace HttpCommon;
 
+// Huffman encoder for building long test strings. The code table is recovered from the decode
+// state machine.
+struct HuffmanCode
+{
+    uint32_t code;
+    uint8_t len;
+};
+
+static void find_huffman_codes(HuffmanCode* codes, HuffmanState state, uint32_t prefix,
+    uint8_t prefix_len)
+{
+    for (unsigned byte = 0; byte <= UINT8_MAX; byte++)
+    {
+        const HuffmanEntry& entry = huffman_decode[state][byte];
+        if (entry.state == HUFFMAN_MATCH)
+            codes[(uint8_t)entry.symbol] = { (prefix << entry.len) | (byte >> (8 - entry.len)),
+                (uint8_t)(prefix_len + entry.len) };
+        else if (entry.state != HUFFMAN_FAILURE)
+            find_huffman_codes(codes, entry.state, (prefix << 8) | byte, prefix_len + 8);
+    }
+}
+
+// Returns the HPACK string literal: huffman flag and 7-bit prefix length followed by the codes
+// and all-ones padding. A code of length 30 inserts EOS.
+static std::vector<uint8_t> huffman_encode(const std::vector<HuffmanCode>& input)
+{
+    std::vector<uint8_t> encoded;
+    uint64_t acc = 0;
+    unsigned acc_len = 0;
+    for (const HuffmanCode& c : input)
+    {
+        acc = (acc << c.len) | c.code;
+        acc_len += c.len;
+        while (acc_len >= 8)
+        {
+            encoded.push_back(acc >> (acc_len - 8));
+            acc_len -= 8;
+        }
+    }
+    if (acc_len > 0)
+        encoded.push_back((acc << (8 - acc_len)) | (0xff >> acc_len));
+
+    std::vector<uint8_t> literal;
+    uint32_t length = encoded.size();
+    if (length < 0x7f)
+        literal.push_back(0x80 | length);
+    else
+    {
+        literal.push_back(0xff);
+        length -= 0x7f;
+        while (length >= 0x80)
+        {
+            literal.push_back(0x80 | (length & 0x7f));
+            length >>= 7;
+        }
+        literal.push_back(length);
+    }
+    literal.insert(literal.end(), encoded.begin(), encoded.end());
+    return literal;
+}
+
 //
 // The following tests should result in a successful decode, no infractions/events
 //
@@ -634,6 +697,39 @@ TEST(http2_hpack_string_decode_success, huffman_decoding_tail_lookup_unsucessful
     CHECK(bytes_written == 2);
 }
 
+TEST(http2_hpack_string_decode_success, huffman_decoding_multi_symbol_all_lengths)
+{
+    // every symbol, in several orders, at every string length up to 300 - covers the
+    // multi-symbol fast path, long codes within it, and the hand-off to the byte-wise tail
+    HuffmanCode codes[UINT8_MAX + 1];
+    find_huffman_codes(codes, HUFFMAN_LOOKUP_1, 0, 0);
+
+    for (unsigned stride = 1; stride < 256; stride += 38)
+    {
+        for (unsigned length = 1; length <= 300; length++)
+        {
+            std::vector<uint8_t> expected;
+            std::vector<HuffmanCode> input;
+            for (unsigned k = 0; k < length; k++)
+            {
+                const uint8_t symbol = (k * stride + length) & 0xff;
+                expected.push_back(symbol);
+                input.push_back(codes[symbol]);
+            }
+            const std::vector<uint8_t> buf = huffman_encode(input);
+
+            uint32_t bytes_processed = 0, bytes_written = 0;
+            std::vector<uint8_t> res(buf.size() * 8 / 5);
+            bool success = decode->translate(buf.data(), buf.size(), decode_int7, bytes_processed,
+                res.data(), res.size(), bytes_written, &events, &inf, false);
+            CHECK(success == true);
+            CHECK(bytes_processed == buf.size());
+            CHECK(bytes_written == length);
+            CHECK(memcmp(res.data(), expected.data(), length) == 0);
+        }
+    }
+}
+
 //
 // The following tests should trigger infractions/events
 //
@@ -927,6 +1023,31 @@ TEST(http2_hpack_string_decode_infractions, huffman_decoded_eos)
     CHECK(local_inf.get_raw(0) == (1<<INF_HUFFMAN_DECODED_EOS));
 }
 
+TEST(http2_hpack_string_decode_infractions, huffman_decoded_eos_after_fast_path)
+{
+    // prepare decode object
+    Http2EventGen local_events;
+    Http2Infractions local_inf;
+    Http2HpackStringDecode local_decode;
+    Http2HpackIntDecode decode_int7(7);
+    HuffmanCode codes[UINT8_MAX + 1];
+    find_huffman_codes(codes, HUFFMAN_LOOKUP_1, 0, 0);
+    // prepare buf to decode - EOS well inside the string, after the multi-symbol decoder has run
+    std::vector<HuffmanCode> input(40, codes['a']);
+    input.push_back({ 0x3fffffff, 30 });
+    input.insert(input.end(), 20, codes['b']);
+    const std::vector<uint8_t> buf = huffman_encode(input);
+    // decode
+    uint32_t bytes_processed = 0, bytes_written = 0;
+    uint8_t res[100];
+    bool success = local_decode.translate(buf.data(), buf.size(), decode_int7, bytes_processed, res,
+        100, bytes_written, &local_events, &local_inf, false);
+    // check results
+    CHECK(success == false);
+    CHECK(bytes_written == 40);
+    CHECK(local_inf.get_raw(0) == (1<<INF_HUFFMAN_DECODED_EOS));
+}
+
 int main(int argc, char** argv)
 {
     return CommandLineTestRunner::RunAllTests(argc, argv);
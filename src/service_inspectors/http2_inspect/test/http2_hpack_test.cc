@@ -25,6 +25,8 @@
 #include <string>
 #include <map>
 #include <algorithm>
+#include <deque>
+#include <random>
 
 #include "../../../flow/flow_data.h"
 #include "../../../framework/counts.h"
@@ -37,6 +39,7 @@
 #include "../http2_hpack_cookie_header_buffer.h"
 #include "../http2_hpack_dynamic_table.h"
 #include "../http2_hpack_int_decode.h"
+#include "../http2_hpack_table.h"
 #include "../http2_module.h"
 #include "../http2_request_line.h"
 #include "../http2_settings_frame.h"
@@ -497,6 +500,129 @@ TEST(http2_hpack_decoder_decode_header_buffers, header_with_65536_long_cookie_ov
 }
 
 
+TEST_GROUP(http2_hpack_dynamic_table)
+{
+    // Reference model of the RFC 7541 dynamic table: newest entry first, FIFO eviction
+    struct RefTable
+    {
+        std::deque<std::pair<std::string, std::string>> entries;
+        uint32_t size = 0;
+        uint32_t max_size = 4096;
+
+        void prune(uint32_t limit)
+        {
+            while (size > limit)
+            {
+                size -= entries.back().first.size() + entries.back().second.size() + 32;
+                entries.pop_back();
+            }
+        }
+        void add(const std::string& name, const std::string& value)
+        {
+            const uint32_t entry_size = name.size() + value.size() + 32;
+            if (entry_size > max_size)
+            {
+                prune(0);
+                return;
+            }
+            prune(max_size - entry_size);
+            entries.emplace_front(name, value);
+            size += entry_size;
+        }
+        void update_size(uint32_t new_size)
+        {
+            prune(new_size);
+            max_size = new_size;
+        }
+    };
+
+    static void check_equal(const HpackDynamicTable& table, const RefTable& ref)
+    {
+        const uint32_t first = HpackIndexTable::STATIC_MAX_INDEX + 1;
+        for (uint32_t k = 0; k < ref.entries.size(); k++)
+        {
+            const HpackTableEntry* entry = table.get_entry(first + k);
+            CHECK(entry != nullptr);
+            CHECK(std::string((const char*)entry->name.start(), entry->name.length()) ==
+                ref.entries[k].first);
+            CHECK(std::string((const char*)entry->value.start(), entry->value.length()) ==
+                ref.entries[k].second);
+        }
+        CHECK(table.get_entry(first + ref.entries.size()) == nullptr);
+    }
+
+    static bool add(HpackDynamicTable& table, const std::string& name, const std::string& value)
+    {
+        const Field name_field(name.size(), (const uint8_t*)name.data());
+        const Field value_field(value.size(), (const uint8_t*)value.data());
+        return table.add_entry(name_field, value_field);
+    }
+};
+
+// Ensure adds, evictions, wraps and compactions match the RFC semantics
+TEST(http2_hpack_dynamic_table, matches_reference_model)
+{
+    HpackDynamicTable table;
+    RefTable ref;
+    std::mt19937 gen(7);
+
+    for (unsigned n = 0; n < 20000; n++)
+    {
+        const unsigned op = gen() % 64;
+        if (op == 0)
+        {
+            const uint32_t new_size = gen() % 8192;
+            table.update_size(new_size);
+            ref.update_size(new_size);
+        }
+        else
+        {
+            const std::string name(gen() % 24, 'a' + gen() % 26);
+            const std::string value(gen() % (op < 4 ? 2000 : 200), 'A' + gen() % 26);
+            CHECK(add(table, name, value));
+            ref.add(name, value);
+        }
+        check_equal(table, ref);
+    }
+}
+
+// Ensure a new entry can reuse the name of an entry it evicts
+TEST(http2_hpack_dynamic_table, name_from_evicted_entry)
+{
+    HpackDynamicTable table;
+    RefTable ref;
+    table.update_size(200);
+    ref.update_size(200);
+
+    std::string name(60, 'n');
+    std::string value(50, 'v');
+    CHECK(add(table, name, value));
+    ref.add(name, value);
+
+    for (unsigned n = 0; n < 50; n++)
+    {
+        const HpackTableEntry* oldest = table.get_entry(HpackIndexTable::STATIC_MAX_INDEX +
+            ref.entries.size());
+        const Field name_field(oldest->name.length(), oldest->name.start());
+        value.assign(40 + n % 17, 'a' + n % 26);
+        const Field value_field(value.size(), (const uint8_t*)value.data());
+        CHECK(table.add_entry(name_field, value_field));
+        const std::string oldest_name = ref.entries.back().first;
+        ref.add(oldest_name, value);
+        check_equal(table, ref);
+    }
+}
+
+// Ensure the table refuses to hold more than 512 entries
+TEST(http2_hpack_dynamic_table, entry_limit)
+{
+    HpackDynamicTable table;
+    table.update_size(1 << 20);
+    for (unsigned n = 0; n < 512; n++)
+        CHECK(add(table, "", ""));
+    CHECK(!add(table, "", ""));
+}
+
 int main(int argc, char** argv)
 {
     return CommandLineTestRunner::RunAllTests(argc, argv);
@@ -25,7 +25,9 @@
 
 #include "http_context_data.h"
 #include "http_cursor_data.h"
+#include "http_inflate.h"
 #include "http_inspect.h"
+#include "http_transaction.h"
 
 using namespace snort;
 
@@ -47,6 +49,13 @@ void HttpApi::http_init()
     HttpCursorData::init();
 }
 
+void HttpApi::http_tterm()
+{
+    HttpInflatePool::term();
+    HttpFlowDataPool::term();
+    HttpTransactionPool::term();
+}
+
 const char* HttpApi::classic_buffer_names[] =
 {
     HTTP_CLASSIC_BUFFER_NAMES,
@@ -74,7 +83,7 @@ const InspectApi HttpApi::http_api =
     HttpApi::http_init,
     HttpApi::http_term,
     nullptr,
-    nullptr,
+    HttpApi::http_tterm,
     HttpApi::http_ctor,
     HttpApi::http_dtor,
     nullptr,
@@ -23,6 +23,8 @@
 
 #include "http_cutter.h"
 
+#include <zlib.h>
+
 #include "http_common.h"
 #include "http_enum.h"
 #include "http_flow_data.h"
@@ -305,20 +307,7 @@ HttpBodyCutter::HttpBodyCutter(bool accelerated_blocking_, ScriptFinder* finder_
     {
         if ((compression == CMP_GZIP) || (compression == CMP_DEFLATE))
         {
-            compress_stream = new z_stream;
-            compress_stream->zalloc = Z_NULL;
-            compress_stream->zfree = Z_NULL;
-            compress_stream->next_in = Z_NULL;
-            compress_stream->avail_in = 0;
-            const int window_bits = (compression == CMP_GZIP) ?
-                GZIP_WINDOW_BITS : DEFLATE_WINDOW_BITS;
-            if (inflateInit2(compress_stream, window_bits) != Z_OK)
-            {
-                assert(false);
-                compression = CMP_NONE;
-                delete compress_stream;
-                compress_stream = nullptr;
-            }
+            inflater.init(compression);
         }
 
         static const uint8_t inspect_string[] = { '<', '/', 's', 'c', 'r', 'i', 'p', 't', '>' };
@@ -330,14 +319,7 @@ HttpBodyCutter::HttpBodyCutter(bool accelerated_blocking_, ScriptFinder* finder_
     }
 }
 
-HttpBodyCutter::~HttpBodyCutter()
-{
-    if (compress_stream != nullptr)
-    {
-        inflateEnd(compress_stream);
-        delete compress_stream;
-    }
-}
+HttpBodyCutter::~HttpBodyCutter() = default;
 
 ScanResult HttpBodyClCutter::cut(const uint8_t* buffer, uint32_t length, HttpInfractions*,
     HttpEventGen*, uint32_t flow_target, bool stretch, HXBodyState)
@@ -906,24 +888,22 @@ bool HttpBodyCutter::dangerous(const uint8_t* data, uint32_t length)
         const uint32_t decomp_buffer_size = MAX_OCTETS;
         decomp_output = new uint8_t[decomp_buffer_size];
 
-        compress_stream->next_in = const_cast<Bytef*>(data);
-        compress_stream->avail_in = length;
-        compress_stream->next_out = decomp_output;
-        compress_stream->avail_out = decomp_buffer_size;
-
-        int ret_val = inflate(compress_stream, Z_SYNC_FLUSH);
+        uint32_t avail_in = length;
+        uint32_t avail_out = decomp_buffer_size;
+        int ret_val = inflater.inflate(data, avail_in, decomp_output, avail_out);
 
         // Not going to be subtle about this and try to fix decompression problems. If it doesn't
         // work out we assume it could be dangerous.
-        if (((ret_val != Z_OK) && (ret_val != Z_STREAM_END)) || (compress_stream->avail_in > 0))
+        if (((ret_val != Z_OK) && (ret_val != Z_STREAM_END)) || (avail_in > 0))
         {
             decompress_failed = true;
+            inflater.reset();
             delete[] decomp_output;
             return true;
         }
 
         input_buf = decomp_output;
-        input_length = decomp_buffer_size - compress_stream->avail_out;
+        input_length = decomp_buffer_size - avail_out;
     }
 
     std::unique_ptr<uint8_t[]> uniq(decomp_output);
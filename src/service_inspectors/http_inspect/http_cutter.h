@@ -21,11 +21,11 @@
 #define HTTP_CUTTER_H
 
 #include <cassert>
-#include <zlib.h>
 
 #include "http_common.h"
 #include "http_enum.h"
 #include "http_event.h"
+#include "http_inflate.h"
 #include "http_module.h"
 
 class HttpFlowData;
@@ -136,7 +136,7 @@ private:
     HttpEnums::CompressId compression = HttpEnums::CompressId::CMP_NONE;
     bool decompress_failed = false;
     uint8_t string_length = 0;
-    z_stream* compress_stream = nullptr;
+    HttpInflater inflater;
     ScriptFinder* const finder;
     const uint8_t* match_string = nullptr;
     const uint8_t* match_string_upper = nullptr;
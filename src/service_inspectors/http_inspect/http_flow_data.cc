@@ -81,6 +81,16 @@ HttpFlowData::HttpFlowData(Flow* flow, const HttpParaList* params_) :
     }
 }
 
+void* HttpFlowData::operator new(std::size_t size)
+{
+    return HttpFlowDataPool::acquire(size);
+}
+
+void HttpFlowData::operator delete(void* ptr, std::size_t size)
+{
+    HttpFlowDataPool::release(ptr, size);
+}
+
 HttpFlowData::~HttpFlowData()
 {
 #ifdef REG_TEST
@@ -104,11 +114,7 @@ HttpFlowData::~HttpFlowData()
         delete partial_mime_bufs[k];
         HttpTransaction::delete_transaction(transaction[k], nullptr);
         delete cutter[k];
-        if (compress_stream[k] != nullptr)
-        {
-            inflateEnd(compress_stream[k]);
-            delete compress_stream[k];
-        }
+        inflater[k].reset();
         delete mime_state[k];
         delete utf_state[k];
         if (fd_state[k] != nullptr)
@@ -149,12 +155,7 @@ void HttpFlowData::half_reset(SourceId source_id)
     compression[source_id] = CMP_NONE;
     gzip_state[source_id] = GZIP_TBD;
     gzip_header_bytes_processed[source_id] = 0;
-    if (compress_stream[source_id] != nullptr)
-    {
-        inflateEnd(compress_stream[source_id]);
-        delete compress_stream[source_id];
-        compress_stream[source_id] = nullptr;
-    }
+    inflater[source_id].reset();
     delete mime_state[source_id];
     mime_state[source_id] = nullptr;
     delete utf_state[source_id];
@@ -189,12 +190,7 @@ void HttpFlowData::trailer_prep(SourceId source_id)
 {
     type_expected[source_id] = SEC_TRAILER;
     compression[source_id] = CMP_NONE;
-    if (compress_stream[source_id] != nullptr)
-    {
-        inflateEnd(compress_stream[source_id]);
-        delete compress_stream[source_id];
-        compress_stream[source_id] = nullptr;
-    }
+    inflater[source_id].reset();
     delete mime_state[source_id];
     mime_state[source_id] = nullptr;
     delete utf_state[source_id];
@@ -20,19 +20,20 @@
 #ifndef HTTP_FLOW_DATA_H
 #define HTTP_FLOW_DATA_H
 
-#include <zlib.h>
-
 #include <cstdio>
 #include <list>
 
 #include "flow/flow.h"
 #include "helpers/utf.h"
 #include "decompress/file_decomp.h"
+#include "memory/memory_cap.h"
+#include "utils/free_list_pool.h"
 
 #include "http_common.h"
 #include "http_enum.h"
 #include "http_event.h"
 #include "http_field.h"
+#include "http_inflate.h"
 #include "http_module.h"
 
 class HttpTransaction;
@@ -54,6 +55,10 @@ public:
     static unsigned inspector_id;
     static void init() { inspector_id = snort::FlowData::create_flow_data_id(); }
 
+    // Storage is recycled through HttpFlowDataPool
+    static void* operator new(std::size_t size);
+    static void operator delete(void* ptr, std::size_t size);
+
     friend class HttpBodyCutter;
     friend class HttpInspect;
     friend class HttpJSNorm;
@@ -146,7 +151,7 @@ private:
     bool last_request_was_connect = false;
     bool stretch_section_to_packet[2] = { false, false };
     bool accelerated_blocking[2] = { false, false };
-    z_stream* compress_stream[2] = { nullptr, nullptr };
+    HttpInflater inflater[2];
     uint64_t zero_nine_expected = 0;
     // length of the data from Content-Length field
     int64_t data_length[2] = { HttpCommon::STAT_NOT_PRESENT, HttpCommon::STAT_NOT_PRESENT };
@@ -226,5 +231,9 @@ private:
 #endif
 };
 
+// Streams of multiplexed HTTP/2 connections create and delete flow data at a high rate
+using HttpFlowDataPool =
+    snort::StoragePool<HttpFlowData, 64, memory::ArenaStorage<memory::ARENA_HTTP>>;
+
 #endif
 
@@ -0,0 +1,376 @@
+//--------------------------------------------------------------------------
+// Copyright (C) 2026 Cisco and/or its affiliates. All rights reserved.
+//
+// This program is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License Version 2 as published
+// by the Free Software Foundation.  You may not use, modify or distribute
+// this program under any other version of the GNU General Public License.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+//--------------------------------------------------------------------------
+// http_inflate.cc author Cisco
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "http_inflate.h"
+
+#include <zlib.h>
+
+#include <cassert>
+#include <cstring>
+
+#include "main/thread.h"
+#include "utils/free_list_pool.h"
+
+#include "http_module.h"
+
+using namespace HttpEnums;
+
+//-------------------------------------------------------------------------
+// zlib engine
+//-------------------------------------------------------------------------
+
+namespace
+{
+class ZlibDecompressor : public HttpDecompressor
+{
+public:
+    ZlibDecompressor()
+    {
+        stream.zalloc = Z_NULL;
+        stream.zfree = Z_NULL;
+        stream.opaque = Z_NULL;
+        stream.next_in = Z_NULL;
+        stream.avail_in = 0;
+    }
+
+    ~ZlibDecompressor() override
+    {
+        if (ready)
+            inflateEnd(&stream);
+    }
+
+    bool reset(int window_bits) override
+    {
+        // inflateReset2() keeps the allocated window when its size does not change
+        if (ready)
+            return inflateReset2(&stream, window_bits) == Z_OK;
+        ready = (inflateInit2(&stream, window_bits) == Z_OK);
+        return ready;
+    }
+
+    int inflate(const uint8_t*& in, uint32_t& in_length, uint8_t*& out,
+        uint32_t& out_length) override
+    {
+        stream.next_in = const_cast<Bytef*>(in);
+        stream.avail_in = in_length;
+        stream.next_out = out;
+        stream.avail_out = out_length;
+        const int ret = ::inflate(&stream, Z_SYNC_FLUSH);
+        in = stream.next_in;
+        in_length = stream.avail_in;
+        out = stream.next_out;
+        out_length = stream.avail_out;
+        return ret;
+    }
+
+    int data_type() const override
+    { return stream.data_type; }
+
+    uint32_t check() const override
+    { return (uint32_t)stream.adler; }
+
+    uint32_t total_out() const override
+    { return (uint32_t)stream.total_out; }
+
+    uint32_t get_window(uint8_t* window) const override
+    {
+        uInt length = 0;
+        inflateGetDictionary(const_cast<z_stream*>(&stream), window, &length);
+        return length;
+    }
+
+    bool restore(const uint8_t* window, uint32_t length, int bits, int value) override
+    {
+        return (inflatePrime(&stream, bits, value) == Z_OK) &&
+            ((length == 0) || (inflateSetDictionary(&stream, window, length) == Z_OK));
+    }
+
+    const char* get_name() const override
+    { return "zlib"; }
+
+private:
+    z_stream stream;
+    bool ready = false;
+};
+}
+
+// zlib-ng built in compatibility mode is a drop-in replacement at link time. Other engines
+// plug in here.
+HttpDecompressor* HttpDecompressor::create()
+{ return new ZlibDecompressor; }
+
+//-------------------------------------------------------------------------
+// per-thread pool
+//-------------------------------------------------------------------------
+
+// Idle contexts keep their zlib state so that reusing one is only a reset
+using IdleEngines = snort::FreeListPool<HttpInflatePool, HttpInflatePool::MAX_IDLE,
+    HttpDecompressor>;
+
+static THREAD_LOCAL unsigned in_use = 0;
+
+HttpDecompressor* HttpInflatePool::acquire(int window_bits)
+{
+    HttpDecompressor* engine = IdleEngines::take();
+    if (engine == nullptr)
+        engine = HttpDecompressor::create();
+
+    if (!engine->reset(window_bits))
+    {
+        delete engine;
+        return nullptr;
+    }
+    in_use++;
+
+    HttpModule::increment_peg_counts(PEG_INFLATE_CONTEXTS);
+    if (HttpModule::get_peg_counts(PEG_MAX_INFLATE_CONTEXTS) <
+        HttpModule::get_peg_counts(PEG_INFLATE_CONTEXTS))
+        HttpModule::increment_peg_counts(PEG_MAX_INFLATE_CONTEXTS);
+    return engine;
+}
+
+void HttpInflatePool::release(HttpDecompressor* engine)
+{
+    assert(in_use > 0);
+    in_use--;
+    if (HttpModule::get_peg_counts(PEG_INFLATE_CONTEXTS) > 0)
+        HttpModule::decrement_peg_counts(PEG_INFLATE_CONTEXTS);
+
+    IdleEngines::give(engine);
+}
+
+void HttpInflatePool::term()
+{
+    // Flows that outlive us delete their contexts instead of returning them
+    IdleEngines::term();
+}
+
+unsigned HttpInflatePool::get_idle()
+{ return IdleEngines::get_idle(); }
+
+unsigned HttpInflatePool::get_in_use()
+{ return in_use; }
+
+//-------------------------------------------------------------------------
+// inflater
+//-------------------------------------------------------------------------
+
+void HttpInflater::init(CompressId compression)
+{
+    reset();
+    assert((compression == CMP_GZIP) || (compression == CMP_DEFLATE));
+    window_bits = (compression == CMP_GZIP) ? GZIP_WINDOW_BITS : DEFLATE_WINDOW_BITS;
+    active = true;
+}
+
+void HttpInflater::reset()
+{
+    if (engine != nullptr)
+    {
+        HttpInflatePool::release(engine);
+        engine = nullptr;
+    }
+    delete[] window;
+    window = nullptr;
+    window_length = 0;
+    parked = false;
+    raw_state = RAW_OFF;
+    trailer_length = 0;
+    active = false;
+}
+
+int HttpInflater::inflate(const uint8_t* in, uint32_t& in_length, uint8_t* out,
+    uint32_t& out_length)
+{
+    assert(active);
+    if (!active)
+        return Z_STREAM_ERROR;
+
+    // A finished stream needs no context to keep reporting that it is finished
+    if (raw_state == RAW_DONE)
+        return Z_STREAM_END;
+
+    if (parked)
+    {
+        if (!resume())
+            return Z_MEM_ERROR;
+    }
+    else if (engine == nullptr)
+    {
+        if ((engine = HttpInflatePool::acquire(window_bits)) == nullptr)
+            return Z_MEM_ERROR;
+    }
+
+    const uint32_t in_start = in_length;
+    const uint32_t out_start = out_length;
+    int ret;
+
+    if (raw_state == RAW_OFF)
+        ret = engine->inflate(in, in_length, out, out_length);
+
+    else
+    {
+        // A resumed raw stream must check the trailer itself just as zlib would have
+        ret = Z_STREAM_END;
+        if (raw_state == RAW_INFLATE)
+            ret = raw_inflate(in, in_length, out, out_length);
+        if (ret == Z_STREAM_END)
+            ret = raw_trailer(in, in_length);
+        if ((ret == Z_OK) && (in_length == in_start) && (out_length == out_start))
+            ret = Z_BUF_ERROR;
+    }
+
+    if (in_length < in_start)
+        last_byte = in[-1];
+
+    if (ret == Z_STREAM_END)
+    {
+        raw_state = RAW_DONE;
+        HttpInflatePool::release(engine);
+        engine = nullptr;
+    }
+    return ret;
+}
+
+int HttpInflater::raw_inflate(const uint8_t*& in, uint32_t& in_length, uint8_t*& out,
+    uint32_t& out_length)
+{
+    uint8_t* const out_start = out;
+    const int ret = engine->inflate(in, in_length, out, out_length);
+    const uint32_t produced = out - out_start;
+    if (produced > 0)
+    {
+        check = (window_bits == GZIP_WINDOW_BITS) ? crc32(check, out_start, produced) :
+            adler32(check, out_start, produced);
+        total += produced;
+    }
+    if (ret == Z_STREAM_END)
+        raw_state = RAW_TRAILER;
+    return ret;
+}
+
+int HttpInflater::raw_trailer(const uint8_t*& in, uint32_t& in_length)
+{
+    const bool gzip = (window_bits == GZIP_WINDOW_BITS);
+
+    // Check value first, then for gzip the length, failing as soon as either is complete
+    while ((trailer_length < 4) && (in_length > 0))
+    {
+        trailer[trailer_length++] = *in++;
+        in_length--;
+    }
+    if (trailer_length < 4)
+        return Z_OK;
+
+    if (trailer_length == 4)
+    {
+        const uint32_t value = gzip ?
+            (trailer[0] | (trailer[1] << 8) | (trailer[2] << 16) | ((uint32_t)trailer[3] << 24)) :
+            (((uint32_t)trailer[0] << 24) | (trailer[1] << 16) | (trailer[2] << 8) | trailer[3]);
+        if (value != check)
+            return Z_DATA_ERROR;
+        if (!gzip)
+            return Z_STREAM_END;
+    }
+
+    while ((trailer_length < 8) && (in_length > 0))
+    {
+        trailer[trailer_length++] = *in++;
+        in_length--;
+    }
+    if (trailer_length < 8)
+        return Z_OK;
+
+    const uint32_t size = trailer[4] | (trailer[5] << 8) | (trailer[6] << 16) |
+        ((uint32_t)trailer[7] << 24);
+    return (size == total) ? Z_STREAM_END : Z_DATA_ERROR;
+}
+
+int HttpInflater::retry_with_zlib_header()
+{
+    static const uint8_t zlib_header[2] = { 0x78, 0x01 };
+
+    assert(active && (engine != nullptr) && (raw_state == RAW_OFF));
+    if ((engine == nullptr) || !engine->reset(window_bits))
+        return Z_STREAM_ERROR;
+
+    uint32_t in_length = sizeof(zlib_header);
+    uint8_t unused;
+    uint32_t out_length = 0;
+    return inflate(zlib_header, in_length, &unused, out_length);
+}
+
+void HttpInflater::park()
+{
+    if (!active || parked || (engine == nullptr))
+        return;
+
+    if ((raw_state != RAW_OFF) && (raw_state != RAW_INFLATE))
+        return;
+
+    // Only right after the end of a block that is not the last one, where everything that
+    // remains is the history window and a few bits of the last input octet
+    const int data_type = engine->data_type();
+    if (!(data_type & 128) || (data_type & 64))
+        return;
+
+    if (raw_state == RAW_OFF)
+    {
+        check = engine->check();
+        total = engine->total_out();
+        raw_state = RAW_INFLATE;
+    }
+    bits = data_type & 7;
+    bit_value = (bits > 0) ? (last_byte >> (8 - bits)) : 0;
+
+    window_length = engine->get_window(nullptr);
+    if (window_length > 0)
+    {
+        window = new uint8_t[window_length];
+        engine->get_window(window);
+    }
+
+    HttpInflatePool::release(engine);
+    engine = nullptr;
+    parked = true;
+    HttpModule::increment_peg_counts(PEG_INFLATE_PARKS);
+}
+
+bool HttpInflater::resume()
+{
+    assert(parked && (engine == nullptr));
+    if ((engine = HttpInflatePool::acquire(-MAX_WBITS)) == nullptr)
+        return false;
+
+    if (!engine->restore(window, window_length, bits, bit_value))
+    {
+        HttpInflatePool::release(engine);
+        engine = nullptr;
+        return false;
+    }
+    delete[] window;
+    window = nullptr;
+    window_length = 0;
+    parked = false;
+    return true;
+}
@@ -0,0 +1,132 @@
+//--------------------------------------------------------------------------
+// Copyright (C) 2026 Cisco and/or its affiliates. All rights reserved.
+//
+// This program is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License Version 2 as published
+// by the Free Software Foundation.  You may not use, modify or distribute
+// this program under any other version of the GNU General Public License.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+//--------------------------------------------------------------------------
+// http_inflate.h author Cisco
+
+#ifndef HTTP_INFLATE_H
+#define HTTP_INFLATE_H
+
+// Decompression of gzip and deflate message bodies.
+//
+// A zlib inflate context costs about 40 KB, most of it the 32 KB history window. Rather than
+// every HTTP flow that announces a compressed body owning one for the life of the message, flows
+// lease a context from a per-thread pool only while decompressing. Between message sections a
+// stream that has stopped on a deflate block boundary is reduced to its history window (often
+// much less than 32 KB) and the context goes back to the pool. It is restored in raw mode when
+// the next section arrives. The caller sees exactly the zlib inflate(Z_SYNC_FLUSH) behavior
+// throughout, including gzip and zlib trailer verification.
+
+#include <cstdint>
+
+#include "http_enum.h"
+
+// Pluggable inflate engine. Status codes and data_type follow zlib.
+class HttpDecompressor
+{
+public:
+    virtual ~HttpDecompressor() = default;
+
+    // window_bits as for inflateInit2(): 8..15 zlib, +16 gzip, negative raw deflate
+    virtual bool reset(int window_bits) = 0;
+    virtual int inflate(const uint8_t*& in, uint32_t& in_length, uint8_t*& out,
+        uint32_t& out_length) = 0;
+    virtual int data_type() const = 0;
+
+    // running crc32 (gzip) or adler32 (zlib) of the output
+    virtual uint32_t check() const = 0;
+    virtual uint32_t total_out() const = 0;
+
+    // copy the history window, at most 32 KB, and return its length
+    virtual uint32_t get_window(uint8_t* window) const = 0;
+
+    // raw mode only, to resume a stream saved at a block boundary
+    virtual bool restore(const uint8_t* window, uint32_t length, int bits, int value) = 0;
+
+    virtual const char* get_name() const = 0;
+
+    static HttpDecompressor* create();
+};
+
+class HttpInflatePool
+{
+public:
+    static HttpDecompressor* acquire(int window_bits);
+    static void release(HttpDecompressor*);
+
+    // free the idle contexts of this packet thread
+    static void term();
+
+    static unsigned get_idle();
+    static unsigned get_in_use();
+
+    static const unsigned MAX_IDLE = 32;
+};
+
+class HttpInflater
+{
+public:
+    HttpInflater() = default;
+    ~HttpInflater() { reset(); }
+    HttpInflater(const HttpInflater&) = delete;
+    HttpInflater& operator=(const HttpInflater&) = delete;
+
+    // Prepare for a new gzip or deflate body. Nothing is allocated until there is data.
+    void init(HttpEnums::CompressId compression);
+
+    // Abandon the current body and give back all resources
+    void reset();
+
+    bool is_active() const { return active; }
+    bool is_parked() const { return parked; }
+
+    // Same results as zlib inflate() with Z_SYNC_FLUSH. in_length and out_length are updated
+    // to the amount of each not used.
+    int inflate(const uint8_t* in, uint32_t& in_length, uint8_t* out, uint32_t& out_length);
+
+    // Start over as if the input began with a minimal zlib header. For deflate senders that
+    // omit it.
+    int retry_with_zlib_header();
+
+    // Section boundary. If the stream is between deflate blocks keep just the history window
+    // and return the context to the pool. Otherwise nothing changes.
+    void park();
+
+private:
+    enum RawState { RAW_OFF, RAW_INFLATE, RAW_TRAILER, RAW_DONE };
+
+    bool resume();
+    int raw_inflate(const uint8_t*& in, uint32_t& in_length, uint8_t*& out,
+        uint32_t& out_length);
+    int raw_trailer(const uint8_t*& in, uint32_t& in_length);
+
+    HttpDecompressor* engine = nullptr;
+    uint8_t* window = nullptr;
+    uint32_t window_length = 0;
+    uint32_t check = 0;
+    uint32_t total = 0;
+    int window_bits = 0;
+    RawState raw_state = RAW_OFF;
+    uint8_t trailer[8] = { };
+    uint8_t trailer_length = 0;
+    uint8_t bits = 0;
+    uint8_t bit_value = 0;
+    uint8_t last_byte = 0;
+    bool active = false;
+    bool parked = false;
+};
+
+#endif
@@ -103,6 +103,8 @@ public:
         bool simplify_path = true;
         std::bitset<256> bad_characters;
         std::bitset<256> unreserved_char;
+        // Only '%', '+', '\\', '/', and '.' may ever be set to something other than CHAR_NORMAL
+        // or CHAR_EIGHTBIT. HttpScan::find_uri_special() depends on this.
         HttpEnums::CharAction uri_char[256];
 
         static const std::bitset<256> default_unreserved_char;
@@ -29,6 +29,7 @@
 #include "http_common.h"
 #include "http_enum.h"
 #include "http_msg_request.h"
+#include "http_scan.h"
 
 using namespace HttpCommon;
 using namespace HttpEnums;
@@ -190,7 +191,9 @@ int32_t HttpMsgHeadShared::find_next_header(const uint8_t* buffer, int32_t lengt
 
     for (k++; k < length; k++)
     {
-        if (is_cr_lf[buffer[k]])
+        // Jump straight to the next separator
+        k += HttpScan::find_cr_lf(buffer + k, length - k);
+        if (k < length)
         {
             // Check for wrapping
             if (((buffer[k] == '\r') && (buffer[k+1] == '\n') && !is_sp_tab[buffer[k+2]]) ||
@@ -220,12 +223,7 @@ void HttpMsgHeadShared::parse_header_lines()
 
     for (int k=0; k < num_headers; k++)
     {
-        int colon;
-        for (colon=0; colon < header_line[k].length(); colon++)
-        {
-            if (header_line[k].start()[colon] == ':')
-                break;
-        }
+        const int colon = HttpScan::find_colon(header_line[k].start(), header_line[k].length());
         if (colon < header_line[k].length())
         {
             header_name[k].set(colon, header_line[k].start());
@@ -256,7 +254,10 @@ void HttpMsgHeadShared::derive_header_name_id(int index)
     // Normalize header field name to lower case and remove LWS for matching purposes
     int32_t lower_length = 0;
     uint8_t* lower_name = new uint8_t[length];
-    for (int32_t k=0; k < length; k++)
+    // Nearly every name is a plain token which can be lowered in bulk
+    if (HttpScan::lower_token(buffer, length, lower_name))
+        lower_length = length;
+    else for (int32_t k=0; k < length; k++)
     {
         if (!is_sp_tab_cr_lf[buffer[k]])
         {
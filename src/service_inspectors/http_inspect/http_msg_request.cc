@@ -29,6 +29,7 @@
 #include "http_api.h"
 #include "http_common.h"
 #include "http_enum.h"
+#include "http_scan.h"
 #include "http_test_manager.h"
 
 using namespace HttpCommon;
@@ -236,7 +237,8 @@ void HttpMsgRequest::gen_events()
     const int32_t version_start = !zero_nine ? start_line.length() - 9 : start_line.length();
     for (int32_t k = method.length() + 1; k < version_start; k++)
     {
-        if (is_sp_tab[start_line.start()[k]])
+        k += HttpScan::find_sp_tab(start_line.start() + k, version_start - k);
+        if (k < version_start)
         {
             if (uri && (uri->get_uri().start() <= start_line.start() + k) &&
                        (start_line.start() + k < uri->get_uri().start() + uri->get_uri().length()))
@@ -0,0 +1,125 @@
+//--------------------------------------------------------------------------
+// Copyright (C) 2026 Cisco and/or its affiliates. All rights reserved.
+//
+// This program is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License Version 2 as published
+// by the Free Software Foundation.  You may not use, modify or distribute
+// this program under any other version of the GNU General Public License.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+//--------------------------------------------------------------------------
+// http_scan.h author Cisco
+
+#ifndef HTTP_SCAN_H
+#define HTTP_SCAN_H
+
+// Vectorized octet scanning used by the message parsers and URI normalizer to skip quickly over
+// long runs of uninteresting octets. Every function has exactly the same result as the obvious
+// byte-at-a-time loop. SSE2 is used when the compiler targets it (always true on x86-64) and a
+// scalar loop otherwise.
+
+#include <cstdint>
+#include <cstring>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace HttpScan
+{
+#ifdef __SSE2__
+template<uint8_t... Cs>
+inline __m128i match_any(__m128i block)
+{
+    __m128i hits = _mm_setzero_si128();
+    ((hits = _mm_or_si128(hits, _mm_cmpeq_epi8(block, _mm_set1_epi8((char)Cs)))), ...);
+    return hits;
+}
+#endif
+
+// Offset of the first octet equal to any of Cs, or length if there is none
+template<uint8_t... Cs>
+inline int32_t find_first_of(const uint8_t* buf, int32_t length)
+{
+    int32_t k = 0;
+#ifdef __SSE2__
+    for (; k + 16 <= length; k += 16)
+    {
+        const __m128i block = _mm_loadu_si128((const __m128i*)(buf + k));
+        const int mask = _mm_movemask_epi8(match_any<Cs...>(block));
+        if (mask != 0)
+            return k + __builtin_ctz(mask);
+    }
+#endif
+    for (; k < length; k++)
+    {
+        if (((buf[k] == Cs) || ...))
+            return k;
+    }
+    return length;
+}
+
+// Header line separators
+inline int32_t find_cr_lf(const uint8_t* buf, int32_t length)
+{ return find_first_of<'\r', '\n'>(buf, length); }
+
+// Start line white space
+inline int32_t find_sp_tab(const uint8_t* buf, int32_t length)
+{ return find_first_of<' ', '\t'>(buf, length); }
+
+// Field name / value divider
+inline int32_t find_colon(const uint8_t* buf, int32_t length)
+{
+    const void* colon = (length > 0) ? memchr(buf, ':', length) : nullptr;
+    return (colon != nullptr) ? (int32_t)((const uint8_t*)colon - buf) : length;
+}
+
+// Every octet that UriParam::uri_char can ever map to something other than CHAR_NORMAL or
+// CHAR_EIGHTBIT. Configuration only switches these between their special class and
+// CHAR_NORMAL so any octet not in this set never needs to be looked up.
+inline int32_t find_uri_special(const uint8_t* buf, int32_t length)
+{ return find_first_of<'%', '+', '\\', '/', '.'>(buf, length); }
+
+// Copy a header field name to out converting it to lower case. This succeeds only when every
+// octet is a visible ASCII character (0x21 - 0x7E), i.e. the name contains no white space and
+// nothing that would be an infraction. Otherwise returns false and the caller must redo the
+// name using the full per-octet rules. The contents of out are unspecified in that case.
+inline bool lower_token(const uint8_t* buf, int32_t length, uint8_t* out)
+{
+    int32_t k = 0;
+#ifdef __SSE2__
+    const __m128i low = _mm_set1_epi8(0x21);
+    const __m128i high = _mm_set1_epi8(0x7E);
+    const __m128i upper_low = _mm_set1_epi8('A' - 1);
+    const __m128i upper_high = _mm_set1_epi8('Z' + 1);
+    const __m128i case_bit = _mm_set1_epi8(0x20);
+    for (; k + 16 <= length; k += 16)
+    {
+        // Signed comparisons put 0x80 - 0xFF below 0x21
+        const __m128i block = _mm_loadu_si128((const __m128i*)(buf + k));
+        const __m128i bad = _mm_or_si128(_mm_cmplt_epi8(block, low), _mm_cmpgt_epi8(block, high));
+        if (_mm_movemask_epi8(bad) != 0)
+            return false;
+        const __m128i upper = _mm_and_si128(_mm_cmpgt_epi8(block, upper_low),
+            _mm_cmplt_epi8(block, upper_high));
+        _mm_storeu_si128((__m128i*)(out + k), _mm_add_epi8(block, _mm_and_si128(upper, case_bit)));
+    }
+#endif
+    for (; k < length; k++)
+    {
+        if ((buf[k] < 0x21) || (buf[k] > 0x7E))
+            return false;
+        out[k] = ((buf[k] < 'A') || (buf[k] > 'Z')) ? buf[k] : buf[k] - ('A' - 'a');
+    }
+    return true;
+}
+}
+
+#endif
@@ -63,7 +63,7 @@ private:
     void chunk_spray(HttpFlowData* session_data, uint8_t* buffer, const uint8_t* data,
         unsigned length) const;
     void decompress_copy(uint8_t* buffer, uint32_t& offset, const uint8_t* data,
-        uint32_t length, HttpEnums::CompressId& compression, z_stream*& compress_stream,
+        uint32_t length, HttpEnums::CompressId& compression, HttpInflater& inflater,
         bool at_start, HttpInfractions* infractions, HttpEventGen* events,
         HttpFlowData* session_data) const;
     uint8_t* process_gzip_header(const uint8_t* data,
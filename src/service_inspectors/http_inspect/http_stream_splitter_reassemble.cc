@@ -101,7 +101,7 @@ void HttpStreamSplitter::chunk_spray(HttpFlowData* session_data, uint8_t* buffer
             const bool at_start = (session_data->body_octets[source_id] == 0) &&
                 (session_data->section_offset[source_id] == 0);
             decompress_copy(buffer, session_data->section_offset[source_id], data+k, skip_amount,
-                session_data->compression[source_id], session_data->compress_stream[source_id],
+                session_data->compression[source_id], session_data->inflater[source_id],
                 at_start, session_data->get_infractions(source_id),
                 session_data->events[source_id], session_data);
             if ((expected -= skip_amount) == 0)
@@ -131,7 +131,7 @@ void HttpStreamSplitter::chunk_spray(HttpFlowData* session_data, uint8_t* buffer
             const bool at_start = (session_data->body_octets[source_id] == 0) &&
                 (session_data->section_offset[source_id] == 0);
             decompress_copy(buffer, session_data->section_offset[source_id], data+k, skip_amount,
-                session_data->compression[source_id], session_data->compress_stream[source_id],
+                session_data->compression[source_id], session_data->inflater[source_id],
                 at_start, session_data->get_infractions(source_id),
                 session_data->events[source_id], session_data);
             k += skip_amount-1;
@@ -190,7 +190,7 @@ bool HttpStreamSplitter::gzip_header_check_done(HttpFlowData* session_data) cons
 }
 
 void HttpStreamSplitter::decompress_copy(uint8_t* buffer, uint32_t& offset, const uint8_t* data,
-    uint32_t length, HttpEnums::CompressId& compression, z_stream*& compress_stream,
+    uint32_t length, HttpEnums::CompressId& compression, HttpInflater& inflater,
     bool at_start, HttpInfractions* infractions, HttpEventGen* events, HttpFlowData* session_data) const
 {
     if ((compression == CMP_GZIP) || (compression == CMP_DEFLATE))
@@ -199,21 +199,17 @@ void HttpStreamSplitter::decompress_copy(uint8_t* buffer, uint32_t& offset, cons
         if (compression == CMP_GZIP and !gzip_header_check_done(session_data))
             data_w_updated_hdr = process_gzip_header(data, length, session_data);
 
-        if (data_w_updated_hdr != nullptr)
-            compress_stream->next_in = const_cast<Bytef*>(data_w_updated_hdr);
-        else 
-            compress_stream->next_in = const_cast<Bytef*>(data);
-        compress_stream->avail_in = length;
-        compress_stream->next_out = buffer + offset;
-        compress_stream->avail_out = MAX_OCTETS - offset;
-        int ret_val = inflate(compress_stream, Z_SYNC_FLUSH);
+        uint32_t avail_in = length;
+        uint32_t avail_out = MAX_OCTETS - offset;
+        int ret_val = inflater.inflate((data_w_updated_hdr != nullptr) ? data_w_updated_hdr : data,
+            avail_in, buffer + offset, avail_out);
 
         delete[] data_w_updated_hdr;
         
         if ((ret_val == Z_OK) || (ret_val == Z_STREAM_END))
         {
-            offset = MAX_OCTETS - compress_stream->avail_out;
-            if (compress_stream->avail_in > 0)
+            offset = MAX_OCTETS - avail_out;
+            if (avail_in > 0)
             {
                 // There are two ways not to consume all the input
                 if (ret_val == Z_STREAM_END)
@@ -221,23 +217,19 @@ void HttpStreamSplitter::decompress_copy(uint8_t* buffer, uint32_t& offset, cons
                     // The zipped data stream ended but there is more input data
                     *infractions += INF_GZIP_EARLY_END;
                     events->create_event(EVENT_GZIP_EARLY_END);
-                    const uInt num_copy =
-                        (compress_stream->avail_in <= compress_stream->avail_out) ?
-                        compress_stream->avail_in : compress_stream->avail_out;
-                    memcpy(buffer + offset, data + (length - compress_stream->avail_in), num_copy);
+                    const uint32_t num_copy = (avail_in <= avail_out) ? avail_in : avail_out;
+                    memcpy(buffer + offset, data + (length - avail_in), num_copy);
                     offset += num_copy;
                 }
                 else
                 {
-                    assert(compress_stream->avail_out == 0);
+                    assert(avail_out == 0);
                     // The data expanded too much
                     *infractions += INF_GZIP_OVERRUN;
                     events->create_event(EVENT_GZIP_OVERRUN);
                 }
                 compression = CMP_NONE;
-                inflateEnd(compress_stream);
-                delete compress_stream;
-                compress_stream = nullptr;
+                inflater.reset();
                 // FIXIT-E - Will need to clear gzip header processing state here when we implement
                 // processing multiple gzip members in a message section
             }
@@ -247,16 +239,11 @@ void HttpStreamSplitter::decompress_copy(uint8_t* buffer, uint32_t& offset, cons
         {
             // Some incorrect implementations of deflate don't use the expected header. Feed a
             // dummy header to zlib and retry the inflate.
-            static constexpr uint8_t zlib_header[2] = { 0x78, 0x01 };
-
-            inflateReset(compress_stream);
-            compress_stream->next_in = const_cast<Bytef*>(zlib_header);
-            compress_stream->avail_in = sizeof(zlib_header);
-            int ret = inflate(compress_stream, Z_SYNC_FLUSH);
+            int ret = inflater.retry_with_zlib_header();
             if ( ret == Z_OK or ret == Z_STREAM_END)
             { 
                 // Start over at the beginning
-                decompress_copy(buffer, offset, data, length, compression, compress_stream, false,
+                decompress_copy(buffer, offset, data, length, compression, inflater, false,
                     infractions, events, session_data);
             }
             return;
@@ -266,9 +253,7 @@ void HttpStreamSplitter::decompress_copy(uint8_t* buffer, uint32_t& offset, cons
             *infractions += INF_GZIP_FAILURE;
             events->create_event(EVENT_GZIP_FAILURE);
             compression = CMP_NONE;
-            inflateEnd(compress_stream);
-            delete compress_stream;
-            compress_stream = nullptr;
+            inflater.reset();
             // Since we failed to uncompress the data, fall through
         }
     }
@@ -450,7 +435,7 @@ const StreamBuffer HttpStreamSplitter::reassemble(Flow* flow, unsigned total,
         const bool at_start = (session_data->body_octets[source_id] == 0) &&
              (session_data->section_offset[source_id] == 0);
         decompress_copy(buffer, session_data->section_offset[source_id], data, len,
-            session_data->compression[source_id], session_data->compress_stream[source_id],
+            session_data->compression[source_id], session_data->inflater[source_id],
             at_start, session_data->get_infractions(source_id),
             session_data->events[source_id], session_data);
     }
@@ -490,6 +475,9 @@ const StreamBuffer HttpStreamSplitter::reassemble(Flow* flow, unsigned total,
         else
             partial_raw_bytes = 0;
 
+        // A compressed body between sections may be able to give back its inflate context
+        session_data->inflater[source_id].park();
+
         http_buf.data = buffer;
         http_buf.length = buf_size;
         session_data->octets_reassembled[source_id] = buf_size;
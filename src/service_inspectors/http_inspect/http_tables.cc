@@ -399,6 +399,9 @@ const PegInfo HttpModule::peg_names[PEG_COUNT_MAX+1] =
     { CountType::SUM, "compressed_not_supported", "total number of HTTP bodies compressed with known but not supported methods" },
     { CountType::SUM, "compressed_unknown", "total number of HTTP bodies compressed with unknown methods" },
     { CountType::SUM, "max_publish_depth_hits", "total number of times the maximum publish depth was exceeded" },
+    { CountType::NOW, "inflate_contexts", "total zlib contexts in use decompressing bodies" },
+    { CountType::MAX, "max_inflate_contexts", "maximum zlib contexts in use decompressing bodies" },
+    { CountType::SUM, "inflate_parks", "total number of times a paused body released its zlib context" },
     { CountType::END, nullptr, nullptr }
 };
 
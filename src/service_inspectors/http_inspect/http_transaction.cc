@@ -69,6 +69,16 @@ void HttpTransaction::publish_end_of_transaction()
     DataBus::publish(pub_id, HttpEventIds::END_OF_TRANSACTION, http_event, flow);
 }
 
+void* HttpTransaction::operator new(std::size_t size)
+{
+    return HttpTransactionPool::acquire(size);
+}
+
+void HttpTransaction::operator delete(void* ptr, std::size_t size)
+{
+    HttpTransactionPool::release(ptr, size);
+}
+
 HttpTransaction::~HttpTransaction()
 {
     publish_end_of_transaction();
@@ -37,6 +37,11 @@ class HttpTransaction
 {
 public:
     ~HttpTransaction();
+
+    // Storage is recycled through HttpTransactionPool
+    static void* operator new(std::size_t size);
+    static void operator delete(void* ptr, std::size_t size);
+
     static HttpTransaction* attach_my_transaction(HttpFlowData*,
         HttpCommon::SourceId, snort::Flow* const);
     static void delete_transaction(HttpTransaction*, HttpFlowData*);
@@ -124,5 +129,8 @@ private:
     static const uint16_t transaction_memory_usage_estimate;
 };
 
+using HttpTransactionPool =
+    snort::StoragePool<HttpTransaction, 64, memory::ArenaStorage<memory::ARENA_HTTP>>;
+
 #endif
 
@@ -26,6 +26,7 @@
 #include <sstream>
 
 #include "http_enum.h"
+#include "http_scan.h"
 #include "log/messages.h"
 
 #define MAP_SIZE 65536
@@ -76,10 +77,14 @@ bool UriNormalizer::need_norm(const Field& uri_component, bool do_path,
 bool UriNormalizer::need_norm_no_path(const Field& uri_component,
     const HttpParaList::UriParam& uri_param)
 {
-    for (int32_t k = 0; k < uri_component.length(); k++)
+    const int32_t length = uri_component.length();
+    const uint8_t* const buf = uri_component.start();
+    // Only the few octets that may have a special character class are looked at
+    for (int32_t k = HttpScan::find_uri_special(buf, length); k < length;
+        k += 1 + HttpScan::find_uri_special(buf + k + 1, length - k - 1))
     {
-        if ((uri_param.uri_char[uri_component.start()[k]] == CHAR_PERCENT) ||
-            (uri_param.uri_char[uri_component.start()[k]] == CHAR_SUBSTIT))
+        if ((uri_param.uri_char[buf[k]] == CHAR_PERCENT) ||
+            (uri_param.uri_char[buf[k]] == CHAR_SUBSTIT))
             return true;
     }
     return false;
@@ -90,7 +95,9 @@ bool UriNormalizer::need_norm_path(const Field& uri_component,
 {
     const int32_t length = uri_component.length();
     const uint8_t* const buf = uri_component.start();
-    for (int32_t k = 0; k < length; k++)
+    // Octets skipped over by find_uri_special() are always CHAR_NORMAL or CHAR_EIGHTBIT
+    for (int32_t k = HttpScan::find_uri_special(buf, length); k < length;
+        k += 1 + HttpScan::find_uri_special(buf + k + 1, length - k - 1))
     {
         switch (uri_param.uri_char[buf[k]])
         {
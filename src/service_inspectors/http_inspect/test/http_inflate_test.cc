@@ -0,0 +1,291 @@
+//--------------------------------------------------------------------------
+// Copyright (C) 2026 Cisco and/or its affiliates. All rights reserved.
+//
+// This program is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License Version 2 as published
+// by the Free Software Foundation.  You may not use, modify or distribute
+// this program under any other version of the GNU General Public License.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+//--------------------------------------------------------------------------
+// http_inflate_test.cc author Cisco
+// unit test main
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "service_inspectors/http_inspect/http_inflate.h"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "service_inspectors/http_inspect/http_module.h"
+
+#include <CppUTest/CommandLineTestRunner.h>
+#include <CppUTest/TestHarness.h>
+
+using namespace HttpEnums;
+
+THREAD_LOCAL PegCount HttpModule::peg_counts[PEG_COUNT_MAX] = { };
+
+// HttpInflater must give exactly the same results as a plain zlib stream, call by call, however
+// the input is segmented and whether or not it was parked in between.
+
+struct CallResult
+{
+    int ret;
+    uint32_t avail_in;
+    std::vector<uint8_t> output;
+
+    bool operator==(const CallResult& rhs) const
+    { return (ret == rhs.ret) && (avail_in == rhs.avail_in) && (output == rhs.output); }
+};
+
+static const uint32_t OUT_SIZE = 1 << 20;
+
+static std::vector<uint8_t> make_text(size_t length, unsigned seed)
+{
+    static const char* words[] = { "alpha ", "bravo ", "charlie ", "<script>", "delta\n",
+        "echo ", "foxtrot ", "golf;" };
+    std::mt19937 gen(seed);
+    std::vector<uint8_t> text;
+    while (text.size() < length)
+    {
+        const char* w = words[gen() % 8];
+        text.insert(text.end(), w, w + strlen(w));
+        if (gen() % 7 == 0)
+            text.push_back(gen() & 0xFF);
+    }
+    text.resize(length);
+    return text;
+}
+
+// Compress with a sync flush every flush_every octets of input. Returns the offsets in the
+// compressed output where each flush ended.
+static std::vector<uint8_t> compress(const std::vector<uint8_t>& text, int window_bits,
+    size_t flush_every, std::vector<uint32_t>& flush_offsets)
+{
+    z_stream strm = { };
+    CHECK(deflateInit2(&strm, 6, Z_DEFLATED, window_bits, 8, Z_DEFAULT_STRATEGY) == Z_OK);
+    std::vector<uint8_t> out(text.size() * 2 + 1024);
+    strm.next_out = out.data();
+    strm.avail_out = out.size();
+    for (size_t pos = 0; pos < text.size(); pos += flush_every)
+    {
+        const size_t n = std::min(flush_every, text.size() - pos);
+        strm.next_in = const_cast<Bytef*>(text.data() + pos);
+        strm.avail_in = n;
+        const bool last = (pos + n == text.size());
+        CHECK(deflate(&strm, last ? Z_FINISH : Z_SYNC_FLUSH) != Z_STREAM_ERROR);
+        flush_offsets.push_back(strm.total_out);
+    }
+    out.resize(strm.total_out);
+    deflateEnd(&strm);
+    return out;
+}
+
+static std::vector<CallResult> run_zlib(const std::vector<uint8_t>& input, int window_bits,
+    const std::vector<uint32_t>& cuts)
+{
+    std::vector<CallResult> results;
+    std::vector<uint8_t> out(OUT_SIZE);
+    z_stream strm = { };
+    CHECK(inflateInit2(&strm, window_bits) == Z_OK);
+    uint32_t start = 0;
+    for (uint32_t cut : cuts)
+    {
+        strm.next_in = const_cast<Bytef*>(input.data() + start);
+        strm.avail_in = cut - start;
+        strm.next_out = out.data();
+        strm.avail_out = OUT_SIZE;
+        const int ret = inflate(&strm, Z_SYNC_FLUSH);
+        results.push_back({ ret, strm.avail_in,
+            std::vector<uint8_t>(out.data(), out.data() + OUT_SIZE - strm.avail_out) });
+        start = cut;
+        if ((ret != Z_OK) && (ret != Z_STREAM_END))
+            break;
+    }
+    inflateEnd(&strm);
+    return results;
+}
+
+static std::vector<CallResult> run_inflater(const std::vector<uint8_t>& input,
+    CompressId compression, const std::vector<uint32_t>& cuts, unsigned& parks)
+{
+    std::vector<CallResult> results;
+    std::vector<uint8_t> out(OUT_SIZE);
+    HttpInflater inflater;
+    inflater.init(compression);
+    uint32_t start = 0;
+    parks = 0;
+    for (uint32_t cut : cuts)
+    {
+        uint32_t avail_in = cut - start;
+        uint32_t avail_out = OUT_SIZE;
+        const int ret = inflater.inflate(input.data() + start, avail_in, out.data(), avail_out);
+        results.push_back({ ret, avail_in,
+            std::vector<uint8_t>(out.data(), out.data() + OUT_SIZE - avail_out) });
+        start = cut;
+        if ((ret != Z_OK) && (ret != Z_STREAM_END))
+            break;
+        inflater.park();
+        if (inflater.is_parked())
+            parks++;
+    }
+    return results;
+}
+
+static void compare(const std::vector<uint8_t>& input, CompressId compression,
+    const std::vector<uint32_t>& cuts, unsigned* parks = nullptr)
+{
+    const int window_bits = (compression == CMP_GZIP) ? GZIP_WINDOW_BITS : DEFLATE_WINDOW_BITS;
+    unsigned num_parks;
+    const std::vector<CallResult> expected = run_zlib(input, window_bits, cuts);
+    const std::vector<CallResult> actual = run_inflater(input, compression, cuts, num_parks);
+    CHECK(expected.size() == actual.size());
+    for (size_t k = 0; k < expected.size(); k++)
+        CHECK(expected[k] == actual[k]);
+    if (parks != nullptr)
+        *parks = num_parks;
+    CHECK(HttpInflatePool::get_in_use() == 0);
+}
+
+TEST_GROUP(http_inflate)
+{
+    std::vector<uint8_t> text;
+
+    void setup() override
+    {
+        text = make_text(200000, 1);
+    }
+};
+
+TEST(http_inflate, cut_at_flush_points)
+{
+    for (CompressId compression : { CMP_GZIP, CMP_DEFLATE })
+    {
+        std::vector<uint32_t> flushes;
+        const int window_bits = (compression == CMP_GZIP) ? GZIP_WINDOW_BITS :
+            DEFLATE_WINDOW_BITS;
+        const std::vector<uint8_t> comp = compress(text, window_bits, 7000, flushes);
+        unsigned parks;
+        compare(comp, compression, flushes, &parks);
+        // Every flush but the final one leaves the stream on a block boundary
+        CHECK(parks == flushes.size() - 1);
+    }
+}
+
+TEST(http_inflate, random_cuts)
+{
+    std::mt19937 gen(7);
+    for (CompressId compression : { CMP_GZIP, CMP_DEFLATE })
+    {
+        std::vector<uint32_t> flushes;
+        const int window_bits = (compression == CMP_GZIP) ? GZIP_WINDOW_BITS :
+            DEFLATE_WINDOW_BITS;
+        const std::vector<uint8_t> comp = compress(text, window_bits, 3000, flushes);
+        for (unsigned round = 0; round < 20; round++)
+        {
+            // Mix of flush points, random points, and some empty segments
+            std::vector<uint32_t> cuts;
+            for (uint32_t f : flushes)
+            {
+                if (gen() % 2)
+                    cuts.push_back(f);
+                if (gen() % 3 == 0)
+                    cuts.push_back(std::min<uint32_t>(f + gen() % 50, comp.size()));
+            }
+            cuts.push_back(comp.size());
+            std::sort(cuts.begin(), cuts.end());
+            compare(comp, compression, cuts);
+        }
+    }
+}
+
+TEST(http_inflate, trailer_split)
+{
+    for (CompressId compression : { CMP_GZIP, CMP_DEFLATE })
+    {
+        std::vector<uint32_t> flushes;
+        const int window_bits = (compression == CMP_GZIP) ? GZIP_WINDOW_BITS :
+            DEFLATE_WINDOW_BITS;
+        const std::vector<uint8_t> comp = compress(text, window_bits, 50000, flushes);
+        const uint32_t last_flush = flushes[flushes.size() - 2];
+        for (uint32_t back = 1; back <= 12; back++)
+        {
+            std::vector<uint32_t> cuts = { last_flush, (uint32_t)comp.size() - back,
+                (uint32_t)comp.size() };
+            compare(comp, compression, cuts);
+        }
+    }
+}
+
+TEST(http_inflate, bad_trailer_and_extra_data)
+{
+    for (CompressId compression : { CMP_GZIP, CMP_DEFLATE })
+    {
+        std::vector<uint32_t> flushes;
+        const int window_bits = (compression == CMP_GZIP) ? GZIP_WINDOW_BITS :
+            DEFLATE_WINDOW_BITS;
+        const std::vector<uint8_t> good = compress(text, window_bits, 40000, flushes);
+        const uint32_t last_flush = flushes[flushes.size() - 2];
+        const uint32_t trailer = (compression == CMP_GZIP) ? 8 : 4;
+
+        for (uint32_t k = 1; k <= trailer; k++)
+        {
+            std::vector<uint8_t> bad = good;
+            bad[bad.size() - k] ^= 0x40;
+            compare(bad, compression, { last_flush, (uint32_t)bad.size() - 2,
+                (uint32_t)bad.size() });
+        }
+
+        std::vector<uint8_t> extra = good;
+        extra.insert(extra.end(), { 'm', 'o', 'r', 'e' });
+        compare(extra, compression, { last_flush, (uint32_t)extra.size(),
+            (uint32_t)extra.size() });
+    }
+}
+
+TEST(http_inflate, pool_reuse)
+{
+    std::vector<uint32_t> flushes;
+    const std::vector<uint8_t> comp = compress(text, GZIP_WINDOW_BITS, 10000, flushes);
+    compare(comp, CMP_GZIP, flushes);
+    const unsigned idle = HttpInflatePool::get_idle();
+    CHECK(idle > 0);
+    compare(comp, CMP_GZIP, flushes);
+    CHECK(HttpInflatePool::get_idle() == idle);
+    HttpInflatePool::term();
+    CHECK(HttpInflatePool::get_idle() == 0);
+}
+
+TEST(http_inflate, lazy)
+{
+    const PegCount before = HttpModule::get_peg_counts(PEG_MAX_INFLATE_CONTEXTS);
+    {
+        HttpInflater inflater;
+        inflater.init(CMP_DEFLATE);
+        CHECK(inflater.is_active());
+        inflater.park();
+        CHECK(!inflater.is_parked());
+    }
+    CHECK(HttpInflatePool::get_in_use() == 0);
+    CHECK(HttpModule::get_peg_counts(PEG_MAX_INFLATE_CONTEXTS) == before);
+}
+
+int main(int argc, char** argv)
+{
+    return CommandLineTestRunner::RunAllTests(argc, argv);
+}
@@ -0,0 +1,147 @@
+//--------------------------------------------------------------------------
+// Copyright (C) 2026 Cisco and/or its affiliates. All rights reserved.
+//
+// This program is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License Version 2 as published
+// by the Free Software Foundation.  You may not use, modify or distribute
+// this program under any other version of the GNU General Public License.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+//--------------------------------------------------------------------------
+// http_scan_benchmark.cc author Cisco
+
+#ifdef BENCHMARK_TEST
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "catch/catch.hpp"
+
+#include <string>
+
+#include "service_inspectors/http_inspect/http_scan.h"
+
+// Compares the vectorized scanners against the byte-at-a-time loops they replaced, using a
+// typical browser request header block and a long query string.
+
+static const std::string header_block =
+    "Host: www.example.com\r\n"
+    "User-Agent: Mozilla/5.0 (X11; Linux x86_64; rv:128.0) Gecko/20100101 Firefox/128.0\r\n"
+    "Accept: text/html,application/xhtml+xml,application/xml;q=0.9,*/*;q=0.8\r\n"
+    "Accept-Language: en-US,en;q=0.5\r\n"
+    "Accept-Encoding: gzip, deflate, br, zstd\r\n"
+    "Referer: https://www.example.com/some/long/path/to/a/previous/page\r\n"
+    "Connection: keep-alive\r\n"
+    "Cookie: session=0123456789abcdef0123456789abcdef; theme=dark; tracking_consent=granted\r\n"
+    "Upgrade-Insecure-Requests: 1\r\n"
+    "Sec-Fetch-Dest: document\r\n"
+    "Sec-Fetch-Mode: navigate\r\n"
+    "Sec-Fetch-Site: same-origin\r\n"
+    "Priority: u=0, i";
+
+static const std::string query =
+    "utm_source=newsletter&utm_medium=email&utm_campaign=autumn_sale_2026&item=12345678"
+    "&sort=price_ascending&page=3&session_token=ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
+
+static int32_t split_scalar(const uint8_t* buf, int32_t length)
+{
+    int32_t lines = 0;
+    for (int32_t k = 0; k < length; k++)
+    {
+        if ((buf[k] == '\r') || (buf[k] == '\n'))
+            lines++;
+    }
+    return lines;
+}
+
+static int32_t split_vector(const uint8_t* buf, int32_t length)
+{
+    int32_t lines = 0;
+    for (int32_t k = HttpScan::find_cr_lf(buf, length); k < length;
+        k += 1 + HttpScan::find_cr_lf(buf + k + 1, length - k - 1))
+        lines++;
+    return lines;
+}
+
+static int32_t special_scalar(const uint8_t* buf, int32_t length)
+{
+    int32_t count = 0;
+    for (int32_t k = 0; k < length; k++)
+    {
+        switch (buf[k])
+        {
+        case '%': case '+': case '\\': case '/': case '.':
+            count++;
+        }
+    }
+    return count;
+}
+
+static int32_t special_vector(const uint8_t* buf, int32_t length)
+{
+    int32_t count = 0;
+    for (int32_t k = HttpScan::find_uri_special(buf, length); k < length;
+        k += 1 + HttpScan::find_uri_special(buf + k + 1, length - k - 1))
+        count++;
+    return count;
+}
+
+static bool lower_scalar(const uint8_t* buf, int32_t length, uint8_t* out)
+{
+    for (int32_t k = 0; k < length; k++)
+    {
+        if ((buf[k] < 0x21) || (buf[k] > 0x7E))
+            return false;
+        out[k] = ((buf[k] < 'A') || (buf[k] > 'Z')) ? buf[k] : buf[k] - ('A' - 'a');
+    }
+    return true;
+}
+
+TEST_CASE("header block split", "[http_scan]")
+{
+    const uint8_t* buf = (const uint8_t*)header_block.data();
+    const int32_t length = header_block.length();
+    REQUIRE(split_scalar(buf, length) == split_vector(buf, length));
+
+    BENCHMARK("scalar")
+    { return split_scalar(buf, length); };
+
+    BENCHMARK("vector")
+    { return split_vector(buf, length); };
+}
+
+TEST_CASE("uri need_norm prefilter", "[http_scan]")
+{
+    const uint8_t* buf = (const uint8_t*)query.data();
+    const int32_t length = query.length();
+    REQUIRE(special_scalar(buf, length) == special_vector(buf, length));
+
+    BENCHMARK("scalar")
+    { return special_scalar(buf, length); };
+
+    BENCHMARK("vector")
+    { return special_vector(buf, length); };
+}
+
+TEST_CASE("field name lowering", "[http_scan]")
+{
+    const uint8_t name[] = "Upgrade-Insecure-Requests";
+    const int32_t length = sizeof(name) - 1;
+    uint8_t out[sizeof(name)];
+
+    BENCHMARK("scalar")
+    { return lower_scalar(name, length, out); };
+
+    BENCHMARK("vector")
+    { return HttpScan::lower_token(name, length, out); };
+}
+
+#endif
@@ -0,0 +1,134 @@
+//--------------------------------------------------------------------------
+// Copyright (C) 2026 Cisco and/or its affiliates. All rights reserved.
+//
+// This program is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License Version 2 as published
+// by the Free Software Foundation.  You may not use, modify or distribute
+// this program under any other version of the GNU General Public License.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+//--------------------------------------------------------------------------
+// http_scan_test.cc author Cisco
+// unit test main
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "service_inspectors/http_inspect/http_scan.h"
+
+#include <cctype>
+#include <cstring>
+
+#include <CppUTest/CommandLineTestRunner.h>
+#include <CppUTest/TestHarness.h>
+
+// Every result is checked against the obvious byte-at-a-time loop. Targets are placed at each
+// offset on both sides of the 16 octet vector boundaries.
+
+static const int32_t MAX_LEN = 50;
+
+static int32_t ref_find(const uint8_t* buf, int32_t length, const char* set)
+{
+    for (int32_t k = 0; k < length; k++)
+    {
+        if ((buf[k] != 0) && (strchr(set, buf[k]) != nullptr))
+            return k;
+    }
+    return length;
+}
+
+static bool ref_lower(const uint8_t* buf, int32_t length, uint8_t* out)
+{
+    for (int32_t k = 0; k < length; k++)
+    {
+        if ((buf[k] < 0x21) || (buf[k] > 0x7E))
+            return false;
+        out[k] = tolower(buf[k]);
+    }
+    return true;
+}
+
+TEST_GROUP(http_scan)
+{
+    uint8_t buf[MAX_LEN];
+
+    void setup() override
+    {
+        for (int32_t k = 0; k < MAX_LEN; k++)
+            buf[k] = 'a' + k % 26;
+    }
+};
+
+TEST(http_scan, empty)
+{
+    CHECK(HttpScan::find_cr_lf(buf, 0) == 0);
+    CHECK(HttpScan::find_colon(buf, 0) == 0);
+    CHECK(HttpScan::find_uri_special(buf, 0) == 0);
+    CHECK(HttpScan::lower_token(buf, 0, buf));
+}
+
+TEST(http_scan, no_match)
+{
+    for (int32_t length = 0; length <= MAX_LEN; length++)
+    {
+        CHECK(HttpScan::find_cr_lf(buf, length) == length);
+        CHECK(HttpScan::find_sp_tab(buf, length) == length);
+        CHECK(HttpScan::find_colon(buf, length) == length);
+        CHECK(HttpScan::find_uri_special(buf, length) == length);
+    }
+}
+
+TEST(http_scan, every_octet_every_offset)
+{
+    for (unsigned c = 0; c < 256; c++)
+    {
+        for (int32_t pos = 0; pos < MAX_LEN; pos++)
+        {
+            setup();
+            buf[pos] = c;
+            // A second target later on must not change the answer
+            if (pos + 17 < MAX_LEN)
+                buf[pos + 17] = c;
+            for (int32_t length : { pos, pos + 1, MAX_LEN })
+            {
+                CHECK(HttpScan::find_cr_lf(buf, length) == ref_find(buf, length, "\r\n"));
+                CHECK(HttpScan::find_sp_tab(buf, length) == ref_find(buf, length, " \t"));
+                CHECK(HttpScan::find_colon(buf, length) == ref_find(buf, length, ":"));
+                CHECK(HttpScan::find_uri_special(buf, length) ==
+                    ref_find(buf, length, "%+\\/."));
+            }
+        }
+    }
+}
+
+TEST(http_scan, lower_token)
+{
+    uint8_t out[MAX_LEN];
+    uint8_t ref_out[MAX_LEN];
+    for (unsigned c = 0; c < 256; c++)
+    {
+        for (int32_t pos = 0; pos < MAX_LEN; pos++)
+        {
+            setup();
+            buf[pos] = c;
+            buf[(pos + 5) % MAX_LEN] = 'Q';
+            const bool ref_ok = ref_lower(buf, MAX_LEN, ref_out);
+            CHECK(HttpScan::lower_token(buf, MAX_LEN, out) == ref_ok);
+            if (ref_ok)
+                CHECK(memcmp(out, ref_out, MAX_LEN) == 0);
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    return CommandLineTestRunner::RunAllTests(argc, argv);
+}
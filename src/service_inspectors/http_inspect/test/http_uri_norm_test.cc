@@ -35,6 +35,7 @@
 #include <CppUTest/TestHarness.h>
 #include <CppUTestExt/MockSupport.h>
 
+using namespace HttpEnums;
 using namespace snort;
 
 namespace snort
@@ -88,6 +89,75 @@ TEST(http_inspect_uri_norm, normalize)
     CHECK(memcmp(result.start(), "/uri/to/normalize", 17) == 0);
 }
 
+// Straightforward versions of the need_norm checks to verify the vectorized fast path
+static bool ref_need_norm(const Field& uri_component, bool do_path,
+    const HttpParaList::UriParam& uri_param)
+{
+    const int32_t length = uri_component.length();
+    const uint8_t* const buf = uri_component.start();
+    for (int32_t k = 0; k < length; k++)
+    {
+        switch (uri_param.uri_char[buf[k]])
+        {
+        case CHAR_NORMAL:
+        case CHAR_EIGHTBIT:
+            continue;
+        case CHAR_PERCENT:
+        case CHAR_SUBSTIT:
+            return true;
+        case CHAR_PATH:
+            if (!do_path || !uri_param.simplify_path)
+                continue;
+            if (buf[k] == '/')
+            {
+                if ((k == 0) || (buf[k-1] != '/'))
+                    continue;
+                return true;
+            }
+            if (((k == 0) || (uri_param.uri_char[buf[k-1]] != CHAR_PATH)) &&
+                ((k == length-1) || (uri_param.uri_char[buf[k+1]] != CHAR_PATH)))
+                continue;
+            return true;
+        }
+    }
+    return false;
+}
+
+TEST(http_inspect_uri_norm, need_norm_fast_path)
+{
+    // Every string of up to five octets from this alphabet, then padded so the interesting part
+    // straddles a vector boundary
+    const uint8_t alphabet[] = { 'a', '%', '+', '\\', '/', '.', 0xC3 };
+    const unsigned alpha_size = sizeof(alphabet);
+    uint8_t uri[32];
+    for (bool backslash : { false, true })
+    {
+        uri_param.uri_char[(uint8_t)'\\'] = backslash ? CHAR_SUBSTIT : CHAR_NORMAL;
+        uri_param.uri_char[(uint8_t)'+'] = backslash ? CHAR_NORMAL : CHAR_SUBSTIT;
+        for (unsigned len = 0; len <= 5; len++)
+        {
+            unsigned combos = 1;
+            for (unsigned k = 0; k < len; k++)
+                combos *= alpha_size;
+            for (unsigned n = 0; n < combos; n++)
+            {
+                for (unsigned pad : { 0, 13 })
+                {
+                    memset(uri, 'x', pad);
+                    for (unsigned k = 0, v = n; k < len; k++, v /= alpha_size)
+                        uri[pad + k] = alphabet[v % alpha_size];
+                    const Field input(pad + len, uri);
+                    for (bool do_path : { false, true })
+                    {
+                        CHECK(UriNormalizer::need_norm(input, do_path, uri_param, &infractions,
+                            &events) == ref_need_norm(input, do_path, uri_param));
+                    }
+                }
+            }
+        }
+    }
+}
+
 TEST_GROUP(http_double_decode_test)
 {
     uint8_t buffer[1000];
@@ -23,10 +23,19 @@
 
 #include "framework/counts.h"
 
+// what to do with the records of a session once it is encrypted
+enum SslPostHandshake
+{
+    SSL_POST_HS_INSPECT,   // decode every record
+    SSL_POST_HS_TRACK,     // pass over application data without reassembly
+    SSL_POST_HS_TRUST      // track, and trust the flow when nothing is left to check
+};
+
 struct SSL_PROTO_CONF
 {
     bool trustservers;
     int max_heartbeat_len;
+    SslPostHandshake post_handshake;
 };
 
 struct SslStats
@@ -49,6 +58,9 @@ struct SslStats
     PegCount bad_handshakes;
     PegCount stopped;
     PegCount disabled;
+    PegCount skipped_records;
+    PegCount skipped_bytes;
+    PegCount trusted;
     PegCount concurrent_sessions;
     PegCount max_concurrent_sessions;
 };
@@ -30,6 +30,7 @@
 
 #include "detection/detection_engine.h"
 #include "log/messages.h"
+#include "packet_io/active.h"
 #include "profiler/profiler.h"
 #include "protocols/packet.h"
 #include "protocols/ssl.h"
@@ -79,6 +80,9 @@ const PegInfo ssl_peg_names[] =
     { CountType::SUM, "bad_handshakes", "total bad handshakes" },
     { CountType::SUM, "sessions_ignored", "total sessions ignore" },
     { CountType::SUM, "detection_disabled", "total detection disabled" },
+    { CountType::SUM, "skipped_records", "encrypted application records passed over without reassembly" },
+    { CountType::SUM, "skipped_bytes", "encrypted application bytes passed over without reassembly" },
+    { CountType::SUM, "sessions_trusted", "encrypted sessions trusted to the DAQ" },
     { CountType::NOW, "concurrent_sessions", "total concurrent ssl sessions" },
     { CountType::MAX, "max_concurrent_sessions", "maximum concurrent ssl sessions" },
 
@@ -174,6 +178,22 @@ static inline bool SSLPP_is_encrypted(SSL_PROTO_CONF* config, uint32_t ssl_flags
     return false;
 }
 
+// Nothing is left to check on an encrypted session without heartbeat checks.
+// The flow may also be trusted so the DAQ can fastpath it, unless another
+// inspector defers trust.
+static inline void SSLPP_stop_inspection(SSL_PROTO_CONF* config, Packet* packet)
+{
+    Stream::stop_inspection(packet->flow, packet, SSN_DIR_BOTH, -1, 0);
+
+    if ( config->post_handshake == SSL_POST_HS_TRUST )
+    {
+        packet->active->trust_session(packet);
+
+        if ( packet->active->session_was_trusted() )
+            sslstats.trusted++;
+    }
+}
+
 static inline uint32_t SSLPP_process_alert(
     SSL_PROTO_CONF*, uint32_t ssn_flags, uint32_t new_flags, Packet* packet, uint32_t info_flags)
 {
@@ -229,7 +249,7 @@ static inline uint32_t SSLPP_process_app(SSL_PROTO_CONF* config, uint32_t ssn_fl
         // Heartbleed check is disabled. Stop inspection on this session.
         if (!config->max_heartbeat_len)
         {
-            Stream::stop_inspection(packet->flow, packet, SSN_DIR_BOTH, -1, 0);
+            SSLPP_stop_inspection(config, packet);
             sslstats.stopped++;
         }
         else if (!(new_flags & SSL_HEARTBEAT_SEEN))
@@ -257,7 +277,7 @@ static inline void SSLPP_process_other(SSL_PROTO_CONF* config, SSLData* sd, uint
 
         if (!config->max_heartbeat_len)
         {
-            Stream::stop_inspection(packet->flow, packet, SSN_DIR_BOTH, -1, 0);
+            SSLPP_stop_inspection(config, packet);
         }
         else if (!(new_flags & SSL_HEARTBEAT_SEEN))
         {
@@ -441,7 +461,7 @@ public:
     bool configure(SnortConfig*) override;
 
     StreamSplitter* get_splitter(bool c2s) override
-    { return new SslSplitter(c2s); }
+    { return new SslSplitter(c2s, config->post_handshake != SSL_POST_HS_INSPECT); }
 
 private:
     SSL_PROTO_CONF* config;
@@ -493,6 +513,21 @@ Ssl::~Ssl()
         delete config;
 }
 
+static const char* to_string(SslPostHandshake mode)
+{
+    switch ( mode )
+    {
+    case SSL_POST_HS_INSPECT:
+        return "inspect";
+    case SSL_POST_HS_TRACK:
+        return "track";
+    case SSL_POST_HS_TRUST:
+        return "trust";
+    }
+
+    return "";
+}
+
 void Ssl::show(const SnortConfig*) const
 {
     if ( !config )
@@ -500,6 +535,7 @@ void Ssl::show(const SnortConfig*) const
 
     ConfigLogger::log_flag("trust_servers", config->trustservers);
     ConfigLogger::log_value("max_heartbeat_length", config->max_heartbeat_len);
+    ConfigLogger::log_value("post_handshake", to_string(config->post_handshake));
 }
 
 void Ssl::eval(Packet* p)
@@ -42,6 +42,10 @@ static const Parameter s_params[] =
     { "max_heartbeat_length", Parameter::PT_INT, "0:65535", "0",
       "maximum length of heartbeat record allowed" },
 
+    { "post_handshake", Parameter::PT_ENUM, "inspect | track | trust", "inspect",
+      "once encrypted, decode all records, only track application data record boundaries, "
+      "or also trust the flow when heartbeats are not checked" },
+
     { nullptr, Parameter::PT_MAX, nullptr, nullptr, nullptr }
 };
 
@@ -90,6 +94,9 @@ bool SslModule::set(const char*, Value& v, SnortConfig*)
     else if ( v.is("max_heartbeat_length") )
         conf->max_heartbeat_len = v.get_uint16();
 
+    else if ( v.is("post_handshake") )
+        conf->post_handshake = (SslPostHandshake)v.get_uint8();
+
     return true;
 }
 
@@ -26,20 +26,60 @@
 
 #include <arpa/inet.h>
 
+#include "flow/flow.h"
+#include "protocols/packet.h"
 #include "protocols/ssl.h"
 
+#include "ssl_config.h"
+#include "ssl_flow_data.h"
+
 using namespace snort;
 
-SslSplitter::SslSplitter(bool c2s) : StreamSplitter(c2s)
+SslSplitter::SslSplitter(bool c2s, bool t) : StreamSplitter(c2s)
 {
     paf_state = SSL_PAF_STATES_START;
     remain_len = 0;
     len_bytes[0] = len_bytes[1] = 0;
     is_sslv2 = false;
+    track = t;
+}
+
+static bool is_encrypted(Packet* p)
+{
+    if ( !p or !p->flow )
+        return false;
+
+    const SSLData* sd = SslBaseFlowData::get_ssl_session_data(p->flow);
+    return sd and (sd->ssn_flags & SSL_ENCRYPTED_FLAG);
+}
+
+// Returns false if the run scanned so far must be flushed before this record.
+// A run that started in an earlier call can't be split anymore and is just
+// inspected if it turns out to be mixed.
+bool SslSplitter::add_record(bool app, uint32_t last_fp)
+{
+    if ( last_fp > 0 )
+    {
+        if ( app != skip_run )
+            return false;
+    }
+    else if ( run_open )
+    {
+        if ( app != skip_run )
+        {
+            skip_run = false;
+            run_records = 0;
+        }
+    }
+    else
+        skip_run = app;
+
+    run_open = true;
+    return true;
 }
 
 StreamSplitter::Status SslSplitter::scan(
-    Packet*, const uint8_t* data, uint32_t len,
+    Packet* pkt, const uint8_t* data, uint32_t len,
     uint32_t, uint32_t* fp)
 {
     uint32_t n = 0;
@@ -53,11 +93,22 @@ StreamSplitter::Status SslSplitter::scan(
         case SSL_PAF_STATES_START:
             if (data[n] >= SSL_CHANGE_CIPHER_REC and data[n] <= SSL_HEARTBEAT_REC)
             {
+                if (track and !add_record(data[n] == SSL_APPLICATION_REC and is_encrypted(pkt),
+                    last_fp))
+                {
+                    n = len;
+                    break;
+                }
                 is_sslv2 = false;
                 paf_state = SSL_PAF_STATES_VER_MJR;
             }
             else if ((data[n] & 0x80) or is_sslv2)
             {
+                if (track and !add_record(false, last_fp))
+                {
+                    n = len;
+                    break;
+                }
                 len_bytes[0] = data[n];
                 is_sslv2 = true;
                 paf_state = SSL_PAF_STATES_LEN2_V2;
@@ -94,6 +145,8 @@ StreamSplitter::Status SslSplitter::scan(
             {
                 last_fp = n;
                 paf_state = SSL_PAF_STATES_START;
+                if (skip_run)
+                    run_records++;
             }
             else
             {
@@ -108,6 +161,8 @@ StreamSplitter::Status SslSplitter::scan(
             {
                 last_fp = n;
                 paf_state = SSL_PAF_STATES_START;
+                if (skip_run)
+                    run_records++;
             }
             n--;
             break;
@@ -140,9 +195,29 @@ StreamSplitter::Status SslSplitter::scan(
         *fp = last_fp;
         remain_len = 0;
         paf_state = SSL_PAF_STATES_START;
+        run_open = false;
         return StreamSplitter::FLUSH;
     }
 
     return StreamSplitter::SEARCH;
 }
 
+const StreamBuffer SslSplitter::reassemble(Flow* f, unsigned total, unsigned offset,
+    const uint8_t* data, unsigned len, uint32_t flags, unsigned& copied)
+{
+    if ( !skip_run )
+        return StreamSplitter::reassemble(f, total, offset, data, len, flags, copied);
+
+    // no pdu is built so the segments are just released
+    copied = len;
+    sslstats.skipped_bytes += len;
+
+    if ( flags & PKT_PDU_TAIL )
+    {
+        sslstats.skipped_records += run_records;
+        run_records = 0;
+    }
+
+    return { nullptr, 0 };
+}
+
@@ -47,21 +47,34 @@ enum SslPafStates
 class SslSplitter : public snort::StreamSplitter
 {
 public:
-    SslSplitter(bool c2s);
+    SslSplitter(bool c2s, bool track = false);
 
     Status scan(snort::Packet*, const uint8_t* data, uint32_t len,
         uint32_t flags, uint32_t* fp) override;
 
+    const snort::StreamBuffer reassemble(snort::Flow*, unsigned total, unsigned offset,
+        const uint8_t* data, unsigned len, uint32_t flags, unsigned& copied) override;
+
     bool is_paf() override
     {
         return true;
     }
 
+private:
+    bool add_record(bool app, uint32_t last_fp);
+
 private:
     SslPafStates paf_state;
     uint16_t remain_len;
     uint8_t len_bytes[2]; // temporary buffer to hold 2-byte length field
     bool is_sslv2;
+
+    // post handshake tracking, runs of encrypted application data records
+    // are flushed on their own and passed over without reassembly
+    bool track;
+    bool skip_run = false;  // records scanned so far are application data
+    bool run_open = false;  // records scanned by previous calls are not flushed yet
+    uint32_t run_records = 0;
 };
 
 #endif
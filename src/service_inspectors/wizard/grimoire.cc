@@ -0,0 +1,334 @@
+//--------------------------------------------------------------------------
+// Copyright (C) 2026 Cisco and/or its affiliates. All rights reserved.
+//
+// This program is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License Version 2 as published
+// by the Free Software Foundation.  You may not use, modify or distribute
+// this program under any other version of the GNU General Public License.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+//--------------------------------------------------------------------------
+// grimoire.cc author Cisco
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "grimoire.h"
+
+#include <algorithm>
+#include <map>
+
+using namespace std;
+
+//-------------------------------------------------------------------------
+// The pages of both books are the states of an NFA. Subset construction
+// turns each reachable set of pages into one DFA state. States from which
+// no pattern can be completed anymore are then dropped, so that a scan
+// stops as soon as the outcome is known.
+//-------------------------------------------------------------------------
+
+static void settle(PageSet& pages)
+{
+    sort(pages.begin(), pages.end());
+    pages.erase(unique(pages.begin(), pages.end()), pages.end());
+}
+
+bool Grimoire::compile(const MagicBook& hexes, const MagicBook& spells, unsigned max_states)
+{
+    if ( max_states > MAX_STATES )
+        max_states = MAX_STATES;
+
+    map<PageSet, uint32_t> index;
+    vector<PageSet> sets;
+
+    auto get_state = [&index, &sets](PageSet& pages)
+    {
+        settle(pages);
+        auto it = index.find(pages);
+
+        if ( it != index.end() )
+            return it->second;
+
+        uint32_t id = sets.size();
+        index.emplace(pages, id);
+        sets.emplace_back(move(pages));
+        return id;
+    };
+
+    PageSet none;
+    get_state(none);
+
+    uint32_t entry[(int)MagicBook::ArcaneType::MAX];
+
+    for ( int proto = 0; proto < (int)MagicBook::ArcaneType::MAX; ++proto )
+    {
+        PageSet pages;
+        hexes.open(hexes.page1((MagicBook::ArcaneType)proto), pages);
+        spells.open(spells.page1((MagicBook::ArcaneType)proto), pages);
+        entry[proto] = get_state(pages);
+    }
+
+    vector<uint32_t> table(256, DEAD);
+
+    for ( uint32_t s = 1; s < sets.size(); ++s )
+    {
+        if ( sets.size() > max_states )
+            return false;
+
+        const PageSet current = sets[s];
+        table.resize((s + 1) << 8, DEAD);
+
+        for ( unsigned c = 0; c < 256; ++c )
+        {
+            PageSet pages;
+
+            for ( const MagicPage* p : current )
+                p->book.turn(p, c, pages);
+
+            if ( !pages.empty() )
+                table[(s << 8) | c] = get_state(pages);
+        }
+    }
+
+    if ( sets.size() > max_states )
+        return false;
+
+    // the first pattern added to the book wins within a state, hexes before spells
+    vector<Chapter> all(sets.size());
+
+    for ( uint32_t s = 1; s < sets.size(); ++s )
+    {
+        unsigned order = 0;
+
+        for ( const MagicPage* p : sets[s] )
+        {
+            if ( !p->value )
+                continue;
+
+            uint8_t rank = (&p->book == &hexes) ? HEX_RANK : SPELL_RANK;
+
+            if ( rank < all[s].rank or (rank == all[s].rank and p->order < order) )
+            {
+                all[s].value = p->value;
+                all[s].rank = rank;
+                order = p->order;
+            }
+        }
+    }
+
+    // keep only the states that can still complete a pattern
+    vector<vector<uint32_t>> from(sets.size());
+
+    for ( uint32_t s = 1; s < sets.size(); ++s )
+    {
+        for ( unsigned c = 0; c < 256; ++c )
+        {
+            uint32_t t = table[(s << 8) | c];
+
+            if ( t != DEAD and (from[t].empty() or from[t].back() != s) )
+                from[t].emplace_back(s);
+        }
+    }
+
+    vector<bool> useful(sets.size(), false);
+    vector<uint32_t> work;
+
+    for ( uint32_t s = 1; s < sets.size(); ++s )
+    {
+        if ( all[s].value )
+        {
+            useful[s] = true;
+            work.emplace_back(s);
+        }
+    }
+
+    while ( !work.empty() )
+    {
+        uint32_t t = work.back();
+        work.pop_back();
+
+        for ( uint32_t s : from[t] )
+        {
+            if ( !useful[s] )
+            {
+                useful[s] = true;
+                work.emplace_back(s);
+            }
+        }
+    }
+
+    vector<uint32_t> renum(sets.size(), DEAD);
+    uint32_t states = 1;
+
+    for ( uint32_t s = 1; s < sets.size(); ++s )
+    {
+        if ( useful[s] )
+            renum[s] = states++;
+    }
+
+    chapters.assign(states, Chapter());
+    next.assign(states << 8, DEAD);
+
+    for ( uint32_t s = 1; s < sets.size(); ++s )
+    {
+        if ( !useful[s] )
+            continue;
+
+        uint32_t r = renum[s];
+        bool last = true;
+
+        for ( unsigned c = 0; c < 256; ++c )
+        {
+            uint32_t t = renum[table[(s << 8) | c]];
+            next[(r << 8) | c] = t;
+
+            if ( t != DEAD )
+                last = false;
+        }
+        chapters[r] = all[s];
+        chapters[r].last = last;
+    }
+
+    for ( int proto = 0; proto < (int)MagicBook::ArcaneType::MAX; ++proto )
+        start[proto] = renum[entry[proto]];
+
+    return true;
+}
+
+//-------------------------------------------------------------------------
+// unit tests
+//-------------------------------------------------------------------------
+
+#ifdef CATCH_TEST_BUILD
+
+#include "catch/catch.hpp"
+
+#include <cstring>
+
+#include "main/snort_config.h"
+
+const char* snort::SnortConfig::get_static_name(const char* name)
+{ return name; }
+
+struct TestBooks
+{
+    HexBook hexes;
+    SpellBook spells;
+    Grimoire magic;
+
+    void hex(const char* key, const char* val, MagicBook::ArcaneType proto = MagicBook::ArcaneType::TCP)
+    { CHECK(hexes.add_spell(key, val, proto)); }
+
+    void spell(const char* key, const char* val, MagicBook::ArcaneType proto = MagicBook::ArcaneType::TCP)
+    { CHECK(spells.add_spell(key, val, proto)); }
+
+    void compile()
+    { REQUIRE(magic.compile(hexes, spells, 4096)); }
+
+    template <unsigned N>
+    const char* cast(const char (&data)[N], MagicBook::ArcaneType proto = MagicBook::ArcaneType::TCP)
+    {
+        uint32_t state = magic.page1(proto);
+        return magic.find_spell((const uint8_t*)data, N - 1, state);
+    }
+};
+
+static bool same(const char* a, const char* b)
+{ return a and b and !strcmp(a, b); }
+
+TEST_CASE("spells", "[Grimoire]")
+{
+    TestBooks t;
+    t.spell("GET", "http");
+    t.spell("SSH-", "ssh");
+    t.spell("220*FTP", "ftp");
+    t.spell("** OK", "imap");
+    t.compile();
+
+    CHECK(same(t.cast("GET / HTTP/1.1\r\n"), "http"));
+    CHECK(same(t.cast("get / HTTP/1.1\r\n"), "http"));
+    CHECK(same(t.cast(" \r\n\tSSH-2.0"), "ssh"));
+    CHECK(same(t.cast("220 example.com FTP server ready"), "ftp"));
+    CHECK(same(t.cast("* OK ready"), "imap"));
+    CHECK(t.cast("X GET") == nullptr);
+    CHECK(t.cast("OK") == nullptr);
+    CHECK(t.cast("220 example.com SMTP") == nullptr);
+}
+
+TEST_CASE("longest spell wins", "[Grimoire]")
+{
+    TestBooks t;
+    t.spell("foobar", "long");
+    t.spell("foo*", "short");
+    t.spell("OPTIONS", "http");
+    t.spell("OPTIONS * SIP/", "sip");
+    t.compile();
+
+    CHECK(same(t.cast("foobar"), "long"));
+    CHECK(same(t.cast("foobaz"), "short"));
+    CHECK(same(t.cast("OPTIONS / HTTP/1.1\r\n"), "http"));
+    CHECK(same(t.cast("OPTIONS sip:user@example.com SIP/2.0\r\n"), "sip"));
+}
+
+TEST_CASE("hexes", "[Grimoire]")
+{
+    TestBooks t;
+    t.hex("???|04 00 00 00 00 00|", "http2");
+    t.hex("|16 03|", "ssl");
+    t.hex("|00 05|", "netflow", MagicBook::ArcaneType::UDP);
+    t.spell("*HTTP", "http");
+    t.compile();
+
+    CHECK(same(t.cast("\x00\x00\x12\x04\x00\x00\x00\x00\x00 HTTP"), "http2"));
+    CHECK(same(t.cast("\x16\x03\x01"), "ssl"));
+    CHECK(same(t.cast("\x16\x03 HTTP"), "ssl"));
+    CHECK(same(t.cast("\x17\x03 HTTP"), "http"));
+    CHECK(t.cast("\x00\x05") == nullptr);
+    CHECK(same(t.cast("\x00\x05", MagicBook::ArcaneType::UDP), "netflow"));
+}
+
+TEST_CASE("resume across segments", "[Grimoire]")
+{
+    TestBooks t;
+    t.spell("SSH-", "ssh");
+    t.spell("220*SMTP", "smtp");
+    t.compile();
+
+    uint32_t state = t.magic.page1(MagicBook::ArcaneType::TCP);
+    CHECK(t.magic.find_spell((const uint8_t*)"SS", 2, state) == nullptr);
+    CHECK(state != Grimoire::DEAD);
+    CHECK(same(t.magic.find_spell((const uint8_t*)"H-2.0", 5, state), "ssh"));
+
+    state = t.magic.page1(MagicBook::ArcaneType::TCP);
+    CHECK(t.magic.find_spell((const uint8_t*)"220 mail.example.com ", 21, state) == nullptr);
+    CHECK(state != Grimoire::DEAD);
+    CHECK(same(t.magic.find_spell((const uint8_t*)"ESMTP", 5, state), "smtp"));
+
+    state = t.magic.page1(MagicBook::ArcaneType::TCP);
+    CHECK(t.magic.find_spell((const uint8_t*)"SX", 2, state) == nullptr);
+    CHECK(state == Grimoire::DEAD);
+}
+
+TEST_CASE("empty and oversized", "[Grimoire]")
+{
+    TestBooks t;
+    t.compile();
+    CHECK(t.magic.page1(MagicBook::ArcaneType::TCP) == Grimoire::DEAD);
+    CHECK(t.magic.page1(MagicBook::ArcaneType::UDP) == Grimoire::DEAD);
+
+    TestBooks u;
+    u.spell("A*B*C*D*E*F*G", "x");
+    u.spell("G*F*E*D*C*B*A", "y");
+    CHECK(!u.magic.compile(u.hexes, u.spells, 8));
+}
+
+#endif
+
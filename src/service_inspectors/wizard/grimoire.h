@@ -0,0 +1,106 @@
+//--------------------------------------------------------------------------
+// Copyright (C) 2026 Cisco and/or its affiliates. All rights reserved.
+//
+// This program is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License Version 2 as published
+// by the Free Software Foundation.  You may not use, modify or distribute
+// this program under any other version of the GNU General Public License.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+//--------------------------------------------------------------------------
+// grimoire.h author Cisco
+
+#ifndef GRIMOIRE_H
+#define GRIMOIRE_H
+
+// Grimoire is the hexes and spells of one direction compiled into a single
+// DFA, so that a flow is identified in one linear pass over its data.
+
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+#include "magic.h"
+
+class Grimoire
+{
+public:
+    Grimoire() = default;
+
+    Grimoire(const Grimoire&) = delete;
+    Grimoire& operator=(const Grimoire&) = delete;
+
+    // build the automaton from the pages of both books, hexes having priority;
+    // returns false if it would need more than max_states (at most MAX_STATES)
+    bool compile(const MagicBook& hexes, const MagicBook& spells, unsigned max_states);
+
+    // starting state for a flow, resumed across segments by find_spell()
+    uint32_t page1(MagicBook::ArcaneType proto) const
+    {
+        assert(proto < MagicBook::ArcaneType::MAX);
+        return start[(int)proto];
+    }
+
+    // Scan data from state, returning the service of the best pattern
+    // completed in it. state is updated for the next segment and becomes
+    // DEAD once no pattern can match anymore.
+    const char* find_spell(const uint8_t* data, unsigned len, uint32_t& state) const
+    {
+        const Chapter* ch = &chapters[state];
+        const char* val = ch->value;
+        uint8_t rank = ch->rank;
+
+        for ( unsigned i = 0; i < len; ++i )
+        {
+            state = next[(state << 8) | data[i]];
+
+            if ( state == DEAD )
+                break;
+
+            ch = &chapters[state];
+
+            if ( ch->value and ch->rank <= rank )
+            {
+                val = ch->value;
+                rank = ch->rank;
+            }
+
+            if ( ch->last )
+            {
+                state = DEAD;
+                break;
+            }
+        }
+        return val;
+    }
+
+    unsigned size() const
+    { return chapters.size(); }
+
+    static constexpr uint32_t DEAD = 0;
+    static constexpr unsigned MAX_STATES = 65536;
+
+private:
+    enum : uint8_t { HEX_RANK = 0, SPELL_RANK = 1, NO_RANK = 2 };
+
+    struct Chapter
+    {
+        const char* value = nullptr;
+        uint8_t rank = NO_RANK;
+        bool last = false;    // nothing longer can match from here
+    };
+
+    std::vector<Chapter> chapters;
+    std::vector<uint16_t> next;    // 256 transitions per state
+    uint32_t start[(int)MagicBook::ArcaneType::MAX] = { };
+};
+
+#endif
+
@@ -98,6 +98,7 @@ void HexBook::add_spell(
 
     p->key = key;
     p->value = SnortConfig::get_static_name(val);
+    p->order = ++spells;
 }
 
 bool HexBook::add_spell(const char* key, const char*& val, ArcaneType proto)
@@ -152,35 +153,12 @@ bool HexBook::add_spell(const char* key, const char*& val, ArcaneType proto)
     return true;
 }
 
-const MagicPage* HexBook::find_spell(
-    const uint8_t* s, unsigned n, const MagicPage* p, unsigned i, const MagicPage*& bookmark) const
+// a wild char matches exactly one byte
+void HexBook::turn(const MagicPage* p, uint8_t c, PageSet& pages) const
 {
-    while ( i < n )
-    {
-        int c = s[i];
-
-        if ( p->next[c] )
-        {
-            if ( p->any )
-            {
-                if ( const MagicPage* q = find_spell(s, n, p->next[c], i+1, bookmark) )
-                    return q;
-            }
-            else
-            {
-                p = p->next[c];
-                ++i;
-                continue;
-            }
-        }
-        if ( p->any )
-        {
-            if ( const MagicPage* q = find_spell(s, n, p->any, i+1, bookmark) )
-                return q;
-        }
-
-        return p->value ? p : nullptr;
-    }
+    if ( p->next[c] )
+        pages.emplace_back(p->next[c]);
 
-    return p;
+    if ( p->any )
+        pages.emplace_back(p->any);
 }
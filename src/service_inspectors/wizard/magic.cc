@@ -23,8 +23,6 @@
 
 #include "magic.h"
 
-#include <cassert>
-
 MagicPage::MagicPage(const MagicBook& b) : book(b)
 {
     for ( int i = 0; i < 256; ++i )
@@ -44,15 +42,6 @@ MagicPage::~MagicPage()
     delete any;
 }
 
-const char* MagicBook::find_spell(const uint8_t* data, unsigned len,
-    const MagicPage*& p, const MagicPage*& bookmark) const
-{
-    assert(p);
-    p = find_spell(data, len, p, 0, bookmark);
-
-    return p ? p->value : nullptr;
-}
-
 MagicBook::MagicBook()
 { root = new MagicPage[(int)ArcaneType::MAX] { *this, *this }; }
 
@@ -31,6 +31,8 @@ struct MagicPage
 {
     std::string key;
     const char* value = nullptr;
+    unsigned order = 0;    // pattern ending here was the n-th added to the book
+    bool loop = false;     // glob page, any number of bytes may precede its successors
 
     MagicPage* next[256];
     MagicPage* any;
@@ -42,8 +44,10 @@ struct MagicPage
 };
 
 typedef std::vector<uint16_t> HexVector;
+typedef std::vector<const MagicPage*> PageSet;
 
-// MagicBook is a set of MagicPages implementing a trie
+// MagicBook is a set of MagicPages implementing a trie. Matching is done by
+// a Grimoire, which treats the pages as the states of an NFA.
 class MagicBook
 {
 public:
@@ -61,8 +65,13 @@ public:
     };
 
     virtual bool add_spell(const char* key, const char*& val, ArcaneType proto) = 0;
-    virtual const char* find_spell(const uint8_t* data, unsigned len, const MagicPage*& p,
-        const MagicPage*& bookmark) const;
+
+    // add p and any pages reachable from it without consuming data
+    virtual void open(const MagicPage* p, PageSet& pages) const
+    { pages.emplace_back(p); }
+
+    // add the pages reached from p by consuming c
+    virtual void turn(const MagicPage* p, uint8_t c, PageSet& pages) const = 0;
 
     const MagicPage* page1(ArcaneType proto) const
     {
@@ -73,15 +82,13 @@ public:
 protected:
     MagicBook();
     MagicPage* root;
+    unsigned spells = 0;
 
     MagicPage* get_root(ArcaneType proto) const
     {
         assert(proto < ArcaneType::MAX);
         return &root[(int)proto];
     }
-
-    virtual const MagicPage* find_spell(const uint8_t*, unsigned,
-        const MagicPage*, unsigned, const MagicPage*&) const = 0;
 };
 
 //-------------------------------------------------------------------------
@@ -95,12 +102,12 @@ public:
     SpellBook();
 
     bool add_spell(const char*, const char*&, ArcaneType) override;
+    void open(const MagicPage*, PageSet&) const override;
+    void turn(const MagicPage*, uint8_t, PageSet&) const override;
 
 private:
     bool translate(const char*, HexVector&);
     void add_spell(const char*, const char*, const HexVector&, unsigned, MagicPage*);
-    const MagicPage* find_spell(const uint8_t*, unsigned, const MagicPage*, unsigned,
-        const MagicPage*&) const override;
 };
 
 //-------------------------------------------------------------------------
@@ -114,12 +121,11 @@ public:
     HexBook() = default;
 
     bool add_spell(const char*, const char*&, ArcaneType) override;
+    void turn(const MagicPage*, uint8_t, PageSet&) const override;
 
 private:
     bool translate(const char*, HexVector&);
     void add_spell(const char*, const char*, const HexVector&, unsigned, MagicPage*);
-    const MagicPage* find_spell(const uint8_t*, unsigned, const MagicPage*, unsigned,
-        const MagicPage*&) const override;
 };
 
 #endif
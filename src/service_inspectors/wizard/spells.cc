@@ -85,7 +85,10 @@ void SpellBook::add_spell(
         MagicPage* t = new MagicPage(*this);
 
         if ( hv[i] == WILD )
+        {
             p->any = t;
+            t->loop = true;
+        }
         else
             p->next[toupper(hv[i])] = t;
 
@@ -95,6 +98,7 @@ void SpellBook::add_spell(
 
     p->key = key;
     p->value = snort::SnortConfig::get_static_name(val);
+    p->order = ++spells;
 }
 
 bool SpellBook::add_spell(const char* key, const char*& val, ArcaneType proto)
@@ -151,55 +155,21 @@ bool SpellBook::add_spell(const char* key, const char*& val, ArcaneType proto)
     return true;
 }
 
-const MagicPage* SpellBook::find_spell(
-    const uint8_t* s, unsigned n, const MagicPage* p, unsigned i, const MagicPage*& bookmark) const
+// a glob may match nothing, so it is entered along with the page before it
+void SpellBook::open(const MagicPage* p, PageSet& pages) const
 {
-    while ( i < n )
+    while ( p )
     {
-        int c = toupper(s[i]);
-
-        if ( p->next[c] )
-        {
-            if ( p->any )
-            {
-                if ( const MagicPage* q = find_spell(s, n, p->next[c], i+1, bookmark) )
-                    return q;
-            }
-            else
-            {
-                p = p->next[c];
-                ++i;
-                continue;
-            }
-        }
-        if ( p->any )
-        {
-            while ( i < n )
-            {
-                if ( const MagicPage* q = find_spell(s, n, p->any, i, bookmark) )
-                {
-                    bookmark = q->any ? q : p;
-
-                    return q;
-                }
-
-                ++i;
-            }
-
-            return p;
-        }
-
-        // If no match but has bookmark, continue lookup from bookmark
-        if ( !p->value and bookmark )
-        {
-            p = bookmark;
-            bookmark = nullptr;
-
-            return find_spell(s, n, p, i, bookmark);
-        }
-
-        return p->value ? p : nullptr;
+        pages.emplace_back(p);
+        p = p->any;
     }
+}
+
+void SpellBook::turn(const MagicPage* p, uint8_t c, PageSet& pages) const
+{
+    if ( p->loop )
+        open(p, pages);
 
-    return p;
+    if ( const MagicPage* q = p->next[toupper(c)] )
+        open(q, pages);
 }
@@ -115,6 +115,9 @@ WizardModule::~WizardModule()
     delete c2s_spells;
     delete s2c_spells;
 
+    delete c2s_magic;
+    delete s2c_magic;
+
     delete curses;
 }
 
@@ -223,6 +226,28 @@ static bool add_spells(MagicBook* b, const string& service, const vector<string>
     return true;
 }
 
+// all hexes and spells of a direction are compiled into one automaton
+static Grimoire* compile(MagicBook*& hexes, MagicBook*& spells, const char* dir)
+{
+    Grimoire* g = new Grimoire;
+
+    if ( !g->compile(*hexes, *spells, Grimoire::MAX_STATES) )
+    {
+        ParseError("wizard %s hexes and spells need more than %u states, "
+            "simplify the patterns with wild chars", dir, Grimoire::MAX_STATES);
+        delete g;
+        g = nullptr;
+    }
+
+    delete hexes;
+    hexes = nullptr;
+
+    delete spells;
+    spells = nullptr;
+
+    return g;
+}
+
 bool WizardModule::end(const char* fqn, int idx, SnortConfig*)
 {
     if ( !strcmp(fqn, "wizard") )
@@ -230,6 +255,15 @@ bool WizardModule::end(const char* fqn, int idx, SnortConfig*)
         service.clear();
         c2s_patterns.clear();
         s2c_patterns.clear();
+
+        delete c2s_magic;
+        delete s2c_magic;
+
+        c2s_magic = compile(c2s_hexes, c2s_spells, "to_server");
+        s2c_magic = compile(s2c_hexes, s2c_spells, "to_client");
+
+        if ( !c2s_magic or !s2c_magic )
+            return false;
     }
     else if ( !strcmp(fqn, "wizard.hexes") )
     {
@@ -281,35 +315,11 @@ bool WizardModule::end(const char* fqn, int idx, SnortConfig*)
     return true;
 }
 
-MagicBook* WizardModule::get_book(bool c2s, bool hex)
+Grimoire* WizardModule::get_grimoire(bool c2s)
 {
-    int k = c2s ? 1 : 0;
-    k |= (hex ? 2 : 0);
-
-    MagicBook* b = nullptr;
-
-    switch ( k )
-    {
-    case 0:
-        b = s2c_spells;
-        s2c_spells = nullptr;
-        break;
-
-    case 1:
-        b = c2s_spells;
-        c2s_spells = nullptr;
-        break;
-
-    case 2:
-        b = s2c_hexes;
-        s2c_hexes = nullptr;
-        break;
-
-    case 3:
-        b = c2s_hexes;
-        c2s_hexes = nullptr;
-        break;
-    }
+    Grimoire*& g = c2s ? c2s_magic : s2c_magic;
+    Grimoire* b = g;
+    g = nullptr;
 
     return b;
 }
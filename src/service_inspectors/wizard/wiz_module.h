@@ -25,6 +25,7 @@
 
 #include "framework/module.h"
 
+#include "grimoire.h"
 #include "magic.h"
 
 #define WIZ_NAME "wizard"
@@ -40,7 +41,6 @@ extern THREAD_LOCAL struct WizStats tstats;
 extern THREAD_LOCAL snort::ProfileStats wizPerfStats;
 extern THREAD_LOCAL const snort::Trace* wizard_trace;
 
-class MagicBook;
 class CurseBook;
 
 class WizardModule : public snort::Module
@@ -57,7 +57,7 @@ public:
     PegCount* get_counts() const override;
     snort::ProfileStats* get_profile() const override;
 
-    MagicBook* get_book(bool c2s, bool hex);
+    Grimoire* get_grimoire(bool c2s);
     CurseBook* get_curse_book();
 
     uint16_t get_max_search_depth() const
@@ -84,6 +84,9 @@ private:
     MagicBook* c2s_spells = nullptr;
     MagicBook* s2c_spells = nullptr;
 
+    Grimoire* c2s_magic = nullptr;
+    Grimoire* s2c_magic = nullptr;
+
     CurseBook* curses = nullptr;
     uint16_t max_search_depth = 0;
 
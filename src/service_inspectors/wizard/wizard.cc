@@ -30,7 +30,7 @@
 #include "trace/trace_api.h"
 
 #include "curse_book.h"
-#include "magic.h"
+#include "grimoire.h"
 #include "wiz_module.h"
 
 using namespace snort;
@@ -79,9 +79,8 @@ struct CurseServiceTracker
 
 struct Wand
 {
-    const MagicPage* hex;
-    const MagicPage* spell;
-    const MagicPage* bookmark;
+    const Grimoire* grimoire;
+    uint32_t page;
     vector<CurseServiceTracker> curse_tracker;
 };
 
@@ -140,20 +139,17 @@ public:
     StreamSplitter* get_splitter(bool) override;
 
     inline bool finished(Wand& w)
-    { return !w.hex and !w.spell and w.curse_tracker.empty(); }
+    { return w.page == Grimoire::DEAD and w.curse_tracker.empty(); }
 
     void reset(Wand&, bool, MagicBook::MagicBook::ArcaneType);
 
     bool cast_spell(Wand&, Flow*, const uint8_t*, unsigned, uint16_t&);
-    bool spellbind(const MagicPage*&, Flow*, const uint8_t*, unsigned, const MagicPage*&);
+    bool spellbind(uint32_t&, const Grimoire*, Flow*, const uint8_t*, unsigned);
     bool cursebind(const vector<CurseServiceTracker>&, Flow*, const uint8_t*, unsigned);
 
 public:
-    MagicBook* c2s_hexes;
-    MagicBook* s2c_hexes;
-
-    MagicBook* c2s_spells;
-    MagicBook* s2c_spells;
+    Grimoire* c2s_magic;
+    Grimoire* s2c_magic;
 
     CurseBook* curses;
 
@@ -241,11 +237,8 @@ StreamSplitter::Status MagicSplitter::scan(
 
 Wizard::Wizard(WizardModule* m)
 {
-    c2s_hexes = m->get_book(true, true);
-    s2c_hexes = m->get_book(false, true);
-
-    c2s_spells = m->get_book(true, false);
-    s2c_spells = m->get_book(false, false);
+    c2s_magic = m->get_grimoire(true);
+    s2c_magic = m->get_grimoire(false);
 
     curses = m->get_curse_book();
     max_search_depth = m->get_max_search_depth();
@@ -253,29 +246,16 @@ Wizard::Wizard(WizardModule* m)
 
 Wizard::~Wizard()
 {
-    delete c2s_hexes;
-    delete s2c_hexes;
-
-    delete c2s_spells;
-    delete s2c_spells;
+    delete c2s_magic;
+    delete s2c_magic;
 
     delete curses;
 }
 
 void Wizard::reset(Wand& w, bool c2s, MagicBook::ArcaneType proto)
 {
-    w.bookmark = nullptr;
-
-    if ( c2s )
-    {
-        w.hex = c2s_hexes->page1(proto);
-        w.spell = c2s_spells->page1(proto);
-    }
-    else
-    {
-        w.hex = s2c_hexes->page1(proto);
-        w.spell = s2c_spells->page1(proto);
-    }
+    w.grimoire = c2s ? c2s_magic : s2c_magic;
+    w.page = w.grimoire->page1(proto);
 
     bool tcp = MagicBook::ArcaneType::TCP == proto;
 
@@ -328,9 +308,9 @@ StreamSplitter* Wizard::get_splitter(bool c2s)
 }
 
 bool Wizard::spellbind(
-    const MagicPage*& m, Flow* f, const uint8_t* data, unsigned len, const MagicPage*& bookmark)
+    uint32_t& state, const Grimoire* g, Flow* f, const uint8_t* data, unsigned len)
 {
-    f->service = m->book.find_spell(data, len, m, bookmark);
+    f->service = g->find_spell(data, len, state);
 
     return f->service != nullptr;
 }
@@ -359,10 +339,7 @@ bool Wizard::cast_spell(
     len = std::min(len, static_cast<unsigned>(max_search_depth - wizard_processed_bytes));
     wizard_processed_bytes += len;
 
-    if ( w.hex and spellbind(w.hex, f, data, len, w.bookmark) )
-        return true;
-
-    if ( w.spell and spellbind(w.spell, f, data, len, w.bookmark) )
+    if ( w.page != Grimoire::DEAD and spellbind(w.page, w.grimoire, f, data, len) )
         return true;
 
     if ( cursebind(w.curse_tracker, f, data, curse_len) )
@@ -372,8 +349,7 @@ bool Wizard::cast_spell(
     // but not assign any inspector - raise tcp_miss and stop
     if ( !f->service and wizard_processed_bytes >= max_search_depth )
     {
-        w.spell = nullptr;
-        w.hex = nullptr;
+        w.page = Grimoire::DEAD;
 
         for ( const CurseServiceTracker& cst : w.curse_tracker )
             delete cst.tracker;
@@ -0,0 +1,394 @@
+//--------------------------------------------------------------------------
+// Copyright (C) 2026 Cisco and/or its affiliates. All rights reserved.
+//
+// This program is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License Version 2 as published
+// by the Free Software Foundation.  You may not use, modify or distribute
+// this program under any other version of the GNU General Public License.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+//--------------------------------------------------------------------------
+// sfrt_poptrie.cc author Cisco
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "sfrt_poptrie.h"
+
+#include <arpa/inet.h>
+
+#include <cassert>
+
+using namespace snort;
+
+// keys are 128 bits held as hi:lo, most significant bit first; IPv4
+// addresses occupy the top 32 bits of hi.  bits past 128 read as zero so
+// the last IPv6 stride may overhang the end of the address.
+
+static inline bool key_less_equal(uint64_t ahi, uint64_t alo, uint64_t bhi, uint64_t blo)
+{ return ahi < bhi or (ahi == bhi and alo <= blo); }
+
+static inline uint32_t get_bits(uint64_t hi, uint64_t lo, unsigned pos, unsigned n)
+{
+    uint64_t mask = (1ULL << n) - 1;
+
+    if ( pos + n <= 64 )
+        return (hi >> (64 - pos - n)) & mask;
+
+    if ( pos >= 64 )
+    {
+        if ( pos + n <= 128 )
+            return (lo >> (128 - pos - n)) & mask;
+
+        return (lo << (pos + n - 128)) & mask;
+    }
+    return ((hi << (pos + n - 64)) | (lo >> (128 - pos - n))) & mask;
+}
+
+static inline void set_bits(uint64_t& hi, uint64_t& lo, unsigned pos, unsigned n, uint64_t v)
+{
+    if ( pos + n <= 64 )
+        hi |= v << (64 - pos - n);
+
+    else if ( pos >= 64 )
+    {
+        if ( pos + n <= 128 )
+            lo |= v << (128 - pos - n);
+        else if ( pos < 128 )
+            lo |= v >> (pos + n - 128);
+    }
+    else
+    {
+        hi |= v >> (pos + n - 64);
+        lo |= v << (128 - pos - n);
+    }
+}
+
+// set all bits at and after pos to get the last key of a prefix
+static inline void fill_bits(uint64_t& hi, uint64_t& lo, unsigned pos)
+{
+    if ( pos < 64 )
+    {
+        hi |= pos ? (~0ULL >> pos) : ~0ULL;
+        lo = ~0ULL;
+    }
+    else if ( pos < 128 )
+        lo |= pos > 64 ? (~0ULL >> (pos - 64)) : ~0ULL;
+}
+
+static inline uint64_t below(unsigned bit)
+{ return ((2ULL << bit) - 1); }
+
+// without the popcnt instruction the builtin is a library call, which costs
+// more than the rest of the lookup
+static inline unsigned popcount(uint64_t v)
+{
+#ifdef __POPCNT__
+    return __builtin_popcountll(v);
+#else
+    v = v - ((v >> 1) & 0x5555555555555555ULL);
+    v = (v & 0x3333333333333333ULL) + ((v >> 2) & 0x3333333333333333ULL);
+    v = (v + (v >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+    return (v * 0x0101010101010101ULL) >> 56;
+#endif
+}
+
+//--------------------------------------------------------------------------
+// compile
+//--------------------------------------------------------------------------
+
+void RtPoptrie::collect_runs(SUB_TABLE_PTR sub_ptr, uint64_t hi, uint64_t lo, unsigned depth,
+    std::vector<Run>& runs) const
+{
+    const dir_sub_table_flat_t* sub = (const dir_sub_table_flat_t*)&base[sub_ptr];
+    const DIR_Entry* entry = (const DIR_Entry*)&base[sub->entries];
+    const INFO* data = (const INFO*)&base[((const table_flat_t*)base)->data];
+    unsigned width = (unsigned)sub->width;
+
+    for ( int i = 0; i < sub->num_entries; ++i )
+    {
+        uint64_t khi = hi, klo = lo;
+        set_bits(khi, klo, depth, width, i);
+
+        if ( entry[i].value and !entry[i].length )
+        {
+            collect_runs(entry[i].value, khi, klo, depth + width, runs);
+            continue;
+        }
+        MEM_OFFSET value = data[entry[i].value];
+
+        if ( runs.empty() or runs.back().value != value )
+            runs.push_back({ khi, klo, value });
+    }
+}
+
+bool RtPoptrie::uniform(const std::vector<Run>& runs, size_t& r, uint64_t hi, uint64_t lo,
+    unsigned depth, MEM_OFFSET& value)
+{
+    while ( r + 1 < runs.size() and key_less_equal(runs[r + 1].hi, runs[r + 1].lo, hi, lo) )
+        ++r;
+
+    value = runs[r].value;
+
+    if ( r + 1 == runs.size() )
+        return true;
+
+    fill_bits(hi, lo, depth);
+    return !key_less_equal(runs[r + 1].hi, runs[r + 1].lo, hi, lo);
+}
+
+void RtPoptrie::fill_node(Trie& t, const std::vector<Run>& runs, size_t r, uint32_t node,
+    uint64_t hi, uint64_t lo, unsigned depth)
+{
+    uint64_t vector = 0, leafvec = 0;
+    uint32_t base0 = t.leaves.size();
+    size_t first[64];
+    unsigned num_nodes = 0;
+    bool have_leaf = false;
+    MEM_OFFSET last = 0;
+
+    for ( unsigned i = 0; i < 64; ++i )
+    {
+        uint64_t khi = hi, klo = lo;
+        set_bits(khi, klo, depth, stride, i);
+
+        MEM_OFFSET value;
+
+        if ( !uniform(runs, r, khi, klo, depth + stride, value) )
+        {
+            first[i] = r;
+            vector |= 1ULL << i;
+            ++num_nodes;
+            continue;
+        }
+        if ( !have_leaf or value != last )
+        {
+            leafvec |= 1ULL << i;
+            t.leaves.push_back(value);
+            last = value;
+            have_leaf = true;
+        }
+    }
+    uint32_t base1 = t.nodes.size();
+    t.nodes.resize(base1 + num_nodes);
+    t.nodes[node] = { vector, leafvec, base0, base1 };
+
+    for ( unsigned i = 0; i < 64; ++i )
+    {
+        if ( !(vector & (1ULL << i)) )
+            continue;
+
+        uint64_t khi = hi, klo = lo;
+        set_bits(khi, klo, depth, stride, i);
+        fill_node(t, runs, first[i], base1++, khi, klo, depth + stride);
+    }
+}
+
+void RtPoptrie::build(Trie& t, TABLE_PTR rt_ptr)
+{
+    std::vector<Run> runs;
+    const dir_table_flat_t* rt = (const dir_table_flat_t*)&base[rt_ptr];
+
+    collect_runs(rt->sub_table, 0, 0, 0, runs);
+    assert(!runs.empty() and !runs[0].hi and !runs[0].lo);
+
+    t.top.assign(1 << top_bits, 0);
+    t.nodes.clear();
+    t.leaves.clear();
+
+    size_t r = 0;
+
+    for ( uint32_t i = 0; i < (1u << top_bits); ++i )
+    {
+        uint64_t hi = (uint64_t)i << (64 - top_bits);
+        MEM_OFFSET value;
+
+        if ( uniform(runs, r, hi, 0, top_bits, value) )
+        {
+            t.top[i] = leaf_flag | value;
+            continue;
+        }
+        uint32_t node = t.nodes.size();
+        t.nodes.emplace_back();
+        t.top[i] = node;
+        fill_node(t, runs, r, node, hi, 0, top_bits);
+
+        // the runs inside this prefix are done
+        uint64_t end_hi = hi, end_lo = 0;
+        fill_bits(end_hi, end_lo, top_bits);
+        while ( r + 1 < runs.size() and
+            key_less_equal(runs[r + 1].hi, runs[r + 1].lo, end_hi, end_lo) )
+            ++r;
+    }
+    t.nodes.shrink_to_fit();
+    t.leaves.shrink_to_fit();
+}
+
+bool RtPoptrie::compile(const table_flat_t* table)
+{
+    if ( !table or !table->rt or !table->rt6 )
+        return false;
+
+    base = (const uint8_t*)table;
+    build(rt, table->rt);
+    build(rt6, table->rt6);
+    return true;
+}
+
+size_t RtPoptrie::usage() const
+{
+    size_t sz = 0;
+
+    for ( const Trie* t : { &rt, &rt6 } )
+    {
+        sz += t->top.capacity() * sizeof(t->top[0]);
+        sz += t->nodes.capacity() * sizeof(t->nodes[0]);
+        sz += t->leaves.capacity() * sizeof(t->leaves[0]);
+    }
+    return sz;
+}
+
+//--------------------------------------------------------------------------
+// lookup
+//--------------------------------------------------------------------------
+
+inline void RtPoptrie::get_key(const SfIp* ip, const Trie*& t, uint64_t& hi, uint64_t& lo) const
+{
+    if ( ip->is_ip4() )
+    {
+        t = &rt;
+        hi = (uint64_t)ntohl(*ip->get_ip4_ptr()) << 32;
+        lo = 0;
+    }
+    else
+    {
+        const uint32_t* a = ip->get_ip6_ptr();
+        t = &rt6;
+        hi = ((uint64_t)ntohl(a[0]) << 32) | ntohl(a[1]);
+        lo = ((uint64_t)ntohl(a[2]) << 32) | ntohl(a[3]);
+    }
+}
+
+inline MEM_OFFSET RtPoptrie::lookup_key(const Trie& t, uint64_t hi, uint64_t lo) const
+{
+    uint64_t top = t.top[hi >> (64 - top_bits)];
+
+    if ( top & leaf_flag )
+        return (MEM_OFFSET)top;
+
+    const Node* node = &t.nodes[top];
+    unsigned pos = top_bits;
+
+    while ( true )
+    {
+        unsigned v = get_bits(hi, lo, pos, stride);
+
+        if ( !(node->vector & (1ULL << v)) )
+            return t.leaves[node->base0 + popcount(node->leafvec & below(v)) - 1];
+
+        node = &t.nodes[node->base1 + popcount(node->vector & below(v)) - 1];
+        pos += stride;
+    }
+}
+
+GENERIC RtPoptrie::lookup(const SfIp* ip) const
+{
+    if ( !base )
+        return nullptr;
+
+    const Trie* t;
+    uint64_t hi, lo;
+
+    get_key(ip, t, hi, lo);
+    MEM_OFFSET value = lookup_key(*t, hi, lo);
+    return value ? (GENERIC)&base[value] : nullptr;
+}
+
+void RtPoptrie::lookup(const SfIp* const* ips, GENERIC* results, unsigned count) const
+{
+    if ( !base )
+    {
+        for ( unsigned i = 0; i < count; ++i )
+            results[i] = nullptr;
+        return;
+    }
+
+    constexpr unsigned batch = 16;
+    constexpr uint32_t no_leaf = ~0u;
+
+    for ( unsigned n = 0; n < count; n += batch )
+    {
+        unsigned num = (count - n) < batch ? (count - n) : batch;
+        const Trie* t[batch];
+        const Node* node[batch];
+        uint64_t hi[batch], lo[batch];
+        MEM_OFFSET value[batch];
+        uint32_t leaf[batch];
+        unsigned pos = top_bits;
+
+        // the walks advance one level per pass with the next node or leaf of
+        // each prefetched so that the misses of all lookups overlap
+        for ( unsigned i = 0; i < num; ++i )
+        {
+            get_key(ips[n + i], t[i], hi[i], lo[i]);
+            __builtin_prefetch(&t[i]->top[hi[i] >> (64 - top_bits)]);
+        }
+        unsigned active = 0;
+
+        for ( unsigned i = 0; i < num; ++i )
+        {
+            uint64_t top = t[i]->top[hi[i] >> (64 - top_bits)];
+
+            if ( top & leaf_flag )
+            {
+                value[i] = (MEM_OFFSET)top;
+                leaf[i] = no_leaf;
+                node[i] = nullptr;
+                continue;
+            }
+            node[i] = &t[i]->nodes[top];
+            __builtin_prefetch(node[i]);
+            ++active;
+        }
+        while ( active )
+        {
+            active = 0;
+
+            for ( unsigned i = 0; i < num; ++i )
+            {
+                if ( !node[i] )
+                    continue;
+
+                unsigned v = get_bits(hi[i], lo[i], pos, stride);
+
+                if ( node[i]->vector & (1ULL << v) )
+                {
+                    node[i] = &t[i]->nodes[node[i]->base1 +
+                        popcount(node[i]->vector & below(v)) - 1];
+                    __builtin_prefetch(node[i]);
+                    ++active;
+                    continue;
+                }
+                leaf[i] = node[i]->base0 + popcount(node[i]->leafvec & below(v)) - 1;
+                __builtin_prefetch(&t[i]->leaves[leaf[i]]);
+                node[i] = nullptr;
+            }
+            pos += stride;
+        }
+        for ( unsigned i = 0; i < num; ++i )
+        {
+            if ( leaf[i] != no_leaf )
+                value[i] = t[i]->leaves[leaf[i]];
+
+            results[n + i] = value[i] ? (GENERIC)&base[value[i]] : nullptr;
+        }
+    }
+}
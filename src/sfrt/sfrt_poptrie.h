@@ -0,0 +1,101 @@
+//--------------------------------------------------------------------------
+// Copyright (C) 2026 Cisco and/or its affiliates. All rights reserved.
+//
+// This program is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License Version 2 as published
+// by the Free Software Foundation.  You may not use, modify or distribute
+// this program under any other version of the GNU General Public License.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+//--------------------------------------------------------------------------
+// sfrt_poptrie.h author Cisco
+
+#ifndef SFRT_POPTRIE_H
+#define SFRT_POPTRIE_H
+
+// RtPoptrie is a read-only, compressed copy of a flat DIR-n-m table built
+// with RtTable.  It follows the poptrie layout: the top 16 bits of the
+// address index a direct pointing array and the remaining bits are
+// consumed 6 at a time by nodes holding two 64-bit maps.  One map marks the
+// children that are internal nodes, the other marks where a run of equal
+// leaves starts; a popcount of the map below the child's bit gives its
+// offset in the node's contiguous block of children or leaves.  A lookup
+// touches the direct pointing entry plus one 24 byte node per level and a
+// leaf instead of a sub table header and its entries at each DIR level
+// followed by the data table.  Prefixes of 16 bits or less resolve in the
+// direct pointing entry alone.
+//
+// Leaves hold the final data offset, so results are the same as
+// sfrt_flat_dir8x_lookup() on the source table.  The source segment must
+// outlive the trie and must not change once the trie is compiled.
+
+#include <vector>
+
+#include "sfrt/sfrt_flat.h"
+
+class RtPoptrie
+{
+public:
+    // Build from a fully loaded table. Returns false if there is nothing to build.
+    bool compile(const table_flat_t*);
+
+    GENERIC lookup(const snort::SfIp*) const;
+
+    // Look up count addresses at once so that their memory accesses overlap.
+    void lookup(const snort::SfIp* const* ips, GENERIC* results, unsigned count) const;
+
+    // Bytes used by the compiled tries, not counting the source segment.
+    size_t usage() const;
+
+private:
+    struct Node
+    {
+        uint64_t vector;     // children that are internal nodes
+        uint64_t leafvec;    // children that start a new run of leaves
+        uint32_t base0;      // first leaf of this node
+        uint32_t base1;      // first internal child of this node
+    };
+
+    struct Run
+    {
+        uint64_t hi;
+        uint64_t lo;
+        MEM_OFFSET value;
+    };
+
+    struct Trie
+    {
+        std::vector<uint64_t> top;     // leaf_flag | data offset, or a node index
+        std::vector<Node> nodes;
+        std::vector<MEM_OFFSET> leaves;
+    };
+
+    static constexpr unsigned top_bits = 16;
+    static constexpr unsigned stride = 6;
+    static constexpr uint64_t leaf_flag = 1ULL << 32;
+
+    void collect_runs(SUB_TABLE_PTR, uint64_t hi, uint64_t lo, unsigned depth,
+        std::vector<Run>&) const;
+    void build(Trie&, TABLE_PTR);
+    void fill_node(Trie&, const std::vector<Run>&, size_t run, uint32_t node,
+        uint64_t hi, uint64_t lo, unsigned depth);
+
+    static bool uniform(const std::vector<Run>&, size_t& run, uint64_t hi, uint64_t lo,
+        unsigned depth, MEM_OFFSET& value);
+
+    MEM_OFFSET lookup_key(const Trie&, uint64_t hi, uint64_t lo) const;
+    void get_key(const snort::SfIp*, const Trie*&, uint64_t& hi, uint64_t& lo) const;
+
+    const uint8_t* base = nullptr;
+    Trie rt;
+    Trie rt6;
+};
+
+#endif
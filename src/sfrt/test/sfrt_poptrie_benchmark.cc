@@ -0,0 +1,159 @@
+//--------------------------------------------------------------------------
+// Copyright (C) 2026 Cisco and/or its affiliates. All rights reserved.
+//
+// This program is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License Version 2 as published
+// by the Free Software Foundation.  You may not use, modify or distribute
+// this program under any other version of the GNU General Public License.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+//--------------------------------------------------------------------------
+// sfrt_poptrie_benchmark.cc author Cisco
+
+#ifdef BENCHMARK_TEST
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "catch/catch.hpp"
+
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "sfip/sf_cidr.h"
+#include "sfrt/sfrt_poptrie.h"
+
+using namespace snort;
+
+namespace snort
+{
+char* snort_strdup(const char* str)
+{
+    size_t n = strlen(str) + 1;
+    char* p = new char[n];
+    memcpy(p, str, n);
+    return p;
+}
+}
+
+static int64_t update_entry(INFO* current, INFO new_entry, SaveDest save_dest, uint8_t*, void*)
+{
+    if ( save_dest == SAVE_TO_CURRENT and !*current )
+        *current = new_entry;
+    return 0;
+}
+
+// a reputation style list: mostly single hosts and /24s spread over the
+// IPv4 space plus IPv6 /48 to /128 entries under a few hundred /32s
+struct BenchTable
+{
+    BenchTable(unsigned num4, unsigned num6)
+    {
+        const uint32_t memcap = 1024;
+        segment.resize((size_t)memcap * 1024 * 1024);
+        rt.segment_meminit(segment.data(), segment.size());
+        rt.sfrt_flat_new(DIR_8x16, IPv6, num4 + num6 + 1, memcap);
+
+        std::mt19937 rng(1);
+
+        for ( unsigned n = 0; n < num4; ++n )
+        {
+            uint32_t a = rng();
+            unsigned len = (n % 4) ? 32 : (n % 64 ? 24 : 16);
+            insert(&a, AF_INET, len);
+        }
+        for ( unsigned n = 0; n < num6; ++n )
+        {
+            uint32_t a[4] = { htonl(0x20010000 | (rng() % 256)), rng(), rng(), rng() };
+            insert(a, AF_INET6, 48 + (rng() % 81));
+        }
+        for ( unsigned n = 0; n < 64 * 1024; ++n )
+        {
+            SfIp ip;
+            uint32_t a = rng();
+            ip.set(&a, AF_INET);
+            ips.emplace_back(ip);
+        }
+        for ( const auto& ip : ips )
+            ptrs.emplace_back(&ip);
+
+        results.resize(ips.size());
+        trie.compile(rt.get_table());
+    }
+
+    void insert(const void* addr, int family, unsigned len)
+    {
+        SfCidr cidr;
+        cidr.set(addr, family);
+        cidr.set_bits((family == AF_INET ? 96 : 0) + len);
+
+        MEM_OFFSET info = rt.segment_snort_calloc(1, sizeof(INFO));
+        rt.sfrt_flat_insert(&cidr, cidr.get_bits(), info, RT_FAVOR_ALL, update_entry, nullptr);
+    }
+
+    std::vector<uint8_t> segment;
+    RtTable rt;
+    RtPoptrie trie;
+    std::vector<SfIp> ips;
+    std::vector<const SfIp*> ptrs;
+    std::vector<GENERIC> results;
+};
+
+static BenchTable& get_table()
+{
+    static BenchTable bt(1000000, 16000);
+    return bt;
+}
+
+TEST_CASE("sfrt lookup", "[sfrt]")
+{
+    BenchTable& bt = get_table();
+    table_flat_t* table = bt.rt.get_table();
+
+    WARN("DIR segment bytes: " << bt.rt.sfrt_flat_usage() <<
+        ", poptrie bytes: " << bt.trie.usage());
+
+    BENCHMARK("dir8x 64K")
+    {
+        unsigned hits = 0;
+        for ( const auto& ip : bt.ips )
+            hits += sfrt_flat_dir8x_lookup(&ip, table) != nullptr;
+        return hits;
+    };
+
+    BENCHMARK("poptrie 64K")
+    {
+        unsigned hits = 0;
+        for ( const auto& ip : bt.ips )
+            hits += bt.trie.lookup(&ip) != nullptr;
+        return hits;
+    };
+
+    BENCHMARK("poptrie batch 64K")
+    {
+        bt.trie.lookup(bt.ptrs.data(), bt.results.data(), bt.ptrs.size());
+        return bt.results[0];
+    };
+}
+
+TEST_CASE("sfrt compile", "[sfrt]")
+{
+    BenchTable& bt = get_table();
+
+    BENCHMARK("poptrie compile 1M")
+    {
+        RtPoptrie trie;
+        return trie.compile(bt.rt.get_table());
+    };
+}
+
+#endif
@@ -0,0 +1,238 @@
+//--------------------------------------------------------------------------
+// Copyright (C) 2026 Cisco and/or its affiliates. All rights reserved.
+//
+// This program is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License Version 2 as published
+// by the Free Software Foundation.  You may not use, modify or distribute
+// this program under any other version of the GNU General Public License.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+//--------------------------------------------------------------------------
+// sfrt_poptrie_test.cc author Cisco
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "catch/catch.hpp"
+
+#include "sfip/sf_cidr.h"
+#include "sfrt/sfrt_poptrie.h"
+
+using namespace snort;
+
+namespace snort
+{
+char* snort_strdup(const char* str)
+{
+    size_t n = strlen(str) + 1;
+    char* p = new char[n];
+    memcpy(p, str, n);
+    return p;
+}
+}
+
+// each prefix maps to the offset of its own data word in the segment like
+// the reputation list info does; the first prefix inserted keeps its data
+static int64_t update_entry(INFO* current, INFO new_entry, SaveDest save_dest, uint8_t*, void*)
+{
+    if ( save_dest == SAVE_TO_CURRENT and !*current )
+        *current = new_entry;
+    return 0;
+}
+
+struct TestTable
+{
+    TestTable(unsigned max_entries, uint32_t memcap)
+    {
+        segment.resize((size_t)memcap * 1024 * 1024);
+        rt.segment_meminit(segment.data(), segment.size());
+        rt.sfrt_flat_new(DIR_8x16, IPv6, max_entries, memcap);
+        table = rt.get_table();
+    }
+
+    bool insert(const uint8_t* addr, int family, unsigned len)
+    {
+        uint8_t buf[16] = { };
+        unsigned bytes = (family == AF_INET) ? 4 : 16;
+
+        for ( unsigned i = 0; i < bytes; ++i )
+        {
+            unsigned bits = (len > i * 8) ? len - i * 8 : 0;
+            buf[i] = bits >= 8 ? addr[i] : (addr[i] & (uint8_t)(0xff00 >> bits));
+        }
+        SfCidr cidr;
+        cidr.set(buf, family);
+        cidr.set_bits((family == AF_INET ? 96 : 0) + len);
+
+        MEM_OFFSET info = rt.segment_snort_calloc(1, sizeof(INFO));
+
+        if ( !info )
+            return false;
+
+        return rt.sfrt_flat_insert(&cidr, cidr.get_bits(), info, RT_FAVOR_ALL,
+            update_entry, nullptr) == RT_SUCCESS;
+    }
+
+    std::vector<uint8_t> segment;
+    RtTable rt;
+    table_flat_t* table;
+};
+
+static void check_all(TestTable& tt, const RtPoptrie& trie, const std::vector<SfIp>& ips)
+{
+    std::vector<const SfIp*> ptrs;
+    for ( const auto& ip : ips )
+        ptrs.push_back(&ip);
+
+    std::vector<GENERIC> batch(ips.size());
+    trie.lookup(ptrs.data(), batch.data(), ptrs.size());
+
+    unsigned hits = 0;
+
+    for ( size_t i = 0; i < ips.size(); ++i )
+    {
+        GENERIC expected = sfrt_flat_dir8x_lookup(&ips[i], tt.table);
+        CHECK(trie.lookup(&ips[i]) == expected);
+        CHECK(batch[i] == expected);
+
+        if ( expected )
+            ++hits;
+    }
+    // make sure the test is not just comparing misses
+    CHECK(hits > 0);
+    CHECK(hits < ips.size());
+}
+
+TEST_CASE("empty table", "[poptrie]")
+{
+    TestTable tt(16, 16);
+    RtPoptrie trie;
+    REQUIRE(trie.compile(tt.table));
+
+    SfIp ip;
+    ip.set("10.1.2.3");
+    CHECK(trie.lookup(&ip) == nullptr);
+    ip.set("2001:db8::1");
+    CHECK(trie.lookup(&ip) == nullptr);
+}
+
+TEST_CASE("nested prefixes", "[poptrie]")
+{
+    TestTable tt(16, 16);
+    const uint8_t a[] = { 10, 1, 2, 3 };
+
+    REQUIRE(tt.insert(a, AF_INET, 8));
+    REQUIRE(tt.insert(a, AF_INET, 16));
+    REQUIRE(tt.insert(a, AF_INET, 30));
+    REQUIRE(tt.insert(a, AF_INET, 32));
+
+    RtPoptrie trie;
+    REQUIRE(trie.compile(tt.table));
+
+    std::vector<SfIp> ips(6);
+    ips[0].set("10.1.2.3");
+    ips[1].set("10.1.2.2");
+    ips[2].set("10.1.2.4");
+    ips[3].set("10.1.3.3");
+    ips[4].set("10.2.2.3");
+    ips[5].set("11.1.2.3");
+    check_all(tt, trie, ips);
+
+    CHECK(trie.lookup(&ips[0]) != trie.lookup(&ips[1]));
+    CHECK(trie.lookup(&ips[1]) != trie.lookup(&ips[2]));
+    CHECK(trie.lookup(&ips[2]) == trie.lookup(&ips[3]));
+    CHECK(trie.lookup(&ips[3]) != trie.lookup(&ips[4]));
+    CHECK(trie.lookup(&ips[5]) == nullptr);
+}
+
+// lookups must match the DIR table for random prefixes of every length,
+// checked at random addresses and at the edges of every inserted prefix
+TEST_CASE("random prefixes", "[poptrie]")
+{
+    std::mt19937 rng(12345);
+    TestTable tt(40000, 256);
+    std::vector<SfIp> ips;
+
+    auto add_edges = [&ips](const uint8_t* addr, int family, unsigned len)
+    {
+        unsigned bytes = (family == AF_INET) ? 4 : 16;
+        uint8_t lo[16], hi[16];
+
+        for ( unsigned i = 0; i < bytes; ++i )
+        {
+            unsigned bits = (len > i * 8) ? len - i * 8 : 0;
+            uint8_t mask = bits >= 8 ? 0xff : (uint8_t)(0xff00 >> bits);
+            lo[i] = addr[i] & mask;
+            hi[i] = addr[i] | (uint8_t)~mask;
+        }
+        SfIp ip;
+        ip.set(lo, family);
+        ips.emplace_back(ip);
+        ip.set(hi, family);
+        ips.emplace_back(ip);
+
+        // one past the end
+        for ( int i = bytes - 1; i >= 0 and !++hi[i]; --i );
+        ip.set(hi, family);
+        ips.emplace_back(ip);
+    };
+
+    for ( unsigned n = 0; n < 20000; ++n )
+    {
+        uint32_t r = rng();
+        uint8_t addr[4];
+        memcpy(addr, &r, sizeof(addr));
+
+        // keep most prefixes under a few /8s so they nest
+        if ( n % 4 )
+            addr[0] = 10 + (n % 3);
+
+        // short prefixes are covered by IPv6 below; these leave room for misses
+        unsigned len = 8 + rng() % 25;
+        REQUIRE(tt.insert(addr, AF_INET, len));
+        add_edges(addr, AF_INET, len);
+    }
+    for ( unsigned n = 0; n < 2000; ++n )
+    {
+        uint8_t addr[16];
+        for ( unsigned i = 0; i < 16; i += 4 )
+        {
+            uint32_t r = rng();
+            memcpy(addr + i, &r, 4);
+        }
+        // keep most prefixes under 2001:db8::/32 so they nest and go deep
+        if ( n % 8 )
+        {
+            addr[0] = 0x20; addr[1] = 0x01; addr[2] = 0x0d; addr[3] = 0xb8;
+            addr[4] = n % 5;
+        }
+        unsigned len = 1 + rng() % 128;
+        REQUIRE(tt.insert(addr, AF_INET6, len));
+        add_edges(addr, AF_INET6, len);
+    }
+    for ( unsigned n = 0; n < 20000; ++n )
+    {
+        uint32_t r = rng();
+        SfIp ip;
+        ip.set(&r, AF_INET);
+        ips.emplace_back(ip);
+    }
+
+    RtPoptrie trie;
+    REQUIRE(trie.compile(tt.table));
+    CHECK(trie.usage() > 0);
+
+    check_all(tt, trie, ips);
+}
@@ -25,6 +25,7 @@
 
 #include "tcp_segment_node.h"
 
+#include "memory/memory_cap.h"
 #include "utils/util.h"
 
 #include "tcp_module.h"
@@ -42,6 +43,10 @@ static constexpr unsigned res_min = 1024;
 static constexpr unsigned res_max = 1460;
 #endif
 
+// nodes are sized for their payload so give the whole block back
+static void free_node(TcpSegmentNode* tsn)
+{ memory::MemoryCap::deallocate(memory::ARENA_STREAM, tsn, sizeof(*tsn) + tsn->size); }
+
 void TcpSegmentNode::setup()
 {
 #ifdef USE_RESERVE
@@ -58,7 +63,7 @@ void TcpSegmentNode::clear()
         TcpSegmentNode* tsn = reserved;
         reserved = reserved->next;
         tcpStats.mem_in_use -= tsn->size;
-        snort_free(tsn);
+        free_node(tsn);
     }
     reserve_sz = 0;
 #endif
@@ -84,7 +89,7 @@ TcpSegmentNode* TcpSegmentNode::create(
 #endif
     {
         size_t size = sizeof(*tsn) + len;
-        tsn = (TcpSegmentNode*)snort_alloc(size);
+        tsn = (TcpSegmentNode*)memory::MemoryCap::allocate(memory::ARENA_STREAM, size);
         tsn->size = len;
         tcpStats.mem_in_use += len;
     }
@@ -125,7 +130,7 @@ void TcpSegmentNode::term()
 #endif
     {
         tcpStats.mem_in_use -= size;
-        snort_free(this);
+        free_node(this);
     }
     tcpStats.segs_released++;
 }
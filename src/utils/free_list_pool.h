@@ -0,0 +1,147 @@
+//--------------------------------------------------------------------------
+// Copyright (C) 2026 Cisco and/or its affiliates. All rights reserved.
+//
+// This program is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License Version 2 as published
+// by the Free Software Foundation.  You may not use, modify or distribute
+// this program under any other version of the GNU General Public License.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+//--------------------------------------------------------------------------
+// free_list_pool.h author Cisco
+
+#ifndef FREE_LIST_POOL_H
+#define FREE_LIST_POOL_H
+
+// Per packet thread caches for things that are created and destroyed at a
+// high rate, such as protocol trackers and decompression contexts.
+//
+// FreeListPool<Owner, MAX_IDLE, Item> keeps up to MAX_IDLE idle Item
+// pointers per thread for its Owner. take() returns one of them, or nullptr
+// when there are none, and give() keeps an item or frees it with Free when
+// the pool is full. term() frees the idle items and closes the pool when the
+// packet thread stops; items given back after that are freed at once. Items
+// are kept as they are given, so a pool of constructed objects keeps any
+// state they have set up.
+//
+// StoragePool<T, MAX_IDLE, Storage> recycles blocks of exactly sizeof(T)
+// through a FreeListPool. A class derives from it to get its operator new and
+// delete, or calls acquire() and release() from its own. Objects are still
+// constructed and destroyed normally. Blocks of any other size, such as
+// those of a derived class, go straight to Storage, which is the global
+// allocator by default.
+
+#include <cstddef>
+#include <memory>
+#include <new>
+
+#include "main/snort_types.h"
+
+namespace snort
+{
+struct GlobalStorage
+{
+    static void* allocate(std::size_t size)
+    { return ::operator new(size); }
+
+    static void deallocate(void* ptr, std::size_t)
+    { ::operator delete(ptr); }
+};
+
+template<typename Owner, unsigned MAX_IDLE, typename Item = Owner,
+    typename Free = std::default_delete<Item>>
+class FreeListPool
+{
+public:
+    static Item* take()
+    { return idle_count ? idle[--idle_count] : nullptr; }
+
+    static void give(Item* item)
+    {
+        if (!item)
+            return;
+
+        if (closed or idle_count >= MAX_IDLE)
+        {
+            Free()(item);
+            return;
+        }
+
+        if (!idle)
+            idle = new Item*[MAX_IDLE];
+
+        idle[idle_count++] = item;
+    }
+
+    static void term()
+    {
+        while (idle_count)
+            Free()(idle[--idle_count]);
+
+        delete[] idle;
+        idle = nullptr;
+        closed = true;
+    }
+
+    static unsigned get_idle()
+    { return idle_count; }
+
+private:
+    static inline THREAD_LOCAL Item** idle = nullptr;
+    static inline THREAD_LOCAL unsigned idle_count = 0;
+    static inline THREAD_LOCAL bool closed = false;
+};
+
+template<typename T, unsigned MAX_IDLE, typename Storage = GlobalStorage>
+class StoragePool
+{
+public:
+    static void* acquire(std::size_t size)
+    {
+        if (size == sizeof(T))
+        {
+            if (void* block = Blocks::take())
+                return block;
+        }
+        return Storage::allocate(size);
+    }
+
+    static void release(void* ptr, std::size_t size)
+    {
+        if (size == sizeof(T))
+            Blocks::give(ptr);
+        else
+            Storage::deallocate(ptr, size);
+    }
+
+    static void* operator new(std::size_t size)
+    { return acquire(size); }
+
+    static void operator delete(void* ptr, std::size_t size)
+    { release(ptr, size); }
+
+    static void term()
+    { Blocks::term(); }
+
+    static unsigned get_idle()
+    { return Blocks::get_idle(); }
+
+private:
+    struct Free
+    {
+        void operator()(void* ptr) const
+        { Storage::deallocate(ptr, sizeof(T)); }
+    };
+
+    using Blocks = FreeListPool<T, MAX_IDLE, void, Free>;
+};
+}
+
+#endif
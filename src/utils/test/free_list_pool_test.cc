@@ -0,0 +1,200 @@
+//--------------------------------------------------------------------------
+// Copyright (C) 2026 Cisco and/or its affiliates. All rights reserved.
+//
+// This program is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License Version 2 as published
+// by the Free Software Foundation.  You may not use, modify or distribute
+// this program under any other version of the GNU General Public License.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+//--------------------------------------------------------------------------
+// free_list_pool_test.cc author Cisco
+// unit test main
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "utils/free_list_pool.h"
+
+#include <cstdint>
+#include <vector>
+
+#include <CppUTest/CommandLineTestRunner.h>
+#include <CppUTest/TestHarness.h>
+
+// Each test uses its own pooled type so that its pool starts out empty and is closed at the end
+
+template <unsigned N>
+struct Pooled : public snort::StoragePool<Pooled<N>, 4>
+{
+    uint8_t payload[64];
+};
+
+template <unsigned N>
+struct PooledDerived : public Pooled<N>
+{
+    uint8_t more[64];
+};
+
+TEST_GROUP(storage_pool)
+{
+};
+
+TEST(storage_pool, storage_reused)
+{
+    using Pool = snort::StoragePool<Pooled<1>, 4>;
+    Pooled<1>* first = new Pooled<1>;
+    void* const first_address = first;
+    delete first;
+    CHECK(Pool::get_idle() == 1);
+    Pooled<1>* second = new Pooled<1>;
+    CHECK(static_cast<void*>(second) == first_address);
+    CHECK(Pool::get_idle() == 0);
+    delete second;
+    Pool::term();
+    CHECK(Pool::get_idle() == 0);
+}
+
+TEST(storage_pool, idle_limit)
+{
+    using Pool = snort::StoragePool<Pooled<2>, 4>;
+    std::vector<Pooled<2>*> objects;
+    for (unsigned k = 0; k < 10; k++)
+        objects.push_back(new Pooled<2>);
+    for (Pooled<2>* object : objects)
+        delete object;
+    CHECK(Pool::get_idle() == 4);
+    Pool::term();
+    CHECK(Pool::get_idle() == 0);
+}
+
+TEST(storage_pool, other_sizes_bypass_pool)
+{
+    using Pool = snort::StoragePool<Pooled<3>, 4>;
+    Pooled<3>* derived = new PooledDerived<3>;
+    delete static_cast<PooledDerived<3>*>(derived);
+    CHECK(Pool::get_idle() == 0);
+    Pool::term();
+}
+
+TEST(storage_pool, closed_pool)
+{
+    using Pool = snort::StoragePool<Pooled<4>, 4>;
+    Pooled<4>* object = new Pooled<4>;
+    Pool::term();
+    delete object;
+    CHECK(Pool::get_idle() == 0);
+}
+
+// Blocks that leave the pool go back to the storage they came from
+
+struct CountingStorage
+{
+    static void* allocate(std::size_t size)
+    {
+        blocks++;
+        return ::operator new(size);
+    }
+
+    static void deallocate(void* ptr, std::size_t)
+    {
+        blocks--;
+        ::operator delete(ptr);
+    }
+
+    static unsigned blocks;
+};
+
+unsigned CountingStorage::blocks = 0;
+
+struct Stored : public snort::StoragePool<Stored, 1, CountingStorage>
+{
+    uint8_t payload[64];
+};
+
+struct StoredDerived : public Stored
+{
+    uint8_t more[64];
+};
+
+TEST(storage_pool, custom_storage)
+{
+    using Pool = snort::StoragePool<Stored, 1, CountingStorage>;
+    Stored* first = new Stored;
+    Stored* second = new Stored;
+    StoredDerived* derived = new StoredDerived;
+    CHECK(CountingStorage::blocks == 3);
+
+    delete derived;
+    delete second;
+    delete first;
+    CHECK(Pool::get_idle() == 1);
+    CHECK(CountingStorage::blocks == 1);
+
+    Pool::term();
+    CHECK(CountingStorage::blocks == 0);
+}
+
+// Objects kept by a FreeListPool are handed back as they were given
+
+struct Context
+{
+    Context() { live++; }
+    ~Context() { live--; }
+
+    unsigned uses = 0;
+    static unsigned live;
+};
+
+unsigned Context::live = 0;
+
+template <unsigned N>
+struct Owner
+{ };
+
+TEST_GROUP(free_list_pool)
+{
+};
+
+TEST(free_list_pool, objects_reused)
+{
+    using Pool = snort::FreeListPool<Owner<1>, 2, Context>;
+    CHECK(Pool::take() == nullptr);
+
+    Context* context = new Context;
+    context->uses = 7;
+    Pool::give(context);
+    CHECK(Pool::get_idle() == 1);
+
+    Context* again = Pool::take();
+    CHECK(again == context);
+    CHECK(again->uses == 7);
+    CHECK(Pool::take() == nullptr);
+
+    Pool::give(again);
+    Pool::give(new Context);
+    Pool::give(new Context);
+    CHECK(Pool::get_idle() == 2);
+    CHECK(Context::live == 2);
+
+    Pool::term();
+    CHECK(Pool::get_idle() == 0);
+    CHECK(Context::live == 0);
+
+    Pool::give(new Context);
+    CHECK(Pool::get_idle() == 0);
+    CHECK(Context::live == 0);
+}
+
+int main(int argc, char** argv)
+{
+    return CommandLineTestRunner::RunAllTests(argc, argv);
+}
@@ -24,6 +24,38 @@
 
 #include "util_unfold.h"
 
+#include <algorithm>
+#include <cstring>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+// Returns the length of the leading run without CR or LF, checked a 16 byte
+// block at a time; whatever is left is handled by the byte loops below.
+static inline uint32_t line_run(const uint8_t* buf, uint32_t len)
+{
+    uint32_t k = 0;
+#ifdef __SSE2__
+    const __m128i cr = _mm_set1_epi8('\r');
+    const __m128i lf = _mm_set1_epi8('\n');
+
+    for (; k + 16 <= len; k += 16)
+    {
+        const __m128i c = _mm_loadu_si128((const __m128i*)(buf + k));
+        const unsigned mask = _mm_movemask_epi8(
+            _mm_or_si128(_mm_cmpeq_epi8(c, cr), _mm_cmpeq_epi8(c, lf)));
+
+        if (mask)
+            return k + __builtin_ctz(mask);
+    }
+#else
+    UNUSED(buf);
+    UNUSED(len);
+#endif
+    return k;
+}
+
 namespace snort
 {
 /* Given a string, removes header folding (\r\n followed by linear whitespace)
@@ -120,6 +152,17 @@ int sf_strip_CRLF(const uint8_t* inbuf, uint32_t inbuf_size, uint8_t* outbuf,
     outbuf_ptr = outbuf;
     while ((cursor < endofinbuf) && (n < outbuf_size))
     {
+        uint32_t run = line_run(cursor, std::min((uint32_t)(endofinbuf - cursor), outbuf_size - n));
+
+        if (run)
+        {
+            memcpy(outbuf_ptr, cursor, run);
+            outbuf_ptr += run;
+            cursor += run;
+            n += run;
+            continue;
+        }
+
         if ((*cursor != '\n') && (*cursor != '\r'))
         {
             *outbuf_ptr++ = *cursor;
@@ -154,6 +197,18 @@ int sf_strip_LWS(const uint8_t* inbuf, uint32_t inbuf_size, uint8_t* outbuf,
     outbuf_ptr = outbuf;
     while ((cursor < endofinbuf) && (n < outbuf_size))
     {
+        uint32_t run = line_run(cursor, std::min((uint32_t)(endofinbuf - cursor), outbuf_size - n));
+
+        if (run)
+        {
+            memcpy(outbuf_ptr, cursor, run);
+            outbuf_ptr += run;
+            cursor += run;
+            n += run;
+            lws = (outbuf_ptr[-1] == ' ') || (outbuf_ptr[-1] == '\t');
+            continue;
+        }
+
         if ((*cursor != '\n') && (*cursor != '\r'))
         {
             if ((*cursor != ' ') && (*cursor != '\t'))